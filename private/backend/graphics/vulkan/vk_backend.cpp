@@ -11,6 +11,8 @@
 #include <wvn/container/array.h>
 #include <wvn/maths/vec3.h>
 
+#include <chrono>
+
 /* =====================
  * TODO LIST
  * ---------------------
@@ -195,18 +197,36 @@ static VkVertexInputBindingDescription get_vertex_binding_description()
 }
 
 RendererBackendProperties VulkanBackend::properties() { return {
-	.y_positive_down = true
+	.y_positive_down = true,
+	.bindless_textures = m_bindless_table.is_enabled()
 }; }
 
+RendererBackendFrameStats VulkanBackend::frame_stats() const
+{
+	return m_frame_stats;
+}
+
 VulkanBackend::VulkanBackend()
 	: vulkan_instance(VK_NULL_HANDLE)
 	, m_current_frame_idx(0)
+	, m_frame_begun(false)
+	, m_frame_stats()
 	, m_current_render_pass_builder()
+	, m_pending_barrier_src_stages(0)
+	, m_pending_barrier_dst_stages(0)
+	, m_pending_barrier_src_access(0)
+	, m_pending_barrier_dst_access(0)
+	, m_pass_begin_info()
+	, m_pass_draws()
+	, m_pass_push_constants()
+	, m_command_recorder()
 	, m_descriptor_pool_mgr(this)
 	, m_image_infos()
+	, m_storage_buffer_infos()
 	, m_shader_stages()
 	, m_sample_shading_enabled(true)
 	, m_ubo_mgr()
+	, m_transfer_mgr()
 	, m_push_constants()
 	, m_min_sample_shading(0.2f)
 	, m_blend_state_logic_op_enabled(false)
@@ -216,6 +236,8 @@ VulkanBackend::VulkanBackend()
 	, m_descriptor_cache(this)
 	, m_descriptor_builder()
 	, m_descriptor_builder_dirty(true)
+	, m_bindless_table()
+	, m_bindless_supported(false)
 	, m_pipeline_process_cache()
 	, swap_chain_image_format()
 	, m_texture_mgr(nullptr)
@@ -323,12 +345,24 @@ VulkanBackend::~VulkanBackend()
 
 	m_current_render_pass_builder->clean_up();
 
+	m_command_recorder.clean_up();
+	m_transfer_mgr.clean_up();
 	m_ubo_mgr.clean_up();
 
+	m_bindless_table.clean_up();
 	m_descriptor_cache.clean_up();
 	m_descriptor_pool_mgr.clean_up();
 
-	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++) {
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++)
+	{
+		for (auto& buffer : frames[i].deferred_buffer_deletions) {
+			delete buffer;
+		}
+
+		for (auto& texture : frames[i].deferred_texture_deletions) {
+			delete texture;
+		}
+
 		vkDestroyFence(this->device, frames[i].in_flight_fence, nullptr);
 		vkDestroyCommandPool(this->device, frames[i].command_pool, nullptr);
 	}
@@ -437,6 +471,26 @@ void VulkanBackend::create_logical_device(const QueueFamilyIdx& phys_idx)
 	create_info.enabledExtensionCount = wvn_ARRAY_LENGTH(vkutil::DEVICE_EXTENSIONS);
 	create_info.pEnabledFeatures = &physical_data.features;
 
+	VkPhysicalDeviceVulkan12Features vulkan12_features = {};
+	vulkan12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	vulkan12_features.timelineSemaphore = VK_TRUE;
+
+	// descriptor indexing is only switched on when it is both asked for and available
+	m_bindless_supported =
+		Root::get_singleton()->config().has_flag(Config::FLAG_BINDLESS_TEXTURES) &&
+		VulkanBindlessTable::is_supported(physical_data.device);
+
+	if (m_bindless_supported)
+	{
+		vulkan12_features.runtimeDescriptorArray = VK_TRUE;
+		vulkan12_features.descriptorBindingPartiallyBound = VK_TRUE;
+		vulkan12_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		vulkan12_features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		vulkan12_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+	}
+
+	create_info.pNext = &vulkan12_features;
+
 #if wvn_DEBUG
 	if (g_debug_enable_validation_layers) {
 		create_info.enabledLayerCount = wvn_ARRAY_LENGTH(vkutil::VALIDATION_LAYERS);
@@ -475,18 +529,23 @@ void VulkanBackend::create_pipeline_process_cache()
 
 VkPipelineLayout VulkanBackend::get_graphics_pipeline_layout()
 {
-	VulkanDescriptorBuilder builder = get_descriptor_builder();
-	u64 pipeline_layout_hash = builder.hash();
+	VulkanDescriptorBuilder& builder = get_descriptor_builder();
+	u64 pipeline_layout_hash = builder.layout_hash();
 
 	u64 push_constant_count = m_push_constants.size();
 	hash::combine(&pipeline_layout_hash, &push_constant_count);
 
+	bool bindless = m_bindless_table.is_enabled();
+	hash::combine(&pipeline_layout_hash, &bindless);
+
 	if (m_pipeline_layout_cache.contains(pipeline_layout_hash)) {
 		return m_pipeline_layout_cache[pipeline_layout_hash];
 	}
 
-	VkDescriptorSetLayout layout = {};
-	builder.build_layout(layout);
+	// set 0 holds the per-draw bindings, set 1 (when enabled) the global bindless table
+	VkDescriptorSetLayout layouts[2] = {};
+	builder.build_layout(layouts[0]);
+	layouts[1] = m_bindless_table.layout();
 
 	VkPushConstantRange push_constants;
 	push_constants.offset = 0;
@@ -495,8 +554,8 @@ VkPipelineLayout VulkanBackend::get_graphics_pipeline_layout()
 
 	VkPipelineLayoutCreateInfo pipeline_layout_create_info = {};
 	pipeline_layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipeline_layout_create_info.setLayoutCount = 1;
-	pipeline_layout_create_info.pSetLayouts = &layout;
+	pipeline_layout_create_info.setLayoutCount = bindless ? 2 : 1;
+	pipeline_layout_create_info.pSetLayouts = layouts;
 	pipeline_layout_create_info.pushConstantRangeCount = 1;
 	pipeline_layout_create_info.pPushConstantRanges = &push_constants;
 
@@ -683,6 +742,10 @@ void VulkanBackend::create_command_buffers()
 		if (VkResult result = vkAllocateCommandBuffers(this->device, &command_buffer_allocate_info, &frames[i].command_buffer); result != VK_SUCCESS) {
 			wvn_ERROR("[VULKAN|DEBUG] Failed to create command buffers: %d", result);
 		}
+
+		// more are allocated on demand if a frame records more passes than this
+		frames[i].pass_command_buffers.push_back(frames[i].command_buffer);
+		frames[i].pass_count = 0;
 	}
 
 	dev::LogMgr::get_singleton()->print("[VULKAN] Created command buffer!");
@@ -738,11 +801,29 @@ Backbuffer* VulkanBackend::create_backbuffer()
 
 	dev::LogMgr::get_singleton()->print("[VULKAN] Created in flight fence!");
 
+	m_transfer_mgr.init(this,
+		queue_families.transfer_family.value(),
+		queue_families.graphics_family.value(),
+		64 * 1024 * 1024
+	);
+
 	m_ubo_mgr.init(this,
 		1024 * 256 * vkutil::FRAMES_IN_FLIGHT
 	);
 
-	m_descriptor_pool_mgr.init();
+	m_command_recorder.init(this,
+		queue_families.graphics_family.value(),
+		Root::get_singleton()->worker_pool()
+	);
+
+	m_descriptor_pool_mgr.init(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
+	m_descriptor_cache.init(&m_descriptor_pool_mgr);
+
+	if (m_bindless_supported) {
+		m_bindless_table.init(this);
+	} else if (Root::get_singleton()->config().has_flag(Config::FLAG_BINDLESS_TEXTURES)) {
+		dev::LogMgr::get_singleton()->print("[VULKAN] Bindless textures were requested but descriptor indexing is not supported, falling back to per-material descriptors.");
+	}
 
 	backbuffer->create();
 
@@ -772,7 +853,7 @@ void VulkanBackend::reset_descriptor_builder()
 	);
 }
 
-VulkanDescriptorBuilder VulkanBackend::get_descriptor_builder()
+VulkanDescriptorBuilder& VulkanBackend::get_descriptor_builder()
 {
 	if (!m_descriptor_builder_dirty) {
 		return m_descriptor_builder;
@@ -809,27 +890,34 @@ VulkanDescriptorBuilder VulkanBackend::get_descriptor_builder()
 		);
 	}
 
+	// bind storage buffers, past every texture slot so a shader can rely on their binding
+	for (int i = 0; i < m_storage_buffer_infos.size(); i++)
+	{
+		if (!m_storage_buffer_infos[i].buffer) {
+			continue;
+		}
+
+		m_descriptor_builder.bind_buffer(
+			n_ubo_descriptors + wvn_MAX_BOUND_TEXTURES + i,
+			&m_storage_buffer_infos[i],
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			VK_SHADER_STAGE_ALL_GRAPHICS
+		);
+	}
+
 	m_descriptor_builder_dirty = false;
 	return m_descriptor_builder;
 }
 
+// the set only holds the (long-lived) buffer & texture bindings, per-draw uniform data is
+// selected through dynamic offsets so it never causes a new set to be allocated
 VkDescriptorSet VulkanBackend::get_descriptor_set()
 {
-	u64 descriptor_set_hash = 0;
-
-	for (int i = 0; i < m_image_infos.size(); i++) {
-		if (!m_image_infos[i].imageView) {
-			break;
-		} else {
-			hash::combine(&descriptor_set_hash, &m_image_infos[i]);
-		}
-	}
-
 	VkDescriptorSet descriptor_set = {};
 	VkDescriptorSetLayout descriptor_set_layout = {};
 
-	VulkanDescriptorBuilder builder = get_descriptor_builder();
-	builder.build(descriptor_set, descriptor_set_layout, descriptor_set_hash);
+	VulkanDescriptorBuilder& builder = get_descriptor_builder();
+	builder.build(descriptor_set, descriptor_set_layout, builder.hash());
 
 	return descriptor_set;
 }
@@ -893,8 +981,13 @@ void VulkanBackend::set_cull_mode(CullMode cull)
 
 void VulkanBackend::set_texture(u32 idx, const Texture* texture)
 {
-	if (!texture) {
-		m_image_infos[idx].imageView = VK_NULL_HANDLE;
+	if (!texture)
+	{
+		if (m_image_infos[idx].imageView) {
+			m_image_infos[idx].imageView = VK_NULL_HANDLE;
+			m_descriptor_builder_dirty = true;
+		}
+
 		return;
 	}
 
@@ -924,6 +1017,51 @@ void VulkanBackend::set_sampler(u32 idx, TextureSampler* sampler)
 	}
 }
 
+void VulkanBackend::set_storage_buffer(u32 idx, const GPUBuffer* buffer)
+{
+	VkBuffer vk_buffer = buffer ? ((const VulkanBuffer*)buffer)->buffer() : VK_NULL_HANDLE;
+
+	if (m_storage_buffer_infos[idx].buffer != vk_buffer)
+	{
+		m_storage_buffer_infos[idx].buffer = vk_buffer;
+		m_storage_buffer_infos[idx].offset = 0;
+		m_storage_buffer_infos[idx].range = VK_WHOLE_SIZE;
+		m_descriptor_builder_dirty = true;
+	}
+}
+
+u32 VulkanBackend::get_bindless_texture_index(const Texture* texture)
+{
+	if (!texture) {
+		return VulkanBindlessTable::INVALID_INDEX;
+	}
+
+	return ((const VulkanTexture*)texture)->bindless_index();
+}
+
+u32 VulkanBackend::get_bindless_sampler_index(TextureSampler* sampler)
+{
+	if (!sampler || !m_bindless_table.is_enabled()) {
+		return VulkanBindlessTable::INVALID_INDEX;
+	}
+
+	return m_bindless_table.register_sampler(((VulkanTextureSampler*)sampler)->bind(device, physical_data.properties, 4));
+}
+
+u32 VulkanBackend::create_bindless_material()
+{
+	if (!m_bindless_table.is_enabled()) {
+		return VulkanBindlessTable::INVALID_INDEX;
+	}
+
+	return m_bindless_table.create_material();
+}
+
+void VulkanBackend::update_bindless_material(u32 idx, const BindlessMaterialData& data)
+{
+	m_bindless_table.update_material(idx, data);
+}
+
 void VulkanBackend::bind_shader(const ShaderProgram* shader)
 {
 	if (!shader) {
@@ -936,9 +1074,9 @@ void VulkanBackend::bind_shader(const ShaderProgram* shader)
 	m_shader_stages[vksh->type] = vksh->get_shader_stage_create_info();
 }
 
-void VulkanBackend::bind_shader_params(ShaderProgramType shader_type, ShaderParameters& params)
+void VulkanBackend::bind_shader_params(ShaderProgramType shader_type, const ShaderParameters& params)
 {
-	ShaderParameters::PackedConstants packed_constants = params.get_packed_constants();
+	const ShaderParameters::PackedConstants& packed_constants = params.get_packed_constants();
 
 	if (packed_constants.size() <= 0) {
 		return;
@@ -954,7 +1092,7 @@ void VulkanBackend::bind_shader_params(ShaderProgramType shader_type, ShaderPara
 	}
 }
 
-void VulkanBackend::set_push_constants(ShaderParameters& params)
+void VulkanBackend::set_push_constants(const ShaderParameters& params)
 {
 	m_push_constants = params.get_packed_constants();
 }
@@ -964,18 +1102,49 @@ void VulkanBackend::reset_push_constants()
 	m_push_constants.clear();
 }
 
-void VulkanBackend::clear_descriptor_set_and_pool()
+void VulkanBackend::begin_frame()
 {
-	m_descriptor_cache.clear_set_cache();
-//	m_descriptor_pool_mgr.reset_pools();
+	FrameData& frame = current_frame();
+
+	// the fence for this frame was already waited on in swap_buffers, so nothing from the pool is in use anymore
+	vkResetCommandPool(this->device, frame.command_pool, 0);
+	frame.pass_count = 0;
+
+	m_command_recorder.begin_frame(m_current_frame_idx);
+	m_descriptor_cache.begin_frame(m_current_frame_idx);
+	m_bindless_table.begin_frame(m_current_frame_idx);
+	m_frame_stats.draw_count = 0;
+
+	m_frame_begun = true;
 }
 
 void VulkanBackend::begin_render()
 {
-	vkWaitForFences(this->device, 1, &current_frame().in_flight_fence, VK_TRUE, UINT64_MAX);
+	if (!m_frame_begun) {
+		begin_frame();
+	}
 
-	vkResetCommandPool(this->device, current_frame().command_pool, 0);
-	VkCommandBuffer current_buffer = current_frame().command_buffer;
+	FrameData& frame = current_frame();
+
+	if (frame.pass_count >= frame.pass_command_buffers.size())
+	{
+		VkCommandBufferAllocateInfo command_buffer_allocate_info = {};
+		command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		command_buffer_allocate_info.commandPool = frame.command_pool;
+		command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		command_buffer_allocate_info.commandBufferCount = 1;
+
+		VkCommandBuffer pass_buffer = VK_NULL_HANDLE;
+
+		if (VkResult result = vkAllocateCommandBuffers(this->device, &command_buffer_allocate_info, &pass_buffer); result != VK_SUCCESS) {
+			wvn_ERROR("[VULKAN|DEBUG] Failed to create pass command buffer: %d", result);
+		}
+
+		frame.pass_command_buffers.push_back(pass_buffer);
+	}
+
+	frame.command_buffer = frame.pass_command_buffers[frame.pass_count++];
+	VkCommandBuffer current_buffer = frame.command_buffer;
 
 	VkCommandBufferBeginInfo command_buffer_begin_info = {};
 	command_buffer_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -985,136 +1154,195 @@ void VulkanBackend::begin_render()
 		wvn_ERROR("[VULKAN|DEBUG] Failed to begin recording command buffer: %d", result);
 	}
 
-	VkRenderPassBeginInfo render_pass_begin_info = m_current_render_pass_builder->build_begin_info();
+	// barriers requested since the last pass have to land before the render pass starts
+	if (m_pending_barrier_dst_stages != 0)
+	{
+		VkMemoryBarrier memory_barrier = {};
+		memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memory_barrier.srcAccessMask = m_pending_barrier_src_access;
+		memory_barrier.dstAccessMask = m_pending_barrier_dst_access;
+
+		vkCmdPipelineBarrier(
+			current_buffer,
+			m_pending_barrier_src_stages, m_pending_barrier_dst_stages,
+			0,
+			1, &memory_barrier,
+			0, nullptr,
+			0, nullptr
+		);
+
+		m_pending_barrier_src_stages = 0;
+		m_pending_barrier_dst_stages = 0;
+		m_pending_barrier_src_access = 0;
+		m_pending_barrier_dst_access = 0;
+	}
 
-	vkCmdBeginRenderPass(current_buffer, &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
+	// the render pass itself is only begun in end_render() once we know how its draws are going to be recorded
+	m_pass_begin_info = m_current_render_pass_builder->build_begin_info();
+
+	m_pass_draws.clear();
+	m_pass_push_constants.clear();
 }
 
 void VulkanBackend::end_render()
 {
 	VkCommandBuffer current_buffer = current_frame().command_buffer;
 
-	vkCmdEndRenderPass(current_buffer);
+	m_command_recorder.record_pass(current_buffer, m_pass_begin_info, m_pass_draws, m_pass_push_constants);
+
+	m_frame_stats.draw_count += m_pass_draws.size();
 
 	if (VkResult result = vkEndCommandBuffer(current_buffer); result != VK_SUCCESS) {
 		wvn_ERROR("[VULKAN|DEBUG] Failed to record command buffer: %d", result);
 	}
+}
+
+// render passes own the image layouts (they start from UNDEFINED and finish in their sampling layout), so only
+// a global memory barrier is needed here. barriers are merged and recorded at the start of the next pass.
+void VulkanBackend::resource_barrier(const Texture* texture, RenderResourceState before, RenderResourceState after)
+{
+	m_pending_barrier_src_stages |= vkutil::get_vk_resource_state_stages(before);
+	m_pending_barrier_dst_stages |= vkutil::get_vk_resource_state_stages(after);
+	m_pending_barrier_src_access |= vkutil::get_vk_resource_state_access(before) & (VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+	m_pending_barrier_dst_access |= vkutil::get_vk_resource_state_access(after);
+}
 
-	const VkSemaphore* wait_for_finish_semaphore = m_current_render_target->type() == RENDER_TARGET_TYPE_BACKBUFFER ? &m_backbuffer->get_image_available_semaphore() : nullptr;
-	const VkSemaphore* queue_finished_semaphore = m_current_render_target->type() == RENDER_TARGET_TYPE_BACKBUFFER ? &m_backbuffer->get_render_finished_semaphore() : nullptr;
-	int semaphore_count = m_current_render_target->type() == RENDER_TARGET_TYPE_BACKBUFFER ? 1 : 0;
+// submits every pass recorded this frame in one go, in the order they were recorded
+void VulkanBackend::submit_frame()
+{
+	if (!m_frame_begun) {
+		begin_frame();
+	}
 
-	VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	FrameData& frame = current_frame();
 
-	VkSubmitInfo submit_info = {};
-	submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-	submit_info.waitSemaphoreCount = semaphore_count;
-	submit_info.pSignalSemaphores = queue_finished_semaphore;
-	submit_info.signalSemaphoreCount = semaphore_count;
-	submit_info.pWaitSemaphores = wait_for_finish_semaphore;
-	submit_info.pWaitDstStageMask = &wait_stage;
-	submit_info.commandBufferCount = 1;
-	submit_info.pCommandBuffers = &current_buffer;
+	// push out any uploads recorded since the last submit so this frame can depend on them
+	u64 upload_value = m_transfer_mgr.flush();
 
-	vkResetFences(this->device, 1, &current_frame().in_flight_fence);
+	VkSemaphore wait_semaphores[2] = {};
+	VkPipelineStageFlags wait_stages[2] = {};
+	u64 wait_values[2] = {};
+	int wait_count = 0;
 
-	if (VkResult result = vkQueueSubmit(queues.graphics, 1, &submit_info, current_frame().in_flight_fence); result != VK_SUCCESS) {
+	wait_semaphores[wait_count] = m_backbuffer->get_image_available_semaphore();
+	wait_stages[wait_count] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	wait_values[wait_count] = 0;
+	wait_count++;
+
+	if (upload_value > 0)
+	{
+		wait_semaphores[wait_count] = m_transfer_mgr.timeline_semaphore();
+		wait_stages[wait_count] = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		wait_values[wait_count] = upload_value;
+		wait_count++;
+	}
+
+	VkTimelineSemaphoreSubmitInfo timeline_submit_info = {};
+	timeline_submit_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timeline_submit_info.waitSemaphoreValueCount = wait_count;
+	timeline_submit_info.pWaitSemaphoreValues = wait_values;
+
+	VkSubmitInfo submit_info = {};
+	submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submit_info.pNext = &timeline_submit_info;
+	submit_info.waitSemaphoreCount = wait_count;
+	submit_info.pWaitSemaphores = wait_semaphores;
+	submit_info.pWaitDstStageMask = wait_stages;
+	submit_info.signalSemaphoreCount = 1;
+	submit_info.pSignalSemaphores = &m_backbuffer->get_render_finished_semaphore();
+	submit_info.commandBufferCount = frame.pass_count;
+	submit_info.pCommandBuffers = frame.pass_command_buffers.data();
+
+	vkResetFences(this->device, 1, &frame.in_flight_fence);
+
+	if (VkResult result = vkQueueSubmit(queues.graphics, 1, &submit_info, frame.in_flight_fence); result != VK_SUCCESS) {
 		wvn_ERROR("[VULKAN|DEBUG] Failed to submit draw command to buffer: %d", result);
 	}
+
+	m_frame_stats.pass_count = frame.pass_count;
+	m_frame_stats.record_ms = m_command_recorder.frame_record_time_ms();
+	m_frame_stats.recording_threads = m_command_recorder.thread_count();
+	m_frame_stats.descriptor_allocations = m_descriptor_cache.stats().allocations;
+	m_frame_stats.descriptor_cache_hits = m_descriptor_cache.stats().cache_hits;
+	m_frame_stats.cached_descriptor_sets = m_descriptor_cache.stats().cached_sets;
+	m_bindless_table.end_frame();
+	m_frame_begun = false;
 }
 
-void VulkanBackend::swap_buffers()
+// blocks until the gpu has finished with the frame that last used this slot, i.e. frame N - FRAMES_IN_FLIGHT
+void VulkanBackend::wait_for_frame()
 {
-	vkWaitForFences(this->device, 1, &current_frame().in_flight_fence, VK_TRUE, UINT64_MAX);
+	FrameData& frame = current_frame();
 
-	reset_descriptor_builder(); // todo: this should NOT be called every frame. figure out when to actually call this!
+	auto wait_start = std::chrono::steady_clock::now();
+	vkWaitForFences(this->device, 1, &frame.in_flight_fence, VK_TRUE, UINT64_MAX);
+	auto wait_end = std::chrono::steady_clock::now();
 
-	m_backbuffer->swap_buffers();
+	m_frame_stats.cpu_wait_ms = std::chrono::duration<double, std::milli>(wait_end - wait_start).count();
 
-	m_current_frame_idx = (m_current_frame_idx + 1) % vkutil::FRAMES_IN_FLIGHT;
+	for (auto& buffer : frame.deferred_buffer_deletions) {
+		delete buffer;
+	}
 
-	m_ubo_mgr.reset_ubo_usage_in_frame();
+	frame.deferred_buffer_deletions.clear();
 
-	m_backbuffer->acquire_next_image();
+	for (auto& texture : frame.deferred_texture_deletions) {
+		delete texture;
+	}
+
+	frame.deferred_texture_deletions.clear();
 }
 
-void VulkanBackend::render(const RenderOp& op)
+void VulkanBackend::swap_buffers()
 {
-	VkCommandBuffer current_buffer = current_frame().command_buffer;
+	submit_frame();
 
+	m_backbuffer->swap_buffers();
 
-	VkViewport viewport = {};
-
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.width = (float)m_current_render_pass_builder->get_width();
-	viewport.height = (float)m_current_render_pass_builder->get_height();
+	m_current_frame_idx = (m_current_frame_idx + 1) % vkutil::FRAMES_IN_FLIGHT;
 
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
+	wait_for_frame();
 
-	VkRect2D scissor = {};
+	m_ubo_mgr.begin_frame(m_current_frame_idx);
+	m_transfer_mgr.collect();
 
-	scissor.offset = { 0, 0 };
-	scissor.extent = { m_current_render_pass_builder->get_width(), m_current_render_pass_builder->get_height() };
+	m_backbuffer->acquire_next_image();
+}
 
-	vkCmdSetViewport(current_buffer, 0, 1, &viewport);
-	vkCmdSetScissor(current_buffer, 0, 1, &scissor);
+// everything that touches the pipeline / descriptor caches is resolved here on the calling thread,
+// the actual vkCmd* calls are deferred until end_render() so they can be spread over several threads
+void VulkanBackend::render(const RenderOp& op)
+{
+	VulkanDrawCommand draw = {};
 
-//	vkCmdSetViewport(current_buffer, 0, 1, &m_viewport);
-//	vkCmdSetScissor(current_buffer, 0, 1, &m_scissor);
+	draw.viewport.x = 0.0f;
+	draw.viewport.y = 0.0f;
+	draw.viewport.width = (float)m_current_render_pass_builder->get_width();
+	draw.viewport.height = (float)m_current_render_pass_builder->get_height();
+	draw.viewport.minDepth = 0.0f;
+	draw.viewport.maxDepth = 1.0f;
 
-	const auto& vertex_buffer = ((VulkanBuffer*)op.vertex_data.buffer)->buffer();
-	const auto& index_buffer  = ((VulkanBuffer*)op.index_data.buffer)->buffer();
+	draw.scissor.offset = { 0, 0 };
+	draw.scissor.extent = { m_current_render_pass_builder->get_width(), m_current_render_pass_builder->get_height() };
 
-	VkBuffer vertex_buffers[] = { vertex_buffer };
-	VkDeviceSize offsets[] = { 0 };
+	draw.vertex_buffer = ((VulkanBuffer*)op.vertex_data.buffer)->buffer();
+	draw.index_buffer  = ((VulkanBuffer*)op.index_data.buffer)->buffer();
+	draw.index_count = op.index_data.indices->size();
 
-	vkCmdBindVertexBuffers(current_buffer, 0, 1, vertex_buffers, offsets);
-	vkCmdBindIndexBuffer(current_buffer, index_buffer, 0, VK_INDEX_TYPE_UINT16);
+	draw.pipeline = get_graphics_pipeline();
+	draw.pipeline_layout = get_graphics_pipeline_layout();
+	draw.descriptor_set = get_descriptor_set();
+	draw.dynamic_offsets = m_ubo_mgr.get_dynamic_offsets();
+	draw.bindless_set = m_bindless_table.is_enabled() ? m_bindless_table.set() : VK_NULL_HANDLE;
 
-	VkPipeline pipeline = get_graphics_pipeline();
-	VkPipelineLayout pipeline_layout = get_graphics_pipeline_layout();
-	VkDescriptorSet descriptor_set = get_descriptor_set();
+	draw.push_constants_offset = m_pass_push_constants.size();
+	draw.push_constants_size = m_push_constants.size();
 
-	if (m_push_constants.size() > 0)
-	{
-		vkCmdPushConstants(
-			current_buffer,
-			pipeline_layout,
-			VK_SHADER_STAGE_ALL_GRAPHICS,
-			0,
-			m_push_constants.size(),
-			m_push_constants.data()
-		);
+	for (u64 i = 0; i < m_push_constants.size(); i++) {
+		m_pass_push_constants.push_back(m_push_constants[i]);
 	}
 
-	const auto& dynamic_offsets = m_ubo_mgr.get_dynamic_offsets();
-
-	vkCmdBindDescriptorSets(
-		current_buffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		pipeline_layout,
-		0,
-		1, &descriptor_set,
-		dynamic_offsets.size(),
-		dynamic_offsets.data()
-	);
-
-	vkCmdBindPipeline(
-		current_buffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		pipeline
-	);
-
-	vkCmdDrawIndexed(
-		current_buffer,
-		op.index_data.indices->size(),
-		1,
-		0,
-		0,
-		0
-	);
+	m_pass_draws.push_back(draw);
 }
 
 VulkanBackend::FrameData& VulkanBackend::current_frame()
@@ -1127,6 +1355,37 @@ u64 VulkanBackend::get_current_frame_idx() const
 	return m_current_frame_idx;
 }
 
+// buffers that may still be referenced by frames in flight are kept alive until this frame slot comes around again
+void VulkanBackend::defer_deletion(VulkanBuffer* buffer)
+{
+	current_frame().deferred_buffer_deletions.push_back(buffer);
+}
+
+void VulkanBackend::defer_deletion(VulkanTexture* texture)
+{
+	current_frame().deferred_texture_deletions.push_back(texture);
+}
+
+VulkanBindlessTable* VulkanBackend::bindless_table()
+{
+	return &m_bindless_table;
+}
+
+VulkanTransferMgr* VulkanBackend::transfer_mgr()
+{
+	return &m_transfer_mgr;
+}
+
+VulkanDescriptorCache* VulkanBackend::descriptor_cache()
+{
+	return &m_descriptor_cache;
+}
+
+void VulkanBackend::set_recording_thread_count(u32 thread_count)
+{
+	m_command_recorder.set_thread_count(thread_count);
+}
+
 void VulkanBackend::sync_stall() const
 {
 	while (Root::get_singleton()->system_backend()->get_window_size() == Vec2I::zero()) { }
@@ -19,8 +19,11 @@
 #include <backend/graphics/vulkan/vk_descriptor_pool_mgr.h>
 #include <backend/graphics/vulkan/vk_descriptor_builder.h>
 #include <backend/graphics/vulkan/vk_descriptor_cache.h>
+#include <backend/graphics/vulkan/vk_bindless_table.h>
 
 #include <backend/graphics/vulkan/vk_ubo_manager.h>
+#include <backend/graphics/vulkan/vk_transfer_mgr.h>
+#include <backend/graphics/vulkan/vk_command_recorder.h>
 
 #include <backend/graphics/vulkan/vk_buffer.h>
 #include <backend/graphics/vulkan/vk_texture.h>
@@ -58,7 +61,11 @@ namespace wvn::gfx
 		{
 			VkFence in_flight_fence;
 			VkCommandPool command_pool;
-			VkCommandBuffer command_buffer;
+			VkCommandBuffer command_buffer; // pass currently being recorded
+			Vector<VkCommandBuffer> pass_command_buffers;
+			u32 pass_count;
+			Vector<VulkanBuffer*> deferred_buffer_deletions;
+			Vector<VulkanTexture*> deferred_texture_deletions;
 		};
 
 	public:
@@ -66,6 +73,7 @@ namespace wvn::gfx
 		~VulkanBackend() override;
 
 		RendererBackendProperties properties() override;
+		RendererBackendFrameStats frame_stats() const override;
 
 		void begin_render() override;
 		void render(const RenderOp& op) override;
@@ -75,6 +83,8 @@ namespace wvn::gfx
 
 		void swap_buffers() override;
 
+		void resource_barrier(const Texture* texture, RenderResourceState before, RenderResourceState after) override;
+
 		void set_render_target(RenderTarget* target) override;
 
 		void on_window_resize(int width, int height) override;
@@ -102,10 +112,17 @@ namespace wvn::gfx
 		void set_texture(u32 idx, const Texture* texture) override;
 		void set_sampler(u32 idx, TextureSampler* sampler) override;
 
+		void set_storage_buffer(u32 idx, const GPUBuffer* buffer) override;
+
+		u32 get_bindless_texture_index(const Texture* texture) override;
+		u32 get_bindless_sampler_index(TextureSampler* sampler) override;
+		u32 create_bindless_material() override;
+		void update_bindless_material(u32 idx, const BindlessMaterialData& data) override;
+
 		void bind_shader(const ShaderProgram* shader) override;
-		void bind_shader_params(ShaderProgramType shader_type, ShaderParameters& params) override;
+		void bind_shader_params(ShaderProgramType shader_type, const ShaderParameters& params) override;
 
-		void set_push_constants(ShaderParameters& params) override;
+		void set_push_constants(const ShaderParameters& params) override;
 		void reset_push_constants() override;
 
 		FrameData& current_frame();
@@ -113,7 +130,14 @@ namespace wvn::gfx
 
 		void sync_stall() const;
 
-		void clear_descriptor_set_and_pool();
+		void defer_deletion(VulkanBuffer* buffer);
+		void defer_deletion(VulkanTexture* texture);
+
+		VulkanTransferMgr* transfer_mgr();
+		VulkanDescriptorCache* descriptor_cache();
+		VulkanBindlessTable* bindless_table();
+
+		void set_recording_thread_count(u32 thread_count);
 
         VkInstance vulkan_instance;
 		VkDevice device;
@@ -133,16 +157,22 @@ namespace wvn::gfx
 
 		void clear_pipeline_cache();
 
+		void begin_frame();
+		void submit_frame();
+		void wait_for_frame();
+
 		VkPipeline get_graphics_pipeline();
 		VkPipelineLayout get_graphics_pipeline_layout();
 
 		void reset_descriptor_builder();
 
-		VulkanDescriptorBuilder get_descriptor_builder();
+		VulkanDescriptorBuilder& get_descriptor_builder();
 		VkDescriptorSet get_descriptor_set();
 
 		// core
 		u64 m_current_frame_idx;
+		bool m_frame_begun;
+		RendererBackendFrameStats m_frame_stats;
 
 		// managers
 		VulkanBufferMgr* m_buffer_mgr;
@@ -157,7 +187,16 @@ namespace wvn::gfx
 
 		// render pass
 		VulkanRenderPassBuilder* m_current_render_pass_builder;
+		VkPipelineStageFlags m_pending_barrier_src_stages;
+		VkPipelineStageFlags m_pending_barrier_dst_stages;
+		VkAccessFlags m_pending_barrier_src_access;
+		VkAccessFlags m_pending_barrier_dst_access;
+		VkRenderPassBeginInfo m_pass_begin_info;
+		Vector<VulkanDrawCommand> m_pass_draws;
+		Vector<byte> m_pass_push_constants;
+		VulkanCommandRecorder m_command_recorder;
 		Array<VkDescriptorImageInfo, wvn_MAX_BOUND_TEXTURES> m_image_infos;
+		Array<VkDescriptorBufferInfo, wvn_MAX_BOUND_STORAGE_BUFFERS> m_storage_buffer_infos;
 		Array<VkPipelineShaderStageCreateInfo, SHADER_TYPE_GRAPHICS_COUNT> m_shader_stages;
 
 		// descriptors
@@ -165,6 +204,8 @@ namespace wvn::gfx
 		VulkanDescriptorCache m_descriptor_cache;
 		VulkanDescriptorBuilder m_descriptor_builder;
 		bool m_descriptor_builder_dirty;
+		VulkanBindlessTable m_bindless_table;
+		bool m_bindless_supported;
 
 		// swap chain
         VulkanBackbuffer* m_backbuffer;
@@ -176,6 +217,9 @@ namespace wvn::gfx
 		//Array<const ShaderParameters*, SHADER_TYPE_GRAPHICS_COUNT> m_current_shader_parameters;
 		ShaderParameters::PackedConstants m_push_constants;
 
+		// uploads
+		VulkanTransferMgr m_transfer_mgr;
+
 		// rendering configs
 		VkPipelineDepthStencilStateCreateInfo m_depth_stencil_create_info;
 		VkPipelineColorBlendAttachmentState m_colour_blend_attachment_state;
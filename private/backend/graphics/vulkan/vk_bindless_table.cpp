@@ -0,0 +1,423 @@
+#include <backend/graphics/vulkan/vk_bindless_table.h>
+#include <backend/graphics/vulkan/vk_backend.h>
+#include <backend/graphics/vulkan/vk_buffer.h>
+
+#include <wvn/devenv/log_mgr.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+VulkanBindlessTable::VulkanBindlessTable()
+	: m_backend(nullptr)
+	, m_layout(VK_NULL_HANDLE)
+	, m_pool(VK_NULL_HANDLE)
+	, m_sets{}
+	, m_material_buffer(nullptr)
+	, m_mapped_materials(nullptr)
+	, m_material_partition_size(0)
+	, m_frame_idx(0)
+	, m_frame_count(0)
+	, m_frame_open(false)
+	, m_pending_writes()
+	, m_texture_count(0)
+	, m_free_textures()
+	, m_retired_textures()
+	, m_samplers()
+	, m_materials()
+	, m_pending_materials()
+{
+}
+
+bool VulkanBindlessTable::is_supported(VkPhysicalDevice physical_device)
+{
+	VkPhysicalDeviceVulkan12Features vulkan12_features = {};
+	vulkan12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+	VkPhysicalDeviceFeatures2 features = {};
+	features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	features.pNext = &vulkan12_features;
+
+	vkGetPhysicalDeviceFeatures2(physical_device, &features);
+
+	return
+		vulkan12_features.runtimeDescriptorArray &&
+		vulkan12_features.descriptorBindingPartiallyBound &&
+		vulkan12_features.descriptorBindingSampledImageUpdateAfterBind &&
+		vulkan12_features.descriptorBindingUpdateUnusedWhilePending &&
+		vulkan12_features.shaderSampledImageArrayNonUniformIndexing;
+}
+
+void VulkanBindlessTable::init(VulkanBackend* backend)
+{
+	this->m_backend = backend;
+
+	// layout
+	VkDescriptorSetLayoutBinding bindings[3] = {};
+
+	bindings[0].binding = 0;
+	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	bindings[0].descriptorCount = MAX_TEXTURES;
+	bindings[0].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+	bindings[1].binding = 1;
+	bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+	bindings[1].descriptorCount = MAX_SAMPLERS;
+	bindings[1].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+	bindings[2].binding = 2;
+	bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	bindings[2].descriptorCount = 1;
+	bindings[2].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+	VkDescriptorBindingFlags binding_flags[3] = {
+		VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+		VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+		0
+	};
+
+	VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_create_info = {};
+	binding_flags_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+	binding_flags_create_info.bindingCount = wvn_ARRAY_LENGTH(binding_flags);
+	binding_flags_create_info.pBindingFlags = binding_flags;
+
+	VkDescriptorSetLayoutCreateInfo layout_create_info = {};
+	layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layout_create_info.pNext = &binding_flags_create_info;
+	layout_create_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+	layout_create_info.bindingCount = wvn_ARRAY_LENGTH(bindings);
+	layout_create_info.pBindings = bindings;
+
+	if (VkResult result = vkCreateDescriptorSetLayout(m_backend->device, &layout_create_info, nullptr, &m_layout); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:BINDLESS|DEBUG] Failed to create bindless descriptor set layout: %d", result);
+	}
+
+	// pool
+	VkDescriptorPoolSize pool_sizes[3] = {
+		{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,  MAX_TEXTURES * vkutil::FRAMES_IN_FLIGHT },
+		{ VK_DESCRIPTOR_TYPE_SAMPLER,        MAX_SAMPLERS * vkutil::FRAMES_IN_FLIGHT },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, vkutil::FRAMES_IN_FLIGHT }
+	};
+
+	VkDescriptorPoolCreateInfo pool_create_info = {};
+	pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	pool_create_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+	pool_create_info.maxSets = vkutil::FRAMES_IN_FLIGHT;
+	pool_create_info.poolSizeCount = wvn_ARRAY_LENGTH(pool_sizes);
+	pool_create_info.pPoolSizes = pool_sizes;
+
+	if (VkResult result = vkCreateDescriptorPool(m_backend->device, &pool_create_info, nullptr, &m_pool); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:BINDLESS|DEBUG] Failed to create bindless descriptor pool: %d", result);
+	}
+
+	VkDescriptorSetLayout layouts[vkutil::FRAMES_IN_FLIGHT];
+
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++) {
+		layouts[i] = m_layout;
+	}
+
+	VkDescriptorSetAllocateInfo alloc_info = {};
+	alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	alloc_info.descriptorPool = m_pool;
+	alloc_info.descriptorSetCount = vkutil::FRAMES_IN_FLIGHT;
+	alloc_info.pSetLayouts = layouts;
+
+	if (VkResult result = vkAllocateDescriptorSets(m_backend->device, &alloc_info, m_sets); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:BINDLESS|DEBUG] Failed to allocate bindless descriptor sets: %d", result);
+	}
+
+	// material buffer, one partition per frame in flight so a frame never sees another frame's writes
+	u64 alignment = m_backend->physical_data.properties.limits.minStorageBufferOffsetAlignment;
+	m_material_partition_size = MAX_MATERIALS * sizeof(BindlessMaterialData);
+
+	if (alignment > 0) {
+		m_material_partition_size = (m_material_partition_size + alignment - 1) & ~(alignment - 1);
+	}
+
+	m_material_buffer = new VulkanBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+	m_material_buffer->create(m_backend, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_material_partition_size * vkutil::FRAMES_IN_FLIGHT);
+	m_mapped_materials = (byte*)m_material_buffer->map_persistent();
+
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++)
+	{
+		VkDescriptorBufferInfo buffer_info = {};
+		buffer_info.buffer = m_material_buffer->buffer();
+		buffer_info.offset = m_material_partition_size * i;
+		buffer_info.range = MAX_MATERIALS * sizeof(BindlessMaterialData);
+
+		VkWriteDescriptorSet write = {};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = m_sets[i];
+		write.dstBinding = 2;
+		write.dstArrayElement = 0;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.pBufferInfo = &buffer_info;
+
+		vkUpdateDescriptorSets(m_backend->device, 1, &write, 0, nullptr);
+	}
+
+	dev::LogMgr::get_singleton()->print("[VULKAN:BINDLESS] Created bindless table with room for %u textures, %u samplers and %u materials.", MAX_TEXTURES, MAX_SAMPLERS, MAX_MATERIALS);
+}
+
+void VulkanBindlessTable::clean_up()
+{
+	if (!m_backend) {
+		return;
+	}
+
+	delete m_material_buffer;
+	m_material_buffer = nullptr;
+	m_mapped_materials = nullptr;
+
+	vkDestroyDescriptorPool(m_backend->device, m_pool, nullptr);
+	vkDestroyDescriptorSetLayout(m_backend->device, m_layout, nullptr);
+
+	m_pool = VK_NULL_HANDLE;
+	m_layout = VK_NULL_HANDLE;
+
+	for (auto& set : m_sets) {
+		set = VK_NULL_HANDLE;
+	}
+
+	for (auto& writes : m_pending_writes) {
+		writes.clear();
+	}
+
+	for (auto& materials : m_pending_materials) {
+		materials.clear();
+	}
+
+	m_frame_open = false;
+	m_backend = nullptr;
+}
+
+// the fence for this frame has been waited on, so its set and its partition of the material buffer are free to overwrite
+void VulkanBindlessTable::begin_frame(u64 frame_idx)
+{
+	if (!m_backend) {
+		return;
+	}
+
+	m_frame_idx = frame_idx;
+	m_frame_count++;
+	m_frame_open = true;
+
+	Vector<PendingWrite>& pending = m_pending_writes[m_frame_idx];
+
+	if (pending.any()) {
+		apply_writes(m_sets[m_frame_idx], pending.data(), pending.size());
+		pending.clear();
+	}
+
+	// a released slot can only be handed out again once no frame in flight can still be sampling from it
+	Vector<Pair<u32, u64>> still_retired;
+
+	for (auto& [idx, frame] : m_retired_textures)
+	{
+		if (m_frame_count - frame > vkutil::FRAMES_IN_FLIGHT) {
+			m_free_textures.push_back(idx);
+		} else {
+			still_retired.push_back(Pair(idx, frame));
+		}
+	}
+
+	m_retired_textures = still_retired;
+
+	Vector<u32>& pending_materials = m_pending_materials[m_frame_idx];
+
+	for (u32 idx : pending_materials) {
+		write_material(m_frame_idx, idx);
+	}
+
+	pending_materials.clear();
+}
+
+// the current set has been submitted, from here on writes to it have to wait for its fence like the others
+void VulkanBindlessTable::end_frame()
+{
+	m_frame_open = false;
+}
+
+u32 VulkanBindlessTable::register_texture(VkImageView view)
+{
+	if (!m_backend || view == VK_NULL_HANDLE) {
+		return INVALID_INDEX;
+	}
+
+	u32 idx = INVALID_INDEX;
+
+	if (m_free_textures.any()) {
+		idx = m_free_textures.back();
+		m_free_textures.pop_back();
+	} else if (m_texture_count < MAX_TEXTURES) {
+		idx = m_texture_count++;
+	} else {
+		wvn_ERROR("[VULKAN:BINDLESS|DEBUG] Ran out of bindless texture slots.");
+		return INVALID_INDEX;
+	}
+
+	write_texture(idx, view);
+
+	return idx;
+}
+
+void VulkanBindlessTable::unregister_texture(u32 idx)
+{
+	if (!m_backend || idx == INVALID_INDEX) {
+		return;
+	}
+
+	m_retired_textures.push_back(Pair(idx, m_frame_count));
+}
+
+void VulkanBindlessTable::replace_texture(u32 idx, VkImageView view)
+{
+	if (!m_backend || idx == INVALID_INDEX) {
+		return;
+	}
+
+	write_texture(idx, view);
+}
+
+u32 VulkanBindlessTable::register_sampler(VkSampler sampler)
+{
+	if (!m_backend || sampler == VK_NULL_HANDLE) {
+		return INVALID_INDEX;
+	}
+
+	// samplers are few and long-lived, a linear scan is plenty
+	for (u32 i = 0; i < m_samplers.size(); i++) {
+		if (m_samplers[i] == sampler) {
+			return i;
+		}
+	}
+
+	if (m_samplers.size() >= MAX_SAMPLERS) {
+		wvn_ERROR("[VULKAN:BINDLESS|DEBUG] Ran out of bindless sampler slots.");
+		return INVALID_INDEX;
+	}
+
+	u32 idx = m_samplers.size();
+	m_samplers.push_back(sampler);
+
+	queue_write({ .binding = 1, .idx = idx, .view = VK_NULL_HANDLE, .sampler = sampler });
+
+	return idx;
+}
+
+u32 VulkanBindlessTable::create_material()
+{
+	if (m_materials.size() >= MAX_MATERIALS) {
+		wvn_ERROR("[VULKAN:BINDLESS|DEBUG] Ran out of bindless material slots.");
+		return INVALID_INDEX;
+	}
+
+	BindlessMaterialData data = {};
+
+	for (int i = 0; i < wvn_MAX_BOUND_TEXTURES; i++) {
+		data.texture_indices[i] = INVALID_INDEX;
+		data.sampler_indices[i] = INVALID_INDEX;
+	}
+
+	u32 idx = m_materials.size();
+	m_materials.push_back(data);
+
+	queue_material_write(idx);
+
+	return idx;
+}
+
+void VulkanBindlessTable::update_material(u32 idx, const BindlessMaterialData& data)
+{
+	if (idx >= m_materials.size()) {
+		return;
+	}
+
+	m_materials[idx] = data;
+
+	queue_material_write(idx);
+}
+
+bool VulkanBindlessTable::is_enabled() const
+{
+	return m_backend != nullptr;
+}
+
+VkDescriptorSetLayout VulkanBindlessTable::layout() const
+{
+	return m_layout;
+}
+
+VkDescriptorSet VulkanBindlessTable::set() const
+{
+	return m_sets[m_frame_idx];
+}
+
+u32 VulkanBindlessTable::texture_count() const
+{
+	return m_texture_count - m_free_textures.size() - m_retired_textures.size();
+}
+
+void VulkanBindlessTable::write_texture(u32 idx, VkImageView view)
+{
+	queue_write({ .binding = 0, .idx = idx, .view = view, .sampler = VK_NULL_HANDLE });
+}
+
+// sets of frames that have been submitted may still be read by the gpu, so they only pick the write up in their begin_frame()
+// the view being replaced has to outlive that, which the backend's deferred deletion already guarantees
+void VulkanBindlessTable::queue_write(const PendingWrite& write)
+{
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++)
+	{
+		if (m_frame_open && (u64)i == m_frame_idx) {
+			apply_writes(m_sets[i], &write, 1);
+		} else {
+			m_pending_writes[i].push_back(write);
+		}
+	}
+}
+
+// materials are created and updated lazily while draws are being recorded, so the frame being recorded has to see the
+// new data straight away rather than a partition later, the same way queue_write() treats the current set
+void VulkanBindlessTable::queue_material_write(u32 idx)
+{
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++)
+	{
+		if (m_frame_open && (u64)i == m_frame_idx) {
+			write_material(i, idx);
+		} else {
+			m_pending_materials[i].push_back(idx);
+		}
+	}
+}
+
+void VulkanBindlessTable::write_material(u64 partition, u32 idx)
+{
+	mem::copy(m_mapped_materials + (m_material_partition_size * partition) + (sizeof(BindlessMaterialData) * idx), &m_materials[idx], sizeof(BindlessMaterialData));
+}
+
+void VulkanBindlessTable::apply_writes(VkDescriptorSet set, const PendingWrite* writes, u64 count)
+{
+	Vector<VkDescriptorImageInfo> image_infos(count);
+	Vector<VkWriteDescriptorSet> descriptor_writes(count);
+
+	for (u64 i = 0; i < count; i++)
+	{
+		image_infos[i] = {};
+		image_infos[i].imageView = writes[i].view;
+		image_infos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		image_infos[i].sampler = writes[i].sampler;
+
+		descriptor_writes[i] = {};
+		descriptor_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptor_writes[i].dstSet = set;
+		descriptor_writes[i].dstBinding = writes[i].binding;
+		descriptor_writes[i].dstArrayElement = writes[i].idx;
+		descriptor_writes[i].descriptorCount = 1;
+		descriptor_writes[i].descriptorType = writes[i].binding == 0 ? VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLER;
+		descriptor_writes[i].pImageInfo = &image_infos[i];
+	}
+
+	// later writes to the same slot come after earlier ones in the array, so the newest one wins
+	vkUpdateDescriptorSets(m_backend->device, count, descriptor_writes.data(), 0, nullptr);
+}
@@ -0,0 +1,109 @@
+#ifndef VK_BINDLESS_TABLE_H_
+#define VK_BINDLESS_TABLE_H_
+
+#include <vulkan/vulkan.h>
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/container/pair.h>
+
+#include <wvn/graphics/material.h>
+
+#include <backend/graphics/vulkan/vk_util.h>
+
+namespace wvn::gfx
+{
+	class VulkanBackend;
+	class VulkanBuffer;
+
+	/**
+	 * One global, update-after-bind descriptor set per frame in flight holding every registered
+	 * texture and sampler, plus a storage buffer of per-material texture/sampler indices.
+	 * Binding a material becomes writing an index instead of allocating a new descriptor set.
+	 *
+	 * Texture and sampler writes are queued per set and only applied once that frame's fence has
+	 * signalled, so a set the gpu may still be reading is never touched. The set of the frame that is
+	 * currently being recorded is written straight away, update-after-bind makes that legal.
+	 *
+	 * set = 1, binding = 0: texture2D textures[]
+	 * set = 1, binding = 1: sampler samplers[]
+	 * set = 1, binding = 2: readonly buffer { BindlessMaterialData materials[]; }
+	 */
+	class VulkanBindlessTable
+	{
+	public:
+		static constexpr u32 INVALID_INDEX = ~0u;
+
+		static constexpr u32 MAX_TEXTURES = 4096;
+		static constexpr u32 MAX_SAMPLERS = 256;
+		static constexpr u32 MAX_MATERIALS = 4096;
+
+		VulkanBindlessTable();
+
+		static bool is_supported(VkPhysicalDevice physical_device);
+
+		void init(VulkanBackend* backend);
+		void clean_up();
+
+		void begin_frame(u64 frame_idx);
+		void end_frame();
+
+		u32 register_texture(VkImageView view);
+		void unregister_texture(u32 idx);
+		void replace_texture(u32 idx, VkImageView view);
+
+		u32 register_sampler(VkSampler sampler);
+
+		u32 create_material();
+		void update_material(u32 idx, const BindlessMaterialData& data);
+
+		bool is_enabled() const;
+
+		VkDescriptorSetLayout layout() const;
+		VkDescriptorSet set() const;
+
+		u32 texture_count() const;
+
+	private:
+		struct PendingWrite
+		{
+			u32 binding;
+			u32 idx;
+			VkImageView view;
+			VkSampler sampler;
+		};
+
+		void write_texture(u32 idx, VkImageView view);
+		void queue_write(const PendingWrite& write);
+		void queue_material_write(u32 idx);
+		void write_material(u64 partition, u32 idx);
+		void apply_writes(VkDescriptorSet set, const PendingWrite* writes, u64 count);
+
+		VulkanBackend* m_backend;
+
+		VkDescriptorSetLayout m_layout;
+		VkDescriptorPool m_pool;
+		VkDescriptorSet m_sets[vkutil::FRAMES_IN_FLIGHT];
+
+		VulkanBuffer* m_material_buffer;
+		byte* m_mapped_materials;
+		u64 m_material_partition_size;
+
+		u64 m_frame_idx;
+		u64 m_frame_count;
+		bool m_frame_open; // between begin_frame() and end_frame(), the current set is only referenced by command buffers still being recorded
+
+		Vector<PendingWrite> m_pending_writes[vkutil::FRAMES_IN_FLIGHT];
+
+		u32 m_texture_count; // high water mark, indices below it have been handed out at least once
+		Vector<u32> m_free_textures;
+		Vector<Pair<u32, u64>> m_retired_textures; // index + the frame it was released on
+
+		Vector<VkSampler> m_samplers;
+
+		Vector<BindlessMaterialData> m_materials;
+		Vector<u32> m_pending_materials[vkutil::FRAMES_IN_FLIGHT]; // per partition, materials it still holds stale data for
+	};
+}
+
+#endif // VK_BINDLESS_TABLE_H_
@@ -12,6 +12,7 @@ VulkanBuffer::VulkanBuffer(GPUBufferUsage usage)
 	, m_backend(nullptr)
 	, m_buffer(VK_NULL_HANDLE)
 	, m_memory(VK_NULL_HANDLE)
+	, m_mapped_data(nullptr)
 	, m_usage(usage)
 	, m_properties()
 {
@@ -60,6 +61,11 @@ void VulkanBuffer::clean_up()
         return;
     }
 
+	if (m_mapped_data) {
+		vkUnmapMemory(m_backend->device, m_memory);
+		m_mapped_data = nullptr;
+	}
+
 	vkDestroyBuffer(m_backend->device, m_buffer, nullptr);
 	vkFreeMemory(m_backend->device, m_memory, nullptr);
 
@@ -69,6 +75,11 @@ void VulkanBuffer::clean_up()
 
 void VulkanBuffer::read_data_from_memory(const void* src, u64 length, u64 offset)
 {
+	if (m_mapped_data) {
+		mem::copy((byte*)m_mapped_data + offset, src, length);
+		return;
+	}
+
 	void* dst = nullptr;
 	vkMapMemory(m_backend->device, m_memory, offset, length, 0, &dst);
 	mem::copy(dst, src, length);
@@ -134,6 +145,22 @@ void VulkanBuffer::write_to_tex(const Texture* texture, u64 size, u64 offset, u3
 	}
 }
 
+// queues the upload on the transfer manager instead of blocking on a single time command
+void VulkanBuffer::upload_data(const void* src, u64 length, u64 offset)
+{
+	m_backend->transfer_mgr()->upload_to_buffer(this, src, length, offset);
+}
+
+// maps the whole buffer once and keeps it mapped until the buffer is cleaned up
+void* VulkanBuffer::map_persistent()
+{
+	if (!m_mapped_data) {
+		vkMapMemory(m_backend->device, m_memory, 0, VK_WHOLE_SIZE, 0, &m_mapped_data);
+	}
+
+	return m_mapped_data;
+}
+
 VkBuffer VulkanBuffer::buffer() const { return m_buffer; }
 VkDeviceMemory VulkanBuffer::memory() const { return m_memory; }
 GPUBufferUsage VulkanBuffer::usage() const { return m_usage; }
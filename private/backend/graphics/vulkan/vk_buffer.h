@@ -23,6 +23,9 @@ namespace wvn::gfx
 		void write_data_to_memory(void* dst, u64 length, u64 offset) override;
 		void write_to_buffer(const GPUBuffer* other, u64 length, u64 src_offset, u64 dst_offset) override;
 		void write_to_tex(const Texture* texture, u64 size, u64 offset = 0, u32 base_array_layer = 0) override;
+		void upload_data(const void* src, u64 length, u64 offset) override;
+
+		void* map_persistent();
 
 		VkBuffer buffer() const;
 		VkDeviceMemory memory() const;
@@ -35,6 +38,7 @@ namespace wvn::gfx
 
 		VkBuffer m_buffer;
 		VkDeviceMemory m_memory;
+		void* m_mapped_data;
 
 		GPUBufferUsage m_usage;
 		VkMemoryPropertyFlags m_properties;
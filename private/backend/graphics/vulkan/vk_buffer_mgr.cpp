@@ -1,4 +1,5 @@
 #include <backend/graphics/vulkan/vk_buffer_mgr.h>
+#include <backend/graphics/vulkan/vk_backend.h>
 #include <wvn/graphics/vertex.h>
 
 using namespace wvn;
@@ -61,3 +62,37 @@ GPUBuffer* VulkanBufferMgr::create_uniform_buffer(u64 size)
 
 	return uniform_buffer;
 }
+
+GPUBuffer* VulkanBufferMgr::create_storage_buffer(u64 size)
+{
+	VulkanBuffer* storage_buffer = new VulkanBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+	storage_buffer->create(m_backend, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, size);
+
+	return storage_buffer;
+}
+
+void VulkanBufferMgr::destroy_buffer(GPUBuffer* buffer)
+{
+	if (!buffer) {
+		return;
+	}
+
+	// vertex & index buffers are also tracked so they can be cleaned up on shutdown, they mustn't be deleted twice
+	for (u64 i = 0; i < m_vertex_buffers.size(); i++) {
+		if (m_vertex_buffers[i] == buffer) {
+			m_vertex_buffers.erase(i);
+			break;
+		}
+	}
+
+	for (u64 i = 0; i < m_index_buffers.size(); i++) {
+		if (m_index_buffers[i] == buffer) {
+			m_index_buffers.erase(i);
+			break;
+		}
+	}
+
+	// cached descriptor sets still pointing at it would otherwise be handed out again once the handle is reused
+	m_backend->descriptor_cache()->retire_buffer(((VulkanBuffer*)buffer)->buffer());
+	m_backend->defer_deletion((VulkanBuffer*)buffer);
+}
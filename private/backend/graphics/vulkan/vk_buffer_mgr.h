@@ -17,6 +17,9 @@ namespace wvn::gfx
 		GPUBuffer* create_vertex_buffer(u64 vertex_count) override;
 		GPUBuffer* create_index_buffer(u64 index_count) override;
 		GPUBuffer* create_uniform_buffer(u64 size) override;
+		GPUBuffer* create_storage_buffer(u64 size) override;
+
+		void destroy_buffer(GPUBuffer* buffer) override;
 
 	private:
 		VulkanBackend* m_backend;
@@ -0,0 +1,245 @@
+#include <backend/graphics/vulkan/vk_command_recorder.h>
+#include <backend/graphics/vulkan/vk_backend.h>
+
+#include <wvn/devenv/log_mgr.h>
+#include <wvn/maths/calc.h>
+
+#include <chrono>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+VulkanCommandRecorder::VulkanCommandRecorder()
+	: m_backend(nullptr)
+	, m_frame_idx(0)
+	, m_frame_record_time_ms(0.0)
+	, m_pools{}
+	, m_secondaries()
+	, m_secondaries_used{}
+	, m_worker_pool(nullptr)
+	, m_thread_count(MAX_THREADS)
+	, m_chunks{}
+	, m_job_draws(nullptr)
+	, m_job_push_constants(nullptr)
+	, m_job_inheritance()
+{
+}
+
+void VulkanCommandRecorder::init(VulkanBackend* backend, u32 graphics_family, sys::WorkerPool* worker_pool)
+{
+	this->m_backend = backend;
+	this->m_worker_pool = worker_pool;
+
+	VkCommandPoolCreateInfo create_info = {};
+	create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	create_info.queueFamilyIndex = graphics_family;
+
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++) {
+		for (int j = 0; j < MAX_THREADS; j++) {
+			if (VkResult result = vkCreateCommandPool(m_backend->device, &create_info, nullptr, &m_pools[i][j]); result != VK_SUCCESS) {
+				wvn_ERROR("[VULKAN:RECORDER|DEBUG] Failed to create recording command pool: %d", result);
+			}
+		}
+	}
+
+	dev::LogMgr::get_singleton()->print("[VULKAN:RECORDER] Recording with up to %u threads.", CalcU::min(m_thread_count, m_worker_pool->thread_count()));
+}
+
+void VulkanCommandRecorder::clean_up()
+{
+	if (!m_backend) {
+		return;
+	}
+
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++)
+	{
+		for (int j = 0; j < MAX_THREADS; j++)
+		{
+			vkDestroyCommandPool(m_backend->device, m_pools[i][j], nullptr);
+			m_pools[i][j] = VK_NULL_HANDLE;
+			m_secondaries[i][j].clear();
+		}
+	}
+
+	m_backend = nullptr;
+}
+
+// the fence for this frame has already been waited on, so every pool belonging to it can be recycled
+void VulkanCommandRecorder::begin_frame(u64 frame_idx)
+{
+	m_frame_idx = frame_idx;
+	m_frame_record_time_ms = 0.0;
+
+	for (int i = 0; i < MAX_THREADS; i++)
+	{
+		if (m_secondaries_used[i] > 0 || m_secondaries[frame_idx][i].any()) {
+			vkResetCommandPool(m_backend->device, m_pools[frame_idx][i], 0);
+		}
+
+		m_secondaries_used[i] = 0;
+	}
+}
+
+void VulkanCommandRecorder::record_pass(VkCommandBuffer primary, const VkRenderPassBeginInfo& begin_info, const Vector<VulkanDrawCommand>& draws, const Vector<byte>& push_constants)
+{
+	auto record_start = std::chrono::steady_clock::now();
+
+	// one chunk per thread, as a chunk is recorded into the pools of the thread with its index
+	DrawChunk ranges[MAX_THREADS];
+	u32 chunk_count = split_draws(ranges, draws.size(), CalcU::min(m_thread_count, m_worker_pool->thread_count()), MIN_DRAWS_PER_CHUNK);
+
+	// not enough work to be worth splitting up, just record straight into the primary buffer
+	if (chunk_count <= 1)
+	{
+		vkCmdBeginRenderPass(primary, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+		record_draws(primary, draws.data(), draws.size(), push_constants.data());
+		vkCmdEndRenderPass(primary);
+
+		m_frame_record_time_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - record_start).count();
+
+		return;
+	}
+
+	for (u32 i = 0; i < chunk_count; i++)
+	{
+		m_chunks[i].begin = ranges[i].begin;
+		m_chunks[i].end = ranges[i].end;
+		m_chunks[i].cmd = VK_NULL_HANDLE;
+	}
+
+	m_job_inheritance = {};
+	m_job_inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	m_job_inheritance.renderPass = begin_info.renderPass;
+	m_job_inheritance.subpass = 0;
+	m_job_inheritance.framebuffer = begin_info.framebuffer;
+
+	m_job_draws = draws.data();
+	m_job_push_constants = push_constants.data();
+
+	// each chunk is recorded by the thread with the same index, this thread records chunk 0 itself
+	m_worker_pool->run(chunk_count, [this](u32 thread_idx) { record_chunk(thread_idx, m_chunks[thread_idx]); });
+
+	VkCommandBuffer secondaries[MAX_THREADS] = {};
+
+	for (u32 i = 0; i < chunk_count; i++) {
+		secondaries[i] = m_chunks[i].cmd;
+	}
+
+	vkCmdBeginRenderPass(primary, &begin_info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	vkCmdExecuteCommands(primary, chunk_count, secondaries);
+	vkCmdEndRenderPass(primary);
+
+	m_frame_record_time_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - record_start).count();
+}
+
+void VulkanCommandRecorder::set_thread_count(u32 thread_count)
+{
+	m_thread_count = CalcU::clamp(thread_count, 1, MAX_THREADS);
+}
+
+u32 VulkanCommandRecorder::thread_count() const
+{
+	return m_thread_count;
+}
+
+double VulkanCommandRecorder::frame_record_time_ms() const
+{
+	return m_frame_record_time_ms;
+}
+
+void VulkanCommandRecorder::record_chunk(u32 thread_idx, Chunk& chunk)
+{
+	chunk.cmd = allocate_secondary(thread_idx);
+
+	VkCommandBufferBeginInfo begin_info = {};
+	begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+	begin_info.pInheritanceInfo = &m_job_inheritance;
+
+	if (VkResult result = vkBeginCommandBuffer(chunk.cmd, &begin_info); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:RECORDER|DEBUG] Failed to begin secondary command buffer: %d", result);
+	}
+
+	record_draws(chunk.cmd, m_job_draws + chunk.begin, chunk.end - chunk.begin, m_job_push_constants);
+
+	if (VkResult result = vkEndCommandBuffer(chunk.cmd); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:RECORDER|DEBUG] Failed to record secondary command buffer: %d", result);
+	}
+}
+
+// only ever called from the thread that owns thread_idx
+VkCommandBuffer VulkanCommandRecorder::allocate_secondary(u32 thread_idx)
+{
+	Vector<VkCommandBuffer>& secondaries = m_secondaries[m_frame_idx][thread_idx];
+	u32& used = m_secondaries_used[thread_idx];
+
+	if (used >= secondaries.size())
+	{
+		VkCommandBufferAllocateInfo alloc_info = {};
+		alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		alloc_info.commandPool = m_pools[m_frame_idx][thread_idx];
+		alloc_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		alloc_info.commandBufferCount = 1;
+
+		VkCommandBuffer cmd_buf = VK_NULL_HANDLE;
+
+		if (VkResult result = vkAllocateCommandBuffers(m_backend->device, &alloc_info, &cmd_buf); result != VK_SUCCESS) {
+			wvn_ERROR("[VULKAN:RECORDER|DEBUG] Failed to allocate secondary command buffer: %d", result);
+		}
+
+		secondaries.push_back(cmd_buf);
+	}
+
+	return secondaries[used++];
+}
+
+void VulkanCommandRecorder::record_draws(VkCommandBuffer cmd, const VulkanDrawCommand* draws, u64 count, const byte* push_constants)
+{
+	VkPipeline bound_pipeline = VK_NULL_HANDLE;
+
+	for (u64 i = 0; i < count; i++)
+	{
+		const VulkanDrawCommand& draw = draws[i];
+
+		vkCmdSetViewport(cmd, 0, 1, &draw.viewport);
+		vkCmdSetScissor(cmd, 0, 1, &draw.scissor);
+
+		VkDeviceSize offsets[] = { 0 };
+
+		vkCmdBindVertexBuffers(cmd, 0, 1, &draw.vertex_buffer, offsets);
+		vkCmdBindIndexBuffer(cmd, draw.index_buffer, 0, VK_INDEX_TYPE_UINT16);
+
+		if (draw.push_constants_size > 0)
+		{
+			vkCmdPushConstants(
+				cmd,
+				draw.pipeline_layout,
+				VK_SHADER_STAGE_ALL_GRAPHICS,
+				0,
+				draw.push_constants_size,
+				push_constants + draw.push_constants_offset
+			);
+		}
+
+		VkDescriptorSet sets[] = { draw.descriptor_set, draw.bindless_set };
+
+		vkCmdBindDescriptorSets(
+			cmd,
+			VK_PIPELINE_BIND_POINT_GRAPHICS,
+			draw.pipeline_layout,
+			0,
+			draw.bindless_set != VK_NULL_HANDLE ? 2 : 1, sets,
+			draw.dynamic_offsets.size(),
+			draw.dynamic_offsets.data()
+		);
+
+		if (draw.pipeline != bound_pipeline)
+		{
+			vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.pipeline);
+			bound_pipeline = draw.pipeline;
+		}
+
+		vkCmdDrawIndexed(cmd, draw.index_count, 1, 0, 0, 0);
+	}
+}
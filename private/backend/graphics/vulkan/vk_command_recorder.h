@@ -0,0 +1,98 @@
+#ifndef VK_COMMAND_RECORDER_H_
+#define VK_COMMAND_RECORDER_H_
+
+#include <vulkan/vulkan.h>
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/container/array.h>
+#include <wvn/system/worker_pool.h>
+
+#include <wvn/graphics/shader.h>
+#include <wvn/graphics/draw_chunks.h>
+
+#include <backend/graphics/vulkan/vk_util.h>
+
+namespace wvn::gfx
+{
+	class VulkanBackend;
+
+	/**
+	 * Fully resolved draw, everything that needs the backend's (non thread-safe)
+	 * caches has already been looked up so it can be recorded from any thread.
+	 */
+	struct VulkanDrawCommand
+	{
+		VkPipeline pipeline;
+		VkPipelineLayout pipeline_layout;
+		VkDescriptorSet descriptor_set;
+		VkDescriptorSet bindless_set; // bound to set 1 when the bindless table is in use
+		Array<u32, SHADER_TYPE_GRAPHICS_COUNT> dynamic_offsets;
+		VkBuffer vertex_buffer;
+		VkBuffer index_buffer;
+		u32 index_count;
+		u32 push_constants_offset;
+		u32 push_constants_size;
+		VkViewport viewport;
+		VkRect2D scissor;
+	};
+
+	/**
+	 * Records the draws of a render pass. Large passes are split into chunks that are recorded
+	 * in parallel into secondary command buffers and then executed from the primary buffer.
+	 * Every recording thread owns one command pool per frame in flight, so pools are never shared between threads.
+	 */
+	class VulkanCommandRecorder
+	{
+		struct Chunk
+		{
+			u64 begin;
+			u64 end;
+			VkCommandBuffer cmd;
+		};
+
+	public:
+		static constexpr u32 MAX_THREADS = sys::WorkerPool::MAX_THREADS;
+		static constexpr u32 MIN_DRAWS_PER_CHUNK = 64; // a chunk has to outweigh waking a thread and an extra secondary buffer, see record_bench
+
+		VulkanCommandRecorder();
+
+		void init(VulkanBackend* backend, u32 graphics_family, sys::WorkerPool* worker_pool);
+		void clean_up();
+
+		void begin_frame(u64 frame_idx);
+
+		void record_pass(VkCommandBuffer primary, const VkRenderPassBeginInfo& begin_info, const Vector<VulkanDrawCommand>& draws, const Vector<byte>& push_constants);
+
+		// at most this many of the worker pool's threads record, including the one calling record_pass()
+		void set_thread_count(u32 thread_count);
+		u32 thread_count() const;
+
+		double frame_record_time_ms() const;
+
+	private:
+		void record_chunk(u32 thread_idx, Chunk& chunk);
+		VkCommandBuffer allocate_secondary(u32 thread_idx);
+
+		static void record_draws(VkCommandBuffer cmd, const VulkanDrawCommand* draws, u64 count, const byte* push_constants);
+
+		VulkanBackend* m_backend;
+
+		u64 m_frame_idx;
+		double m_frame_record_time_ms;
+
+		VkCommandPool m_pools[vkutil::FRAMES_IN_FLIGHT][MAX_THREADS];
+		Vector<VkCommandBuffer> m_secondaries[vkutil::FRAMES_IN_FLIGHT][MAX_THREADS];
+		u32 m_secondaries_used[MAX_THREADS];
+
+		sys::WorkerPool* m_worker_pool;
+		u32 m_thread_count;
+
+		Chunk m_chunks[MAX_THREADS];
+		const VulkanDrawCommand* m_job_draws;
+		const byte* m_job_push_constants;
+		VkCommandBufferInheritanceInfo m_job_inheritance;
+	};
+}
+
+#endif // VK_COMMAND_RECORDER_H_
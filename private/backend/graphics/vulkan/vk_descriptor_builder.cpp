@@ -15,16 +15,41 @@ void VulkanDescriptorBuilder::reset(VulkanDescriptorPoolMgr* mgr, VulkanDescript
 	m_writes.clear();
 }
 
+// hashes what the set actually points at field by field, the raw structs contain
+// padding and pointers that change from frame to frame even when the bindings don't
 u64 VulkanDescriptorBuilder::hash() const
+{
+	u64 result = layout_hash();
+
+	for (auto& write : m_writes)
+	{
+		if (write.pBufferInfo)
+		{
+			hash::combine(&result, &write.pBufferInfo->buffer);
+			hash::combine(&result, &write.pBufferInfo->offset);
+			hash::combine(&result, &write.pBufferInfo->range);
+		}
+
+		if (write.pImageInfo)
+		{
+			hash::combine(&result, &write.pImageInfo->sampler);
+			hash::combine(&result, &write.pImageInfo->imageView);
+			hash::combine(&result, &write.pImageInfo->imageLayout);
+		}
+	}
+
+	return result;
+}
+
+u64 VulkanDescriptorBuilder::layout_hash() const
 {
 	u64 result = 0;
 
 	for (auto& binding : m_bindings) {
-		hash::combine(&result, &binding);
-	}
-
-	for (auto& binding : m_writes) {
-		hash::combine(&result, &binding);
+		hash::combine(&result, &binding.binding);
+		hash::combine(&result, &binding.descriptorType);
+		hash::combine(&result, &binding.descriptorCount);
+		hash::combine(&result, &binding.stageFlags);
 	}
 
 	return result;
@@ -35,19 +60,26 @@ void VulkanDescriptorBuilder::build(VkDescriptorSet& set, VkDescriptorSetLayout&
 	build_layout(layout);
 
 	bool needs_updating = false;
-	set = m_cache->create_set(m_mgr, layout, hash, &needs_updating);
+	set = m_cache->create_set(layout, hash, &needs_updating);
 
 	for (auto& write : m_writes) {
 		write.dstSet = set;
 	}
 
-	if (needs_updating) {
+	if (needs_updating)
+	{
 		vkUpdateDescriptorSets(
 			m_mgr->backend()->device,
 			m_writes.size(),
 			m_writes.data(),
 			0, nullptr
 		);
+
+		for (auto& write : m_writes) {
+			if (write.pBufferInfo) {
+				m_cache->track_buffer(hash, write.pBufferInfo->buffer);
+			}
+		}
 	}
 }
 
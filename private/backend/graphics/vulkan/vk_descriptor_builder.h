@@ -17,6 +17,7 @@ namespace wvn::gfx
 		void reset(VulkanDescriptorPoolMgr* mgr, VulkanDescriptorCache* cache);
 
 		u64 hash() const;
+		u64 layout_hash() const;
 
 		void build(VkDescriptorSet& set, VkDescriptorSetLayout& layout, u64 hash);
 		void build_layout(VkDescriptorSetLayout& layout);
@@ -10,7 +10,16 @@ using namespace wvn::gfx;
 
 VulkanDescriptorCache::VulkanDescriptorCache(VulkanBackend* backend)
 	: m_backend(backend)
+	, m_descriptor_cache()
+	, m_cached_sets()
 	, m_layout_cache()
+	, m_buffer_slots()
+	, m_retired_sets()
+	, m_persistent_pool_mgr(nullptr)
+	, m_frame_pool_mgrs{}
+	, m_frame_number(0)
+	, m_frame_slot(0)
+	, m_stats()
 {
 }
 
@@ -18,10 +27,32 @@ VulkanDescriptorCache::~VulkanDescriptorCache()
 {
 }
 
+void VulkanDescriptorCache::init(VulkanDescriptorPoolMgr* persistent_pool_mgr)
+{
+	m_persistent_pool_mgr = persistent_pool_mgr;
+
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++) {
+		m_frame_pool_mgrs[i] = new VulkanDescriptorPoolMgr(m_backend);
+		m_frame_pool_mgrs[i]->init();
+	}
+}
+
 void VulkanDescriptorCache::clean_up()
 {
 	clear_set_cache();
 
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++)
+	{
+		if (!m_frame_pool_mgrs[i]) {
+			continue;
+		}
+
+		m_frame_pool_mgrs[i]->clean_up();
+
+		delete m_frame_pool_mgrs[i];
+		m_frame_pool_mgrs[i] = nullptr;
+	}
+
 	for (auto& [id, layout] : m_layout_cache) {
 		vkDestroyDescriptorSetLayout(m_backend->device, layout, nullptr);
 	}
@@ -29,28 +60,159 @@ void VulkanDescriptorCache::clean_up()
 	m_layout_cache.clear();
 }
 
+// only forgets the sets, their memory is given back when the pools are reset / destroyed
 void VulkanDescriptorCache::clear_set_cache()
 {
-	m_descriptor_cache.clear();
+	for (auto& cached : m_cached_sets) {
+		cached.set = VK_NULL_HANDLE;
+	}
+
+	for (int i = 0; i < vkutil::FRAMES_IN_FLIGHT; i++) {
+		m_retired_sets[i].clear();
+	}
+
+	m_buffer_slots.clear();
+
+	m_stats.cached_sets = 0;
 }
 
-VkDescriptorSet VulkanDescriptorCache::create_set(VulkanDescriptorPoolMgr* mgr, const VkDescriptorSetLayout& layout, u64 hash, bool* was_already_cached)
+// the fence for this frame slot has been waited on, so everything allocated from its pool can go
+void VulkanDescriptorCache::begin_frame(u64 frame_slot)
 {
+	m_frame_number++;
+	m_frame_slot = frame_slot;
+
+	m_stats = {};
+
+	release_frame_sets(m_frame_slot);
+	free_retired_sets(m_frame_slot);
+	m_frame_pool_mgrs[m_frame_slot]->reset_pools();
+
+	if (m_frame_number % EVICTION_INTERVAL == 0) {
+		evict_stale_sets();
+	}
+
+	for (auto& cached : m_cached_sets) {
+		if (cached.set) {
+			m_stats.cached_sets++;
+		}
+	}
+}
+
+VkDescriptorSet VulkanDescriptorCache::create_set(const VkDescriptorSetLayout& layout, u64 hash, bool* needs_updating)
+{
+	u32 slot = INVALID_IDX;
+
 	if (m_descriptor_cache.contains(hash)) {
-		if (was_already_cached) {
-			(*was_already_cached) = false;
+		slot = m_descriptor_cache[hash];
+	}
+
+	if (slot != INVALID_IDX && m_cached_sets[slot].set)
+	{
+		CachedSet& cached = m_cached_sets[slot];
+
+		bool promote = cached.frame_slot != PERSISTENT_SLOT && cached.last_used_frame != m_frame_number;
+
+		cached.last_used_frame = m_frame_number;
+
+		if (!promote)
+		{
+			if (needs_updating) {
+				(*needs_updating) = false;
+			}
+
+			m_stats.cache_hits++;
+
+			return cached.set;
 		}
-		return m_descriptor_cache[hash];
-	} else {
-		if (was_already_cached) {
-			(*was_already_cached) = true;
+
+		// used again in a later frame, so it is worth keeping around for good
+		cached.set = m_persistent_pool_mgr->allocate_descriptor_set(layout, &cached.pool);
+		cached.frame_slot = PERSISTENT_SLOT;
+
+		if (needs_updating) {
+			(*needs_updating) = true;
+		}
+
+		m_stats.allocations++;
+		m_stats.promotions++;
+
+		return cached.set;
+	}
+
+	if (slot == INVALID_IDX)
+	{
+		slot = m_cached_sets.size();
+		m_cached_sets.push_back({});
+
+		m_descriptor_cache.insert(Pair(hash, slot));
+	}
+
+	CachedSet& cached = m_cached_sets[slot];
+	cached.set = m_frame_pool_mgrs[m_frame_slot]->allocate_descriptor_set(layout, &cached.pool);
+	cached.last_used_frame = m_frame_number;
+	cached.frame_slot = m_frame_slot;
+
+	if (needs_updating) {
+		(*needs_updating) = true;
+	}
+
+	m_stats.allocations++;
+	m_stats.cached_sets++;
+
+	return cached.set;
+}
+
+void VulkanDescriptorCache::track_buffer(u64 hash, VkBuffer buffer)
+{
+	u64 key = (u64)buffer;
+	u32 slot = m_descriptor_cache[hash];
+
+	if (!m_buffer_slots.contains(key)) {
+		m_buffer_slots.insert(Pair(key, Vector<u32>()));
+	}
+
+	Vector<u32>& slots = m_buffer_slots[key];
+
+	// a slot is tracked again each time its set is reallocated
+	for (u32 tracked : slots) {
+		if (tracked == slot) {
+			return;
 		}
 	}
 
-	VkDescriptorSet set = mgr->allocate_descriptor_set(layout);
-	m_descriptor_cache.insert(Pair(hash, set));
+	slots.push_back(slot);
+}
+
+// the hash of a set includes its buffer handles, so a new buffer given the same handle would otherwise pick up the old set.
+// the slot keeps its hash, the next set asked for with it is just allocated and written from scratch.
+// persistent sets might still be bound by a frame in flight, so they're only freed once this frame slot comes round again
+void VulkanDescriptorCache::retire_buffer(VkBuffer buffer)
+{
+	u64 key = (u64)buffer;
+
+	if (!m_buffer_slots.contains(key)) {
+		return;
+	}
+
+	for (u32 slot : m_buffer_slots[key])
+	{
+		CachedSet& cached = m_cached_sets[slot];
+
+		if (!cached.set) {
+			continue;
+		}
+
+		if (cached.frame_slot == PERSISTENT_SLOT) {
+			m_retired_sets[m_frame_slot].push_back(cached);
+		}
+
+		cached.set = VK_NULL_HANDLE;
 
-	return set;
+		m_stats.evictions++;
+	}
+
+	m_buffer_slots.erase(key);
 }
 
 VkDescriptorSetLayout VulkanDescriptorCache::create_layout(const VkDescriptorSetLayoutCreateInfo& layout_create_info)
@@ -80,3 +242,42 @@ VkDescriptorSetLayout VulkanDescriptorCache::create_layout(const VkDescriptorSet
 
 	return created_descriptor;
 }
+
+const VulkanDescriptorStats& VulkanDescriptorCache::stats() const
+{
+	return m_stats;
+}
+
+void VulkanDescriptorCache::release_frame_sets(u32 frame_slot)
+{
+	for (auto& cached : m_cached_sets) {
+		if (cached.set && cached.frame_slot == frame_slot) {
+			cached.set = VK_NULL_HANDLE;
+		}
+	}
+}
+
+void VulkanDescriptorCache::free_retired_sets(u32 frame_slot)
+{
+	for (auto& retired : m_retired_sets[frame_slot]) {
+		m_persistent_pool_mgr->free_descriptor_set(retired.set, retired.pool);
+	}
+
+	m_retired_sets[frame_slot].clear();
+}
+
+// sets that haven't been touched in a long while are most likely pointing at resources that no longer exist
+// (e.g. a uniform buffer that was reallocated), and have long since left every frame in flight
+void VulkanDescriptorCache::evict_stale_sets()
+{
+	for (auto& cached : m_cached_sets)
+	{
+		if (cached.set && cached.frame_slot == PERSISTENT_SLOT && m_frame_number - cached.last_used_frame > EVICT_AFTER_FRAMES)
+		{
+			m_persistent_pool_mgr->free_descriptor_set(cached.set, cached.pool);
+			cached.set = VK_NULL_HANDLE;
+
+			m_stats.evictions++;
+		}
+	}
+}
@@ -4,29 +4,92 @@
 #include <vulkan/vulkan.h>
 
 #include <wvn/container/hash_map.h>
+#include <wvn/container/vector.h>
+
+#include <backend/graphics/vulkan/vk_util.h>
 
 namespace wvn::gfx
 {
 	class VulkanBackend;
 	class VulkanDescriptorPoolMgr;
 
+	/**
+	 * Descriptor allocation counters for the frame currently being recorded.
+	 */
+	struct VulkanDescriptorStats
+	{
+		u32 allocations;
+		u32 cache_hits;
+		u32 promotions;
+		u32 evictions;
+		u32 cached_sets;
+	};
+
+	/**
+	 * Caches descriptor sets by the hash of their contents so unchanged sets persist across frames.
+	 * Sets are first allocated from a per-frame pool that is reset in bulk once the gpu is done with that frame.
+	 * Only sets that are asked for again in a later frame are promoted to the long-lived pool, one-off sets just die with their frame.
+	 */
 	class VulkanDescriptorCache
 	{
+		static constexpr u32 INVALID_IDX = ~0u;
+		static constexpr u32 PERSISTENT_SLOT = ~0u - 1;
+		static constexpr u64 EVICT_AFTER_FRAMES = 256;
+		static constexpr u64 EVICTION_INTERVAL = 64;
+
+		struct CachedSet
+		{
+			VkDescriptorSet set; // null once released / evicted, the slot is reused if the same hash shows up again
+			VkDescriptorPool pool;
+			u64 last_used_frame;
+			u32 frame_slot;
+		};
+
 	public:
 		VulkanDescriptorCache(VulkanBackend* backend);
 		~VulkanDescriptorCache();
 
+		void init(VulkanDescriptorPoolMgr* persistent_pool_mgr);
 		void clean_up();
 		void clear_set_cache();
 
-		VkDescriptorSet create_set(VulkanDescriptorPoolMgr* mgr, const VkDescriptorSetLayout& layout, u64 hash, bool* was_already_cached);
+		void begin_frame(u64 frame_slot);
+
+		VkDescriptorSet create_set(const VkDescriptorSetLayout& layout, u64 hash, bool* needs_updating);
+
+		// remembers that the set with this hash points at the buffer, so retire_buffer() can find it
+		void track_buffer(u64 hash, VkBuffer buffer);
+
+		// forgets every set pointing at a buffer that is about to be destroyed, before its handle can be reused
+		void retire_buffer(VkBuffer buffer);
 		VkDescriptorSetLayout create_layout(const VkDescriptorSetLayoutCreateInfo& layout_create_info);
 
+		const VulkanDescriptorStats& stats() const;
+
 	private:
+		void release_frame_sets(u32 frame_slot);
+		void free_retired_sets(u32 frame_slot);
+		void evict_stale_sets();
+
 		VulkanBackend* m_backend;
 
-		HashMap<u64, VkDescriptorSet > m_descriptor_cache;
+		// slots are never erased from the map, only recycled
+		HashMap<u64, u32> m_descriptor_cache;
+		Vector<CachedSet> m_cached_sets;
 		HashMap<u64, VkDescriptorSetLayout> m_layout_cache;
+
+		// keyed by buffer handle, the slots of the sets pointing at it
+		HashMap<u64, Vector<u32>> m_buffer_slots;
+
+		// persistent sets whose buffer was retired, freed once the frame that retired them is done with
+		Vector<CachedSet> m_retired_sets[vkutil::FRAMES_IN_FLIGHT];
+
+		VulkanDescriptorPoolMgr* m_persistent_pool_mgr;
+		VulkanDescriptorPoolMgr* m_frame_pool_mgrs[vkutil::FRAMES_IN_FLIGHT];
+
+		u64 m_frame_number;
+		u32 m_frame_slot;
+		VulkanDescriptorStats m_stats;
 	};
 }
 
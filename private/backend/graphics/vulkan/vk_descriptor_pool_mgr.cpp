@@ -10,6 +10,9 @@ VulkanDescriptorPoolMgr::VulkanDescriptorPoolMgr(VulkanBackend* backend)
 	, m_free_pools()
 	, m_used_pools()
 	, m_current_pool(VK_NULL_HANDLE)
+	, m_pool_flags(0)
+	, m_sizes()
+	, m_allocation_count(0)
 {
 }
 
@@ -17,8 +20,10 @@ VulkanDescriptorPoolMgr::~VulkanDescriptorPoolMgr()
 {
 }
 
-void VulkanDescriptorPoolMgr::init()
+void VulkanDescriptorPoolMgr::init(VkDescriptorPoolCreateFlags pool_flags)
 {
+	m_pool_flags = pool_flags;
+
 	init_sizes();
 }
 
@@ -63,9 +68,10 @@ void VulkanDescriptorPoolMgr::reset_pools()
 
 	m_used_pools.clear();
 	m_current_pool = VK_NULL_HANDLE;
+	m_allocation_count = 0;
 }
 
-VkDescriptorSet VulkanDescriptorPoolMgr::allocate_descriptor_set(const VkDescriptorSetLayout& layout)
+VkDescriptorSet VulkanDescriptorPoolMgr::allocate_descriptor_set(const VkDescriptorSetLayout& layout, VkDescriptorPool* out_pool)
 {
 	if (m_current_pool == VK_NULL_HANDLE) {
 		m_current_pool = grab_pool();
@@ -83,8 +89,13 @@ VkDescriptorSet VulkanDescriptorPoolMgr::allocate_descriptor_set(const VkDescrip
 	VkResult result = vkAllocateDescriptorSets(m_backend->device, &alloc_info, &ret);
 	bool reallocate_memory = false;
 
+	m_allocation_count++;
+
+	if (out_pool) {
+		(*out_pool) = m_current_pool;
+	}
+
 	if (result == VK_SUCCESS) {
-		dev::LogMgr::get_singleton()->print("[VULKAN:DESCRIPTORPOOL] Created descriptor sets successfully!");
 		return ret;
 	} else if (result == VK_ERROR_FRAGMENTED_POOL || result == VK_ERROR_OUT_OF_POOL_MEMORY) {
 		dev::LogMgr::get_singleton()->print("[VULKAN:DESCRIPTORPOOL] Failed to allocate descriptor sets initially, reallocating memory...");
@@ -98,6 +109,12 @@ VkDescriptorSet VulkanDescriptorPoolMgr::allocate_descriptor_set(const VkDescrip
 		m_current_pool = grab_pool();
 		m_used_pools.push_back(m_current_pool);
 
+		alloc_info.descriptorPool = m_current_pool;
+
+		if (out_pool) {
+			(*out_pool) = m_current_pool;
+		}
+
 		result = vkAllocateDescriptorSets(m_backend->device, &alloc_info, &ret);
 
 		if (result != VK_SUCCESS) {
@@ -112,6 +129,13 @@ VkDescriptorSet VulkanDescriptorPoolMgr::allocate_descriptor_set(const VkDescrip
 	return ret;
 }
 
+void VulkanDescriptorPoolMgr::free_descriptor_set(VkDescriptorSet set, VkDescriptorPool pool)
+{
+	wvn_ASSERT(m_pool_flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, "[VULKAN:DESCRIPTORPOOL|DEBUG] Pools were not created with individually freeable sets.");
+
+	vkFreeDescriptorSets(m_backend->device, pool, 1, &set);
+}
+
 VkDescriptorPool VulkanDescriptorPoolMgr::create_new_pool(u32 count)
 {
 	Vector<VkDescriptorPoolSize> pool_sizes;
@@ -135,7 +159,7 @@ VkDescriptorPool VulkanDescriptorPoolMgr::create_new_pool(u32 count)
 
 	VkDescriptorPoolCreateInfo pool_create_info = {};
 	pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-	pool_create_info.flags = 0;
+	pool_create_info.flags = m_pool_flags;
 	pool_create_info.poolSizeCount = pool_sizes.size();
 	pool_create_info.pPoolSizes = pool_sizes.data();
 	pool_create_info.maxSets = count;
@@ -171,3 +195,13 @@ const VulkanBackend* VulkanDescriptorPoolMgr::backend() const
 {
 	return m_backend;
 }
+
+u32 VulkanDescriptorPoolMgr::allocation_count() const
+{
+	return m_allocation_count;
+}
+
+u32 VulkanDescriptorPoolMgr::pool_count() const
+{
+	return m_used_pools.size() + m_free_pools.size();
+}
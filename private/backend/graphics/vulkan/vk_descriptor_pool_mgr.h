@@ -5,25 +5,36 @@
 
 #include <wvn/container/vector.h>
 #include <wvn/container/pair.h>
+#include <wvn/common.h>
 
 namespace wvn::gfx
 {
 	class VulkanBackend;
 
+	/**
+	 * Hands out descriptor sets from a growing list of pools.
+	 * Pools are either reset all at once (per-frame usage) or, if created with
+	 * VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, have their sets freed individually.
+	 */
 	class VulkanDescriptorPoolMgr
 	{
 	public:
 		VulkanDescriptorPoolMgr(VulkanBackend* backend);
 		~VulkanDescriptorPoolMgr();
 
-		void init();
+		void init(VkDescriptorPoolCreateFlags pool_flags = 0);
 
 		void clean_up();
 		void reset_pools();
 
-		VkDescriptorSet allocate_descriptor_set(const VkDescriptorSetLayout& layout);
+		VkDescriptorSet allocate_descriptor_set(const VkDescriptorSetLayout& layout, VkDescriptorPool* out_pool = nullptr);
+		void free_descriptor_set(VkDescriptorSet set, VkDescriptorPool pool);
+
 		VkDescriptorPool grab_pool();
 
+		u32 allocation_count() const;
+		u32 pool_count() const;
+
 		VulkanBackend* backend();
 		const VulkanBackend* backend() const;
 
@@ -37,8 +48,11 @@ namespace wvn::gfx
 		Vector<VkDescriptorPool> m_free_pools;
 
 		VkDescriptorPool m_current_pool;
+		VkDescriptorPoolCreateFlags m_pool_flags;
 
 		Vector<Pair<VkDescriptorType, float>> m_sizes;
+
+		u32 m_allocation_count; // since the last reset
 	};
 }
 
@@ -1,7 +1,7 @@
 #include <backend/graphics/vulkan/vk_shader_mgr.h>
 #include <backend/graphics/vulkan/vk_backend.h>
 #include <wvn/io/file_stream.h>
-#include <wvn/container/vector.h>
+#include <wvn/container/small_vector.h>
 #include <wvn/devenv/log_mgr.h>
 
 using namespace wvn;
@@ -19,7 +19,7 @@ VulkanShaderMgr::~VulkanShaderMgr()
 ShaderProgram* VulkanShaderMgr::create(const String& source, ShaderProgramType type)
 {
 	io::FileStream fs(source.c_str(), "r");
-	Vector<char> source_data(fs.size());
+	SmallVector<char, 4096> source_data(fs.size());
 	fs.read(source_data.data(), fs.size());
 	fs.close();
 
@@ -19,6 +19,7 @@ VulkanTexture::VulkanTexture(VulkanBackend* backend)
 	, m_image_memory(VK_NULL_HANDLE)
 	, m_image_layout()
 	, m_view(VK_NULL_HANDLE)
+	, m_bindless_idx(VulkanBindlessTable::INVALID_INDEX)
 	, m_format()
 	, m_tiling()
 	, m_type()
@@ -37,6 +38,12 @@ VulkanTexture::~VulkanTexture()
 
 void VulkanTexture::clean_up()
 {
+	if (m_bindless_idx != VulkanBindlessTable::INVALID_INDEX)
+	{
+		m_backend->bindless_table()->unregister_texture(m_bindless_idx);
+		m_bindless_idx = VulkanBindlessTable::INVALID_INDEX;
+	}
+
 	if (m_image != VK_NULL_HANDLE)
 	{
 		vkDestroyImage(m_backend->device, m_image, nullptr);
@@ -129,9 +136,10 @@ void VulkanTexture::create_internal_resources()
 		create_info.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
 	}
 
+	// block compressed formats can only ever be sampled from, never rendered to
 	if (vkutil::has_stencil_component(vkfmt)) {
 		create_info.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-	} else {
+	} else if (!vkutil::is_block_compressed(vkfmt)) {
 		create_info.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 	}
 
@@ -156,6 +164,32 @@ void VulkanTexture::create_internal_resources()
 	m_view = generate_view();
 }
 
+// swaps the image for a new one of a different size, the old one stays alive until the frames that might still be sampling it are done
+void VulkanTexture::reallocate(u32 width, u32 height, u32 mip_levels)
+{
+	VulkanTexture* retired = new VulkanTexture(m_backend);
+	retired->m_image = m_image;
+	retired->m_image_memory = m_image_memory;
+	retired->m_view = m_view;
+
+	m_backend->defer_deletion(retired);
+
+	m_image = VK_NULL_HANDLE;
+	m_image_memory = VK_NULL_HANDLE;
+	m_view = VK_NULL_HANDLE;
+	m_image_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	init_size(width, height);
+	init_mip_levels(mip_levels);
+
+	create_internal_resources();
+
+	// keep the same bindless slot so materials referencing it don't have to be rewritten
+	if (m_bindless_idx != VulkanBindlessTable::INVALID_INDEX) {
+		m_backend->bindless_table()->replace_texture(m_bindless_idx, m_view);
+	}
+}
+
 VkImageView VulkanTexture::generate_view() const
 {
 	VkFormat vkfmt = vkutil::get_vk_texture_format(m_format);
@@ -198,6 +232,14 @@ VkImageView VulkanTexture::generate_view() const
 
 // also transitions the texture into SHADER_READ_ONLY layout
 void VulkanTexture::generate_mipmaps() const
+{
+	VkCommandBuffer cmd_buf = vkutil::begin_single_time_commands(m_backend->current_frame().command_pool, m_backend->device);
+	generate_mipmaps(cmd_buf);
+	vkutil::end_single_time_graphics_commands(m_backend, cmd_buf);
+}
+
+// records the mipmap generation into an existing command buffer, which must belong to a graphics queue
+void VulkanTexture::generate_mipmaps(VkCommandBuffer cmd_buf) const
 {
 	wvn_ASSERT(m_image_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, "[VULKAN:TEXTURE|DEBUG] Texture must be in TRANSFER_DST_OPTIMAL layout to generate mipmaps.");
 
@@ -211,7 +253,6 @@ void VulkanTexture::generate_mipmaps() const
 		return;
 	}
 
-	VkCommandBuffer cmd_buf = vkutil::begin_single_time_commands(m_backend->current_frame().command_pool, m_backend->device);
 	{
 		VkImageMemoryBarrier barrier = {};
 		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -303,12 +344,17 @@ void VulkanTexture::generate_mipmaps() const
 			1, &barrier
 		);
 	}
-	vkutil::end_single_time_graphics_commands(m_backend, cmd_buf);
 }
 
 void VulkanTexture::transition_layout(VkImageLayout new_layout)
 {
 	VkCommandBuffer cmd_buf = vkutil::begin_single_time_commands(m_backend->current_frame().command_pool, m_backend->device);
+	transition_layout(cmd_buf, new_layout);
+	vkutil::end_single_time_commands(m_backend->current_frame().command_pool, cmd_buf, m_backend->device, m_backend->queues.graphics);
+}
+
+void VulkanTexture::transition_layout(VkCommandBuffer cmd_buf, VkImageLayout new_layout)
+{
 	{
 		VkImageMemoryBarrier barrier = {};
 		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -382,7 +428,6 @@ void VulkanTexture::transition_layout(VkImageLayout new_layout)
 
 		m_image_layout = new_layout;
 	}
-	vkutil::end_single_time_commands(m_backend->current_frame().command_pool, cmd_buf, m_backend->device, m_backend->queues.graphics);
 }
 
 void VulkanTexture::set_parent(RenderTarget* parent)
@@ -412,6 +457,16 @@ u32 VulkanTexture::get_face_count() const
 
 VkImage VulkanTexture::image() const { return m_image; }
 VkImageView VulkanTexture::image_view() const { return m_view; }
+
+u32 VulkanTexture::bindless_index() const
+{
+	if (m_bindless_idx == VulkanBindlessTable::INVALID_INDEX && m_backend->bindless_table()->is_enabled()) {
+		m_bindless_idx = m_backend->bindless_table()->register_texture(m_view);
+	}
+
+	return m_bindless_idx;
+}
+
 u32 VulkanTexture::width() const { return m_width; }
 u32 VulkanTexture::height() const { return m_height; }
 u32 VulkanTexture::mip_levels() const { return m_mipmap_count; }
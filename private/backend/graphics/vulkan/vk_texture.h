@@ -32,9 +32,12 @@ namespace wvn::gfx
 		void init_transient(bool transient);
 
 		void create_internal_resources();
+		void reallocate(u32 width, u32 height, u32 mip_levels);
 
 		void transition_layout(VkImageLayout new_layout);
+		void transition_layout(VkCommandBuffer cmd_buf, VkImageLayout new_layout);
 		void generate_mipmaps() const;
+		void generate_mipmaps(VkCommandBuffer cmd_buf) const;
 
 		void set_parent(RenderTarget* parent) override;
 		const RenderTarget* get_parent() const override;
@@ -46,6 +49,9 @@ namespace wvn::gfx
 		VkImage image() const;
 		VkImageView image_view() const;
 
+		// registered with the bindless table the first time it is asked for
+		u32 bindless_index() const;
+
 		u32 width() const override;
 		u32 height() const override;
 
@@ -65,6 +71,7 @@ namespace wvn::gfx
 		VkDeviceMemory m_image_memory;
 		VkImageLayout m_image_layout;
 		VkImageView m_view;
+		mutable u32 m_bindless_idx;
 		u32 m_mipmap_count;
 		VkSampleCountFlagBits m_num_samples;
 		bool m_transient;
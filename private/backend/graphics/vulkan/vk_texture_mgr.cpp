@@ -5,6 +5,7 @@
 #include <wvn/graphics/image.h>
 #include <wvn/graphics/gpu_buffer.h>
 #include <wvn/graphics/gpu_buffer_mgr.h>
+#include <wvn/graphics/block_compression.h>
 
 using namespace wvn;
 using namespace wvn::gfx;
@@ -28,12 +29,8 @@ Texture* VulkanTextureMgr::create(const Image& image)
 
 	texture->create_internal_resources();
 
-	texture->transition_layout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-	GPUBuffer* stage = GPUBufferMgr::get_singleton()->create_staging_buffer(image.size());
-	stage->read_data_from_memory(image.data(), image.size(), 0);
-	stage->write_to_tex(texture, image.size());
-	delete stage;
+	const void* pixels = image.data();
+	m_backend->transfer_mgr()->upload_to_texture(texture, &pixels, image.size(), 1);
 
 	return texture;
 }
@@ -48,19 +45,16 @@ Texture* VulkanTextureMgr::create(u32 width, u32 height, TextureFormat format, T
 
 	texture->create_internal_resources();
 
-    texture->transition_layout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
 	if (data)
 	{
 		texture->set_mipmapped(true);
 
-		GPUBuffer* stage = GPUBufferMgr::get_singleton()->create_staging_buffer(size);
-		stage->read_data_from_memory(data, size, 0);
-		stage->write_to_tex(texture, size);
-		delete stage;
+		const void* pixels = data;
+		m_backend->transfer_mgr()->upload_to_texture(texture, &pixels, size, 1);
 	}
 	else
 	{
+		texture->transition_layout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 		texture->transition_layout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 	}
 
@@ -94,22 +88,72 @@ Texture* VulkanTextureMgr::create_cube_map(TextureFormat format, const Image& ri
 
 	texture->create_internal_resources();
 
-	texture->transition_layout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-	VulkanBuffer* stage = (VulkanBuffer*)GPUBufferMgr::get_singleton()->create_staging_buffer(right.size() * 6);
+	const void* sides[] = { right.data(), left.data(), top.data(), bottom.data(), front.data(), back.data() };
+	m_backend->transfer_mgr()->upload_to_texture(texture, sides, right.size(), 6);
 
-	const Image* sides[] = { &right, &left, &top, &bottom, &front, &back };
+	return texture;
+}
 
-	for (int i = 0; i < 6; i++) {
-		stage->read_data_from_memory(sides[i]->data(), sides[i]->size(), sides[i]->size() * i);
-		stage->write_to_tex(texture, sides[i]->size(), sides[i]->size() * i, i);
+Texture* VulkanTextureMgr::create_from_levels(u32 width, u32 height, TextureFormat format, const byte* const* levels, const u64* level_sizes, u32 level_count)
+{
+	if (bc::is_block_compressed(format) && !m_backend->physical_data.features.textureCompressionBC) {
+		wvn_ERROR("[VULKAN:TEXTUREMGR|DEBUG] Physical device does not support BC texture compression, cannot create texture of format: %d", format);
+		return nullptr;
 	}
 
-	delete stage;
+	VulkanTexture* texture = new VulkanTexture(m_backend);
+
+	texture->init_size(width, height);
+	texture->init_metadata(format, TEX_TILE_OPTIMAL, TEX_TYPE_2D);
+	texture->init_mip_levels(level_count);
+
+	texture->create_internal_resources();
+
+	m_backend->transfer_mgr()->upload_levels_to_texture(texture, (const void* const*)levels, level_sizes, level_count);
 
 	return texture;
 }
 
+Texture* VulkanTextureMgr::create_streamed(u32 width, u32 height, u32 mip_levels, const byte* data, u64 size)
+{
+	VulkanTexture* texture = new VulkanTexture(m_backend);
+
+	texture->init_size(width, height);
+	texture->init_metadata(TEX_FORMAT_R8G8B8A8_SRGB, TEX_TILE_OPTIMAL, TEX_TYPE_2D);
+	texture->init_mip_levels(mip_levels);
+
+	texture->set_mipmapped(true);
+
+	texture->create_internal_resources();
+
+	const void* pixels = data;
+	m_backend->transfer_mgr()->upload_to_texture(texture, &pixels, size, 1);
+
+	return texture;
+}
+
+// the old image is only destroyed once the gpu is done with it so the upload can't race a frame that's still drawing
+void VulkanTextureMgr::update(Texture* texture, const byte* data, u64 size)
+{
+	VulkanTexture* vk_texture = (VulkanTexture*)texture;
+
+	vk_texture->reallocate(vk_texture->width(), vk_texture->height(), vk_texture->mip_levels());
+
+	const void* pixels = data;
+	m_backend->transfer_mgr()->upload_to_texture(vk_texture, &pixels, size, 1);
+}
+
+// the new most detailed mip is uploaded and the smaller ones are regenerated from it on the gpu
+void VulkanTextureMgr::update_streamed(Texture* texture, u32 width, u32 height, u32 mip_levels, const byte* data, u64 size)
+{
+	VulkanTexture* vk_texture = (VulkanTexture*)texture;
+
+	vk_texture->reallocate(width, height, mip_levels);
+
+	const void* pixels = data;
+	m_backend->transfer_mgr()->upload_to_texture(vk_texture, &pixels, size, 1);
+}
+
 TextureSampler* VulkanTextureMgr::create_sampler(const TextureSampler::Style& style)
 {
 	return new VulkanTextureSampler(style);
@@ -20,6 +20,12 @@ namespace wvn::gfx
 		Texture* create(u32 width, u32 height, TextureFormat format, TextureTiling tiling, const byte* data, u64 size) override;
 		Texture* create_attachment(u32 width, u32 height, TextureFormat format, TextureTiling tiling) override;
 		Texture* create_cube_map(TextureFormat format, const Image& right, const Image& left, const Image& top, const Image& bottom, const Image& front, const Image& back) override;
+		void update(Texture* texture, const byte* data, u64 size) override;
+
+		Texture* create_from_levels(u32 width, u32 height, TextureFormat format, const byte* const* levels, const u64* level_sizes, u32 level_count) override;
+
+		Texture* create_streamed(u32 width, u32 height, u32 mip_levels, const byte* data, u64 size) override;
+		void update_streamed(Texture* texture, u32 width, u32 height, u32 mip_levels, const byte* data, u64 size) override;
 
 		TextureSampler* create_sampler(const TextureSampler::Style& style) override;
 
@@ -0,0 +1,640 @@
+#include <backend/graphics/vulkan/vk_transfer_mgr.h>
+#include <backend/graphics/vulkan/vk_backend.h>
+#include <backend/graphics/vulkan/vk_buffer.h>
+#include <backend/graphics/vulkan/vk_texture.h>
+
+#include <wvn/graphics/gpu_buffer_mgr.h>
+#include <wvn/devenv/log_mgr.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+// copies into images need their buffer offset to be a multiple of the texel size (and 4)
+static constexpr u64 STAGING_ALIGNMENT = 16;
+
+VulkanTransferMgr::VulkanTransferMgr()
+	: m_backend(nullptr)
+	, m_transfer_family(0)
+	, m_graphics_family(0)
+	, m_transfer_pool(VK_NULL_HANDLE)
+	, m_graphics_pool(VK_NULL_HANDLE)
+	, m_timeline(VK_NULL_HANDLE)
+	, m_ring(nullptr)
+	, m_ring_data(nullptr)
+	, m_ring_size(0)
+	, m_ring_head(0)
+	, m_ring_tail(0)
+	, m_ring_used(0)
+	, m_open_batch()
+	, m_batch_open(false)
+	, m_in_flight()
+	, m_dedicated_stages()
+	, m_next_value(0)
+	, m_last_submitted_value(0)
+{
+}
+
+void VulkanTransferMgr::init(VulkanBackend* backend, u32 transfer_family, u32 graphics_family, u64 staging_size)
+{
+	this->m_backend = backend;
+
+	m_transfer_family = transfer_family;
+	m_graphics_family = graphics_family;
+
+	VkCommandPoolCreateInfo pool_create_info = {};
+	pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	pool_create_info.queueFamilyIndex = transfer_family;
+
+	if (VkResult result = vkCreateCommandPool(m_backend->device, &pool_create_info, nullptr, &m_transfer_pool); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to create transfer command pool: %d", result);
+	}
+
+	pool_create_info.queueFamilyIndex = graphics_family;
+
+	if (VkResult result = vkCreateCommandPool(m_backend->device, &pool_create_info, nullptr, &m_graphics_pool); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to create graphics command pool: %d", result);
+	}
+
+	VkSemaphoreTypeCreateInfo semaphore_type_create_info = {};
+	semaphore_type_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	semaphore_type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+	semaphore_type_create_info.initialValue = 0;
+
+	VkSemaphoreCreateInfo semaphore_create_info = {};
+	semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	semaphore_create_info.pNext = &semaphore_type_create_info;
+
+	if (VkResult result = vkCreateSemaphore(m_backend->device, &semaphore_create_info, nullptr, &m_timeline); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to create timeline semaphore: %d", result);
+	}
+
+	m_ring = (VulkanBuffer*)GPUBufferMgr::get_singleton()->create_staging_buffer(staging_size);
+	m_ring_data = (byte*)m_ring->map_persistent();
+	m_ring_size = staging_size;
+	m_ring_head = 0;
+	m_ring_tail = 0;
+	m_ring_used = 0;
+
+	dev::LogMgr::get_singleton()->print("[VULKAN:TRANSFER] Created staging ring buffer with size %llu.", staging_size);
+}
+
+void VulkanTransferMgr::clean_up()
+{
+	if (!m_backend) {
+		return;
+	}
+
+	wait_all();
+
+	for (auto& [value, stage] : m_dedicated_stages) {
+		delete stage;
+	}
+
+	m_dedicated_stages.clear();
+
+	delete m_ring;
+	m_ring = nullptr;
+	m_ring_data = nullptr;
+
+	vkDestroySemaphore(m_backend->device, m_timeline, nullptr);
+	vkDestroyCommandPool(m_backend->device, m_graphics_pool, nullptr);
+	vkDestroyCommandPool(m_backend->device, m_transfer_pool, nullptr);
+
+	m_timeline = VK_NULL_HANDLE;
+	m_graphics_pool = VK_NULL_HANDLE;
+	m_transfer_pool = VK_NULL_HANDLE;
+}
+
+void VulkanTransferMgr::upload_to_buffer(const VulkanBuffer* buffer, const void* data, u64 size, u64 dst_offset)
+{
+	VkBuffer src = VK_NULL_HANDLE;
+	u64 src_offset = 0;
+	void* mapped = nullptr;
+
+	allocate_staging(size, &src, &src_offset, &mapped);
+	mem::copy(mapped, data, size);
+
+	begin_batch();
+
+	VkBufferCopy region = {};
+	region.srcOffset = src_offset;
+	region.dstOffset = dst_offset;
+	region.size = size;
+
+	vkCmdCopyBuffer(m_open_batch.transfer_cmd, src, buffer->buffer(), 1, &region);
+
+	if (m_transfer_family == m_graphics_family) {
+		return;
+	}
+
+	// hand ownership of the buffer over to the graphics queue
+	VkBufferMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = 0;
+	barrier.srcQueueFamilyIndex = m_transfer_family;
+	barrier.dstQueueFamilyIndex = m_graphics_family;
+	barrier.buffer = buffer->buffer();
+	barrier.offset = dst_offset;
+	barrier.size = size;
+
+	vkCmdPipelineBarrier(
+		m_open_batch.transfer_cmd,
+		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		0,
+		0, nullptr,
+		1, &barrier,
+		0, nullptr
+	);
+
+	begin_graphics_cmd();
+
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT;
+
+	vkCmdPipelineBarrier(
+		m_open_batch.graphics_cmd,
+		VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		0,
+		0, nullptr,
+		1, &barrier,
+		0, nullptr
+	);
+}
+
+// uploads mip level 0 of each layer, layers are expected to be tightly packed and of equal size
+// mipmap generation & the final layout transition happen on the graphics queue once the copy has landed
+void VulkanTransferMgr::upload_to_texture(VulkanTexture* texture, const void* const* layers, u64 layer_size, u32 layer_count)
+{
+	VkBuffer src = VK_NULL_HANDLE;
+	u64 src_offset = 0;
+	void* mapped = nullptr;
+
+	allocate_staging(layer_size * layer_count, &src, &src_offset, &mapped);
+
+	for (u32 i = 0; i < layer_count; i++) {
+		mem::copy((byte*)mapped + (layer_size * i), layers[i], layer_size);
+	}
+
+	begin_batch();
+
+	texture->transition_layout(m_open_batch.transfer_cmd, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+	Vector<VkBufferImageCopy> regions(layer_count);
+
+	for (u32 i = 0; i < layer_count; i++)
+	{
+		regions[i].bufferOffset = src_offset + (layer_size * i);
+		regions[i].bufferRowLength = 0;
+		regions[i].bufferImageHeight = 0;
+		regions[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		regions[i].imageSubresource.mipLevel = 0;
+		regions[i].imageSubresource.baseArrayLayer = i;
+		regions[i].imageSubresource.layerCount = 1;
+		regions[i].imageOffset = { 0, 0, 0 };
+		regions[i].imageExtent = { texture->width(), texture->height(), 1 };
+	}
+
+	vkCmdCopyBufferToImage(
+		m_open_batch.transfer_cmd,
+		src,
+		texture->image(),
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		regions.size(),
+		regions.data()
+	);
+
+	begin_graphics_cmd();
+
+	if (m_transfer_family != m_graphics_family)
+	{
+		VkImageMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.srcQueueFamilyIndex = m_transfer_family;
+		barrier.dstQueueFamilyIndex = m_graphics_family;
+		barrier.image = texture->image();
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = texture->mip_levels();
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = texture->get_layer_count();
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = 0;
+
+		vkCmdPipelineBarrier(
+			m_open_batch.transfer_cmd,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &barrier
+		);
+
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(
+			m_open_batch.graphics_cmd,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &barrier
+		);
+	}
+
+	if (texture->is_mipmapped()) {
+		texture->generate_mipmaps(m_open_batch.graphics_cmd);
+	} else {
+		texture->transition_layout(m_open_batch.graphics_cmd, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	}
+}
+
+void VulkanTransferMgr::upload_levels_to_texture(VulkanTexture* texture, const void* const* levels, const u64* level_sizes, u32 level_count)
+{
+	// every level keeps the staging alignment so block compressed copies start on a whole block
+	Vector<u64> offsets(level_count);
+	u64 total_size = 0;
+
+	for (int i = 0; i < level_count; i++)
+	{
+		offsets[i] = total_size;
+		total_size += ((level_sizes[i] + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT) * STAGING_ALIGNMENT;
+	}
+
+	VkBuffer src = VK_NULL_HANDLE;
+	u64 src_offset = 0;
+	void* mapped = nullptr;
+
+	allocate_staging(total_size, &src, &src_offset, &mapped);
+
+	for (int i = 0; i < level_count; i++) {
+		mem::copy((byte*)mapped + offsets[i], levels[i], level_sizes[i]);
+	}
+
+	begin_batch();
+
+	texture->transition_layout(m_open_batch.transfer_cmd, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+	Vector<VkBufferImageCopy> regions(level_count);
+
+	for (int i = 0; i < level_count; i++)
+	{
+		regions[i].bufferOffset = src_offset + offsets[i];
+		regions[i].bufferRowLength = 0;
+		regions[i].bufferImageHeight = 0;
+		regions[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		regions[i].imageSubresource.mipLevel = i;
+		regions[i].imageSubresource.baseArrayLayer = 0;
+		regions[i].imageSubresource.layerCount = 1;
+		regions[i].imageOffset = { 0, 0, 0 };
+		regions[i].imageExtent = { CalcU::max(texture->width() >> i, 1), CalcU::max(texture->height() >> i, 1), 1 };
+	}
+
+	vkCmdCopyBufferToImage(
+		m_open_batch.transfer_cmd,
+		src,
+		texture->image(),
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		regions.size(),
+		regions.data()
+	);
+
+	begin_graphics_cmd();
+
+	if (m_transfer_family != m_graphics_family)
+	{
+		VkImageMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.srcQueueFamilyIndex = m_transfer_family;
+		barrier.dstQueueFamilyIndex = m_graphics_family;
+		barrier.image = texture->image();
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = texture->mip_levels();
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = texture->get_layer_count();
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = 0;
+
+		vkCmdPipelineBarrier(
+			m_open_batch.transfer_cmd,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &barrier
+		);
+
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(
+			m_open_batch.graphics_cmd,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &barrier
+		);
+	}
+
+	texture->transition_layout(m_open_batch.graphics_cmd, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+u64 VulkanTransferMgr::flush()
+{
+	if (!m_batch_open) {
+		return m_last_submitted_value;
+	}
+
+	vkEndCommandBuffer(m_open_batch.transfer_cmd);
+
+	u64 transfer_value = ++m_next_value;
+
+	VkTimelineSemaphoreSubmitInfo transfer_timeline_info = {};
+	transfer_timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	transfer_timeline_info.signalSemaphoreValueCount = 1;
+	transfer_timeline_info.pSignalSemaphoreValues = &transfer_value;
+
+	VkSubmitInfo transfer_submit_info = {};
+	transfer_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	transfer_submit_info.pNext = &transfer_timeline_info;
+	transfer_submit_info.commandBufferCount = 1;
+	transfer_submit_info.pCommandBuffers = &m_open_batch.transfer_cmd;
+	transfer_submit_info.signalSemaphoreCount = 1;
+	transfer_submit_info.pSignalSemaphores = &m_timeline;
+
+	if (VkResult result = vkQueueSubmit(m_backend->queues.transfer, 1, &transfer_submit_info, VK_NULL_HANDLE); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to submit transfer batch: %d", result);
+	}
+
+	u64 batch_value = transfer_value;
+
+	if (m_open_batch.graphics_cmd != VK_NULL_HANDLE)
+	{
+		vkEndCommandBuffer(m_open_batch.graphics_cmd);
+
+		u64 graphics_value = ++m_next_value;
+		VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+		VkTimelineSemaphoreSubmitInfo graphics_timeline_info = {};
+		graphics_timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		graphics_timeline_info.waitSemaphoreValueCount = 1;
+		graphics_timeline_info.pWaitSemaphoreValues = &transfer_value;
+		graphics_timeline_info.signalSemaphoreValueCount = 1;
+		graphics_timeline_info.pSignalSemaphoreValues = &graphics_value;
+
+		VkSubmitInfo graphics_submit_info = {};
+		graphics_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		graphics_submit_info.pNext = &graphics_timeline_info;
+		graphics_submit_info.waitSemaphoreCount = 1;
+		graphics_submit_info.pWaitSemaphores = &m_timeline;
+		graphics_submit_info.pWaitDstStageMask = &wait_stage;
+		graphics_submit_info.commandBufferCount = 1;
+		graphics_submit_info.pCommandBuffers = &m_open_batch.graphics_cmd;
+		graphics_submit_info.signalSemaphoreCount = 1;
+		graphics_submit_info.pSignalSemaphores = &m_timeline;
+
+		if (VkResult result = vkQueueSubmit(m_backend->queues.graphics, 1, &graphics_submit_info, VK_NULL_HANDLE); result != VK_SUCCESS) {
+			wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to submit upload finalisation: %d", result);
+		}
+
+		batch_value = graphics_value;
+	}
+
+	// oversized uploads that bypassed the ring get freed alongside this batch
+	for (auto& [value, stage] : m_dedicated_stages) {
+		if (value == 0) {
+			value = batch_value;
+		}
+	}
+
+	m_open_batch.timeline_value = batch_value;
+	m_in_flight.push_back(m_open_batch);
+
+	m_open_batch = {};
+	m_batch_open = false;
+
+	m_last_submitted_value = batch_value;
+
+	return batch_value;
+}
+
+void VulkanTransferMgr::collect()
+{
+	u64 completed = 0;
+	vkGetSemaphoreCounterValue(m_backend->device, m_timeline, &completed);
+
+	u64 n_retired = 0;
+
+	while (n_retired < m_in_flight.size() && m_in_flight[n_retired].timeline_value <= completed) {
+		retire_batch(m_in_flight[n_retired]);
+		n_retired++;
+	}
+
+	m_in_flight.erase(0, n_retired);
+
+	if (m_dedicated_stages.empty()) {
+		return;
+	}
+
+	Vector<Pair<u64, VulkanBuffer*>> pending_stages;
+
+	for (auto& [value, stage] : m_dedicated_stages)
+	{
+		if (value != 0 && value <= completed) {
+			delete stage;
+		} else {
+			pending_stages.push_back(Pair<u64, VulkanBuffer*>(value, stage));
+		}
+	}
+
+	m_dedicated_stages = pending_stages;
+}
+
+void VulkanTransferMgr::wait(u64 value)
+{
+	if (value == 0) {
+		return;
+	}
+
+	VkSemaphoreWaitInfo wait_info = {};
+	wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+	wait_info.semaphoreCount = 1;
+	wait_info.pSemaphores = &m_timeline;
+	wait_info.pValues = &value;
+
+	if (VkResult result = vkWaitSemaphores(m_backend->device, &wait_info, UINT64_MAX); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to wait on timeline semaphore: %d", result);
+	}
+
+	collect();
+}
+
+void VulkanTransferMgr::wait_all()
+{
+	wait(flush());
+}
+
+bool VulkanTransferMgr::is_complete(u64 value) const
+{
+	u64 completed = 0;
+	vkGetSemaphoreCounterValue(m_backend->device, m_timeline, &completed);
+
+	return completed >= value;
+}
+
+VkSemaphore VulkanTransferMgr::timeline_semaphore() const
+{
+	return m_timeline;
+}
+
+u64 VulkanTransferMgr::last_submitted_value() const
+{
+	return m_last_submitted_value;
+}
+
+void VulkanTransferMgr::allocate_staging(u64 size, VkBuffer* buffer, u64* offset, void** mapped)
+{
+	u64 aligned_size = ((size + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT) * STAGING_ALIGNMENT;
+
+	// too big to ever fit in the ring, fall back to a one-off staging buffer
+	if (aligned_size > m_ring_size)
+	{
+		VulkanBuffer* stage = (VulkanBuffer*)GPUBufferMgr::get_singleton()->create_staging_buffer(size);
+		m_dedicated_stages.push_back(Pair<u64, VulkanBuffer*>(0, stage));
+
+		(*buffer) = stage->buffer();
+		(*offset) = 0;
+		(*mapped) = stage->map_persistent();
+
+		return;
+	}
+
+	while (true)
+	{
+		collect();
+
+		if (m_ring_used == 0) {
+			m_ring_head = 0;
+			m_ring_tail = 0;
+		}
+
+		u64 start = 0;
+		u64 wasted = 0;
+		bool fits = false;
+
+		if (m_ring_used == 0)
+		{
+			fits = true;
+		}
+		else if (m_ring_head > m_ring_tail)
+		{
+			if (m_ring_head + aligned_size <= m_ring_size) {
+				start = m_ring_head;
+				fits = true;
+			} else if (aligned_size <= m_ring_tail) {
+				// wrap around, the tail end of the ring is left unused until this batch retires
+				wasted = m_ring_size - m_ring_head;
+				fits = true;
+			}
+		}
+		else if (m_ring_head < m_ring_tail)
+		{
+			if (m_ring_head + aligned_size <= m_ring_tail) {
+				start = m_ring_head;
+				fits = true;
+			}
+		}
+
+		if (fits)
+		{
+			m_ring_head = start + aligned_size;
+			m_ring_used += aligned_size + wasted;
+
+			m_open_batch.ring_end = m_ring_head;
+			m_open_batch.ring_bytes += aligned_size + wasted;
+
+			(*buffer) = m_ring->buffer();
+			(*offset) = start;
+			(*mapped) = m_ring_data + start;
+
+			return;
+		}
+
+		// the ring is full, push out whatever is pending and wait for the oldest batch to retire
+		flush();
+
+		wvn_ASSERT(m_in_flight.any(), "[VULKAN:TRANSFER|DEBUG] Staging ring is full but no batches are in flight.");
+
+		wait(m_in_flight.front().timeline_value);
+	}
+}
+
+void VulkanTransferMgr::begin_batch()
+{
+	if (m_batch_open) {
+		return;
+	}
+
+	m_open_batch.transfer_cmd = allocate_command_buffer(m_transfer_pool);
+	m_open_batch.graphics_cmd = VK_NULL_HANDLE;
+	m_batch_open = true;
+}
+
+void VulkanTransferMgr::begin_graphics_cmd()
+{
+	if (m_open_batch.graphics_cmd != VK_NULL_HANDLE) {
+		return;
+	}
+
+	m_open_batch.graphics_cmd = allocate_command_buffer(m_graphics_pool);
+}
+
+void VulkanTransferMgr::retire_batch(const UploadBatch& batch)
+{
+	vkFreeCommandBuffers(m_backend->device, m_transfer_pool, 1, &batch.transfer_cmd);
+
+	if (batch.graphics_cmd != VK_NULL_HANDLE) {
+		vkFreeCommandBuffers(m_backend->device, m_graphics_pool, 1, &batch.graphics_cmd);
+	}
+
+	// a batch that only used dedicated staging buffers never touched the ring, so its ring_end means nothing
+	if (batch.ring_bytes > 0) {
+		m_ring_tail = batch.ring_end;
+	}
+
+	m_ring_used -= batch.ring_bytes;
+}
+
+VkCommandBuffer VulkanTransferMgr::allocate_command_buffer(VkCommandPool pool)
+{
+	VkCommandBufferAllocateInfo alloc_info = {};
+	alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	alloc_info.commandPool = pool;
+	alloc_info.commandBufferCount = 1;
+
+	VkCommandBuffer cmd_buf = VK_NULL_HANDLE;
+
+	if (VkResult result = vkAllocateCommandBuffers(m_backend->device, &alloc_info, &cmd_buf); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to allocate command buffer: %d", result);
+	}
+
+	VkCommandBufferBeginInfo begin_info = {};
+	begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	if (VkResult result = vkBeginCommandBuffer(cmd_buf, &begin_info); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:TRANSFER|DEBUG] Failed to begin command buffer: %d", result);
+	}
+
+	return cmd_buf;
+}
@@ -0,0 +1,90 @@
+#ifndef VK_TRANSFER_MGR_H_
+#define VK_TRANSFER_MGR_H_
+
+#include <vulkan/vulkan.h>
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/container/pair.h>
+
+namespace wvn::gfx
+{
+	class VulkanBackend;
+	class VulkanBuffer;
+	class VulkanTexture;
+
+	/**
+	 * Streams buffer & texture data to the gpu through a persistently mapped
+	 * staging ring buffer. Copies are batched into a single command buffer on the
+	 * transfer queue and completion is tracked with a timeline semaphore, so an
+	 * upload never stalls the graphics queue.
+	 */
+	class VulkanTransferMgr
+	{
+		struct UploadBatch
+		{
+			VkCommandBuffer transfer_cmd;
+			VkCommandBuffer graphics_cmd;
+			u64 timeline_value;
+			u64 ring_end;
+			u64 ring_bytes;
+		};
+
+	public:
+		VulkanTransferMgr();
+
+		void init(VulkanBackend* backend, u32 transfer_family, u32 graphics_family, u64 staging_size);
+		void clean_up();
+
+		void upload_to_buffer(const VulkanBuffer* buffer, const void* data, u64 size, u64 dst_offset);
+		void upload_to_texture(VulkanTexture* texture, const void* const* layers, u64 layer_size, u32 layer_count);
+
+		// uploads a complete precomputed mip chain (mip 0 first), nothing is generated on the gpu afterwards
+		void upload_levels_to_texture(VulkanTexture* texture, const void* const* levels, const u64* level_sizes, u32 level_count);
+
+		u64 flush();
+		void collect();
+
+		void wait(u64 value);
+		void wait_all();
+		bool is_complete(u64 value) const;
+
+		VkSemaphore timeline_semaphore() const;
+		u64 last_submitted_value() const;
+
+	private:
+		void allocate_staging(u64 size, VkBuffer* buffer, u64* offset, void** mapped);
+		void begin_batch();
+		void begin_graphics_cmd();
+		void retire_batch(const UploadBatch& batch);
+
+		VkCommandBuffer allocate_command_buffer(VkCommandPool pool);
+
+		VulkanBackend* m_backend;
+
+		u32 m_transfer_family;
+		u32 m_graphics_family;
+
+		VkCommandPool m_transfer_pool;
+		VkCommandPool m_graphics_pool;
+		VkSemaphore m_timeline;
+
+		VulkanBuffer* m_ring;
+		byte* m_ring_data;
+		u64 m_ring_size;
+		u64 m_ring_head;
+		u64 m_ring_tail;
+		u64 m_ring_used;
+
+		UploadBatch m_open_batch;
+		bool m_batch_open;
+
+		Vector<UploadBatch> m_in_flight;
+		Vector<Pair<u64, VulkanBuffer*>> m_dedicated_stages;
+
+		u64 m_next_value;
+		u64 m_last_submitted_value;
+	};
+}
+
+#endif // VK_TRANSFER_MGR_H_
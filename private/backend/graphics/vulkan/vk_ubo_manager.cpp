@@ -10,93 +10,114 @@ using namespace wvn::gfx;
 VulkanUBOManager::VulkanUBOManager()
 	: m_backend(nullptr)
 	, m_ubo(nullptr)
+	, m_mapped_data(nullptr)
 	, m_ubo_dynamic_offsets()
 	, m_ubo_infos()
-	, m_ubo_usage_in_frame()
-	, m_ubo_offset(0)
-	, m_ubo_max_size(0)
+	, m_frame_idx(0)
+	, m_frame_offset(0)
+	, m_frame_partition_size(0)
+	, m_alignment(1)
 {
 }
 
 void VulkanUBOManager::init(VulkanBackend* backend, u64 initial_size)
 {
 	this->m_backend = backend;
+	this->m_alignment = m_backend->physical_data.properties.limits.minUniformBufferOffsetAlignment;
 
-	reallocate_uniform_buffer(initial_size);
-
-	m_ubo_usage_in_frame.clear();
+	reallocate_uniform_buffer(initial_size / vkutil::FRAMES_IN_FLIGHT);
 }
 
 void VulkanUBOManager::clean_up()
 {
 	delete m_ubo;
 	m_ubo = nullptr;
+	m_mapped_data = nullptr;
 }
 
+// the common case is just a pointer bump and a memcpy into mapped memory
 void VulkanUBOManager::push_data(ShaderProgramType shader, const void* data, u64 size, bool* modified)
 {
-	u64 used_memory_total = 0;
-	for (int i = 0; i < m_ubo_usage_in_frame.size(); i++) {
-		used_memory_total += m_ubo_usage_in_frame[i];
-	}
+	u64 offset = (m_frame_offset + m_alignment - 1) & ~(m_alignment - 1);
 
-	if (used_memory_total + size > m_ubo_max_size) {
-		reallocate_uniform_buffer(m_ubo_max_size * 2);
-	}
+	if (offset + size > m_frame_partition_size)
+	{
+		u64 new_partition_size = m_frame_partition_size * 2;
+
+		while (new_partition_size < offset + size) {
+			new_partition_size *= 2;
+		}
+
+		reallocate_uniform_buffer(new_partition_size);
 
-	if (m_ubo_offset + size >= m_ubo_max_size) {
-		m_ubo_offset = 0;
+		// the descriptors now point at a different buffer
+		if (modified) {
+			(*modified) = true;
+		}
 	}
 
-	u32 dynamic_offset = vkutil::calc_ubo_aligned_offset(
-		m_ubo_offset,
-		m_backend->physical_data.properties
-	);
+	u64 dynamic_offset = (m_frame_idx * m_frame_partition_size) + offset;
 
-	m_ubo_dynamic_offsets[shader] = dynamic_offset;
+	mem::copy(m_mapped_data + dynamic_offset, data, size);
+
+	m_frame_offset = offset + size;
 
-	m_ubo_infos[shader].offset = 0;
+	m_ubo_dynamic_offsets[shader] = dynamic_offset;
 
 	if (m_ubo_infos[shader].range != size && modified) {
 		(*modified) = true;
 	}
 
 	m_ubo_infos[shader].range = size;
+}
 
-	m_ubo->read_data_from_memory(data, size, dynamic_offset);
+// the old buffer is kept alive until every frame that could still be reading from it has finished.
+// the sets pointing at it are dropped from the descriptor cache straight away though, as once it's destroyed
+// a new buffer could be given the same handle and hash to one of them
+void VulkanUBOManager::reallocate_uniform_buffer(u64 frame_partition_size)
+{
+	VulkanBuffer* old_ubo = m_ubo;
+	byte* old_mapped_data = m_mapped_data;
+	u64 old_partition_size = m_frame_partition_size;
 
-	m_ubo_offset += size;
-	m_ubo_usage_in_frame[m_backend->get_current_frame_idx()] += size;
+	m_frame_partition_size = vkutil::get_ubo_size(frame_partition_size, m_backend->physical_data.properties);
 
-	if (m_ubo_offset >= m_ubo_max_size) {
-		m_ubo_offset = 0;
-	}
-}
+	m_ubo = (VulkanBuffer*)GPUBufferMgr::get_singleton()->create_uniform_buffer(m_frame_partition_size * vkutil::FRAMES_IN_FLIGHT);
+	m_mapped_data = (byte*)m_ubo->map_persistent();
 
-void VulkanUBOManager::reallocate_uniform_buffer(u64 size)
-{
-	delete m_ubo;
+	if (old_ubo)
+	{
+		u64 old_start = m_frame_idx * old_partition_size;
+		u64 new_start = m_frame_idx * m_frame_partition_size;
+
+		// data pushed earlier this frame may not have been drawn with yet, and the next draw picks up the new buffer,
+		// so it's carried over to the same place in the new partition and any offsets into it follow along
+		mem::copy(m_mapped_data + new_start, old_mapped_data + old_start, m_frame_offset);
 
-	VkDeviceSize buffer_size = vkutil::get_ubo_size(size, m_backend->physical_data.properties);
+		for (auto& dynamic_offset : m_ubo_dynamic_offsets)
+		{
+			if (dynamic_offset >= old_start && dynamic_offset < old_start + m_frame_offset) {
+				dynamic_offset = new_start + (dynamic_offset - old_start);
+			}
+		}
 
-	m_ubo_max_size = size;
-	m_ubo_offset = 0;
-	m_ubo = (VulkanBuffer*)GPUBufferMgr::get_singleton()->create_uniform_buffer(buffer_size);
+		m_backend->descriptor_cache()->retire_buffer(old_ubo->buffer());
+		m_backend->defer_deletion(old_ubo);
+	}
 
 	for (auto& info : m_ubo_infos) {
 		info.buffer = m_ubo->buffer();
 		info.offset = 0;
-		info.range = 0;
 	}
 
-	m_backend->clear_descriptor_set_and_pool();
-
-	dev::LogMgr::get_singleton()->print("[VULKAN:UBO] (Re)Allocated uniform buffer with size %u.", size);
+	dev::LogMgr::get_singleton()->print("[VULKAN:UBO] (Re)Allocated uniform buffer with %llu bytes per frame.", (unsigned long long)m_frame_partition_size);
 }
 
-void VulkanUBOManager::reset_ubo_usage_in_frame()
+// only called once the fence for this frame has been waited on, so its whole partition is free again
+void VulkanUBOManager::begin_frame(u64 frame_idx)
 {
-	m_ubo_usage_in_frame[m_backend->get_current_frame_idx()] = 0;
+	m_frame_idx = frame_idx;
+	m_frame_offset = 0;
 }
 
 u64 VulkanUBOManager::get_descriptor_count() const
@@ -13,7 +13,9 @@ namespace wvn::gfx
 {
 	/**
 	 * Abstracts away & manages the allocation
-	 * and lifetime of a uniform buffer for use in shaders
+	 * and lifetime of a uniform buffer for use in shaders.
+	 * The buffer is persistently mapped and split into one partition per frame in flight,
+	 * each of which is bump allocated from and only rewound once the gpu is done with that frame.
 	 */
 	class VulkanUBOManager
 	{
@@ -24,9 +26,9 @@ namespace wvn::gfx
 		void clean_up();
 
 		void push_data(ShaderProgramType shader, const void* data, u64 size, bool* modified);
-		void reallocate_uniform_buffer(u64 size);
+		void reallocate_uniform_buffer(u64 frame_partition_size);
 
-		void reset_ubo_usage_in_frame();
+		void begin_frame(u64 frame_idx);
 
 		u64 get_descriptor_count() const;
 		const VkDescriptorBufferInfo& get_descriptor(u64 idx) const;
@@ -38,11 +40,13 @@ namespace wvn::gfx
 		VulkanBackend* m_backend;
 
 		VulkanBuffer* m_ubo;
+		byte* m_mapped_data;
 		Array<u32, SHADER_TYPE_GRAPHICS_COUNT> m_ubo_dynamic_offsets;
 		Array<VkDescriptorBufferInfo, SHADER_TYPE_GRAPHICS_COUNT> m_ubo_infos;
-		Array<u64, vkutil::FRAMES_IN_FLIGHT> m_ubo_usage_in_frame;
-		u64 m_ubo_offset;
-		u64 m_ubo_max_size;
+		u64 m_frame_idx;
+		u64 m_frame_offset; // bump pointer inside of the current frame's partition
+		u64 m_frame_partition_size;
+		u64 m_alignment;
 	};
 }
 
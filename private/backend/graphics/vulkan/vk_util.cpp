@@ -99,6 +99,11 @@ bool vkutil::has_stencil_component(VkFormat format)
 	return (format == VK_FORMAT_D32_SFLOAT) || (format == VK_FORMAT_D32_SFLOAT_S8_UINT) || (format == VK_FORMAT_D24_UNORM_S8_UINT);
 }
 
+bool vkutil::is_block_compressed(VkFormat format)
+{
+	return (format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK) && (format <= VK_FORMAT_BC7_SRGB_BLOCK);
+}
+
 VkCommandBuffer vkutil::begin_single_time_commands(VkCommandPool cmd_pool, VkDevice device)
 {
 	VkCommandBufferAllocateInfo alloc_info = {};
@@ -133,9 +138,20 @@ void vkutil::end_single_time_commands(VkCommandPool cmd_pool, VkCommandBuffer cm
 	submit_info.commandBufferCount = 1;
 	submit_info.pCommandBuffers = &cmd_buf;
 
-	vkQueueSubmit(graphics, 1, &submit_info, VK_NULL_HANDLE);
-	vkQueueWaitIdle(graphics);
+	// only wait on this submission rather than draining the whole queue
+	VkFenceCreateInfo fence_create_info = {};
+	fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+	VkFence fence = VK_NULL_HANDLE;
+
+	if (VkResult result = vkCreateFence(device, &fence_create_info, nullptr, &fence); result != VK_SUCCESS) {
+		wvn_ERROR("[VULKAN:UTIL|DEBUG] Failed to create fence for single time command: %d", result);
+	}
 
+	vkQueueSubmit(graphics, 1, &submit_info, fence);
+	vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+
+	vkDestroyFence(device, fence, nullptr);
 	vkFreeCommandBuffers(device, cmd_pool, 1, &cmd_buf);
 }
 
@@ -696,6 +712,27 @@ TextureFormat vkutil::get_wvn_texture_format(VkFormat fmt)
 	case VK_FORMAT_D24_UNORM_S8_UINT:
 		return TEX_FORMAT_D24_UNORM_S8_UINT;
 
+	case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		return TEX_FORMAT_BC1_RGBA_UNORM;
+
+	case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		return TEX_FORMAT_BC1_RGBA_SRGB;
+
+	case VK_FORMAT_BC3_UNORM_BLOCK:
+		return TEX_FORMAT_BC3_UNORM;
+
+	case VK_FORMAT_BC3_SRGB_BLOCK:
+		return TEX_FORMAT_BC3_SRGB;
+
+	case VK_FORMAT_BC5_UNORM_BLOCK:
+		return TEX_FORMAT_BC5_UNORM;
+
+	case VK_FORMAT_BC7_UNORM_BLOCK:
+		return TEX_FORMAT_BC7_UNORM;
+
+	case VK_FORMAT_BC7_SRGB_BLOCK:
+		return TEX_FORMAT_BC7_SRGB;
+
 	default:
 		dev::LogMgr::get_singleton()->print("[VULKAN:UTIL] Failed to find TextureFormat given VkFormat: %d", fmt);
 		return TEX_FORMAT_MAX_ENUM;
@@ -1093,6 +1130,27 @@ VkFormat vkutil::get_vk_texture_format(TextureFormat fmt)
 	case TEX_FORMAT_D24_UNORM_S8_UINT:
 		return VK_FORMAT_D24_UNORM_S8_UINT;
 
+	case TEX_FORMAT_BC1_RGBA_UNORM:
+		return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+
+	case TEX_FORMAT_BC1_RGBA_SRGB:
+		return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+
+	case TEX_FORMAT_BC3_UNORM:
+		return VK_FORMAT_BC3_UNORM_BLOCK;
+
+	case TEX_FORMAT_BC3_SRGB:
+		return VK_FORMAT_BC3_SRGB_BLOCK;
+
+	case TEX_FORMAT_BC5_UNORM:
+		return VK_FORMAT_BC5_UNORM_BLOCK;
+
+	case TEX_FORMAT_BC7_UNORM:
+		return VK_FORMAT_BC7_UNORM_BLOCK;
+
+	case TEX_FORMAT_BC7_SRGB:
+		return VK_FORMAT_BC7_SRGB_BLOCK;
+
 	default:
 		dev::LogMgr::get_singleton()->print("[VULKAN:UTIL] Failed to find VkFormat given TextureFormat: %d", fmt);
 		return VK_FORMAT_MAX_ENUM;
@@ -1599,3 +1657,51 @@ VkCullModeFlagBits vkutil::get_vk_cull_mode(CullMode cull)
 		return VK_CULL_MODE_FLAG_BITS_MAX_ENUM;
 	}
 }
+
+VkPipelineStageFlags vkutil::get_vk_resource_state_stages(RenderResourceState state)
+{
+	switch (state)
+	{
+	case RENDER_RESOURCE_STATE_UNDEFINED:
+		return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+	case RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT:
+		return VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+	case RENDER_RESOURCE_STATE_DEPTH_ATTACHMENT:
+		return VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+	case RENDER_RESOURCE_STATE_SHADER_READ:
+		return VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+	case RENDER_RESOURCE_STATE_PRESENT:
+		return VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+	default:
+		dev::LogMgr::get_singleton()->print("[VULKAN:UTIL] Failed to find VkPipelineStageFlags given RenderResourceState: %d", state);
+		return VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+	}
+}
+
+VkAccessFlags vkutil::get_vk_resource_state_access(RenderResourceState state)
+{
+	switch (state)
+	{
+	case RENDER_RESOURCE_STATE_UNDEFINED:
+	case RENDER_RESOURCE_STATE_PRESENT:
+		return 0;
+
+	case RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT:
+		return VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+	case RENDER_RESOURCE_STATE_DEPTH_ATTACHMENT:
+		return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+	case RENDER_RESOURCE_STATE_SHADER_READ:
+		return VK_ACCESS_SHADER_READ_BIT;
+
+	default:
+		dev::LogMgr::get_singleton()->print("[VULKAN:UTIL] Failed to find VkAccessFlags given RenderResourceState: %d", state);
+		return VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+	}
+}
@@ -89,6 +89,7 @@ namespace wvn::gfx
 		VkFormat find_depth_format(VkPhysicalDevice device);
 
 		bool has_stencil_component(VkFormat format);
+		bool is_block_compressed(VkFormat format);
 
 		VkCommandBuffer begin_single_time_commands(VkCommandPool cmd_pool, VkDevice device);
 		void end_single_time_commands(VkCommandPool cmd_pool, VkCommandBuffer cmd_buf, VkDevice device, VkQueue graphics);
@@ -117,6 +118,8 @@ namespace wvn::gfx
 		VkLogicOp get_vk_logic_op(LogicOp op);
 		VkBorderColor get_vk_border_colour(TextureBorderColour border_colour);
 		VkCullModeFlagBits get_vk_cull_mode(CullMode cull);
+		VkPipelineStageFlags get_vk_resource_state_stages(RenderResourceState state);
+		VkAccessFlags get_vk_resource_state_access(RenderResourceState state);
 	}
 }
 #endif // VK_UTIL_H_
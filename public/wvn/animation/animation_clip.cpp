@@ -0,0 +1,466 @@
+#include <wvn/animation/animation_clip.h>
+#include <wvn/maths/calc.h>
+#include <wvn/maths/simd.h>
+
+using namespace wvn;
+using namespace wvn::anim;
+
+// rotations keep 15 bits for each of their three smallest components, which are all within +-1/sqrt(2)
+static constexpr float ROTATION_QUANTIZE = 32767.0f;
+static constexpr float INV_SQRT_2 = 0.70710678118f;
+
+// how far the track is at 'frame' from the straight line between two of its frames
+static float interpolation_error(const float* values, u32 dims, bool rotation, bool euclidean, u32 a, u32 b, u32 frame)
+{
+	const float* va = values + (a * dims);
+	const float* vb = values + (b * dims);
+	const float* v = values + (frame * dims);
+
+	float alpha = (float)(frame - a) / (float)(b - a);
+	float lerped[4];
+
+	for (u32 c = 0; c < dims; c++) {
+		lerped[c] = va[c] + ((vb[c] - va[c]) * alpha);
+	}
+
+	if (rotation)
+	{
+		float len2 = 0.0f;
+
+		for (u32 c = 0; c < 4; c++) {
+			len2 += lerped[c] * lerped[c];
+		}
+
+		float inv_len = 1.0f / CalcF::sqrt(len2);
+		float dist2 = 0.0f;
+
+		for (u32 c = 0; c < 4; c++)
+		{
+			float diff = (lerped[c] * inv_len) - v[c];
+			dist2 += diff * diff;
+		}
+
+		// angle between the two rotations, from the chord rather than acos(dot) as that loses too much precision near zero
+		return 4.0f * CalcF::asin(CalcF::min(CalcF::sqrt(dist2) * 0.5f, 1.0f));
+	}
+
+	float error = 0.0f;
+
+	for (u32 c = 0; c < dims; c++)
+	{
+		float diff = lerped[c] - v[c];
+		error = euclidean ? error + (diff * diff) : CalcF::max(error, CalcF::abs(diff));
+	}
+
+	return euclidean ? CalcF::sqrt(error) : error;
+}
+
+AnimationClip::AnimationClip()
+	: m_tracks()
+	, m_frames()
+	, m_values()
+	, m_sample_rate(30.0f)
+	, m_frame_count(0)
+	, m_joint_count(0)
+{
+}
+
+AnimationClip::~AnimationClip()
+{
+}
+
+void AnimationClip::compress(const RawClip& raw, const ClipCompression& settings)
+{
+	wvn_ASSERT(raw.frame_count > 0 && raw.frame_count <= 0xFFFF, "[ANIMATION CLIP|DEBUG] Frame count must be between 1 and 65535.");
+	wvn_ASSERT(raw.sample_rate > 0.0f, "[ANIMATION CLIP|DEBUG] Sample rate must be positive.");
+	wvn_ASSERT(raw.positions.size() == raw.frame_count * raw.joint_count, "[ANIMATION CLIP|DEBUG] Must have a position for every joint on every frame.");
+	wvn_ASSERT(raw.rotations.size() == raw.frame_count * raw.joint_count, "[ANIMATION CLIP|DEBUG] Must have a rotation for every joint on every frame.");
+	wvn_ASSERT(raw.scales.size() == raw.frame_count * raw.joint_count, "[ANIMATION CLIP|DEBUG] Must have a scale for every joint on every frame.");
+
+	m_tracks.clear();
+	m_frames.clear();
+	m_values.clear();
+
+	m_sample_rate = raw.sample_rate;
+	m_frame_count = raw.frame_count;
+	m_joint_count = raw.joint_count;
+
+	for (u16 j = 0; j < raw.joint_count; j++)
+	{
+		add_track(TRACK_POSITION, raw.positions[j].data, raw.joint_count * 3, settings.position_tolerance);
+		add_track(TRACK_ROTATION, raw.rotations[j].data, raw.joint_count * 4, settings.rotation_tolerance);
+		add_track(TRACK_SCALE, raw.scales[j].data, raw.joint_count * 3, settings.scale_tolerance);
+	}
+}
+
+void AnimationClip::add_track(TrackType type, const float* values, u32 stride, float tolerance)
+{
+	bool rotation = type == TRACK_ROTATION;
+	bool euclidean = type == TRACK_POSITION;
+	u32 dims = rotation ? 4 : 3;
+	u32 count = m_frame_count;
+
+	// this joint's frames packed together
+	Vector<float> track(count * dims);
+
+	for (u32 f = 0; f < count; f++)
+	{
+		for (u32 c = 0; c < dims; c++) {
+			track[(f * dims) + c] = values[(f * stride) + c];
+		}
+	}
+
+	if (rotation)
+	{
+		// the error measure further down only holds for unit rotations, which importers don't always give us
+		for (u32 f = 0; f < count; f++)
+		{
+			float* cur = &track[f * 4];
+			float len = CalcF::sqrt((cur[0] * cur[0]) + (cur[1] * cur[1]) + (cur[2] * cur[2]) + (cur[3] * cur[3]));
+
+			for (u32 c = 0; c < 4; c++) {
+				cur[c] /= len;
+			}
+		}
+
+		// keep consecutive rotations on the same side so interpolating between keys takes the short way
+		for (u32 f = 1; f < count; f++)
+		{
+			float* prev = &track[(f - 1) * 4];
+			float* cur = &track[f * 4];
+
+			if ((prev[0] * cur[0]) + (prev[1] * cur[1]) + (prev[2] * cur[2]) + (prev[3] * cur[3]) < 0.0f)
+			{
+				for (u32 c = 0; c < 4; c++) {
+					cur[c] = -cur[c];
+				}
+			}
+		}
+	}
+
+	// keyframe reduction: from each key, reach as far ahead as a straight line stays within tolerance of every frame it skips
+	Vector<u32> keys;
+	keys.push_back(0);
+
+	bool constant = true;
+
+	for (u32 f = 1; f < count && constant; f++)
+	{
+		float error = 0.0f;
+
+		for (u32 c = 0; c < dims; c++) {
+			error = CalcF::max(error, CalcF::abs(track[(f * dims) + c] - track[c]));
+		}
+
+		constant = error <= tolerance * 0.5f;
+	}
+
+	if (!constant)
+	{
+		u32 key = 0;
+
+		while (key < count - 1)
+		{
+			u32 next = key + 1;
+
+			for (u32 candidate = key + 2; candidate < count; candidate++)
+			{
+				bool fits = true;
+
+				for (u32 f = key + 1; f < candidate && fits; f++) {
+					fits = interpolation_error(track.data(), dims, rotation, euclidean, key, candidate, f) <= tolerance;
+				}
+
+				if (!fits) {
+					break;
+				}
+
+				next = candidate;
+			}
+
+			keys.push_back(next);
+			key = next;
+		}
+	}
+
+	Track result = {};
+	result.first_key = m_frames.size();
+	result.key_count = keys.size();
+
+	if (rotation)
+	{
+		for (u32 key : keys)
+		{
+			const float* q = &track[key * 4];
+			u32 largest = 0;
+
+			for (u32 c = 1; c < 4; c++)
+			{
+				if (CalcF::abs(q[c]) > CalcF::abs(q[largest])) {
+					largest = c;
+				}
+			}
+
+			// with the largest made positive it can be rebuilt from the other three without its sign
+			float sign = (q[largest] < 0.0f) ? -1.0f : 1.0f;
+			u16 packed[3];
+			u32 n = 0;
+
+			for (u32 c = 0; c < 4; c++)
+			{
+				if (c == largest) {
+					continue;
+				}
+
+				float s = CalcF::clamp(q[c] * sign, -INV_SQRT_2, INV_SQRT_2);
+				packed[n++] = (u16)((((s / INV_SQRT_2) + 1.0f) * 0.5f * ROTATION_QUANTIZE) + 0.5f);
+			}
+
+			// which one was dropped goes in the spare top bits of the first two
+			packed[0] |= (u16)((largest & 1) << 15);
+			packed[1] |= (u16)((largest >> 1) << 15);
+
+			m_frames.push_back(key);
+			m_values.push_back(packed[0]);
+			m_values.push_back(packed[1]);
+			m_values.push_back(packed[2]);
+		}
+	}
+	else
+	{
+		for (u32 c = 0; c < 3; c++)
+		{
+			float mn = track[(keys[0] * 3) + c];
+			float mx = mn;
+
+			for (u32 key : keys)
+			{
+				mn = CalcF::min(mn, track[(key * 3) + c]);
+				mx = CalcF::max(mx, track[(key * 3) + c]);
+			}
+
+			result.offset[c] = mn;
+			result.scale[c] = (mx - mn) / 65535.0f;
+		}
+
+		for (u32 key : keys)
+		{
+			m_frames.push_back(key);
+
+			for (u32 c = 0; c < 3; c++)
+			{
+				float v = track[(key * 3) + c] - result.offset[c];
+				m_values.push_back((result.scale[c] > 0.0f) ? (u16)CalcF::clamp((v / result.scale[c]) + 0.5f, 0.0f, 65535.0f) : 0);
+			}
+		}
+	}
+
+	m_tracks.push_back(result);
+}
+
+void AnimationClip::find_keys(const Track& track, float frame, u32& key_a, u32& key_b, float& frame_a, float& frame_b) const
+{
+	const u16* frames = m_frames.data() + track.first_key;
+
+	// first key after the frame
+	u32 lo = 1;
+	u32 hi = track.key_count;
+
+	while (lo < hi)
+	{
+		u32 mid = (lo + hi) / 2;
+
+		if ((float)frames[mid] <= frame) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	u32 a = lo - 1;
+	u32 b = (lo < track.key_count) ? lo : a;
+
+	key_a = track.first_key + a;
+	key_b = track.first_key + b;
+	frame_a = frames[a];
+	frame_b = frames[b];
+}
+
+void AnimationClip::sample(JointTransform4* dst, float time) const
+{
+	float frame = CalcF::clamp(time * m_sample_rate, 0.0f, (float)(m_frame_count - 1));
+
+	simd::Float4 frame4 = simd::splat(frame);
+	simd::Float4 zero = simd::splat(0.0f);
+	simd::Float4 one = simd::splat(1.0f);
+
+	for (u32 b = 0; b < pose_block_count(m_joint_count); b++)
+	{
+		JointTransform4& out = dst[b];
+		u32 n = CalcU::min(m_joint_count - (b * 4), 4);
+
+		for (u32 type = 0; type < TRACK_MAX_ENUM; type++)
+		{
+			// the keys either side of the frame for each of the four joints, gathered into lanes
+			alignas(16) float qa[3][4];
+			alignas(16) float qb[3][4];
+			alignas(16) float offset[3][4];
+			alignas(16) float scale[3][4];
+			alignas(16) float largest_a[4];
+			alignas(16) float largest_b[4];
+			alignas(16) float fa[4];
+			alignas(16) float fb[4];
+
+			for (u32 k = 0; k < 4; k++)
+			{
+				if (k >= n)
+				{
+					// unused lanes come out as the identity
+					float identity = (type == TRACK_SCALE) ? 1.0f : 0.0f;
+					float zero_rotation = ROTATION_QUANTIZE * 0.5f;
+
+					for (u32 c = 0; c < 3; c++)
+					{
+						qa[c][k] = qb[c][k] = (type == TRACK_ROTATION) ? zero_rotation : 0.0f;
+						offset[c][k] = identity;
+						scale[c][k] = 0.0f;
+					}
+
+					largest_a[k] = largest_b[k] = 0.0f;
+					fa[k] = fb[k] = 0.0f;
+
+					continue;
+				}
+
+				const Track& track = m_tracks[((b * 4) + k) * TRACK_MAX_ENUM + type];
+
+				u32 key_a = 0, key_b = 0;
+				find_keys(track, frame, key_a, key_b, fa[k], fb[k]);
+
+				const u16* va = m_values.data() + (key_a * 3);
+				const u16* vb = m_values.data() + (key_b * 3);
+
+				if (type == TRACK_ROTATION)
+				{
+					for (u32 c = 0; c < 3; c++)
+					{
+						qa[c][k] = (float)(va[c] & 0x7FFF);
+						qb[c][k] = (float)(vb[c] & 0x7FFF);
+					}
+
+					largest_a[k] = (float)((va[0] >> 15) | ((va[1] >> 15) << 1));
+					largest_b[k] = (float)((vb[0] >> 15) | ((vb[1] >> 15) << 1));
+				}
+				else
+				{
+					for (u32 c = 0; c < 3; c++)
+					{
+						qa[c][k] = (float)va[c];
+						qb[c][k] = (float)vb[c];
+						offset[c][k] = track.offset[c];
+						scale[c][k] = track.scale[c];
+					}
+				}
+			}
+
+			simd::Float4 alpha = simd::div(
+				simd::sub(frame4, simd::load(fa)),
+				simd::max(simd::sub(simd::load(fb), simd::load(fa)), one)
+			);
+
+			if (type != TRACK_ROTATION)
+			{
+				float* dst_components[2][3] = {
+					{ out.tx, out.ty, out.tz },
+					{ out.sx, out.sy, out.sz }
+				};
+
+				for (u32 c = 0; c < 3; c++)
+				{
+					simd::Float4 off = simd::load(offset[c]);
+					simd::Float4 scl = simd::load(scale[c]);
+
+					simd::Float4 a = simd::madd(simd::load(qa[c]), scl, off);
+					simd::Float4 v = simd::madd(simd::sub(simd::madd(simd::load(qb[c]), scl, off), a), alpha, a);
+
+					simd::store(dst_components[type == TRACK_SCALE][c], v);
+				}
+
+				continue;
+			}
+
+			// three smallest back to [-1/sqrt(2), 1/sqrt(2)], the largest from the unit length, then everything back in its place
+			simd::Float4 dequant_scale = simd::splat((2.0f / ROTATION_QUANTIZE) * INV_SQRT_2);
+			simd::Float4 dequant_offset = simd::splat(-INV_SQRT_2);
+
+			simd::Float4 quats[2][4];
+			const float (*packed[2])[4] = { qa, qb };
+			const float* largest[2] = { largest_a, largest_b };
+
+			for (u32 i = 0; i < 2; i++)
+			{
+				simd::Float4 s0 = simd::madd(simd::load(packed[i][0]), dequant_scale, dequant_offset);
+				simd::Float4 s1 = simd::madd(simd::load(packed[i][1]), dequant_scale, dequant_offset);
+				simd::Float4 s2 = simd::madd(simd::load(packed[i][2]), dequant_scale, dequant_offset);
+
+				simd::Float4 rest = simd::madd(s0, s0, simd::madd(s1, s1, simd::mul(s2, s2)));
+				simd::Float4 d = simd::sqrt(simd::max(simd::sub(one, rest), zero));
+
+				simd::Float4 l = simd::load(largest[i]);
+				simd::Mask4 is_0 = simd::less(l, simd::splat(0.5f));
+				simd::Mask4 below_2 = simd::less(l, simd::splat(1.5f));
+				simd::Mask4 below_3 = simd::less(l, simd::splat(2.5f));
+
+				quats[i][0] = simd::select(is_0, d, s0);
+				quats[i][1] = simd::select(is_0, s0, simd::select(below_2, d, s1));
+				quats[i][2] = simd::select(below_2, s1, simd::select(below_3, d, s2));
+				quats[i][3] = simd::select(below_3, s2, d);
+			}
+
+			// nlerp, flipping the second key onto the same side as the first
+			simd::Float4 dot = simd::mul(quats[0][0], quats[1][0]);
+			dot = simd::madd(quats[0][1], quats[1][1], dot);
+			dot = simd::madd(quats[0][2], quats[1][2], dot);
+			dot = simd::madd(quats[0][3], quats[1][3], dot);
+
+			simd::Float4 alpha_b = simd::select(simd::less(dot, zero), simd::sub(zero, alpha), alpha);
+			simd::Float4 alpha_a = simd::sub(one, alpha);
+
+			simd::Float4 r[4];
+			simd::Float4 len2 = zero;
+
+			for (u32 c = 0; c < 4; c++)
+			{
+				r[c] = simd::madd(quats[1][c], alpha_b, simd::mul(quats[0][c], alpha_a));
+				len2 = simd::madd(r[c], r[c], len2);
+			}
+
+			simd::Float4 inv_len = simd::div(one, simd::sqrt(len2));
+
+			simd::store(out.rw, simd::mul(r[0], inv_len));
+			simd::store(out.rx, simd::mul(r[1], inv_len));
+			simd::store(out.ry, simd::mul(r[2], inv_len));
+			simd::store(out.rz, simd::mul(r[3], inv_len));
+		}
+	}
+}
+
+float AnimationClip::duration() const
+{
+	return (m_frame_count > 0) ? (float)(m_frame_count - 1) / m_sample_rate : 0.0f;
+}
+
+u16 AnimationClip::joint_count() const
+{
+	return m_joint_count;
+}
+
+u64 AnimationClip::key_count() const
+{
+	return m_frames.size();
+}
+
+u64 AnimationClip::size_in_bytes() const
+{
+	return (m_tracks.size() * sizeof(Track)) + (m_frames.size() * sizeof(u16)) + (m_values.size() * sizeof(u16));
+}
@@ -0,0 +1,94 @@
+#ifndef ANIMATION_CLIP_H_
+#define ANIMATION_CLIP_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/animation/pose.h>
+
+namespace wvn::anim
+{
+	/**
+	 * Uncompressed animation straight out of an importer, sampled at a fixed rate.
+	 * Frame f of joint j is at [(f * joint_count) + j] in each array.
+	 */
+	struct RawClip
+	{
+		float sample_rate = 30.0f;
+		u32 frame_count = 0;
+		u16 joint_count = 0;
+
+		Vector<Vec3F> positions;
+		Vector<Quat> rotations;
+		Vector<Vec3F> scales;
+	};
+
+	/**
+	 * How far a compressed clip is allowed to drift from the raw one.
+	 */
+	struct ClipCompression
+	{
+		float position_tolerance = 0.001f;
+		float rotation_tolerance = 0.001f; // in radians
+		float scale_tolerance = 0.001f;
+	};
+
+	/**
+	 * Compressed animation of every joint in a skeleton.
+	 * Each joint has a position, rotation and scale track, from which any keys that can be linearly
+	 * interpolated from their neighbours within tolerance are dropped (so a track that never moves keeps just one).
+	 * The remaining keys are quantized to 16 bits per component: positions and scales over the range
+	 * of their track, and rotations as the three smallest components with the largest rebuilt from them.
+	 */
+	class AnimationClip
+	{
+	public:
+		AnimationClip();
+		~AnimationClip();
+
+		void compress(const RawClip& raw, const ClipCompression& settings = ClipCompression());
+
+		// local pose of every joint at 'time' seconds, clamped to the length of the clip
+		void sample(JointTransform4* dst, float time) const;
+
+		float duration() const;
+		u16 joint_count() const;
+
+		u64 key_count() const;
+		u64 size_in_bytes() const;
+
+	private:
+		enum TrackType
+		{
+			TRACK_POSITION,
+			TRACK_ROTATION,
+			TRACK_SCALE,
+
+			TRACK_MAX_ENUM
+		};
+
+		struct Track
+		{
+			u32 first_key;
+			u32 key_count;
+
+			// dequantized value = offset + (quantized * scale), unused by rotations
+			float offset[3];
+			float scale[3];
+		};
+
+		void add_track(TrackType type, const float* values, u32 stride, float tolerance);
+
+		// the keys either side of 'frame', and the frames they're on
+		void find_keys(const Track& track, float frame, u32& key_a, u32& key_b, float& frame_a, float& frame_b) const;
+
+		Vector<Track> m_tracks; // TRACK_MAX_ENUM per joint, in joint order
+		Vector<u16> m_frames; // frame each key is on
+		Vector<u16> m_values; // three per key
+
+		float m_sample_rate;
+		u32 m_frame_count;
+		u16 m_joint_count;
+	};
+}
+
+#endif // ANIMATION_CLIP_H_
@@ -1,5 +1,10 @@
 #include <wvn/animation/animation_mgr.h>
 #include <wvn/devenv/log_mgr.h>
+#include <wvn/root.h>
+#include <wvn/maths/calc.h>
+#include <wvn/time.h>
+
+#include <chrono>
 
 using namespace wvn;
 using namespace wvn::anim;
@@ -7,15 +12,114 @@ using namespace wvn::anim;
 wvn_IMPL_SINGLETON(AnimationMgr);
 
 AnimationMgr::AnimationMgr()
+	: m_tweens()
+	, m_animators()
+	, m_animator_time_ms(0.0)
+	, m_worker_pool(Root::get_singleton()->worker_pool())
+	, m_thread_count(MAX_THREADS)
+	, m_next_job(0)
 {
 	dev::LogMgr::get_singleton()->print("[ANIMATION] Initialized!");
 }
 
 AnimationMgr::~AnimationMgr()
 {
+	for (auto& animator : m_animators) {
+		delete animator;
+	}
+
 	dev::LogMgr::get_singleton()->print("[ANIMATION] Destroyed!");
 }
 
 void AnimationMgr::tick()
 {
+	// tweens first, as they might be driving layer weights
+	m_tweens.update(time::delta);
+	update_animators(time::delta);
+}
+
+TweenSystem& AnimationMgr::tweens()
+{
+	return m_tweens;
+}
+
+Animator* AnimationMgr::create_animator(const Skeleton* skeleton)
+{
+	Animator* animator = new Animator(skeleton);
+	m_animators.push_back(animator);
+	return animator;
+}
+
+void AnimationMgr::destroy_animator(Animator* animator)
+{
+	for (u64 i = 0; i < m_animators.size(); i++)
+	{
+		if (m_animators[i] != animator) {
+			continue;
+		}
+
+		// order doesn't matter, so swap with the back rather than shuffle everything down
+		m_animators[i] = m_animators.back();
+		m_animators.pop_back();
+
+		delete animator;
+		return;
+	}
+
+	wvn_ERROR("[ANIMATION|DEBUG] Animator was not created by the animation manager.");
+}
+
+void AnimationMgr::update_animators(float dt)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	if (CalcU::min(m_thread_count, m_worker_pool->thread_count()) <= 1 || m_animators.size() < MIN_ANIMATORS_FOR_THREADING)
+	{
+		for (auto& animator : m_animators) {
+			animator->update(dt);
+		}
+	}
+	else
+	{
+		m_next_job = 0;
+		m_worker_pool->run(m_thread_count, [this, dt](u32) { run_jobs(dt); });
+	}
+
+	m_animator_time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void AnimationMgr::set_thread_count(u32 thread_count)
+{
+	m_thread_count = CalcU::clamp(thread_count, 1, MAX_THREADS);
+}
+
+u32 AnimationMgr::thread_count() const
+{
+	return m_thread_count;
+}
+
+double AnimationMgr::animator_time_ms() const
+{
+	return m_animator_time_ms;
+}
+
+// characters cost about the same as each other but not exactly, so threads take small batches until they run out
+void AnimationMgr::run_jobs(float dt)
+{
+	u32 count = m_animators.size();
+
+	while (true)
+	{
+		u32 begin = m_next_job.fetch_add(ANIMATORS_PER_JOB);
+
+		if (begin >= count) {
+			return;
+		}
+
+		u32 end = CalcU::min(begin + ANIMATORS_PER_JOB, count);
+
+		for (u32 i = begin; i < end; i++) {
+			m_animators[i]->update(dt);
+		}
+	}
 }
@@ -1,7 +1,13 @@
 #ifndef ANIMATION_MGR_H_
 #define ANIMATION_MGR_H_
 
+#include <atomic>
+
 #include <wvn/singleton.h>
+#include <wvn/container/vector.h>
+#include <wvn/system/worker_pool.h>
+#include <wvn/animation/tween_system.h>
+#include <wvn/animation/animator.h>
 
 namespace wvn::anim
 {
@@ -14,10 +20,41 @@ namespace wvn::anim
 		wvn_DEF_SINGLETON(AnimationMgr);
 
 	public:
+		static constexpr u32 MAX_THREADS = sys::WorkerPool::MAX_THREADS;
+		static constexpr u32 MIN_ANIMATORS_FOR_THREADING = 16;
+		static constexpr u32 ANIMATORS_PER_JOB = 8;
+
 		AnimationMgr();
 		~AnimationMgr();
 
 		void tick();
+
+		TweenSystem& tweens();
+
+		// updated every tick() until destroyed, the skeleton has to outlive it
+		Animator* create_animator(const Skeleton* skeleton);
+		void destroy_animator(Animator* animator);
+
+		void update_animators(float dt);
+
+		// at most this many of the shared pool's threads are used, including the one calling tick()
+		void set_thread_count(u32 thread_count);
+		u32 thread_count() const;
+
+		double animator_time_ms() const;
+
+	private:
+		void run_jobs(float dt);
+
+		TweenSystem m_tweens;
+
+		Vector<Animator*> m_animators;
+
+		double m_animator_time_ms;
+
+		sys::WorkerPool* m_worker_pool;
+		u32 m_thread_count;
+		std::atomic<u32> m_next_job;
 	};
 }
 
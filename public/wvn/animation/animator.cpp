@@ -0,0 +1,143 @@
+#include <wvn/animation/animator.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::anim;
+
+Animator::Animator(const Skeleton* skeleton)
+	: m_skeleton(skeleton)
+	, m_layers()
+	, m_samples()
+	, m_local(pose_block_count(skeleton->joint_count()), JointTransform4::identity())
+	, m_model(skeleton->joint_count(), Affine3D::identity())
+	, m_skinning(skeleton->joint_count(), Affine3D::identity())
+	, m_root(Affine3D::identity())
+{
+	for (u32 i = 0; i < MAX_LAYERS; i++) {
+		m_layers[i] = { nullptr, nullptr, 0.0f, 1.0f, 0.0f, false };
+	}
+}
+
+Animator::~Animator()
+{
+}
+
+void Animator::play(u32 layer, const AnimationClip* clip, float weight, bool loop, float speed)
+{
+	wvn_ASSERT(layer < MAX_LAYERS, "[ANIMATOR|DEBUG] Layer must be less than MAX_LAYERS.");
+	wvn_ASSERT(clip->joint_count() == m_skeleton->joint_count(), "[ANIMATOR|DEBUG] Clip must be for the same skeleton.");
+
+	m_layers[layer] = { clip, m_layers[layer].joint_weights, 0.0f, speed, weight, loop };
+
+	if (m_samples[layer].empty()) {
+		m_samples[layer] = Vector<JointTransform4>(pose_block_count(m_skeleton->joint_count()), JointTransform4::identity());
+	}
+}
+
+void Animator::stop(u32 layer)
+{
+	m_layers[layer].clip = nullptr;
+}
+
+void Animator::set_weight(u32 layer, float weight)
+{
+	m_layers[layer].weight = weight;
+}
+
+void Animator::set_speed(u32 layer, float speed)
+{
+	m_layers[layer].speed = speed;
+}
+
+void Animator::set_time(u32 layer, float time)
+{
+	m_layers[layer].time = time;
+}
+
+void Animator::set_joint_weights(u32 layer, const float* weights)
+{
+	m_layers[layer].joint_weights = weights;
+}
+
+float Animator::weight(u32 layer) const
+{
+	return m_layers[layer].weight;
+}
+
+float Animator::time(u32 layer) const
+{
+	return m_layers[layer].time;
+}
+
+void Animator::set_root(const Affine3D& root)
+{
+	m_root = root;
+}
+
+void Animator::update(float dt)
+{
+	BlendLayer blend[MAX_LAYERS];
+	u32 blend_count = 0;
+
+	for (u32 i = 0; i < MAX_LAYERS; i++)
+	{
+		Layer& layer = m_layers[i];
+
+		if (!layer.clip) {
+			continue;
+		}
+
+		float duration = layer.clip->duration();
+		layer.time += dt * layer.speed;
+
+		if (layer.loop && duration > 0.0f)
+		{
+			layer.time = CalcF::mod(layer.time, duration);
+
+			if (layer.time < 0.0f) {
+				layer.time += duration;
+			}
+		}
+		else
+		{
+			layer.time = CalcF::clamp(layer.time, 0.0f, duration);
+		}
+
+		// faded out layers still keep time, but there's no point sampling them
+		if (layer.weight <= 0.0f) {
+			continue;
+		}
+
+		layer.clip->sample(m_samples[i].data(), layer.time);
+		blend[blend_count++] = { m_samples[i].data(), layer.weight, layer.joint_weights };
+	}
+
+	blend_poses(m_local.data(), blend, blend_count, m_skeleton->rest_pose(), m_skeleton->joint_count());
+	local_to_model(m_model.data(), m_local.data(), m_skeleton->parents(), m_skeleton->joint_count(), m_root);
+
+	const Affine3D* inverse_bind = m_skeleton->inverse_bind();
+
+	for (u32 i = 0; i < m_skeleton->joint_count(); i++) {
+		m_skinning[i] = inverse_bind[i] * m_model[i];
+	}
+}
+
+const Skeleton* Animator::skeleton() const
+{
+	return m_skeleton;
+}
+
+const JointTransform4* Animator::local_pose() const
+{
+	return m_local.data();
+}
+
+const Affine3D* Animator::model_matrices() const
+{
+	return m_model.data();
+}
+
+const Affine3D* Animator::skinning_matrices() const
+{
+	return m_skinning.data();
+}
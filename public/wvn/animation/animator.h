@@ -0,0 +1,78 @@
+#ifndef ANIMATOR_H_
+#define ANIMATOR_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/animation/pose.h>
+#include <wvn/animation/skeleton.h>
+#include <wvn/animation/animation_clip.h>
+
+namespace wvn::anim
+{
+	/**
+	 * Plays and blends clips on one instance of a skeleton.
+	 * update() only touches the animator's own buffers and reads the (shared) skeleton and clips,
+	 * so different animators can be updated on different threads at once.
+	 */
+	class Animator
+	{
+	public:
+		constexpr static u32 MAX_LAYERS = 4;
+
+		Animator(const Skeleton* skeleton);
+		~Animator();
+
+		void play(u32 layer, const AnimationClip* clip, float weight = 1.0f, bool loop = true, float speed = 1.0f);
+		void stop(u32 layer);
+
+		void set_weight(u32 layer, float weight);
+		void set_speed(u32 layer, float speed);
+		void set_time(u32 layer, float time);
+
+		// one weight per joint for partial body layers, or nullptr for the whole body, must outlive the animator
+		void set_joint_weights(u32 layer, const float* weights);
+
+		float weight(u32 layer) const;
+		float time(u32 layer) const;
+
+		// position of the skeleton's roots in model space
+		void set_root(const Affine3D& root);
+
+		// moves every layer on by dt and works out the new pose
+		void update(float dt);
+
+		const Skeleton* skeleton() const;
+
+		const JointTransform4* local_pose() const;
+
+		// every joint's transform in model space
+		const Affine3D* model_matrices() const;
+
+		// inverse bind * model, ready to skin vertices with
+		const Affine3D* skinning_matrices() const;
+
+	private:
+		struct Layer
+		{
+			const AnimationClip* clip;
+			const float* joint_weights;
+			float time;
+			float speed;
+			float weight;
+			bool loop;
+		};
+
+		const Skeleton* m_skeleton;
+
+		Layer m_layers[MAX_LAYERS];
+		Vector<JointTransform4> m_samples[MAX_LAYERS];
+
+		Vector<JointTransform4> m_local;
+		Vector<Affine3D> m_model;
+		Vector<Affine3D> m_skinning;
+
+		Affine3D m_root;
+	};
+}
+
+#endif // ANIMATOR_H_
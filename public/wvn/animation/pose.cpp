@@ -0,0 +1,234 @@
+#include <wvn/animation/pose.h>
+#include <wvn/maths/simd.h>
+
+using namespace wvn;
+using namespace wvn::anim;
+
+void JointTransform4::set(u32 lane, const Vec3F& position, const Quat& rotation, const Vec3F& scale)
+{
+	tx[lane] = position.x;
+	ty[lane] = position.y;
+	tz[lane] = position.z;
+
+	rw[lane] = rotation.w;
+	rx[lane] = rotation.x;
+	ry[lane] = rotation.y;
+	rz[lane] = rotation.z;
+
+	sx[lane] = scale.x;
+	sy[lane] = scale.y;
+	sz[lane] = scale.z;
+}
+
+Vec3F JointTransform4::position(u32 lane) const
+{
+	return Vec3F(tx[lane], ty[lane], tz[lane]);
+}
+
+Quat JointTransform4::rotation(u32 lane) const
+{
+	return Quat(rw[lane], rx[lane], ry[lane], rz[lane]);
+}
+
+Vec3F JointTransform4::scale(u32 lane) const
+{
+	return Vec3F(sx[lane], sy[lane], sz[lane]);
+}
+
+const JointTransform4& JointTransform4::identity()
+{
+	static const JointTransform4 IDENTITY = {
+		{ 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f },
+		{ 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f },
+		{ 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }
+	};
+
+	return IDENTITY;
+}
+
+void anim::blend_poses(JointTransform4* dst, const BlendLayer* layers, u32 layer_count, const JointTransform4* rest, u32 joint_count)
+{
+	simd::Float4 zero = simd::splat(0.0f);
+	simd::Float4 one = simd::splat(1.0f);
+
+	for (u32 b = 0; b < pose_block_count(joint_count); b++)
+	{
+		const JointTransform4& r = rest[b];
+
+		simd::Float4 rest_rw = simd::load(r.rw);
+		simd::Float4 rest_rx = simd::load(r.rx);
+		simd::Float4 rest_ry = simd::load(r.ry);
+		simd::Float4 rest_rz = simd::load(r.rz);
+
+		simd::Float4 tx = zero, ty = zero, tz = zero;
+		simd::Float4 rw = zero, rx = zero, ry = zero, rz = zero;
+		simd::Float4 sx = zero, sy = zero, sz = zero;
+		simd::Float4 total = zero;
+
+		for (u32 i = 0; i < layer_count; i++)
+		{
+			const BlendLayer& layer = layers[i];
+			const JointTransform4& p = layer.pose[b];
+
+			simd::Float4 w = simd::splat(layer.weight);
+
+			if (layer.joint_weights)
+			{
+				float jw[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+				for (u32 k = 0; k < 4 && (b * 4) + k < joint_count; k++) {
+					jw[k] = layer.joint_weights[(b * 4) + k];
+				}
+
+				w = simd::mul(w, simd::loadu(jw));
+			}
+
+			simd::Float4 qw = simd::load(p.rw);
+			simd::Float4 qx = simd::load(p.rx);
+			simd::Float4 qy = simd::load(p.ry);
+			simd::Float4 qz = simd::load(p.rz);
+
+			// q and -q are the same rotation, so flip anything on the other side of what's been added so far
+			simd::Float4 dot = simd::mul(qw, rw);
+			dot = simd::madd(qx, rx, dot);
+			dot = simd::madd(qy, ry, dot);
+			dot = simd::madd(qz, rz, dot);
+
+			simd::Float4 rot_w = simd::select(simd::less(dot, zero), simd::sub(zero, w), w);
+
+			tx = simd::madd(simd::load(p.tx), w, tx);
+			ty = simd::madd(simd::load(p.ty), w, ty);
+			tz = simd::madd(simd::load(p.tz), w, tz);
+
+			rw = simd::madd(qw, rot_w, rw);
+			rx = simd::madd(qx, rot_w, rx);
+			ry = simd::madd(qy, rot_w, ry);
+			rz = simd::madd(qz, rot_w, rz);
+
+			sx = simd::madd(simd::load(p.sx), w, sx);
+			sy = simd::madd(simd::load(p.sy), w, sy);
+			sz = simd::madd(simd::load(p.sz), w, sz);
+
+			total = simd::add(total, w);
+		}
+
+		// the rest pose fills in whatever the layers didn't cover
+		simd::Float4 rest_w = simd::max(simd::sub(one, total), zero);
+
+		simd::Float4 rest_dot = simd::mul(rest_rw, rw);
+		rest_dot = simd::madd(rest_rx, rx, rest_dot);
+		rest_dot = simd::madd(rest_ry, ry, rest_dot);
+		rest_dot = simd::madd(rest_rz, rz, rest_dot);
+
+		simd::Float4 rest_rot_w = simd::select(simd::less(rest_dot, zero), simd::sub(zero, rest_w), rest_w);
+
+		tx = simd::madd(simd::load(r.tx), rest_w, tx);
+		ty = simd::madd(simd::load(r.ty), rest_w, ty);
+		tz = simd::madd(simd::load(r.tz), rest_w, tz);
+
+		rw = simd::madd(rest_rw, rest_rot_w, rw);
+		rx = simd::madd(rest_rx, rest_rot_w, rx);
+		ry = simd::madd(rest_ry, rest_rot_w, ry);
+		rz = simd::madd(rest_rz, rest_rot_w, rz);
+
+		sx = simd::madd(simd::load(r.sx), rest_w, sx);
+		sy = simd::madd(simd::load(r.sy), rest_w, sy);
+		sz = simd::madd(simd::load(r.sz), rest_w, sz);
+
+		// weights adding up to more than one are scaled back down
+		simd::Float4 inv_total = simd::div(one, simd::max(simd::add(total, rest_w), one));
+
+		simd::Float4 len2 = simd::mul(rw, rw);
+		len2 = simd::madd(rx, rx, len2);
+		len2 = simd::madd(ry, ry, len2);
+		len2 = simd::madd(rz, rz, len2);
+
+		simd::Float4 inv_len = simd::div(one, simd::sqrt(len2));
+
+		JointTransform4& d = dst[b];
+
+		simd::store(d.tx, simd::mul(tx, inv_total));
+		simd::store(d.ty, simd::mul(ty, inv_total));
+		simd::store(d.tz, simd::mul(tz, inv_total));
+
+		simd::store(d.rw, simd::mul(rw, inv_len));
+		simd::store(d.rx, simd::mul(rx, inv_len));
+		simd::store(d.ry, simd::mul(ry, inv_len));
+		simd::store(d.rz, simd::mul(rz, inv_len));
+
+		simd::store(d.sx, simd::mul(sx, inv_total));
+		simd::store(d.sy, simd::mul(sy, inv_total));
+		simd::store(d.sz, simd::mul(sz, inv_total));
+	}
+}
+
+// four local matrices at once, the same as Affine3D::create_transform() with no origin
+static void joint_matrices_4(Affine3D* out, const JointTransform4& joints)
+{
+	simd::Float4 qw = simd::load(joints.rw);
+	simd::Float4 qx = simd::load(joints.rx);
+	simd::Float4 qy = simd::load(joints.ry);
+	simd::Float4 qz = simd::load(joints.rz);
+
+	simd::Float4 sx = simd::load(joints.sx);
+	simd::Float4 sy = simd::load(joints.sy);
+	simd::Float4 sz = simd::load(joints.sz);
+
+	simd::Float4 one = simd::splat(1.0f);
+	simd::Float4 two = simd::splat(2.0f);
+
+	simd::Float4 xx = simd::mul(qx, qx), yy = simd::mul(qy, qy), zz = simd::mul(qz, qz);
+	simd::Float4 xy = simd::mul(qx, qy), xz = simd::mul(qx, qz), yz = simd::mul(qy, qz);
+	simd::Float4 xw = simd::mul(qx, qw), yw = simd::mul(qy, qw), zw = simd::mul(qz, qw);
+
+	simd::Float4 r11 = simd::sub(one, simd::mul(two, simd::add(yy, zz)));
+	simd::Float4 r12 = simd::mul(two, simd::sub(xy, zw));
+	simd::Float4 r13 = simd::mul(two, simd::add(xz, yw));
+	simd::Float4 r21 = simd::mul(two, simd::add(xy, zw));
+	simd::Float4 r22 = simd::sub(one, simd::mul(two, simd::add(xx, zz)));
+	simd::Float4 r23 = simd::mul(two, simd::sub(yz, xw));
+	simd::Float4 r31 = simd::mul(two, simd::sub(xz, yw));
+	simd::Float4 r32 = simd::mul(two, simd::add(yz, xw));
+	simd::Float4 r33 = simd::sub(one, simd::mul(two, simd::add(xx, yy)));
+
+	// in memory order: the basis column by column, then the origin
+	simd::Float4 m[12] = {
+		simd::mul(r11, sx), simd::mul(r21, sy), simd::mul(r31, sz),
+		simd::mul(r12, sx), simd::mul(r22, sy), simd::mul(r32, sz),
+		simd::mul(r13, sx), simd::mul(r23, sy), simd::mul(r33, sz),
+		simd::load(joints.tx), simd::load(joints.ty), simd::load(joints.tz)
+	};
+
+	for (int k = 0; k < 12; k += 4) {
+		simd::transpose(m[k + 0], m[k + 1], m[k + 2], m[k + 3]);
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		float* result = (float*)&out[i];
+
+		simd::store(result + 0, m[i + 0]);
+		simd::store(result + 4, m[i + 4]);
+		simd::store(result + 8, m[i + 8]);
+	}
+}
+
+void anim::local_to_model(Affine3D* dst, const JointTransform4* local, const u16* parents, u32 joint_count, const Affine3D& root)
+{
+	Affine3D matrices[4];
+
+	for (u32 b = 0; b < pose_block_count(joint_count); b++)
+	{
+		joint_matrices_4(matrices, local[b]);
+
+		for (u32 k = 0; k < 4 && (b * 4) + k < joint_count; k++)
+		{
+			u32 joint = (b * 4) + k;
+			u16 parent = parents[joint];
+
+			wvn_ASSERT(parent == NO_JOINT || parent < joint, "[POSE|DEBUG] Parents must come before their children.");
+
+			dst[joint] = matrices[k] * ((parent != NO_JOINT) ? dst[parent] : root);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#ifndef POSE_H_
+#define POSE_H_
+
+#include <wvn/common.h>
+#include <wvn/maths/vec3.h>
+#include <wvn/maths/quat.h>
+#include <wvn/maths/affine_3d.h>
+
+namespace wvn::anim
+{
+	// parent of a root joint, and what looking up a joint that doesn't exist gives back
+	constexpr u16 NO_JOINT = 0xFFFF;
+
+	/**
+	 * Local transforms of four joints stored side by side, so each component of all four
+	 * loads straight into one simd register. Joint i lives in block i / 4, lane i % 4.
+	 * A pose is just an array of these, with any lanes past the last joint left as the identity.
+	 */
+	struct alignas(16) JointTransform4
+	{
+		float tx[4];
+		float ty[4];
+		float tz[4];
+
+		float rw[4];
+		float rx[4];
+		float ry[4];
+		float rz[4];
+
+		float sx[4];
+		float sy[4];
+		float sz[4];
+
+		void set(u32 lane, const Vec3F& position, const Quat& rotation, const Vec3F& scale);
+
+		Vec3F position(u32 lane) const;
+		Quat rotation(u32 lane) const;
+		Vec3F scale(u32 lane) const;
+
+		static const JointTransform4& identity();
+	};
+
+	inline u32 pose_block_count(u32 joint_count) { return (joint_count + 3) / 4; }
+
+	/**
+	 * One pose going into blend_poses().
+	 * joint_weights, if not nullptr, scales the weight per joint (one float per joint) for partial body layers.
+	 */
+	struct BlendLayer
+	{
+		const JointTransform4* pose;
+		float weight;
+		const float* joint_weights;
+	};
+
+	/*
+	 * Weighted blend of several poses. Rotations are summed along the same hemisphere and renormalized.
+	 * Wherever the weights add up to less than one, the rest pose makes up the difference.
+	 * dst can be one of the layer poses.
+	 */
+	void blend_poses(JointTransform4* dst, const BlendLayer* layers, u32 layer_count, const JointTransform4* rest, u32 joint_count);
+
+	/*
+	 * Local joint transforms to model space, where each joint's matrix is its local one times its parent's.
+	 * Parents have to come before their children, and root joints are taken as relative to 'root'.
+	 */
+	void local_to_model(Affine3D* dst, const JointTransform4* local, const u16* parents, u32 joint_count, const Affine3D& root = Affine3D::identity());
+}
+
+#endif // POSE_H_
@@ -0,0 +1,87 @@
+#include <wvn/animation/skeleton.h>
+
+using namespace wvn;
+using namespace wvn::anim;
+
+Skeleton::Skeleton()
+	: m_names()
+	, m_parents()
+	, m_rest_pose()
+	, m_bind()
+	, m_inverse_bind()
+{
+}
+
+Skeleton::~Skeleton()
+{
+}
+
+u16 Skeleton::add_joint(const String& name, u16 parent, const Vec3F& position, const Quat& rotation, const Vec3F& scale)
+{
+	u16 joint = m_parents.size();
+
+	wvn_ASSERT(joint < NO_JOINT, "[SKELETON|DEBUG] Too many joints.");
+	wvn_ASSERT(parent == NO_JOINT || parent < joint, "[SKELETON|DEBUG] Parent must be added before its children.");
+
+	// a new block starts out as the identity so the unused lanes stay harmless
+	if (joint % 4 == 0) {
+		m_rest_pose.push_back(JointTransform4::identity());
+	}
+
+	// blending and the simd matrix build expect unit rotations
+	Quat unit_rotation = rotation.normalized();
+
+	m_rest_pose[joint / 4].set(joint % 4, position, unit_rotation, scale);
+
+	Affine3D local = Affine3D::create_transform(position, unit_rotation, scale, Vec3F::zero());
+	Affine3D bind = (parent != NO_JOINT) ? local * m_bind[parent] : local;
+
+	m_names.push_back(name);
+	m_parents.push_back(parent);
+	m_bind.push_back(bind);
+	m_inverse_bind.push_back(bind.inverse());
+
+	return joint;
+}
+
+u16 Skeleton::find_joint(const String& name) const
+{
+	for (u16 i = 0; i < m_names.size(); i++)
+	{
+		if (m_names[i] == name) {
+			return i;
+		}
+	}
+
+	return NO_JOINT;
+}
+
+u16 Skeleton::joint_count() const
+{
+	return m_parents.size();
+}
+
+u16 Skeleton::parent(u16 joint) const
+{
+	return m_parents[joint];
+}
+
+const String& Skeleton::name(u16 joint) const
+{
+	return m_names[joint];
+}
+
+const u16* Skeleton::parents() const
+{
+	return m_parents.data();
+}
+
+const JointTransform4* Skeleton::rest_pose() const
+{
+	return m_rest_pose.data();
+}
+
+const Affine3D* Skeleton::inverse_bind() const
+{
+	return m_inverse_bind.data();
+}
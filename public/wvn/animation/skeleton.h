@@ -0,0 +1,45 @@
+#ifndef SKELETON_H_
+#define SKELETON_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/container/string.h>
+#include <wvn/animation/pose.h>
+
+namespace wvn::anim
+{
+	/**
+	 * Joint hierarchy of an animated model along with its rest pose.
+	 * Joints are added parents first, which is the order everything that walks the hierarchy relies on.
+	 */
+	class Skeleton
+	{
+	public:
+		Skeleton();
+		~Skeleton();
+
+		u16 add_joint(const String& name, u16 parent, const Vec3F& position, const Quat& rotation, const Vec3F& scale = Vec3F::one());
+
+		u16 find_joint(const String& name) const;
+
+		u16 joint_count() const;
+		u16 parent(u16 joint) const;
+		const String& name(u16 joint) const;
+
+		const u16* parents() const;
+
+		const JointTransform4* rest_pose() const;
+
+		// model space rest matrix of every joint inverted, for taking vertices into joint space before skinning
+		const Affine3D* inverse_bind() const;
+
+	private:
+		Vector<String> m_names;
+		Vector<u16> m_parents;
+		Vector<JointTransform4> m_rest_pose;
+		Vector<Affine3D> m_bind;
+		Vector<Affine3D> m_inverse_bind;
+	};
+}
+
+#endif // SKELETON_H_
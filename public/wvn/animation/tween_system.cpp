@@ -0,0 +1,488 @@
+#include <wvn/animation/tween_system.h>
+#include <wvn/entity/event.h>
+#include <wvn/maths/batch_ease.h>
+#include <wvn/maths/simd.h>
+
+using namespace wvn;
+using namespace wvn::anim;
+
+TweenSystem::TweenSystem()
+	: m_pools()
+	, m_slots()
+	, m_free_slots()
+	, m_progress()
+	, m_values()
+	, m_finished()
+	, m_count(0)
+{
+}
+
+TweenSystem::~TweenSystem()
+{
+}
+
+TweenID TweenSystem::tween(float* target, float from, float to, float duration, EaseType ease, float delay)
+{
+	return add(TWEEN_KIND_FLOAT, target, &from, &to, duration, ease, delay);
+}
+
+TweenID TweenSystem::tween(Vec3F* target, const Vec3F& from, const Vec3F& to, float duration, EaseType ease, float delay)
+{
+	return add(TWEEN_KIND_VEC3, target, from.data, to.data, duration, ease, delay);
+}
+
+TweenID TweenSystem::tween(Colour* target, const Colour& from, const Colour& to, float duration, EaseType ease, float delay)
+{
+	float from_rgba[4] = { (float)from.r, (float)from.g, (float)from.b, (float)from.a };
+	float to_rgba[4] = { (float)to.r, (float)to.g, (float)to.b, (float)to.a };
+
+	return add(TWEEN_KIND_COLOUR, target, from_rgba, to_rgba, duration, ease, delay);
+}
+
+TweenID TweenSystem::tween(Quat* target, const Quat& from, const Quat& to, float duration, EaseType ease, float delay)
+{
+	// q and -q are the same rotation, pick whichever is closer so it doesn't go the long way round
+	Quat end = (Quat::dot(from, to) < 0.0f) ? Quat(-to.w, -to.x, -to.y, -to.z) : to;
+
+	return add(TWEEN_KIND_QUAT, target, from.data, end.data, duration, ease, delay);
+}
+
+void TweenSystem::notify(TweenID id, const ent::EntityHandle& receiver)
+{
+	Slot* slot = find_slot(id);
+	wvn_ASSERT(slot, "[TWEEN|DEBUG] Tween must be active.");
+
+	slot->receiver = receiver;
+}
+
+void TweenSystem::cancel(TweenID id)
+{
+	Slot* slot = find_slot(id);
+
+	if (!slot) {
+		return;
+	}
+
+	remove(m_pools[slot->kind][slot->ease], (TweenKind)slot->kind, slot->index);
+}
+
+void TweenSystem::cancel_all()
+{
+	for (int kind = 0; kind < TWEEN_KIND_MAX_ENUM; kind++)
+	{
+		for (int ease = 0; ease < EASE_MAX_ENUM; ease++)
+		{
+			Pool& pool = m_pools[kind][ease];
+
+			while (pool.ids.any()) {
+				remove(pool, (TweenKind)kind, pool.ids.size() - 1);
+			}
+		}
+	}
+}
+
+bool TweenSystem::is_active(TweenID id) const
+{
+	return find_slot(id) != nullptr;
+}
+
+void TweenSystem::update(float dt)
+{
+	m_finished.clear();
+
+	for (int kind = 0; kind < TWEEN_KIND_MAX_ENUM; kind++)
+	{
+		for (int ease = 0; ease < EASE_MAX_ENUM; ease++)
+		{
+			if (m_pools[kind][ease].ids.any()) {
+				update_pool(m_pools[kind][ease], (TweenKind)kind, (EaseType)ease, dt);
+			}
+		}
+	}
+
+	// everything that finished this update goes out together once all the values are written
+	for (auto& finished : m_finished)
+	{
+		if (!finished.receiver.is_valid()) {
+			continue;
+		}
+
+		ent::Event event("tween_finished");
+		event.append_u64("id", finished.id);
+		event.send(finished.receiver);
+	}
+}
+
+u64 TweenSystem::size() const
+{
+	return m_count;
+}
+
+int TweenSystem::component_count(TweenKind kind)
+{
+	switch (kind)
+	{
+	case TWEEN_KIND_FLOAT:
+		return 1;
+
+	case TWEEN_KIND_VEC3:
+		return 3;
+
+	case TWEEN_KIND_QUAT:
+	case TWEEN_KIND_COLOUR:
+		return 4;
+
+	default:
+		return 0;
+	}
+}
+
+TweenID TweenSystem::add(TweenKind kind, void* target, const float* from, const float* to, float duration, EaseType ease, float delay)
+{
+	wvn_ASSERT(target, "[TWEEN|DEBUG] Target must not be nullptr.");
+	wvn_ASSERT(duration >= 0.0f, "[TWEEN|DEBUG] Duration must not be negative.");
+	wvn_ASSERT(ease >= 0 && ease < EASE_MAX_ENUM, "[TWEEN|DEBUG] Ease type must be valid.");
+
+	u32 slot_idx = 0;
+
+	if (m_free_slots.any())
+	{
+		slot_idx = m_free_slots.back();
+		m_free_slots.pop_back();
+	}
+	else
+	{
+		slot_idx = m_slots.size();
+		m_slots.push_back({ 1, NO_INDEX, 0, 0, ent::EntityHandle() });
+	}
+
+	Slot& slot = m_slots[slot_idx];
+	Pool& pool = m_pools[kind][ease];
+
+	// the generation goes in the top half so an old id can never match whatever reuses its slot
+	TweenID id = ((u64)slot.generation << 32) | slot_idx;
+
+	slot.index = pool.ids.size();
+	slot.kind = kind;
+	slot.ease = ease;
+	slot.receiver = ent::EntityHandle();
+
+	// a zero duration jumps straight to the end on the next update
+	pool.elapsed.push_back(-delay);
+	pool.inv_duration.push_back(duration > 0.0f ? 1.0f / duration : 1.0e30f);
+
+	for (int c = 0; c < component_count(kind); c++)
+	{
+		pool.from[c].push_back(from[c]);
+		pool.to[c].push_back(to[c]);
+	}
+
+	pool.targets.push_back(target);
+	pool.ids.push_back(id);
+
+	m_count++;
+
+	return id;
+}
+
+void TweenSystem::remove(Pool& pool, TweenKind kind, u32 idx)
+{
+	u32 last = pool.ids.size() - 1;
+
+	Slot& slot = m_slots[(u32)pool.ids[idx]];
+	slot.generation++;
+	slot.index = NO_INDEX;
+	slot.receiver = ent::EntityHandle();
+
+	m_free_slots.push_back((u32)pool.ids[idx]);
+
+	// move the last tween into the gap so the arrays stay packed
+	if (idx != last)
+	{
+		pool.elapsed[idx] = pool.elapsed[last];
+		pool.inv_duration[idx] = pool.inv_duration[last];
+
+		for (int c = 0; c < component_count(kind); c++)
+		{
+			pool.from[c][idx] = pool.from[c][last];
+			pool.to[c][idx] = pool.to[c][last];
+		}
+
+		pool.targets[idx] = pool.targets[last];
+		pool.ids[idx] = pool.ids[last];
+
+		m_slots[(u32)pool.ids[idx]].index = idx;
+	}
+
+	pool.elapsed.pop_back();
+	pool.inv_duration.pop_back();
+
+	for (int c = 0; c < component_count(kind); c++)
+	{
+		pool.from[c].pop_back();
+		pool.to[c].pop_back();
+	}
+
+	pool.targets.pop_back();
+	pool.ids.pop_back();
+
+	m_count--;
+}
+
+void TweenSystem::update_pool(Pool& pool, TweenKind kind, EaseType ease, float dt)
+{
+	u64 count = pool.ids.size();
+	int components = component_count(kind);
+
+	m_progress.resize_uninitialized(count);
+
+	for (int c = 0; c < components; c++) {
+		m_values[c].resize_uninitialized(count);
+	}
+
+	float* elapsed = pool.elapsed.data();
+	const float* inv_duration = pool.inv_duration.data();
+	float* progress = m_progress.data();
+
+	// move the clocks on and work out how far along each tween is
+	u64 i = 0;
+
+	simd::Float4 dt4 = simd::splat(dt);
+	simd::Float4 zero = simd::splat(0.0f);
+	simd::Float4 one = simd::splat(1.0f);
+
+	// also keeps track of the furthest along, so finding the finished ones can be skipped when there aren't any,
+	// and of the least elapsed, so picking out the ones still in their delay can be skipped when none are
+	simd::Float4 furthest4 = zero;
+	simd::Float4 soonest4 = zero;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		simd::Float4 e = simd::add(simd::loadu(elapsed + i), dt4);
+		simd::Float4 p = simd::mul(e, simd::loadu(inv_duration + i));
+
+		simd::storeu(elapsed + i, e);
+		simd::storeu(progress + i, simd::min(simd::max(p, zero), one));
+
+		furthest4 = simd::max(furthest4, p);
+		soonest4 = simd::min(soonest4, e);
+	}
+
+	float lanes[4];
+
+	simd::storeu(lanes, furthest4);
+	float furthest = CalcF::max(CalcF::max(lanes[0], lanes[1]), CalcF::max(lanes[2], lanes[3]));
+
+	simd::storeu(lanes, soonest4);
+	float soonest = CalcF::min(CalcF::min(lanes[0], lanes[1]), CalcF::min(lanes[2], lanes[3]));
+
+	for (; i < count; i++)
+	{
+		elapsed[i] += dt;
+
+		float p = elapsed[i] * inv_duration[i];
+
+		progress[i] = CalcF::clamp(p, 0.0f, 1.0f);
+		furthest = CalcF::max(furthest, p);
+		soonest = CalcF::min(soonest, elapsed[i]);
+	}
+
+	batch::ease(progress, progress, count, ease);
+
+	// from + (to - from) * eased progress, one component at a time
+	for (int c = 0; c < components; c++)
+	{
+		const float* from = pool.from[c].data();
+		const float* to = pool.to[c].data();
+		float* value = m_values[c].data();
+
+		for (i = 0; i + 4 <= count; i += 4)
+		{
+			simd::Float4 f = simd::loadu(from + i);
+			simd::storeu(value + i, simd::madd(simd::sub(simd::loadu(to + i), f), simd::loadu(progress + i), f));
+		}
+
+		for (; i < count; i++) {
+			value[i] = from[i] + ((to[i] - from[i]) * progress[i]);
+		}
+	}
+
+	// lerped rotations need pulling back onto the unit sphere
+	if (kind == TWEEN_KIND_QUAT)
+	{
+		float* w = m_values[0].data();
+		float* x = m_values[1].data();
+		float* y = m_values[2].data();
+		float* z = m_values[3].data();
+
+		for (i = 0; i + 4 <= count; i += 4)
+		{
+			simd::Float4 qw = simd::loadu(w + i);
+			simd::Float4 qx = simd::loadu(x + i);
+			simd::Float4 qy = simd::loadu(y + i);
+			simd::Float4 qz = simd::loadu(z + i);
+
+			simd::Float4 len2 = simd::mul(qw, qw);
+			len2 = simd::madd(qx, qx, len2);
+			len2 = simd::madd(qy, qy, len2);
+			len2 = simd::madd(qz, qz, len2);
+
+			simd::Float4 inv_len = simd::div(one, simd::sqrt(len2));
+
+			simd::storeu(w + i, simd::mul(qw, inv_len));
+			simd::storeu(x + i, simd::mul(qx, inv_len));
+			simd::storeu(y + i, simd::mul(qy, inv_len));
+			simd::storeu(z + i, simd::mul(qz, inv_len));
+		}
+
+		for (; i < count; i++)
+		{
+			float inv_len = 1.0f / CalcF::sqrt((w[i] * w[i]) + (x[i] * x[i]) + (y[i] * y[i]) + (z[i] * z[i]));
+
+			w[i] *= inv_len;
+			x[i] *= inv_len;
+			y[i] *= inv_len;
+			z[i] *= inv_len;
+		}
+	}
+
+	if (soonest >= 0.0f)
+	{
+		const float* values[MAX_COMPONENTS] = { m_values[0].data(), m_values[1].data(), m_values[2].data(), m_values[3].data() };
+		write_targets(kind, pool.targets.data(), values, count);
+	}
+	else
+	{
+		// a tween still in its delay leaves its target alone, otherwise it would pin it to 'from' and fight
+		// whatever else is moving it until the delay is over, so only the runs of started ones get written
+		for (u64 begin = 0; begin < count;)
+		{
+			if (elapsed[begin] < 0.0f) {
+				begin++;
+				continue;
+			}
+
+			u64 end = begin + 1;
+
+			while (end < count && elapsed[end] >= 0.0f) {
+				end++;
+			}
+
+			const float* values[MAX_COMPONENTS] = { nullptr, nullptr, nullptr, nullptr };
+
+			for (int c = 0; c < components; c++) {
+				values[c] = m_values[c].data() + begin;
+			}
+
+			write_targets(kind, pool.targets.data() + begin, values, end - begin);
+
+			begin = end;
+		}
+	}
+
+	if (furthest < 1.0f) {
+		return;
+	}
+
+	// backwards so whatever gets swapped into a removed tween's place has already been handled
+	for (u64 j = count; j > 0; j--)
+	{
+		u32 idx = j - 1;
+
+		if (pool.elapsed[idx] * pool.inv_duration[idx] < 1.0f) {
+			continue;
+		}
+
+		// land exactly on the end value whatever the ease gave
+		const float* end[MAX_COMPONENTS] = { nullptr, nullptr, nullptr, nullptr };
+
+		for (int c = 0; c < components; c++) {
+			end[c] = pool.to[c].data() + idx;
+		}
+
+		write_targets(kind, pool.targets.data() + idx, end, 1);
+
+		const Slot& slot = m_slots[(u32)pool.ids[idx]];
+
+		if (slot.receiver != ent::EntityHandle()) {
+			m_finished.push_back({ pool.ids[idx], slot.receiver });
+		}
+
+		remove(pool, kind, idx);
+	}
+}
+
+// one loop per kind rather than checking the kind for every tween
+void TweenSystem::write_targets(TweenKind kind, void* const* targets, const float* const* values, u64 count)
+{
+	switch (kind)
+	{
+	case TWEEN_KIND_FLOAT:
+		for (u64 i = 0; i < count; i++) {
+			*(float*)targets[i] = values[0][i];
+		}
+		break;
+
+	case TWEEN_KIND_VEC3:
+		for (u64 i = 0; i < count; i++)
+		{
+			Vec3F* target = (Vec3F*)targets[i];
+
+			target->x = values[0][i];
+			target->y = values[1][i];
+			target->z = values[2][i];
+		}
+		break;
+
+	case TWEEN_KIND_QUAT:
+		for (u64 i = 0; i < count; i++)
+		{
+			Quat* target = (Quat*)targets[i];
+
+			target->w = values[0][i];
+			target->x = values[1][i];
+			target->y = values[2][i];
+			target->z = values[3][i];
+		}
+		break;
+
+	case TWEEN_KIND_COLOUR:
+		// eases like back and elastic overshoot, which would wrap round without the clamp
+		for (u64 i = 0; i < count; i++)
+		{
+			Colour* target = (Colour*)targets[i];
+
+			target->r = (u8)CalcF::clamp(values[0][i] + 0.5f, 0.0f, 255.0f);
+			target->g = (u8)CalcF::clamp(values[1][i] + 0.5f, 0.0f, 255.0f);
+			target->b = (u8)CalcF::clamp(values[2][i] + 0.5f, 0.0f, 255.0f);
+			target->a = (u8)CalcF::clamp(values[3][i] + 0.5f, 0.0f, 255.0f);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+TweenSystem::Slot* TweenSystem::find_slot(TweenID id)
+{
+	u32 slot_idx = (u32)id;
+	u32 generation = (u32)(id >> 32);
+
+	if (slot_idx >= m_slots.size()) {
+		return nullptr;
+	}
+
+	Slot& slot = m_slots[slot_idx];
+
+	if (slot.generation != generation || slot.index == NO_INDEX) {
+		return nullptr;
+	}
+
+	return &slot;
+}
+
+const TweenSystem::Slot* TweenSystem::find_slot(TweenID id) const
+{
+	return const_cast<TweenSystem*>(this)->find_slot(id);
+}
@@ -0,0 +1,120 @@
+#ifndef TWEEN_SYSTEM_H_
+#define TWEEN_SYSTEM_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/maths/ease.h>
+#include <wvn/maths/vec3.h>
+#include <wvn/maths/quat.h>
+#include <wvn/maths/colour.h>
+#include <wvn/entity/entity_handle.h>
+
+namespace wvn::anim
+{
+	using TweenID = u64;
+
+	/**
+	 * Eases values from one to another over time and writes them straight into wherever they live.
+	 * Tweens are kept in flat arrays grouped by value type and ease, so each group is evaluated in one
+	 * vectorised pass instead of one tween at a time.
+	 * A tween's target is written every update() until it finishes, so it has to outlive the tween or be cancel()ed first.
+	 */
+	class TweenSystem
+	{
+	public:
+		constexpr static TweenID NULL_ID = 0;
+
+		TweenSystem();
+		~TweenSystem();
+
+		// the target holds 'from' after the first update() past the delay and exactly 'to' once it finishes
+		TweenID tween(float* target, float from, float to, float duration, EaseType ease = EASE_LINEAR, float delay = 0.0f);
+		TweenID tween(Vec3F* target, const Vec3F& from, const Vec3F& to, float duration, EaseType ease = EASE_LINEAR, float delay = 0.0f);
+		TweenID tween(Colour* target, const Colour& from, const Colour& to, float duration, EaseType ease = EASE_LINEAR, float delay = 0.0f);
+
+		// normalized lerp along the shorter arc
+		TweenID tween(Quat* target, const Quat& from, const Quat& to, float duration, EaseType ease = EASE_LINEAR, float delay = 0.0f);
+
+		// sends the entity a "tween_finished" event with the tween's id under "id" when it finishes, but not if it's cancelled
+		void notify(TweenID id, const ent::EntityHandle& receiver);
+
+		void cancel(TweenID id);
+		void cancel_all();
+
+		// false once it has finished or been cancelled, the id never becomes valid again
+		bool is_active(TweenID id) const;
+
+		void update(float dt);
+
+		u64 size() const;
+
+	private:
+		constexpr static u32 NO_INDEX = ~0u;
+
+		enum TweenKind
+		{
+			TWEEN_KIND_FLOAT,
+			TWEEN_KIND_VEC3,
+			TWEEN_KIND_QUAT,
+			TWEEN_KIND_COLOUR,
+
+			TWEEN_KIND_MAX_ENUM
+		};
+
+		constexpr static int MAX_COMPONENTS = 4;
+
+		/*
+		 * Every tween of one kind with the same ease.
+		 * Values are split into one array per component so they can be lerped four tweens at a time.
+		 */
+		struct Pool
+		{
+			Vector<float> elapsed; // negative until the delay is over
+			Vector<float> inv_duration;
+			Vector<float> from[MAX_COMPONENTS];
+			Vector<float> to[MAX_COMPONENTS];
+			Vector<void*> targets;
+			Vector<TweenID> ids;
+		};
+
+		struct Slot
+		{
+			u32 generation;
+			u32 index;
+			u8 kind;
+			u8 ease;
+			ent::EntityHandle receiver;
+		};
+
+		struct Finished
+		{
+			TweenID id;
+			ent::EntityHandle receiver;
+		};
+
+		static int component_count(TweenKind kind);
+
+		TweenID add(TweenKind kind, void* target, const float* from, const float* to, float duration, EaseType ease, float delay);
+		void remove(Pool& pool, TweenKind kind, u32 idx);
+
+		void update_pool(Pool& pool, TweenKind kind, EaseType ease, float dt);
+		void write_targets(TweenKind kind, void* const* targets, const float* const* values, u64 count);
+
+		Slot* find_slot(TweenID id);
+		const Slot* find_slot(TweenID id) const;
+
+		Pool m_pools[TWEEN_KIND_MAX_ENUM][EASE_MAX_ENUM];
+
+		Vector<Slot> m_slots;
+		Vector<u32> m_free_slots;
+
+		// scratch space for update(), kept around so it isn't reallocated every frame
+		Vector<float> m_progress;
+		Vector<float> m_values[MAX_COMPONENTS];
+		Vector<Finished> m_finished;
+
+		u64 m_count;
+	};
+}
+
+#endif // TWEEN_SYSTEM_H_
@@ -10,11 +10,7 @@ using namespace wvn;
 template <>
 u64 hash::calc(u64 start, const char* str)
 {
-	u64 hash = start + 7521;
-	for (int i = 0; str[i] != '\0'; i++) {
-		hash = ((hash << 5) + hash) + str[i];
-	}
-	return hash;
+	return bytes(start, str, cstr::length(str));
 }
 
 template <>
@@ -2,7 +2,13 @@
 #define TYPES_H_
 
 #include <inttypes.h>
+#include <cstring>
 #include <memory>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
 
 #include <wvn/time.h>
 
@@ -18,8 +24,8 @@
 
 #else // wvn_DEBUG
 
-#define wvn_ASSERT(_exp, _msg)
-#define wvn_ERROR(_msg)
+#define wvn_ASSERT(_exp, _msg, ...)
+#define wvn_ERROR(_msg, ...)
 
 #endif // wvn_DEBUG
 
@@ -90,24 +96,194 @@ namespace wvn
 
 	namespace hash
 	{
-		// fowler noll vo hash function
-		template <typename T>
-		u64 calc(u64 start, const T* data)
+		/*
+		 * 64-bit hash in the style of wyhash: eight bytes are read at a time and folded in with a 64x64 -> 128-bit
+		 * multiply, inputs over 48 bytes run three independent lanes so the multiplies can overlap.
+		 * Everything is constexpr so keys can be hashed at compile time and still match what's computed at runtime.
+		 */
+		namespace detail
 		{
-			const u64 prime = 0x01000193;
-			const u64 offset = 0x811C9DC5;
-			const byte* input = (const byte*)data;
+			constexpr u64 SECRET[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+			constexpr u64 read64(const char* p)
+			{
+				if (std::is_constant_evaluated())
+				{
+					u64 v = 0;
+
+					for (int i = 0; i < 8; i++) {
+						v |= (u64)(u8)p[i] << (i * 8);
+					}
+
+					return v;
+				}
+
+				u64 v = 0;
+				std::memcpy(&v, p, 8);
+				return v;
+			}
+
+			constexpr u64 read32(const char* p)
+			{
+				if (std::is_constant_evaluated()) {
+					return (u64)(u8)p[0] | ((u64)(u8)p[1] << 8) | ((u64)(u8)p[2] << 16) | ((u64)(u8)p[3] << 24);
+				}
+
+				u32 v = 0;
+				std::memcpy(&v, p, 4);
+				return v;
+			}
 
-			u64 output = start;
-			for (u64 i = 0; i < sizeof(T); i++)
+			// 1 to 3 bytes, picks the first, middle and last one so every length reads something different
+			constexpr u64 read_small(const char* p, u64 size)
 			{
-				output ^= input[i];
-				output *= prime;
+				return ((u64)(u8)p[0] << 16) | ((u64)(u8)p[size >> 1] << 8) | (u64)(u8)p[size - 1];
 			}
 
-			return output ^ offset;
+			// schoolbook multiply on 32-bit halves, for constant evaluation on compilers without a 128-bit integer
+			constexpr void mul128_portable(u64 a, u64 b, u64* lo, u64* hi)
+			{
+				u64 a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+				u64 b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+
+				u64 ll = a_lo * b_lo;
+				u64 lh = a_lo * b_hi;
+				u64 hl = a_hi * b_lo;
+				u64 hh = a_hi * b_hi;
+
+				u64 cross = (ll >> 32) + (lh & 0xFFFFFFFFull) + (hl & 0xFFFFFFFFull);
+
+				(*lo) = (cross << 32) | (ll & 0xFFFFFFFFull);
+				(*hi) = hh + (lh >> 32) + (hl >> 32) + (cross >> 32);
+			}
+
+			// full 64x64 -> 128-bit multiply
+			constexpr void mul128(u64 a, u64 b, u64* lo, u64* hi)
+			{
+#if defined(__SIZEOF_INT128__)
+				__uint128_t r = (__uint128_t)a * b;
+				(*lo) = (u64)r;
+				(*hi) = (u64)(r >> 64);
+#else
+				if (!std::is_constant_evaluated())
+				{
+#if defined(_MSC_VER) && defined(_M_X64)
+					(*lo) = _umul128(a, b, hi);
+					return;
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+					(*lo) = a * b;
+					(*hi) = __umulh(a, b);
+					return;
+#endif
+				}
+
+				mul128_portable(a, b, lo, hi);
+#endif
+			}
+		}
+
+		// multiplies the two into 128 bits and folds the halves back together
+		constexpr u64 mix(u64 a, u64 b)
+		{
+			u64 lo = 0, hi = 0;
+			detail::mul128(a, b, &lo, &hi);
+			return lo ^ hi;
+		}
+
+		constexpr u64 bytes(u64 seed, const char* p, u64 size)
+		{
+			using namespace detail;
+
+			seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+
+			u64 a = 0;
+			u64 b = 0;
+
+			if (size <= 16)
+			{
+				if (size >= 4)
+				{
+					u64 mid = (size >> 3) << 2;
+					a = (read32(p) << 32) | read32(p + mid);
+					b = (read32(p + size - 4) << 32) | read32(p + size - 4 - mid);
+				}
+				else if (size > 0)
+				{
+					a = read_small(p, size);
+				}
+			}
+			else
+			{
+				const char* q = p;
+				u64 left = size;
+
+				if (left > 48)
+				{
+					u64 lane1 = seed;
+					u64 lane2 = seed;
+
+					do
+					{
+						seed  = mix(read64(q +  0) ^ SECRET[1], read64(q +  8) ^ seed);
+						lane1 = mix(read64(q + 16) ^ SECRET[2], read64(q + 24) ^ lane1);
+						lane2 = mix(read64(q + 32) ^ SECRET[3], read64(q + 40) ^ lane2);
+
+						q += 48;
+						left -= 48;
+					}
+					while (left > 48);
+
+					seed ^= lane1 ^ lane2;
+				}
+
+				while (left > 16)
+				{
+					seed = mix(read64(q) ^ SECRET[1], read64(q + 8) ^ seed);
+
+					q += 16;
+					left -= 16;
+				}
+
+				// the last 16 bytes of the input, overlapping whatever was already consumed
+				a = read64(q + left - 16);
+				b = read64(q + left - 8);
+			}
+
+			a ^= SECRET[1];
+			b ^= seed;
+
+			u64 lo = 0, hi = 0;
+			mul128(a, b, &lo, &hi);
+
+			return mix(lo ^ SECRET[0] ^ size, hi ^ SECRET[1]);
+		}
+
+		inline u64 bytes(u64 seed, const void* data, u64 size)
+		{
+			return bytes(seed, (const char*)data, size);
+		}
+
+		// for compile time keys, gives the same result as calc() on the same string at runtime
+		constexpr u64 str(const char* str, u64 seed = 0)
+		{
+			u64 length = 0;
+
+			while (str[length] != '\0') {
+				length++;
+			}
+
+			return bytes(seed, str, length);
+		}
+
+		// hashes the raw bytes of the object, so padding and pointers are part of the result
+		template <typename T>
+		u64 calc(u64 start, const T* data)
+		{
+			return bytes(start, (const void*)data, sizeof(T));
 		}
 
+		// the current value is used as the seed, which gets mixed before any input is read,
+		// so combining the same values in a different order gives an unrelated result
 		template <typename T>
 		void combine(u64* inout, const T* data)
 		{
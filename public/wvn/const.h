@@ -2,5 +2,6 @@
 #define CONST_H_
 
 #define wvn_MAX_BOUND_TEXTURES 16
+#define wvn_MAX_BOUND_STORAGE_BUFFERS 4
 
 #endif // CONST_H_
@@ -1,7 +1,10 @@
 #ifndef FUNCTION_H_
 #define FUNCTION_H_
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <wvn/common.h>
 
 namespace wvn
@@ -9,44 +12,210 @@ namespace wvn
 	template <typename T>
 	class Function;
 
-	/**
-	 * Wrapper around a function pointer pretty much
-	 */
-	template <typename Result, typename... Args>
-	class Function<Result(Args...)>
+	template <typename T>
+	class UniqueFunction;
+
+	template <typename T>
+	class FunctionRef;
+
+	namespace detail
 	{
-		typedef Result (*call_fn)(byte*, Args&&...);
-		typedef void   (*ctor_fn)(byte*, byte*);
-		typedef void   (*dtor_fn)(byte*);
+		// enough for a lambda capturing a handful of pointers, anything bigger goes on the heap
+		constexpr u64 FUNCTION_INLINE_SIZE = 48;
+		constexpr u64 FUNCTION_INLINE_ALIGN = alignof(std::max_align_t);
 
 		template <typename F>
-		static Result get_call_fn(F* fn, Args&&... args)
-		{
-			return (*fn)(std::forward<Args>(args)...);
-		}
+		constexpr bool FUNCTION_FITS_INLINE =
+			sizeof(F) <= FUNCTION_INLINE_SIZE &&
+			alignof(F) <= FUNCTION_INLINE_ALIGN &&
+			std::is_nothrow_move_constructible_v<F>;
 
-		template <typename F>
-		static void get_ctor_fn(F* dst, F* src)
+		template <typename Result, typename... Args>
+		struct FunctionOps
 		{
-			new (dst) F(*src);
-		}
+			Result (*call)(byte*, Args&&...);
+			void (*copy)(byte*, const byte*); // null for callables that can't be copied
+			void (*move)(byte*, byte*);
+			void (*destroy)(byte*);
+		};
 
-		template <typename F>
-		static void get_dtor_fn(F* fn)
+		/**
+		 * Type erased storage shared by Function & UniqueFunction.
+		 * Small callables live inline, bigger ones are heap allocated and only their pointer is kept inline.
+		 */
+		template <typename Result, typename... Args>
+		class FunctionStorage
 		{
-			fn->~F();
-		}
+			using Ops = FunctionOps<Result, Args...>;
+
+			template <typename F>
+			struct Handler
+			{
+				static F* get(byte* storage)
+				{
+					if constexpr (FUNCTION_FITS_INLINE<F>) {
+						return std::launder(reinterpret_cast<F*>(storage));
+					} else {
+						return *reinterpret_cast<F**>(storage);
+					}
+				}
+
+				static const F* get(const byte* storage)
+				{
+					return get(const_cast<byte*>(storage));
+				}
+
+				template <typename Fn>
+				static void create(byte* storage, Fn&& fn)
+				{
+					if constexpr (FUNCTION_FITS_INLINE<F>) {
+						new (storage) F(std::forward<Fn>(fn));
+					} else {
+						*reinterpret_cast<F**>(storage) = new F(std::forward<Fn>(fn));
+					}
+				}
+
+				static Result call(byte* storage, Args&&... args)
+				{
+					return (*get(storage))(std::forward<Args>(args)...);
+				}
+
+				static void copy(byte* dst, const byte* src)
+				{
+					create(dst, *get(src));
+				}
+
+				static void move(byte* dst, byte* src)
+				{
+					if constexpr (FUNCTION_FITS_INLINE<F>) {
+						new (dst) F(std::move(*get(src)));
+						get(src)->~F();
+					} else {
+						*reinterpret_cast<F**>(dst) = *reinterpret_cast<F**>(src);
+					}
+				}
 
+				static void destroy(byte* storage)
+				{
+					if constexpr (FUNCTION_FITS_INLINE<F>) {
+						get(storage)->~F();
+					} else {
+						delete get(storage);
+					}
+				}
+
+				// only names copy() when it can actually be instantiated
+				static constexpr void (*copy_fn())(byte*, const byte*)
+				{
+					if constexpr (std::is_copy_constructible_v<F>) {
+						return copy;
+					} else {
+						return nullptr;
+					}
+				}
+
+				static constexpr Ops OPS = {
+					.call = call,
+					.copy = copy_fn(),
+					.move = move,
+					.destroy = destroy
+				};
+			};
+
+		public:
+			FunctionStorage()
+				: m_ops(nullptr)
+			{
+			}
+
+			template <typename F>
+			void assign(F&& fn)
+			{
+				using Callable = std::decay_t<F>;
+
+				// empty function pointers stay empty, same as assigning nullptr
+				if constexpr (std::is_pointer_v<std::remove_reference_t<F>>)
+				{
+					if (!fn) {
+						return;
+					}
+				}
+
+				Handler<Callable>::create(m_storage, std::forward<F>(fn));
+				m_ops = &Handler<Callable>::OPS;
+			}
+
+			void copy_from(const FunctionStorage& other)
+			{
+				if (other.m_ops) {
+					other.m_ops->copy(m_storage, other.m_storage);
+					m_ops = other.m_ops;
+				}
+			}
+
+			void move_from(FunctionStorage& other)
+			{
+				if (other.m_ops)
+				{
+					other.m_ops->move(m_storage, other.m_storage);
+					m_ops = other.m_ops;
+					other.m_ops = nullptr;
+				}
+			}
+
+			void reset()
+			{
+				if (m_ops) {
+					m_ops->destroy(m_storage);
+					m_ops = nullptr;
+				}
+			}
+
+			Result call(Args&&... args) const
+			{
+				return m_ops->call(const_cast<byte*>(m_storage), std::forward<Args>(args)...);
+			}
+
+			bool empty() const
+			{
+				return m_ops == nullptr;
+			}
+
+		private:
+			alignas(FUNCTION_INLINE_ALIGN) byte m_storage[FUNCTION_INLINE_SIZE];
+			const Ops* m_ops;
+		};
+
+		// keeps the converting constructors from hijacking copies, nullptr & anything that can't be called like the wrapper
+		template <typename F, typename Self, typename Result, typename... Args>
+		constexpr bool IS_COMPATIBLE_CALLABLE =
+			!std::is_same_v<std::decay_t<F>, Self> &&
+			!std::is_same_v<std::decay_t<F>, std::nullptr_t> &&
+			std::is_invocable_r_v<Result, std::decay_t<F>&, Args...>;
+	}
+
+	/**
+	 * Copyable wrapper around any callable.
+	 * Small callables are stored inline so wrapping them never allocates.
+	 */
+	template <typename Result, typename... Args>
+	class Function<Result(Args...)>
+	{
 	public:
 		Function();
-		Function(std::nullptr_t null);
+		Function(std::nullptr_t);
 		Function(const Function& other);
+		Function(Function&& other) noexcept;
 
-		template <typename F>
-		Function(F fn);
+		template <typename F, typename = std::enable_if_t<detail::IS_COMPATIBLE_CALLABLE<F, Function, Result, Args...>>>
+		Function(F&& fn);
 
 		~Function();
 
+		Function& operator = (const Function& other);
+		Function& operator = (Function&& other) noexcept;
+		Function& operator = (std::nullptr_t);
+
 		Result call(Args... args) const;
 		Result operator ()(Args... args) const;
 
@@ -56,99 +225,104 @@ namespace wvn
 		bool operator != (const Function& other);
 
 	private:
-		call_fn m_call_func;
-		ctor_fn m_create_func;
-		dtor_fn m_destroy_func;
-
-		byte* m_data;
-		u64 m_data_size;
+		detail::FunctionStorage<Result, Args...> m_storage;
 	};
 
 	template <typename Result, typename... Args>
 	Function<Result(Args...)>::Function()
-		: m_call_func(nullptr)
-		, m_create_func(nullptr)
-		, m_destroy_func(nullptr)
-		, m_data(nullptr)
-		, m_data_size(0)
+		: m_storage()
 	{
 	}
 
 	template <typename Result, typename... Args>
-	Function<Result(Args...)>::Function(std::nullptr_t null)
-		: m_call_func(nullptr)
-		, m_create_func(nullptr)
-		, m_destroy_func(nullptr)
-		, m_data(nullptr)
-		, m_data_size(0)
+	Function<Result(Args...)>::Function(std::nullptr_t)
+		: m_storage()
 	{
 	}
 
 	template <typename Result, typename... Args>
-	Function<Result(Args...)>::Function(const Function<Result(Args...)>& other)
-		: m_call_func(other.m_call_func)
-		, m_create_func(other.m_create_func)
-		, m_destroy_func(other.m_destroy_func)
-		, m_data_size(other.m_data_size)
-		, m_data(nullptr)
+	Function<Result(Args...)>::Function(const Function& other)
+		: m_storage()
 	{
-		if (m_call_func && other.m_data)
-		{
-			m_data = new byte[this->m_data_size];
-			m_create_func(m_data, other.m_data);
-		}
+		m_storage.copy_from(other.m_storage);
+	}
+
+	template <typename Result, typename... Args>
+	Function<Result(Args...)>::Function(Function&& other) noexcept
+		: m_storage()
+	{
+		m_storage.move_from(other.m_storage);
 	}
 
 	template <typename Result, typename... Args>
-	template <typename F>
-	Function<Result(Args...)>::Function(F fn)
-		: m_call_func   (reinterpret_cast<call_fn>(get_call_fn<F>))
-		, m_create_func (reinterpret_cast<ctor_fn>(get_ctor_fn<F>))
-		, m_destroy_func(reinterpret_cast<dtor_fn>(get_dtor_fn<F>))
+	template <typename F, typename>
+	Function<Result(Args...)>::Function(F&& fn)
+		: m_storage()
 	{
-		m_data_size = sizeof(F);
-		m_data = new byte[m_data_size];
-		m_create_func(m_data, reinterpret_cast<byte*>(&fn));
+		static_assert(std::is_copy_constructible_v<std::decay_t<F>>, "[FUNCTION|DEBUG] Callable must be copyable, use UniqueFunction for move-only callables.");
+		m_storage.assign(std::forward<F>(fn));
 	}
 
 	template <typename Result, typename... Args>
 	Function<Result(Args...)>::~Function()
 	{
-		if (m_destroy_func && m_data) {
-			m_destroy_func(m_data);
+		m_storage.reset();
+	}
+
+	template <typename Result, typename... Args>
+	Function<Result(Args...)>& Function<Result(Args...)>::operator = (const Function& other)
+	{
+		if (this != &other)
+		{
+			m_storage.reset();
+			m_storage.copy_from(other.m_storage);
 		}
 
-		delete[] m_data;
+		return *this;
+	}
+
+	template <typename Result, typename... Args>
+	Function<Result(Args...)>& Function<Result(Args...)>::operator = (Function&& other) noexcept
+	{
+		if (this != &other)
+		{
+			m_storage.reset();
+			m_storage.move_from(other.m_storage);
+		}
+
+		return *this;
+	}
+
+	template <typename Result, typename... Args>
+	Function<Result(Args...)>& Function<Result(Args...)>::operator = (std::nullptr_t)
+	{
+		m_storage.reset();
+		return *this;
 	}
 
 	template <typename Result, typename... Args>
 	Result Function<Result(Args...)>::call(Args... args) const
 	{
-		return m_call_func(m_data, std::forward<Args>(args)...);
+		return m_storage.call(std::forward<Args>(args)...);
 	}
 
 	template <typename Result, typename... Args>
 	Result Function<Result(Args...)>::operator ()(Args... args) const
 	{
-		return m_call_func(m_data, std::forward<Args>(args)...);
+		return m_storage.call(std::forward<Args>(args)...);
 	}
 
 	template <typename Result, typename... Args>
 	Function<Result(Args...)>::operator bool () const
 	{
-		return m_call_func != nullptr;
+		return !m_storage.empty();
 	}
 
+	// every function owns its own copy of the callable, so only empty functions compare equal to others
 	template <typename Result, typename... Args>
 	bool Function<Result(Args...)>::operator == (const Function& other)
 	{
-		return (
-			this->m_data == other.m_data &&
-			this->m_data_size == other.m_data_size &&
-			this->m_call_func == other.m_call_func &&
-			this->m_create_func == other.m_create_func &&
-			this->m_destroy_func == other.m_destroy_func
-		);
+		return this == &other || (m_storage.empty() && other.m_storage.empty());
 	}
 
 	template <typename Result, typename... Args>
@@ -156,6 +330,156 @@ namespace wvn
 	{
 		return !(*this == other);
 	}
+
+	/**
+	 * Move-only wrapper around any callable, so callables owning move-only state can be stored too.
+	 */
+	template <typename Result, typename... Args>
+	class UniqueFunction<Result(Args...)>
+	{
+	public:
+		UniqueFunction();
+		UniqueFunction(std::nullptr_t);
+		UniqueFunction(const UniqueFunction& other) = delete;
+		UniqueFunction(UniqueFunction&& other) noexcept;
+
+		template <typename F, typename = std::enable_if_t<detail::IS_COMPATIBLE_CALLABLE<F, UniqueFunction, Result, Args...>>>
+		UniqueFunction(F&& fn);
+
+		~UniqueFunction();
+
+		UniqueFunction& operator = (const UniqueFunction& other) = delete;
+		UniqueFunction& operator = (UniqueFunction&& other) noexcept;
+		UniqueFunction& operator = (std::nullptr_t);
+
+		Result call(Args... args) const;
+		Result operator ()(Args... args) const;
+
+		operator bool () const;
+
+	private:
+		detail::FunctionStorage<Result, Args...> m_storage;
+	};
+
+	template <typename Result, typename... Args>
+	UniqueFunction<Result(Args...)>::UniqueFunction()
+		: m_storage()
+	{
+	}
+
+	template <typename Result, typename... Args>
+	UniqueFunction<Result(Args...)>::UniqueFunction(std::nullptr_t)
+		: m_storage()
+	{
+	}
+
+	template <typename Result, typename... Args>
+	UniqueFunction<Result(Args...)>::UniqueFunction(UniqueFunction&& other) noexcept
+		: m_storage()
+	{
+		m_storage.move_from(other.m_storage);
+	}
+
+	template <typename Result, typename... Args>
+	template <typename F, typename>
+	UniqueFunction<Result(Args...)>::UniqueFunction(F&& fn)
+		: m_storage()
+	{
+		m_storage.assign(std::forward<F>(fn));
+	}
+
+	template <typename Result, typename... Args>
+	UniqueFunction<Result(Args...)>::~UniqueFunction()
+	{
+		m_storage.reset();
+	}
+
+	template <typename Result, typename... Args>
+	UniqueFunction<Result(Args...)>& UniqueFunction<Result(Args...)>::operator = (UniqueFunction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			m_storage.reset();
+			m_storage.move_from(other.m_storage);
+		}
+
+		return *this;
+	}
+
+	template <typename Result, typename... Args>
+	UniqueFunction<Result(Args...)>& UniqueFunction<Result(Args...)>::operator = (std::nullptr_t)
+	{
+		m_storage.reset();
+		return *this;
+	}
+
+	template <typename Result, typename... Args>
+	Result UniqueFunction<Result(Args...)>::call(Args... args) const
+	{
+		return m_storage.call(std::forward<Args>(args)...);
+	}
+
+	template <typename Result, typename... Args>
+	Result UniqueFunction<Result(Args...)>::operator ()(Args... args) const
+	{
+		return m_storage.call(std::forward<Args>(args)...);
+	}
+
+	template <typename Result, typename... Args>
+	UniqueFunction<Result(Args...)>::operator bool () const
+	{
+		return !m_storage.empty();
+	}
+
+	/**
+	 * Non-owning reference to a callable, for callbacks that are only called during the call they're passed to.
+	 * Never allocates or copies, but must not outlive the callable it was made from.
+	 */
+	template <typename Result, typename... Args>
+	class FunctionRef<Result(Args...)>
+	{
+		using call_fn = Result (*)(void*, Args&&...);
+
+		template <typename F>
+		static Result call_callable(void* callable, Args&&... args)
+		{
+			return (*reinterpret_cast<F*>(callable))(std::forward<Args>(args)...);
+		}
+
+	public:
+		template <typename F, typename = std::enable_if_t<detail::IS_COMPATIBLE_CALLABLE<F, FunctionRef, Result, Args...>>>
+		FunctionRef(F&& fn);
+
+		FunctionRef(const FunctionRef& other) = default;
+		FunctionRef& operator = (const FunctionRef& other) = default;
+
+		Result call(Args... args) const;
+		Result operator ()(Args... args) const;
+
+	private:
+		void* m_callable;
+		call_fn m_call_func;
+	};
+
+	template <typename Result, typename... Args>
+	template <typename F, typename>
+	FunctionRef<Result(Args...)>::FunctionRef(F&& fn)
+		: m_callable((void*)std::addressof(fn))
+		, m_call_func(call_callable<std::remove_reference_t<F>>)
+	{
+	}
+
+	template <typename Result, typename... Args>
+	Result FunctionRef<Result(Args...)>::call(Args... args) const
+	{
+		return m_call_func(m_callable, std::forward<Args>(args)...);
+	}
+
+	template <typename Result, typename... Args>
+	Result FunctionRef<Result(Args...)>::operator ()(Args... args) const
+	{
+		return m_call_func(m_callable, std::forward<Args>(args)...);
+	}
 }
 
 #endif // FUNCTION_H_
@@ -0,0 +1,830 @@
+#ifndef SMALL_VECTOR_H_
+#define SMALL_VECTOR_H_
+
+#include <initializer_list>
+#include <new>
+#include <cstdlib>
+#include <type_traits>
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+
+namespace wvn
+{
+	/**
+	 * Dynamically sized array that keeps its first InlineCapacity elements inside of itself.
+	 * Only touches the heap once it grows past that, after which it behaves like a regular Vector.
+	 * Meant for short lists that are built and thrown away often, where the allocation would cost more than the data.
+	 */
+	template <typename T, u64 InlineCapacity>
+	class SmallVector
+	{
+		static_assert(InlineCapacity > 0, "[SMALLVECTOR|DEBUG] Inline capacity must be greater than 0.");
+
+		static constexpr bool RELOCATE_BITWISE = TriviallyRelocatable<T>::value;
+		static constexpr bool COPY_BITWISE = std::is_trivially_copyable_v<T>;
+		static constexpr bool USE_MALLOC = alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	public:
+		using Iterator = typename Vector<T>::Iterator;
+		using ConstIterator = typename Vector<T>::ConstIterator;
+		using ReverseIterator = typename Vector<T>::ReverseIterator;
+		using ReverseConstIterator = typename Vector<T>::ReverseConstIterator;
+
+		SmallVector();
+
+		SmallVector(std::initializer_list<T> data);
+		SmallVector(u64 initial_size);
+		SmallVector(u64 initial_size, const T& initial_element);
+		SmallVector(const T* buf, u64 length);
+		SmallVector(const Iterator& begin, const Iterator& end);
+
+		SmallVector(const SmallVector& other);
+		SmallVector(SmallVector&& other) noexcept;
+
+		SmallVector& operator = (const SmallVector& other);
+		SmallVector& operator = (SmallVector&& other) noexcept;
+
+		~SmallVector();
+
+		// reserves room for at least this many elements without constructing any of them
+		void allocate(u64 capacity);
+
+		// moves back into the inline storage if everything fits again
+		void shrink_to_fit();
+
+		void resize(u64 new_size);
+		void expand(u64 amount = 1);
+
+		// grows without constructing the new elements, for buffers that are about to be filled in bulk
+		void resize_uninitialized(u64 new_size);
+
+		void fill(byte value);
+
+		void append(const T* items, u64 count);
+		void append(const SmallVector& other);
+
+		Iterator insert(u64 index, const T& item);
+
+		template <typename... Args>
+		Iterator emplace(u64 index, Args&&... args);
+
+		void erase(u64 index, u64 amount = 1);
+		void erase(Iterator it, u64 amount = 1);
+
+		Iterator find(const T& item);
+
+		T* data();
+		const T* data() const;
+
+		Iterator push_front(const T& item);
+		Iterator push_back(const T& item);
+		Iterator push_back(T&& item);
+
+		void pop_front();
+		void pop_back();
+
+		template <typename... Args>
+		Iterator emplace_front(Args&&... args);
+
+		template <typename... Args>
+		Iterator emplace_back(Args&&... args);
+
+		void clear();
+		u64 size() const;
+		u64 capacity() const;
+
+		// whether the elements are still in the inline storage
+		bool is_inline() const;
+		static constexpr u64 inline_capacity() { return InlineCapacity; }
+
+		bool any() const;
+		bool empty() const;
+
+		T& front();
+		const T& front() const;
+		T& back();
+		const T& back() const;
+
+		Iterator begin();
+		ConstIterator begin() const;
+		Iterator end();
+		ConstIterator end() const;
+
+		ReverseIterator rbegin();
+		ReverseConstIterator rbegin() const;
+		ReverseIterator rend();
+		ReverseConstIterator rend() const;
+
+		ConstIterator cbegin() const;
+		ConstIterator cend() const;
+		ReverseConstIterator crbegin() const;
+		ReverseConstIterator crend() const;
+
+		T& at(u64 idx);
+		const T& at(u64 idx) const;
+
+		T& operator [] (u64 idx);
+		const T& operator [] (u64 idx) const;
+
+	private:
+		T* inline_buffer();
+
+		static T* allocate_buffer(u64 capacity);
+		static void free_buffer(T* buf);
+
+		void reallocate(u64 new_capacity);
+		void grow(u64 min_capacity);
+
+		static void relocate(T* dst, T* src, u64 count);
+		void copy_construct(T* dst, const T* src, u64 count);
+		void destroy(u64 from, u64 to);
+		void open_gap(u64 index, u64 count);
+
+		void steal(SmallVector& other);
+
+		T* m_buf;
+		u64 m_size;
+		u64 m_capacity;
+
+		alignas(T) byte m_inline[sizeof(T) * InlineCapacity];
+	};
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector()
+		: m_buf((T*)m_inline)
+		, m_size(0)
+		, m_capacity(InlineCapacity)
+	{
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector(std::initializer_list<T> data)
+		: SmallVector()
+	{
+		append(data.begin(), data.size());
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector(u64 initial_size)
+		: SmallVector()
+	{
+		resize(initial_size);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector(u64 initial_size, const T& initial_element)
+		: SmallVector()
+	{
+		allocate(initial_size);
+
+		for (u64 i = 0; i < initial_size; i++) {
+			new (m_buf + i) T(initial_element);
+		}
+
+		m_size = initial_size;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector(const T* buf, u64 length)
+		: SmallVector()
+	{
+		append(buf, length);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector(const Iterator& begin, const Iterator& end)
+		: SmallVector()
+	{
+		append(begin.operator->(), end.operator->() - begin.operator->());
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector(const SmallVector& other)
+		: SmallVector()
+	{
+		append(other.m_buf, other.m_size);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::SmallVector(SmallVector&& other) noexcept
+		: SmallVector()
+	{
+		steal(other);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>& SmallVector<T, InlineCapacity>::operator = (const SmallVector& other)
+	{
+		if (this == &other) {
+			return *this;
+		}
+
+		clear();
+		append(other.m_buf, other.m_size);
+
+		return *this;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>& SmallVector<T, InlineCapacity>::operator = (SmallVector&& other) noexcept
+	{
+		if (this == &other) {
+			return *this;
+		}
+
+		clear();
+
+		if (!is_inline())
+		{
+			free_buffer(m_buf);
+
+			m_buf = inline_buffer();
+			m_capacity = InlineCapacity;
+		}
+
+		steal(other);
+
+		return *this;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	SmallVector<T, InlineCapacity>::~SmallVector()
+	{
+		clear();
+
+		if (!is_inline()) {
+			free_buffer(m_buf);
+		}
+	}
+
+	// expects this to be empty and inline, heap buffers are handed over while inline elements have to be moved across one by one
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::steal(SmallVector& other)
+	{
+		if (other.is_inline())
+		{
+			relocate(m_buf, other.m_buf, other.m_size);
+			m_size = other.m_size;
+		}
+		else
+		{
+			m_buf = other.m_buf;
+			m_size = other.m_size;
+			m_capacity = other.m_capacity;
+
+			other.m_buf = other.inline_buffer();
+			other.m_capacity = InlineCapacity;
+		}
+
+		other.m_size = 0;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	T* SmallVector<T, InlineCapacity>::inline_buffer()
+	{
+		return (T*)m_inline;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	T* SmallVector<T, InlineCapacity>::allocate_buffer(u64 capacity)
+	{
+		if constexpr (USE_MALLOC) {
+			return (T*)std::malloc(sizeof(T) * capacity);
+		} else {
+			return (T*)::operator new (sizeof(T) * capacity, std::align_val_t(alignof(T)));
+		}
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::free_buffer(T* buf)
+	{
+		if constexpr (USE_MALLOC) {
+			std::free(buf);
+		} else {
+			::operator delete (buf, std::align_val_t(alignof(T)));
+		}
+	}
+
+	// moves count elements into uninitialised memory at dst, leaving src unconstructed
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::relocate(T* dst, T* src, u64 count)
+	{
+		if constexpr (RELOCATE_BITWISE)
+		{
+			if (count > 0) {
+				mem::copy(dst, src, sizeof(T) * count);
+			}
+		}
+		else
+		{
+			for (u64 i = 0; i < count; i++)
+			{
+				new (dst + i) T(std::move(src[i]));
+				src[i].~T();
+			}
+		}
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::reallocate(u64 new_capacity)
+	{
+		wvn_ASSERT(new_capacity >= m_size, "[SMALLVECTOR|DEBUG] Can't reallocate to less than the current size.");
+
+		if (new_capacity <= InlineCapacity)
+		{
+			if (is_inline()) {
+				return;
+			}
+
+			T* heap_buf = m_buf;
+
+			relocate(inline_buffer(), heap_buf, m_size);
+			free_buffer(heap_buf);
+
+			m_buf = inline_buffer();
+			m_capacity = InlineCapacity;
+
+			return;
+		}
+
+		if (new_capacity == m_capacity) {
+			return;
+		}
+
+		if constexpr (COPY_BITWISE && USE_MALLOC)
+		{
+			// realloc can often grow in place and skip the copy entirely
+			if (!is_inline()) {
+				m_buf = (T*)std::realloc(m_buf, sizeof(T) * new_capacity);
+				m_capacity = new_capacity;
+				return;
+			}
+		}
+
+		T* new_buf = allocate_buffer(new_capacity);
+
+		relocate(new_buf, m_buf, m_size);
+
+		if (!is_inline()) {
+			free_buffer(m_buf);
+		}
+
+		m_buf = new_buf;
+		m_capacity = new_capacity;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::grow(u64 min_capacity)
+	{
+		if (min_capacity <= m_capacity) {
+			return;
+		}
+
+		u64 new_capacity = m_capacity * 2;
+
+		if (new_capacity < min_capacity) {
+			new_capacity = min_capacity;
+		}
+
+		reallocate(new_capacity);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::copy_construct(T* dst, const T* src, u64 count)
+	{
+		if constexpr (COPY_BITWISE)
+		{
+			if (count > 0) {
+				mem::copy(dst, src, sizeof(T) * count);
+			}
+		}
+		else
+		{
+			for (u64 i = 0; i < count; i++) {
+				new (dst + i) T(src[i]);
+			}
+		}
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::destroy(u64 from, u64 to)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (u64 i = from; i < to; i++) {
+				m_buf[i].~T();
+			}
+		}
+	}
+
+	// shifts everything from index onwards up by count, leaving [index, index + count) unconstructed
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::open_gap(u64 index, u64 count)
+	{
+		grow(m_size + count);
+
+		if constexpr (RELOCATE_BITWISE)
+		{
+			if (index < m_size) {
+				mem::move(m_buf + index + count, m_buf + index, sizeof(T) * (m_size - index));
+			}
+		}
+		else
+		{
+			for (u64 i = m_size; i > index; i--)
+			{
+				new (m_buf + i - 1 + count) T(std::move(m_buf[i - 1]));
+				m_buf[i - 1].~T();
+			}
+		}
+
+		m_size += count;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::clear()
+	{
+		destroy(0, m_size);
+		m_size = 0;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::allocate(u64 capacity)
+	{
+		if (capacity <= m_capacity) {
+			return;
+		}
+
+		reallocate(capacity);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::shrink_to_fit()
+	{
+		reallocate(m_size);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::resize(u64 new_size)
+	{
+		if (new_size < m_size)
+		{
+			destroy(new_size, m_size);
+		}
+		else if (new_size > m_size)
+		{
+			grow(new_size);
+
+			for (u64 i = m_size; i < new_size; i++) {
+				new (m_buf + i) T();
+			}
+		}
+
+		m_size = new_size;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::expand(u64 amount)
+	{
+		wvn_ASSERT(amount > 0, "[SMALLVECTOR|DEBUG] Expand amount must be higher than 0");
+
+		resize(m_size + amount);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::resize_uninitialized(u64 new_size)
+	{
+		static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "[SMALLVECTOR|DEBUG] Only trivial types can be left uninitialized.");
+
+		grow(new_size);
+		m_size = new_size;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::fill(byte value)
+	{
+		mem::set(m_buf, value, sizeof(T) * m_capacity);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::append(const T* items, u64 count)
+	{
+		if (count == 0) {
+			return;
+		}
+
+		// appending part of itself, the source moves along with the buffer if it has to grow
+		if (items >= m_buf && items < m_buf + m_size)
+		{
+			u64 offset = items - m_buf;
+			grow(m_size + count);
+			items = m_buf + offset;
+		}
+		else
+		{
+			grow(m_size + count);
+		}
+
+		copy_construct(m_buf + m_size, items, count);
+		m_size += count;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::append(const SmallVector& other)
+	{
+		append(other.m_buf, other.m_size);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::insert(u64 index, const T& item)
+	{
+		return emplace(index, item);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	template <typename... Args>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::emplace(u64 index, Args&&... args)
+	{
+		wvn_ASSERT(index <= m_size, "[SMALLVECTOR|DEBUG] Index must be within bounds: INDEX=%llu, SIZE=%llu", (unsigned long long)index, (unsigned long long)m_size);
+
+		// built before the gap is opened in case the arguments refer to elements that are about to move
+		T item(std::forward<Args>(args)...);
+
+		open_gap(index, 1);
+		new (m_buf + index) T(std::move(item));
+
+		return Iterator(m_buf + index);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::erase(u64 index, u64 amount)
+	{
+		if (amount <= 0) {
+			return;
+		}
+
+		wvn_ASSERT(index + amount <= m_size, "[SMALLVECTOR|DEBUG] Erase range must be within bounds: INDEX=%llu, AMOUNT=%llu, SIZE=%llu", (unsigned long long)index, (unsigned long long)amount, (unsigned long long)m_size);
+
+		if constexpr (RELOCATE_BITWISE)
+		{
+			destroy(index, index + amount);
+			mem::move(m_buf + index, m_buf + index + amount, sizeof(T) * (m_size - index - amount));
+		}
+		else
+		{
+			for (u64 i = index; i + amount < m_size; i++) {
+				m_buf[i] = std::move(m_buf[i + amount]);
+			}
+
+			destroy(m_size - amount, m_size);
+		}
+
+		m_size -= amount;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::erase(Iterator it, u64 amount)
+	{
+		erase(&(*it) - m_buf, amount);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::find(const T& item)
+	{
+		for (u64 i = 0; i < m_size; i++) {
+			if (m_buf[i] == item) {
+				return Iterator(&m_buf[i]);
+			}
+		}
+
+		return end();
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::push_front(const T& item)
+	{
+		return emplace(0, item);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::push_back(const T& item)
+	{
+		return emplace_back(item);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::push_back(T&& item)
+	{
+		return emplace_back(std::move(item));
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::pop_front()
+	{
+		erase(0);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	void SmallVector<T, InlineCapacity>::pop_back()
+	{
+		m_buf[m_size - 1].~T();
+		m_size--;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	template <typename... Args>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::emplace_front(Args&&... args)
+	{
+		return emplace(0, std::forward<Args>(args)...);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	template <typename... Args>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::emplace_back(Args&&... args)
+	{
+		if (m_size < m_capacity)
+		{
+			new (m_buf + m_size) T(std::forward<Args>(args)...);
+		}
+		else
+		{
+			// the arguments might point into the buffer that's about to be reallocated
+			T item(std::forward<Args>(args)...);
+
+			grow(m_size + 1);
+			new (m_buf + m_size) T(std::move(item));
+		}
+
+		m_size++;
+		return Iterator(m_buf + m_size - 1);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	T* SmallVector<T, InlineCapacity>::data()
+	{
+		return m_buf;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	const T* SmallVector<T, InlineCapacity>::data() const
+	{
+		return m_buf;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	T& SmallVector<T, InlineCapacity>::front()
+	{
+		return m_buf[0];
+	}
+
+	template <typename T, u64 InlineCapacity>
+	const T& SmallVector<T, InlineCapacity>::front() const
+	{
+		return m_buf[0];
+	}
+
+	template <typename T, u64 InlineCapacity>
+	T& SmallVector<T, InlineCapacity>::back()
+	{
+		return m_buf[m_size - 1];
+	}
+
+	template <typename T, u64 InlineCapacity>
+	const T& SmallVector<T, InlineCapacity>::back() const
+	{
+		return m_buf[m_size - 1];
+	}
+
+	template <typename T, u64 InlineCapacity>
+	u64 SmallVector<T, InlineCapacity>::size() const
+	{
+		return m_size;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	u64 SmallVector<T, InlineCapacity>::capacity() const
+	{
+		return m_capacity;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	bool SmallVector<T, InlineCapacity>::is_inline() const
+	{
+		return m_buf == (const T*)m_inline;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	bool SmallVector<T, InlineCapacity>::any() const
+	{
+		return m_size != 0;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	bool SmallVector<T, InlineCapacity>::empty() const
+	{
+		return m_size == 0;
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::begin()
+	{
+		return Iterator(m_buf);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ConstIterator SmallVector<T, InlineCapacity>::begin() const
+	{
+		return ConstIterator(m_buf);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::Iterator SmallVector<T, InlineCapacity>::end()
+	{
+		return Iterator(m_buf + m_size);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ConstIterator SmallVector<T, InlineCapacity>::end() const
+	{
+		return ConstIterator(m_buf + m_size);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ReverseIterator SmallVector<T, InlineCapacity>::rbegin()
+	{
+		return ReverseIterator(m_buf + m_size - 1);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ReverseConstIterator SmallVector<T, InlineCapacity>::rbegin() const
+	{
+		return ReverseConstIterator(m_buf + m_size - 1);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ReverseIterator SmallVector<T, InlineCapacity>::rend()
+	{
+		return ReverseIterator(m_buf - 1);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ReverseConstIterator SmallVector<T, InlineCapacity>::rend() const
+	{
+		return ReverseConstIterator(m_buf - 1);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ConstIterator SmallVector<T, InlineCapacity>::cbegin() const
+	{
+		return ConstIterator(m_buf);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ConstIterator SmallVector<T, InlineCapacity>::cend() const
+	{
+		return ConstIterator(m_buf + m_size);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ReverseConstIterator SmallVector<T, InlineCapacity>::crbegin() const
+	{
+		return ReverseConstIterator(m_buf + m_size - 1);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	typename SmallVector<T, InlineCapacity>::ReverseConstIterator SmallVector<T, InlineCapacity>::crend() const
+	{
+		return ReverseConstIterator(m_buf - 1);
+	}
+
+	template <typename T, u64 InlineCapacity>
+	T& SmallVector<T, InlineCapacity>::at(u64 idx)
+	{
+		wvn_ASSERT(idx >= 0 && idx < m_size, "[SMALLVECTOR|DEBUG] Index must be within bounds: INDEX=%llu, SIZE=%llu", (unsigned long long)idx, (unsigned long long)m_size);
+		return m_buf[idx];
+	}
+
+	template <typename T, u64 InlineCapacity>
+	const T& SmallVector<T, InlineCapacity>::at(u64 idx) const
+	{
+		wvn_ASSERT(idx >= 0 && idx < m_size, "[SMALLVECTOR|DEBUG] Index must be within bounds: INDEX=%llu, SIZE=%llu", (unsigned long long)idx, (unsigned long long)m_size);
+		return m_buf[idx];
+	}
+
+	template <typename T, u64 InlineCapacity>
+	T& SmallVector<T, InlineCapacity>::operator [] (u64 idx)
+	{
+		wvn_ASSERT(idx >= 0 && idx < m_size, "[SMALLVECTOR|DEBUG] Index must be within bounds: INDEX=%llu, SIZE=%llu", (unsigned long long)idx, (unsigned long long)m_size);
+		return m_buf[idx];
+	}
+
+	template <typename T, u64 InlineCapacity>
+	const T& SmallVector<T, InlineCapacity>::operator [] (u64 idx) const
+	{
+		wvn_ASSERT(idx >= 0 && idx < m_size, "[SMALLVECTOR|DEBUG] Index must be within bounds: INDEX=%llu, SIZE=%llu", (unsigned long long)idx, (unsigned long long)m_size);
+		return m_buf[idx];
+	}
+}
+
+#endif // SMALL_VECTOR_H_
@@ -174,6 +174,13 @@ namespace wvn
 		u64 m_length;
 	};
 
+	// only owns its heap buffer, so vectors of strings can move them around with memcpy
+	template <u64 Size>
+	struct TriviallyRelocatable<Str<Size>>
+	{
+		static constexpr bool value = true;
+	};
+
 	using String = Str<512>;
 
 	template <u64 Size>
@@ -213,8 +220,6 @@ namespace wvn
 	{
 		wvn_ASSERT(other.m_length < (Size - 1), "[STRING|DEBUG] Length must not exceed maximum size.");
 
-		m_buf = new char[Size];
-
 		m_length = std::move(other.m_length);
 		m_buf = std::move(other.m_buf);
 
@@ -245,8 +250,11 @@ namespace wvn
 	{
 		wvn_ASSERT(other.m_length < (Size - 1), "[STRING|DEBUG] Length must not exceed maximum size");
 
-		if (!m_buf)
-			m_buf = new char[Size];
+		if (this == &other) {
+			return *this;
+		}
+
+		delete[] m_buf;
 
 		m_length = std::move(other.m_length);
 		m_buf = std::move(other.m_buf);
@@ -3,20 +3,37 @@
 
 #include <initializer_list>
 #include <new>
+#include <cstdlib>
+#include <type_traits>
 
 #include <wvn/common.h>
 
-// todo: does resizing work downwards
-// why don't I call resize(m_size - 1) in the pop_...() calls?????
-
 namespace wvn
 {
+	/**
+	 * Whether a T can be moved to a new address with a plain memcpy, without running its move constructor or destructor.
+	 * True for anything trivially copyable, specialise it for types that only own heap memory (like Vector itself).
+	 * Only trivially copyable types are handed to realloc, opted in types are memcpy'd into a fresh buffer instead.
+	 */
+	template <typename T>
+	struct TriviallyRelocatable
+	{
+		static constexpr bool value = std::is_trivially_copyable_v<T>;
+	};
+
 	/**
 	 * Dynamically sized array.
+	 * Grows geometrically, trivially relocatable types are moved around with memcpy / realloc instead of element by element.
 	 */
 	template <typename T>
 	class Vector
 	{
+		static constexpr bool RELOCATE_BITWISE = TriviallyRelocatable<T>::value;
+		static constexpr bool COPY_BITWISE = std::is_trivially_copyable_v<T>;
+		static constexpr bool USE_MALLOC = alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+		static constexpr u64 MIN_CAPACITY = 8;
+
     public:
 		class Iterator
 		{
@@ -93,9 +110,9 @@ namespace wvn
         Vector();
 
         Vector(std::initializer_list<T> data);
-        Vector(u64 initial_capacity);
-        Vector(u64 initial_capacity, const T& initial_element);
-		Vector(T* buf, u64 length);
+        Vector(u64 initial_size);
+        Vector(u64 initial_size, const T& initial_element);
+		Vector(const T* buf, u64 length);
 		Vector(const Iterator& begin, const Iterator& end);
 
         Vector(const Vector& other);
@@ -106,11 +123,26 @@ namespace wvn
 
         ~Vector();
 
+		// reserves room for at least this many elements without constructing any of them
         void allocate(u64 capacity);
+		void shrink_to_fit();
+
         void resize(u64 new_size);
         void expand(u64 amount = 1);
+
+		// grows without constructing the new elements, for buffers that are about to be filled in bulk
+		void resize_uninitialized(u64 new_size);
+
         void fill(byte value);
 
+		void append(const T* items, u64 count);
+		void append(const Vector& other);
+
+		Iterator insert(u64 index, const T& item);
+
+		template <typename... Args>
+		Iterator emplace(u64 index, Args&&... args);
+
 		void erase(u64 index, u64 amount = 1);
 		void erase(Iterator it, u64 amount = 1);
 
@@ -121,6 +153,7 @@ namespace wvn
 
         Iterator push_front(const T& item);
         Iterator push_back(const T& item);
+        Iterator push_back(T&& item);
 
         void pop_front();
         void pop_back();
@@ -133,6 +166,7 @@ namespace wvn
 
         void clear();
         u64 size() const;
+		u64 capacity() const;
 
 		bool any() const;
 		bool empty() const;
@@ -164,11 +198,27 @@ namespace wvn
         const T& operator [] (u64 idx) const;
 
     private:
+		static T* allocate_buffer(u64 capacity);
+		static void free_buffer(T* buf);
+
+		void reallocate(u64 new_capacity);
+		void grow(u64 min_capacity);
+
+		void copy_construct(T* dst, const T* src, u64 count);
+		void destroy(u64 from, u64 to);
+		void open_gap(u64 index, u64 count);
+
         T* m_buf;
         u64 m_size;
         u64 m_capacity;
 	};
 
+	template <typename T>
+	struct TriviallyRelocatable<Vector<T>>
+	{
+		static constexpr bool value = true;
+	};
+
     template <typename T>
     Vector<T>::Vector()
 		: m_buf(nullptr)
@@ -176,124 +226,94 @@ namespace wvn
         , m_capacity(0)
     {
     }
-    
+
     template <typename T>
     Vector<T>::Vector(std::initializer_list<T> data)
         : Vector()
     {
-        allocate(data.size());
-        m_size = data.size();
-
-        for (u64 i = 0; i < m_size; i++) {
-            new (m_buf + i) T(data.begin()[i]);
-        }
+		append(data.begin(), data.size());
     }
 
     template <typename T>
-    Vector<T>::Vector(u64 initial_capacity)
+    Vector<T>::Vector(u64 initial_size)
         : Vector()
     {
-        allocate(initial_capacity);
-        m_size = initial_capacity;
-
-        for (u64 i = 0; i < m_capacity; i++) {
-            new (m_buf + i) T();
-        }
+		resize(initial_size);
     }
 
     template <typename T>
-    Vector<T>::Vector(u64 initial_capacity, const T& initial_element)
+    Vector<T>::Vector(u64 initial_size, const T& initial_element)
         : Vector()
     {
-        allocate(initial_capacity);
-        m_size = initial_capacity;
+        allocate(initial_size);
 
-        for (u64 i = 0; i < m_capacity; i++) {
+        for (u64 i = 0; i < initial_size; i++) {
             new (m_buf + i) T(initial_element);
         }
+
+		m_size = initial_size;
     }
 
 	template <typename T>
-	Vector<T>::Vector(T* buf, u64 length)
+	Vector<T>::Vector(const T* buf, u64 length)
 		: Vector()
 	{
-		allocate(length);
-		m_size = length;
-
-		for (u64 i = 0; i < length; i++) {
-			new (m_buf + i) T(buf[i]);
-        }
+		append(buf, length);
 	}
 
 	template <typename T>
 	Vector<T>::Vector(const Iterator& begin, const Iterator& end)
 		: Vector()
 	{
-		allocate(end.m_ptr - begin.m_ptr);
-		m_size = end.m_ptr - begin.m_ptr;
-
-		for (u64 i = 0; i < m_size; i++) {
-			new (m_buf + i) T(begin.m_ptr[i]);
-        }
+		append(begin.operator->(), end.operator->() - begin.operator->());
 	}
 
     template <typename T>
     Vector<T>::Vector(const Vector& other)
         : Vector()
     {
-        if (other.m_capacity <= 0) {
-			return;
-		}
-
-		allocate(other.m_capacity);
-		clear();
-		m_size = other.size();
-
-		for (u64 i = 0; i < other.m_size; i++) {
-			new (m_buf + i) T(other.m_buf[i]);
-		}
+		append(other.m_buf, other.m_size);
     }
 
     template <typename T>
     Vector<T>::Vector(Vector&& other) noexcept
 		: Vector()
     {
-        this->m_capacity = std::move(other.m_capacity);
-        this->m_size = std::move(other.m_size);
-        this->m_buf = std::move(other.m_buf);
+        this->m_capacity = other.m_capacity;
+        this->m_size = other.m_size;
+        this->m_buf = other.m_buf;
 
         other.m_capacity = 0;
         other.m_size = 0;
         other.m_buf = nullptr;
     }
-    
+
     template <typename T>
     Vector<T>& Vector<T>::operator = (const Vector& other)
     {
-		allocate(other.m_capacity);
-		clear();
-
-		m_size = other.m_size;
-
-		for (u64 i = 0; i < other.m_size; i++) {
-			new (m_buf + i) T(other.m_buf[i]);
+		if (this == &other) {
+			return *this;
 		}
 
+		clear();
+		append(other.m_buf, other.m_size);
+
         return *this;
     }
-    
+
     template <typename T>
     Vector<T>& Vector<T>::operator = (Vector&& other) noexcept
     {
-		clear();
-
-		if (m_buf) {
-			::operator delete (m_buf, sizeof(T) * m_capacity);
+		if (this == &other) {
+			return *this;
 		}
 
-		this->m_capacity = std::move(other.m_capacity);
-		this->m_size = std::move(other.m_size);
-		this->m_buf = std::move(other.m_buf);
+		clear();
+		free_buffer(m_buf);
+
+		this->m_capacity = other.m_capacity;
+		this->m_size = other.m_size;
+		this->m_buf = other.m_buf;
 
 		other.m_capacity = 0;
 		other.m_size = 0;
@@ -306,63 +326,194 @@ namespace wvn
     Vector<T>::~Vector()
     {
         clear();
-
-		if (m_buf) {
-			::operator delete (m_buf, sizeof(T) * m_capacity);
-		}
+		free_buffer(m_buf);
 
         m_buf = nullptr;
         m_capacity = 0;
-        m_size = 0;
     }
 
-    template <typename T>
-    void Vector<T>::clear()
-    {
-        for (int i = 0; i < m_size; i++) {
-            m_buf[i].~T();
+	template <typename T>
+	T* Vector<T>::allocate_buffer(u64 capacity)
+	{
+		if constexpr (USE_MALLOC) {
+			return (T*)std::malloc(sizeof(T) * capacity);
+		} else {
+			return (T*)::operator new (sizeof(T) * capacity, std::align_val_t(alignof(T)));
 		}
+	}
 
-		mem::set(m_buf, 0, m_size * sizeof(T));
-        m_size = 0;
-    }
-
-    template <typename T>
-    void Vector<T>::allocate(u64 capacity)
-    {
-        if (capacity <= m_capacity) {
+	template <typename T>
+	void Vector<T>::free_buffer(T* buf)
+	{
+		if (!buf) {
 			return;
 		}
 
-		u64 new_capacity = capacity > 8 ? capacity : 8;
+		if constexpr (USE_MALLOC) {
+			std::free(buf);
+		} else {
+			::operator delete (buf, std::align_val_t(alignof(T)));
+		}
+	}
 
-		while (new_capacity < capacity) {
-			new_capacity *= 2;
+	template <typename T>
+	void Vector<T>::reallocate(u64 new_capacity)
+	{
+		wvn_ASSERT(new_capacity >= m_size, "[VECTOR|DEBUG] Can't reallocate to less than the current size.");
+
+		if (new_capacity == m_capacity) {
+			return;
 		}
 
-		T* new_buf = (T*)::operator new (sizeof(T) * new_capacity);
-		mem::set(new_buf, 0, sizeof(T) * new_capacity);
+		if (new_capacity == 0)
+		{
+			free_buffer(m_buf);
+			m_buf = nullptr;
+			m_capacity = 0;
+			return;
+		}
 
-		for (int i = 0; i < m_size; i++) {
-			new (new_buf + i) T(std::move(m_buf[i]));
+		if constexpr (COPY_BITWISE && USE_MALLOC)
+		{
+			// realloc can often grow in place and skip the copy entirely
+			m_buf = (T*)std::realloc(m_buf, sizeof(T) * new_capacity);
 		}
+		else
+		{
+			T* new_buf = allocate_buffer(new_capacity);
 
-		if (m_buf) {
-			::operator delete (m_buf, sizeof(T) * m_capacity);
+			if constexpr (RELOCATE_BITWISE)
+			{
+				if (m_size > 0) {
+					mem::copy(new_buf, m_buf, sizeof(T) * m_size);
+				}
+			}
+			else
+			{
+				for (u64 i = 0; i < m_size; i++)
+				{
+					new (new_buf + i) T(std::move(m_buf[i]));
+					m_buf[i].~T();
+				}
+			}
+
+			free_buffer(m_buf);
+			m_buf = new_buf;
 		}
 
-		m_buf = new_buf;
 		m_capacity = new_capacity;
+	}
+
+	template <typename T>
+	void Vector<T>::grow(u64 min_capacity)
+	{
+		if (min_capacity <= m_capacity) {
+			return;
+		}
+
+		u64 new_capacity = m_capacity * 2;
+
+		if (new_capacity < min_capacity) {
+			new_capacity = min_capacity;
+		}
+
+		if (new_capacity < MIN_CAPACITY) {
+			new_capacity = MIN_CAPACITY;
+		}
+
+		reallocate(new_capacity);
+	}
+
+	template <typename T>
+	void Vector<T>::copy_construct(T* dst, const T* src, u64 count)
+	{
+		if constexpr (COPY_BITWISE)
+		{
+			if (count > 0) {
+				mem::copy(dst, src, sizeof(T) * count);
+			}
+		}
+		else
+		{
+			for (u64 i = 0; i < count; i++) {
+				new (dst + i) T(src[i]);
+			}
+		}
+	}
+
+	template <typename T>
+	void Vector<T>::destroy(u64 from, u64 to)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (u64 i = from; i < to; i++) {
+				m_buf[i].~T();
+			}
+		}
+	}
+
+	// shifts everything from index onwards up by count, leaving [index, index + count) unconstructed
+	template <typename T>
+	void Vector<T>::open_gap(u64 index, u64 count)
+	{
+		grow(m_size + count);
+
+		if constexpr (RELOCATE_BITWISE)
+		{
+			if (index < m_size) {
+				mem::move(m_buf + index + count, m_buf + index, sizeof(T) * (m_size - index));
+			}
+		}
+		else
+		{
+			for (u64 i = m_size; i > index; i--)
+			{
+				new (m_buf + i - 1 + count) T(std::move(m_buf[i - 1]));
+				m_buf[i - 1].~T();
+			}
+		}
+
+		m_size += count;
+	}
+
+    template <typename T>
+    void Vector<T>::clear()
+    {
+		destroy(0, m_size);
+        m_size = 0;
     }
 
+    template <typename T>
+    void Vector<T>::allocate(u64 capacity)
+    {
+        if (capacity <= m_capacity) {
+			return;
+		}
+
+		reallocate(capacity > MIN_CAPACITY ? capacity : MIN_CAPACITY);
+    }
+
+	template <typename T>
+	void Vector<T>::shrink_to_fit()
+	{
+		reallocate(m_size);
+	}
+
     template <typename T>
     void Vector<T>::resize(u64 new_size)
     {
-        if (new_size < m_size) {
-            erase(new_size, m_size - new_size);
-        } else if (new_size > m_size) {
-            expand(new_size - m_size);
-        }
+        if (new_size < m_size)
+		{
+			destroy(new_size, m_size);
+		}
+		else if (new_size > m_size)
+		{
+			grow(new_size);
+
+			for (u64 i = m_size; i < new_size; i++) {
+				new (m_buf + i) T();
+			}
+		}
 
 		m_size = new_size;
     }
@@ -372,13 +523,18 @@ namespace wvn
     {
         wvn_ASSERT(amount > 0, "[VECTOR|DEBUG] Expand amount must be higher than 0");
 
-        allocate(m_size + amount);
-
-        for (int i = 0; i < amount; i++) {
-            new (m_buf + m_size + i) T();
-        }
+		resize(m_size + amount);
     }
 
+	template <typename T>
+	void Vector<T>::resize_uninitialized(u64 new_size)
+	{
+		static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "[VECTOR|DEBUG] Only trivial types can be left uninitialized.");
+
+		grow(new_size);
+		m_size = new_size;
+	}
+
     template <typename T>
     void Vector<T>::fill(byte value)
     {
@@ -386,41 +542,87 @@ namespace wvn
     }
 
 	template <typename T>
-	void Vector<T>::erase(u64 index, u64 amount)
+	void Vector<T>::append(const T* items, u64 count)
 	{
-		if (amount <= 0) {
+		if (count == 0) {
 			return;
 		}
 
-		for (u64 i = 0; i < amount; i++) {
-			m_buf[i + index].~T();
+		// appending part of itself, the source moves along with the buffer if it has to grow
+		if (items >= m_buf && items < m_buf + m_size)
+		{
+			u64 offset = items - m_buf;
+			grow(m_size + count);
+			items = m_buf + offset;
+		}
+		else
+		{
+			grow(m_size + count);
 		}
 
-		for (u64 i = 0; i < m_size - amount; i++) {
-			m_buf[i + index] = std::move(m_buf[i + index + amount]);
-        }
+		copy_construct(m_buf + m_size, items, count);
+		m_size += count;
+	}
 
-		m_size -= amount;
+	template <typename T>
+	void Vector<T>::append(const Vector& other)
+	{
+		append(other.m_buf, other.m_size);
 	}
 
 	template <typename T>
-	void Vector<T>::erase(Iterator it, u64 amount)
+	typename Vector<T>::Iterator Vector<T>::insert(u64 index, const T& item)
+	{
+		return emplace(index, item);
+	}
+
+	template <typename T>
+	template <typename... Args>
+	typename Vector<T>::Iterator Vector<T>::emplace(u64 index, Args&&... args)
+	{
+		wvn_ASSERT(index <= m_size, "[VECTOR|DEBUG] Index must be within bounds: INDEX=%llu, SIZE=%llu", index, m_size);
+
+		// built before the gap is opened in case the arguments refer to elements that are about to move
+		T item(std::forward<Args>(args)...);
+
+		open_gap(index, 1);
+		new (m_buf + index) T(std::move(item));
+
+		return Iterator(m_buf + index);
+	}
+
+	template <typename T>
+	void Vector<T>::erase(u64 index, u64 amount)
 	{
 		if (amount <= 0) {
 			return;
 		}
 
-		for (int i = 0; i < m_size - amount; i++) {
-			*(it.m_ptr + i) = std::move(*(it.m_ptr + i + amount));
-        }
+		wvn_ASSERT(index + amount <= m_size, "[VECTOR|DEBUG] Erase range must be within bounds: INDEX=%llu, AMOUNT=%llu, SIZE=%llu", index, amount, m_size);
 
-		for (int i = m_size - amount; i < m_size; i++) {
-			it->~T();
-        }
+		if constexpr (RELOCATE_BITWISE)
+		{
+			destroy(index, index + amount);
+			mem::move(m_buf + index, m_buf + index + amount, sizeof(T) * (m_size - index - amount));
+		}
+		else
+		{
+			for (u64 i = index; i + amount < m_size; i++) {
+				m_buf[i] = std::move(m_buf[i + amount]);
+			}
+
+			destroy(m_size - amount, m_size);
+		}
 
 		m_size -= amount;
 	}
 
+	template <typename T>
+	void Vector<T>::erase(Iterator it, u64 amount)
+	{
+		erase(&(*it) - m_buf, amount);
+	}
+
 	template <typename T>
 	typename Vector<T>::Iterator Vector<T>::find(const T& item)
 	{
@@ -436,34 +638,30 @@ namespace wvn
     template <typename T>
 	Vector<T>::Iterator Vector<T>::push_front(const T& item)
     {
-        resize(m_size + 1);
-        mem::move(m_buf + 1, m_buf, sizeof(T) * m_size);
-        new (m_buf) T(std::move(item));
-        m_size++;
-		return Iterator(m_buf);
+		return emplace(0, item);
     }
 
     template <typename T>
 	Vector<T>::Iterator Vector<T>::push_back(const T& item)
     {
-        resize(m_size + 1);
-        new (m_buf + m_size - 1) T(std::move(item));
-		return Iterator(m_buf + m_size - 1);
+		return emplace_back(item);
+    }
+
+    template <typename T>
+	Vector<T>::Iterator Vector<T>::push_back(T&& item)
+    {
+		return emplace_back(std::move(item));
     }
 
     template <typename T>
     void Vector<T>::pop_front()
     {
-        T item = std::move(m_buf[0]);
-        m_buf[0].~T();
-		mem::move(m_buf, m_buf + 1, m_size - 1);
-        m_size--;
+		erase(0);
     }
 
     template <typename T>
     void Vector<T>::pop_back()
     {
-        T item = std::move(m_buf[m_size - 1]);
         m_buf[m_size - 1].~T();
         m_size--;
     }
@@ -472,18 +670,27 @@ namespace wvn
 	template <typename... Args>
 	Vector<T>::Iterator Vector<T>::emplace_front(Args&&... args)
 	{
-		resize(m_size + 1);
-		mem::move(m_buf + 1, m_buf, sizeof(T) * (m_size - 1));
-		new (m_buf) T(std::forward<Args>(args)...);
-		return Iterator(m_buf);
+		return emplace(0, std::forward<Args>(args)...);
 	}
 
 	template <typename T>
 	template <typename... Args>
 	Vector<T>::Iterator Vector<T>::emplace_back(Args&&... args)
 	{
-		resize(m_size + 1);
-		new (m_buf + m_size - 1) T(std::forward<Args>(args)...);
+		if (m_size < m_capacity)
+		{
+			new (m_buf + m_size) T(std::forward<Args>(args)...);
+		}
+		else
+		{
+			// the arguments might point into the buffer that's about to be reallocated
+			T item(std::forward<Args>(args)...);
+
+			grow(m_size + 1);
+			new (m_buf + m_size) T(std::move(item));
+		}
+
+		m_size++;
 		return Iterator(m_buf + m_size - 1);
 	}
 
@@ -529,6 +736,12 @@ namespace wvn
         return m_size;
     }
 
+	template <typename T>
+	u64 Vector<T>::capacity() const
+	{
+		return m_capacity;
+	}
+
 	template <typename T>
 	bool Vector<T>::any() const
 	{
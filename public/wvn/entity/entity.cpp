@@ -10,6 +10,7 @@ Entity::Entity()
 	: m_flags(0)
 	, m_id(NULL_ID)
     , m_transform()
+    , m_transform_node(TransformHierarchy::NULL_ID)
     , m_rigidbody(nullptr)
     , m_renderable_object(nullptr)
     , m_velocity()
@@ -26,6 +27,16 @@ Transform3D& Entity::get_transform()
 	return m_transform;
 }
 
+TransformNodeID Entity::get_transform_node() const
+{
+	return m_transform_node;
+}
+
+void Entity::set_transform_node(TransformNodeID node)
+{
+	m_transform_node = node;
+}
+
 gfx::RenderableObjectHandle Entity::get_renderable_object()
 {
 	return m_renderable_object;
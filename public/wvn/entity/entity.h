@@ -3,6 +3,7 @@
 
 #include <wvn/entity/entity_common.h>
 #include <wvn/maths/transform_3d.h>
+#include <wvn/maths/transform_hierarchy.h>
 #include <wvn/graphics/renderable_object.h>
 
 namespace wvn::phys { class RigidBody; }
@@ -37,6 +38,11 @@ namespace wvn::ent
 		virtual void tick();
 
 		Transform3D& get_transform();
+
+		// node in EntityMgr::transforms(), destroyed along with the entity
+		TransformNodeID get_transform_node() const;
+		void set_transform_node(TransformNodeID node);
+
 		gfx::RenderableObjectHandle get_renderable_object();
 
 		void add_flag(u64 flag);
@@ -54,6 +60,7 @@ namespace wvn::ent
 
 	protected:
 		Transform3D m_transform;
+		TransformNodeID m_transform_node;
 		phys::RigidBody* m_rigidbody;
 		gfx::RenderableObjectHandle m_renderable_object;
 
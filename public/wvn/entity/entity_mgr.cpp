@@ -13,6 +13,7 @@ EntityMgr::EntityMgr()
 	, m_entities_destroying()
 	, m_free_ids()
 	, m_unique_id(Entity::NULL_ID + 1)
+	, m_transforms()
 {
 	dev::LogMgr::get_singleton()->print("[ACTOR] Initialized!");
 }
@@ -54,6 +55,7 @@ void EntityMgr::tick_post_animation()
 
 void EntityMgr::tick_post_physics_update()
 {
+	m_transforms.update();
 }
 
 void EntityMgr::resolve_initializing()
@@ -73,6 +75,12 @@ void EntityMgr::resolve_removing()
 
 	for (auto& ent : m_entities_destroying)
 	{
+		TransformNodeID node = ent->get_transform_node();
+
+		if (m_transforms.is_valid(node)) {
+			m_transforms.destroy(node);
+		}
+
 		delete ent.get();
 		m_entities.erase(ent.id());
 		m_free_ids.push_back(ent.id());
@@ -100,7 +108,7 @@ Entity* EntityMgr::fetch(const EntityHandle& ent)
 	return m_entities[ent.id()];
 }
 
-void EntityMgr::foreach(const Function<void(EntityHandle&)>& fn)
+void EntityMgr::foreach(FunctionRef<void(EntityHandle&)> fn)
 {
 	for (auto& [id, ent] : m_entities)
 	{
@@ -109,7 +117,7 @@ void EntityMgr::foreach(const Function<void(EntityHandle&)>& fn)
 	}
 }
 
-void EntityMgr::foreach(u64 mask, const Function<void(EntityHandle&)>& fn)
+void EntityMgr::foreach(u64 mask, FunctionRef<void(EntityHandle&)> fn)
 {
 	for (auto& [id, ent] : m_entities)
 	{
@@ -121,7 +129,7 @@ void EntityMgr::foreach(u64 mask, const Function<void(EntityHandle&)>& fn)
 	}
 }
 
-void EntityMgr::foreach_stoppable(const Function<bool(EntityHandle&)>& fn)
+void EntityMgr::foreach_stoppable(FunctionRef<bool(EntityHandle&)> fn)
 {
 	for (auto& [id, ent] : m_entities)
 	{
@@ -133,7 +141,7 @@ void EntityMgr::foreach_stoppable(const Function<bool(EntityHandle&)>& fn)
 	}
 }
 
-void EntityMgr::foreach_stoppable(u64 mask, const Function<bool(EntityHandle&)>& fn)
+void EntityMgr::foreach_stoppable(u64 mask, FunctionRef<bool(EntityHandle&)> fn)
 {
 	for (auto& [id, ent] : m_entities)
 	{
@@ -147,3 +155,8 @@ void EntityMgr::foreach_stoppable(u64 mask, const Function<bool(EntityHandle&)>&
 		}
 	}
 }
+
+TransformHierarchy& EntityMgr::transforms()
+{
+	return m_transforms;
+}
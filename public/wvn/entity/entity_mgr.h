@@ -8,6 +8,8 @@
 #include <wvn/container/deque.h>
 #include <wvn/container/function.h>
 
+#include <wvn/maths/transform_hierarchy.h>
+
 #include <wvn/entity/entity.h>
 #include <wvn/entity/entity_handle.h>
 #include <wvn/entity/entity_common.h>
@@ -45,10 +47,13 @@ namespace wvn::ent
 		bool is_valid(const EntityHandle& ent);
 		Entity* fetch(const EntityHandle& ent);
 
-		void foreach(const Function<void(EntityHandle&)>& fn);
-		void foreach(u64 mask, const Function<void(EntityHandle&)>& fn);
-		void foreach_stoppable(const Function<bool(EntityHandle&)>& fn);
-		void foreach_stoppable(u64 mask, const Function<bool(EntityHandle&)>& fn);
+		void foreach(FunctionRef<void(EntityHandle&)> fn);
+		void foreach(u64 mask, FunctionRef<void(EntityHandle&)> fn);
+		void foreach_stoppable(FunctionRef<bool(EntityHandle&)> fn);
+		void foreach_stoppable(u64 mask, FunctionRef<bool(EntityHandle&)> fn);
+
+		// parented transforms for entities, renderables and anything attached to them, updated after physics each frame
+		TransformHierarchy& transforms();
 
 	private:
 		void resolve_initializing();
@@ -60,6 +65,8 @@ namespace wvn::ent
 
 		Deque<EntityID> m_free_ids;
 		EntityID m_unique_id;
+
+		TransformHierarchy m_transforms;
 	};
 
 	template <typename T, typename... Args>
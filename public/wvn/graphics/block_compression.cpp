@@ -0,0 +1,831 @@
+#include <wvn/graphics/block_compression.h>
+#include <wvn/maths/calc.h>
+
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define wvn_BC_SSE 1
+#include <emmintrin.h>
+#else
+#define wvn_BC_SSE 0
+#endif
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	// block split up into one array per channel so four texels can be compared against a palette entry at once
+	struct BlockSoA
+	{
+		alignas(16) float ch[4][bc::BLOCK_TEXELS];
+	};
+
+	constexpr float BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	void load_block(const Colour* texels, BlockSoA* soa)
+	{
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+		{
+			soa->ch[0][i] = texels[i].r;
+			soa->ch[1][i] = texels[i].g;
+			soa->ch[2][i] = texels[i].b;
+			soa->ch[3][i] = texels[i].a;
+		}
+	}
+
+	// nearest palette entry for every texel over the first few channels, returns the total squared error
+	float select_indices(const BlockSoA& block, const float (*palette)[4], u32 palette_count, u32 channels, u8* indices)
+	{
+		float total = 0.0f;
+
+#if wvn_BC_SSE
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i += 4)
+		{
+			__m128 best = _mm_set1_ps(FLT_MAX);
+			__m128i best_idx = _mm_setzero_si128();
+
+			for (u32 p = 0; p < palette_count; p++)
+			{
+				__m128 dist = _mm_setzero_ps();
+
+				for (u32 c = 0; c < channels; c++)
+				{
+					__m128 d = _mm_sub_ps(_mm_load_ps(&block.ch[c][i]), _mm_set1_ps(palette[p][c]));
+					dist = _mm_add_ps(dist, _mm_mul_ps(d, d));
+				}
+
+				__m128i closer = _mm_castps_si128(_mm_cmplt_ps(dist, best));
+
+				best = _mm_min_ps(dist, best);
+				best_idx = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(p)), _mm_andnot_si128(closer, best_idx));
+			}
+
+			alignas(16) s32 idx[4];
+			alignas(16) float err[4];
+
+			_mm_store_si128((__m128i*)idx, best_idx);
+			_mm_store_ps(err, best);
+
+			for (u32 j = 0; j < 4; j++)
+			{
+				indices[i + j] = (u8)idx[j];
+				total += err[j];
+			}
+		}
+#else
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+		{
+			float best = FLT_MAX;
+
+			for (u32 p = 0; p < palette_count; p++)
+			{
+				float dist = 0.0f;
+
+				for (u32 c = 0; c < channels; c++)
+				{
+					float d = block.ch[c][i] - palette[p][c];
+					dist += d * d;
+				}
+
+				if (dist < best)
+				{
+					best = dist;
+					indices[i] = (u8)p;
+				}
+			}
+
+			total += best;
+		}
+#endif // wvn_BC_SSE
+
+		return total;
+	}
+
+	// principal axis of the texels through power iteration, endpoints are the extremes of the texels projected onto it
+	void fit_principal_axis(const BlockSoA& block, u32 channels, const float* mask, float* ep0, float* ep1)
+	{
+		float mean[4] = {};
+		float total = 0.0f;
+
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+		{
+			for (u32 c = 0; c < channels; c++) {
+				mean[c] += block.ch[c][i] * mask[i];
+			}
+
+			total += mask[i];
+		}
+
+		if (total <= 0.0f) {
+			total = 1.0f;
+		}
+
+		for (u32 c = 0; c < channels; c++) {
+			mean[c] /= total;
+		}
+
+		float cov[4][4] = {};
+		float min[4] = { 255.0f, 255.0f, 255.0f, 255.0f };
+		float max[4] = {};
+
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+		{
+			if (mask[i] <= 0.0f) {
+				continue;
+			}
+
+			for (u32 a = 0; a < channels; a++)
+			{
+				float da = block.ch[a][i] - mean[a];
+
+				for (u32 b = 0; b < channels; b++) {
+					cov[a][b] += da * (block.ch[b][i] - mean[b]);
+				}
+
+				min[a] = CalcF::min(min[a], block.ch[a][i]);
+				max[a] = CalcF::max(max[a], block.ch[a][i]);
+			}
+		}
+
+		float axis[4] = {};
+
+		for (u32 c = 0; c < channels; c++) {
+			axis[c] = max[c] - min[c];
+		}
+
+		for (u32 iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+
+			for (u32 a = 0; a < channels; a++)
+			{
+				for (u32 b = 0; b < channels; b++) {
+					next[a] += cov[a][b] * axis[b];
+				}
+
+				length += next[a] * next[a];
+			}
+
+			if (length <= 1e-8f) {
+				break;
+			}
+
+			length = CalcF::sqrt(length);
+
+			for (u32 c = 0; c < channels; c++) {
+				axis[c] = next[c] / length;
+			}
+		}
+
+		float axis_length = 0.0f;
+
+		for (u32 c = 0; c < channels; c++) {
+			axis_length += axis[c] * axis[c];
+		}
+
+		if (axis_length <= 1e-8f)
+		{
+			for (u32 c = 0; c < channels; c++) {
+				ep0[c] = ep1[c] = mean[c];
+			}
+
+			return;
+		}
+
+		float lo = FLT_MAX;
+		float hi = -FLT_MAX;
+
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+		{
+			if (mask[i] <= 0.0f) {
+				continue;
+			}
+
+			float t = 0.0f;
+
+			for (u32 c = 0; c < channels; c++) {
+				t += (block.ch[c][i] - mean[c]) * axis[c];
+			}
+
+			lo = CalcF::min(lo, t);
+			hi = CalcF::max(hi, t);
+		}
+
+		for (u32 c = 0; c < channels; c++)
+		{
+			ep0[c] = CalcF::clamp(mean[c] + (axis[c] * lo), 0.0f, 255.0f);
+			ep1[c] = CalcF::clamp(mean[c] + (axis[c] * hi), 0.0f, 255.0f);
+		}
+	}
+
+	// least squares fit of the endpoints given each texel's position between them
+	bool refine_endpoints(const BlockSoA& block, u32 channels, const float* mask, const u8* indices, const float* index_t, float* ep0, float* ep1)
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[4] = {};
+		float bx[4] = {};
+
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+		{
+			float t = index_t[indices[i]];
+			float a = (1.0f - t) * mask[i];
+			float b = t * mask[i];
+
+			aa += a * (1.0f - t);
+			ab += a * t;
+			bb += b * t;
+
+			for (u32 c = 0; c < channels; c++)
+			{
+				ax[c] += a * block.ch[c][i];
+				bx[c] += b * block.ch[c][i];
+			}
+		}
+
+		float det = (aa * bb) - (ab * ab);
+
+		if (CalcF::abs(det) < 1e-6f) {
+			return false;
+		}
+
+		float inv_det = 1.0f / det;
+
+		for (u32 c = 0; c < channels; c++)
+		{
+			ep0[c] = CalcF::clamp(((ax[c] * bb) - (bx[c] * ab)) * inv_det, 0.0f, 255.0f);
+			ep1[c] = CalcF::clamp(((bx[c] * aa) - (ax[c] * ab)) * inv_det, 0.0f, 255.0f);
+		}
+
+		return true;
+	}
+
+	u16 pack_565(const float* c)
+	{
+		u16 r = (u16)CalcF::clamp(CalcF::floor((c[0] * 31.0f / 255.0f) + 0.5f), 0.0f, 31.0f);
+		u16 g = (u16)CalcF::clamp(CalcF::floor((c[1] * 63.0f / 255.0f) + 0.5f), 0.0f, 63.0f);
+		u16 b = (u16)CalcF::clamp(CalcF::floor((c[2] * 31.0f / 255.0f) + 0.5f), 0.0f, 31.0f);
+
+		return (r << 11) | (g << 5) | b;
+	}
+
+	void unpack_565(u16 packed, float* c)
+	{
+		u32 r = (packed >> 11) & 31;
+		u32 g = (packed >> 5) & 63;
+		u32 b = packed & 31;
+
+		c[0] = (float)((r << 3) | (r >> 2));
+		c[1] = (float)((g << 2) | (g >> 4));
+		c[2] = (float)((b << 3) | (b >> 2));
+		c[3] = 255.0f;
+	}
+
+	void bc1_palette(u16 c0, u16 c1, bool four_colour, float (*palette)[4])
+	{
+		unpack_565(c0, palette[0]);
+		unpack_565(c1, palette[1]);
+
+		for (u32 c = 0; c < 3; c++)
+		{
+			if (four_colour)
+			{
+				palette[2][c] = CalcF::floor(((2.0f * palette[0][c]) + palette[1][c]) / 3.0f);
+				palette[3][c] = CalcF::floor((palette[0][c] + (2.0f * palette[1][c])) / 3.0f);
+			}
+			else
+			{
+				palette[2][c] = CalcF::floor((palette[0][c] + palette[1][c]) / 2.0f);
+				palette[3][c] = 0.0f;
+			}
+		}
+
+		palette[2][3] = 255.0f;
+		palette[3][3] = four_colour ? 255.0f : 0.0f;
+	}
+
+	void write_bc1(byte* block, u16 c0, u16 c1, const u8* indices)
+	{
+		u32 bits = 0;
+
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++) {
+			bits |= (u32)indices[i] << (i * 2);
+		}
+
+		block[0] = c0 & 0xFF;
+		block[1] = c0 >> 8;
+		block[2] = c1 & 0xFF;
+		block[3] = c1 >> 8;
+		block[4] = bits & 0xFF;
+		block[5] = (bits >> 8) & 0xFF;
+		block[6] = (bits >> 16) & 0xFF;
+		block[7] = (bits >> 24) & 0xFF;
+	}
+
+	void encode_bc1_colour(const Colour* texels, byte* block, bool punch_through)
+	{
+		BlockSoA soa;
+		load_block(texels, &soa);
+
+		float mask[bc::BLOCK_TEXELS];
+		bool transparent = false;
+
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+		{
+			bool hidden = punch_through && texels[i].a < 128;
+			mask[i] = hidden ? 0.0f : 1.0f;
+			transparent |= hidden;
+		}
+
+		// four colour mode needs c0 > c1, three colour mode (with a transparent entry) needs c0 <= c1
+		const float four_colour_t[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+		const float three_colour_t[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+		const float* index_t = transparent ? three_colour_t : four_colour_t;
+
+		float ep0[4] = {}, ep1[4] = {};
+		fit_principal_axis(soa, 3, mask, ep0, ep1);
+
+		u16 best_c0 = 0, best_c1 = 0;
+		u8 best_indices[bc::BLOCK_TEXELS] = {};
+		float best_error = FLT_MAX;
+
+		for (u32 attempt = 0; attempt < 3; attempt++)
+		{
+			u16 c0 = pack_565(ep0);
+			u16 c1 = pack_565(ep1);
+
+			bool swapped = transparent ? (c0 > c1) : (c0 < c1);
+
+			if (swapped) {
+				u16 tmp = c0; c0 = c1; c1 = tmp;
+			}
+
+			float palette[4][4];
+			bc1_palette(c0, c1, !transparent && c0 != c1, palette);
+
+			u8 indices[bc::BLOCK_TEXELS];
+			float error = select_indices(soa, palette, (transparent || c0 == c1) ? 3 : 4, 3, indices);
+
+			if (transparent)
+			{
+				error = 0.0f;
+
+				for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+				{
+					if (mask[i] <= 0.0f) {
+						indices[i] = 3;
+						continue;
+					}
+
+					for (u32 c = 0; c < 3; c++) {
+						float d = soa.ch[c][i] - palette[indices[i]][c];
+						error += d * d;
+					}
+				}
+			}
+
+			if (error < best_error)
+			{
+				best_error = error;
+				best_c0 = c0;
+				best_c1 = c1;
+				mem::copy(best_indices, indices, sizeof(indices));
+			}
+
+			if (best_error <= 0.0f) {
+				break;
+			}
+
+			// the indices were picked against the (possibly swapped) quantized endpoints, so refine those
+			if (swapped) {
+				for (u32 c = 0; c < 3; c++) { float tmp = ep0[c]; ep0[c] = ep1[c]; ep1[c] = tmp; }
+			}
+
+			if (!refine_endpoints(soa, 3, mask, indices, index_t, ep0, ep1)) {
+				break;
+			}
+		}
+
+		write_bc1(block, best_c0, best_c1, best_indices);
+	}
+
+	void bc4_palette(u8 a0, u8 a1, float (*palette)[4])
+	{
+		palette[0][0] = a0;
+		palette[1][0] = a1;
+
+		for (u32 i = 2; i < 8; i++) {
+			palette[i][0] = (float)((((8 - i) * a0) + ((i - 1) * a1)) / 7);
+		}
+	}
+
+	void write_bits(byte* block, u32* bit, u32 value, u32 count)
+	{
+		for (u32 i = 0; i < count; i++, (*bit)++)
+		{
+			if (value & (1u << i)) {
+				block[(*bit) >> 3] |= 1 << ((*bit) & 7);
+			}
+		}
+	}
+
+	u32 read_bits(const byte* block, u32* bit, u32 count)
+	{
+		u32 value = 0;
+
+		for (u32 i = 0; i < count; i++, (*bit)++) {
+			value |= (u32)((block[(*bit) >> 3] >> ((*bit) & 7)) & 1) << i;
+		}
+
+		return value;
+	}
+
+	// 7 bit endpoint + a p-bit shared by all of its channels, picks whichever p-bit gets closer
+	void quantize_bc7_endpoint(const float* endpoint, u8* q, u8* p)
+	{
+		float best_error = FLT_MAX;
+
+		for (u8 pbit = 0; pbit < 2; pbit++)
+		{
+			u8 candidate[4];
+			float error = 0.0f;
+
+			for (u32 c = 0; c < 4; c++)
+			{
+				candidate[c] = (u8)CalcF::clamp(CalcF::floor(((endpoint[c] - pbit) / 2.0f) + 0.5f), 0.0f, 127.0f);
+
+				float d = (float)((candidate[c] << 1) | pbit) - endpoint[c];
+				error += d * d;
+			}
+
+			if (error < best_error)
+			{
+				best_error = error;
+				mem::copy(q, candidate, sizeof(candidate));
+				*p = pbit;
+			}
+		}
+	}
+
+	void bc7_palette(const u8* q0, u8 p0, const u8* q1, u8 p1, float (*palette)[4])
+	{
+		for (u32 c = 0; c < 4; c++)
+		{
+			u32 e0 = (q0[c] << 1) | p0;
+			u32 e1 = (q1[c] << 1) | p1;
+
+			for (u32 i = 0; i < 16; i++) {
+				palette[i][c] = (float)((((64 - (u32)BC7_WEIGHTS[i]) * e0) + ((u32)BC7_WEIGHTS[i] * e1) + 32) >> 6);
+			}
+		}
+	}
+}
+
+bool bc::is_block_compressed(TextureFormat format)
+{
+	return block_bytes(format) > 0;
+}
+
+u32 bc::block_bytes(TextureFormat format)
+{
+	switch (format)
+	{
+	case TEX_FORMAT_BC1_RGBA_UNORM:
+	case TEX_FORMAT_BC1_RGBA_SRGB:
+		return 8;
+
+	case TEX_FORMAT_BC3_UNORM:
+	case TEX_FORMAT_BC3_SRGB:
+	case TEX_FORMAT_BC5_UNORM:
+	case TEX_FORMAT_BC7_UNORM:
+	case TEX_FORMAT_BC7_SRGB:
+		return 16;
+
+	default:
+		return 0;
+	}
+}
+
+u64 bc::level_size(TextureFormat format, u32 width, u32 height)
+{
+	u64 blocks_x = (CalcU::max(width, 1) + BLOCK_DIM - 1) / BLOCK_DIM;
+	u64 blocks_y = (CalcU::max(height, 1) + BLOCK_DIM - 1) / BLOCK_DIM;
+
+	return blocks_x * blocks_y * block_bytes(format);
+}
+
+void bc::encode_bc1(const Colour* texels, byte* block, bool punch_through)
+{
+	encode_bc1_colour(texels, block, punch_through);
+}
+
+void bc::encode_bc3(const Colour* texels, byte* block)
+{
+	u8 alpha[BLOCK_TEXELS];
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+		alpha[i] = texels[i].a;
+	}
+
+	encode_bc4(alpha, block);
+	encode_bc1_colour(texels, block + 8, false);
+}
+
+void bc::encode_bc4(const u8* values, byte* block)
+{
+	BlockSoA soa;
+	u8 a0 = 0, a1 = 255;
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++)
+	{
+		soa.ch[0][i] = values[i];
+
+		a0 = CalcU::max(a0, values[i]);
+		a1 = CalcU::min(a1, values[i]);
+	}
+
+	u8 indices[BLOCK_TEXELS] = {};
+
+	// a0 > a1 selects the eight value mode, when they are equal every texel is just a0
+	if (a0 > a1)
+	{
+		float palette[8][4];
+		bc4_palette(a0, a1, palette);
+		select_indices(soa, palette, 8, 1, indices);
+	}
+
+	mem::set(block, 0, 8);
+
+	block[0] = a0;
+	block[1] = a1;
+
+	u32 bit = 16;
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+		write_bits(block, &bit, indices[i], 3);
+	}
+}
+
+void bc::encode_bc5(const Colour* texels, byte* block)
+{
+	u8 red[BLOCK_TEXELS];
+	u8 green[BLOCK_TEXELS];
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++)
+	{
+		red[i] = texels[i].r;
+		green[i] = texels[i].g;
+	}
+
+	encode_bc4(red, block);
+	encode_bc4(green, block + 8);
+}
+
+void bc::encode_bc7(const Colour* texels, byte* block)
+{
+	BlockSoA soa;
+	load_block(texels, &soa);
+
+	const float mask[BLOCK_TEXELS] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+	float index_t[16];
+
+	for (u32 i = 0; i < 16; i++) {
+		index_t[i] = BC7_WEIGHTS[i] / 64.0f;
+	}
+
+	float ep0[4] = {}, ep1[4] = {};
+	fit_principal_axis(soa, 4, mask, ep0, ep1);
+
+	u8 best_q0[4] = {}, best_q1[4] = {};
+	u8 best_p0 = 0, best_p1 = 0;
+	u8 best_indices[BLOCK_TEXELS] = {};
+	float best_error = FLT_MAX;
+
+	for (u32 attempt = 0; attempt < 3; attempt++)
+	{
+		u8 q0[4], q1[4], p0, p1;
+		quantize_bc7_endpoint(ep0, q0, &p0);
+		quantize_bc7_endpoint(ep1, q1, &p1);
+
+		float palette[16][4];
+		bc7_palette(q0, p0, q1, p1, palette);
+
+		u8 indices[BLOCK_TEXELS];
+		float error = select_indices(soa, palette, 16, 4, indices);
+
+		if (error < best_error)
+		{
+			best_error = error;
+			mem::copy(best_q0, q0, sizeof(q0));
+			mem::copy(best_q1, q1, sizeof(q1));
+			best_p0 = p0;
+			best_p1 = p1;
+			mem::copy(best_indices, indices, sizeof(indices));
+		}
+
+		if (best_error <= 0.0f || !refine_endpoints(soa, 4, mask, indices, index_t, ep0, ep1)) {
+			break;
+		}
+	}
+
+	// the first index is stored with its top bit implied to be zero, flip the endpoints around if it isn't
+	if (best_indices[0] >= 8)
+	{
+		for (u32 c = 0; c < 4; c++) {
+			u8 tmp = best_q0[c]; best_q0[c] = best_q1[c]; best_q1[c] = tmp;
+		}
+
+		u8 tmp = best_p0; best_p0 = best_p1; best_p1 = tmp;
+
+		for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+			best_indices[i] = 15 - best_indices[i];
+		}
+	}
+
+	mem::set(block, 0, 16);
+
+	u32 bit = 0;
+
+	write_bits(block, &bit, 1 << 6, 7); // mode 6
+
+	for (u32 c = 0; c < 4; c++)
+	{
+		write_bits(block, &bit, best_q0[c], 7);
+		write_bits(block, &bit, best_q1[c], 7);
+	}
+
+	write_bits(block, &bit, best_p0, 1);
+	write_bits(block, &bit, best_p1, 1);
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+		write_bits(block, &bit, best_indices[i], i == 0 ? 3 : 4);
+	}
+}
+
+void bc::decode_bc1(const byte* block, Colour* texels, bool always_opaque)
+{
+	u16 c0 = block[0] | (block[1] << 8);
+	u16 c1 = block[2] | (block[3] << 8);
+	u32 bits = block[4] | (block[5] << 8) | (block[6] << 16) | ((u32)block[7] << 24);
+
+	float palette[4][4];
+	bc1_palette(c0, c1, always_opaque || c0 > c1, palette);
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++)
+	{
+		const float* entry = palette[(bits >> (i * 2)) & 3];
+		texels[i] = Colour((u8)entry[0], (u8)entry[1], (u8)entry[2], (u8)entry[3]);
+	}
+}
+
+void bc::decode_bc3(const byte* block, Colour* texels)
+{
+	u8 alpha[BLOCK_TEXELS];
+
+	decode_bc4(block, alpha);
+	decode_bc1(block + 8, texels, true);
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+		texels[i].a = alpha[i];
+	}
+}
+
+void bc::decode_bc4(const byte* block, u8* values)
+{
+	u8 a0 = block[0];
+	u8 a1 = block[1];
+
+	float palette[8][4];
+
+	if (a0 > a1)
+	{
+		bc4_palette(a0, a1, palette);
+	}
+	else
+	{
+		palette[0][0] = a0;
+		palette[1][0] = a1;
+
+		for (u32 i = 2; i < 6; i++) {
+			palette[i][0] = (float)((((6 - i) * a0) + ((i - 1) * a1)) / 5);
+		}
+
+		palette[6][0] = 0.0f;
+		palette[7][0] = 255.0f;
+	}
+
+	u32 bit = 16;
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+		values[i] = (u8)palette[read_bits(block, &bit, 3)][0];
+	}
+}
+
+void bc::decode_bc5(const byte* block, Colour* texels)
+{
+	u8 red[BLOCK_TEXELS];
+	u8 green[BLOCK_TEXELS];
+
+	decode_bc4(block, red);
+	decode_bc4(block + 8, green);
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+		texels[i] = Colour(red[i], green[i], 0, 255);
+	}
+}
+
+bool bc::decode_bc7(const byte* block, Colour* texels)
+{
+	u32 bit = 0;
+
+	if (read_bits(block, &bit, 7) != (1 << 6))
+	{
+		for (u32 i = 0; i < BLOCK_TEXELS; i++) {
+			texels[i] = Colour::magenta();
+		}
+
+		return false;
+	}
+
+	u8 q0[4], q1[4];
+
+	for (u32 c = 0; c < 4; c++)
+	{
+		q0[c] = (u8)read_bits(block, &bit, 7);
+		q1[c] = (u8)read_bits(block, &bit, 7);
+	}
+
+	u8 p0 = (u8)read_bits(block, &bit, 1);
+	u8 p1 = (u8)read_bits(block, &bit, 1);
+
+	float palette[16][4];
+	bc7_palette(q0, p0, q1, p1, palette);
+
+	for (u32 i = 0; i < BLOCK_TEXELS; i++)
+	{
+		const float* entry = palette[read_bits(block, &bit, i == 0 ? 3 : 4)];
+		texels[i] = Colour((u8)entry[0], (u8)entry[1], (u8)entry[2], (u8)entry[3]);
+	}
+
+	return true;
+}
+
+void bc::encode_block(TextureFormat format, const Colour* texels, byte* block)
+{
+	switch (format)
+	{
+	case TEX_FORMAT_BC1_RGBA_UNORM:
+	case TEX_FORMAT_BC1_RGBA_SRGB:
+		encode_bc1(texels, block, true);
+		break;
+
+	case TEX_FORMAT_BC3_UNORM:
+	case TEX_FORMAT_BC3_SRGB:
+		encode_bc3(texels, block);
+		break;
+
+	case TEX_FORMAT_BC5_UNORM:
+		encode_bc5(texels, block);
+		break;
+
+	case TEX_FORMAT_BC7_UNORM:
+	case TEX_FORMAT_BC7_SRGB:
+		encode_bc7(texels, block);
+		break;
+
+	default:
+		wvn_ERROR("[BLOCK COMPRESSION|DEBUG] Format %d is not block compressed.", format);
+		break;
+	}
+}
+
+void bc::decode_block(TextureFormat format, const byte* block, Colour* texels)
+{
+	switch (format)
+	{
+	case TEX_FORMAT_BC1_RGBA_UNORM:
+	case TEX_FORMAT_BC1_RGBA_SRGB:
+		decode_bc1(block, texels, false);
+		break;
+
+	case TEX_FORMAT_BC3_UNORM:
+	case TEX_FORMAT_BC3_SRGB:
+		decode_bc3(block, texels);
+		break;
+
+	case TEX_FORMAT_BC5_UNORM:
+		decode_bc5(block, texels);
+		break;
+
+	case TEX_FORMAT_BC7_UNORM:
+	case TEX_FORMAT_BC7_SRGB:
+		decode_bc7(block, texels);
+		break;
+
+	default:
+		wvn_ERROR("[BLOCK COMPRESSION|DEBUG] Format %d is not block compressed.", format);
+		break;
+	}
+}
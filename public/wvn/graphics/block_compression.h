@@ -0,0 +1,38 @@
+#ifndef BLOCK_COMPRESSION_H_
+#define BLOCK_COMPRESSION_H_
+
+#include <wvn/common.h>
+#include <wvn/maths/colour.h>
+#include <wvn/graphics/texture.h>
+
+/*
+ * Encoders & decoders for single 4x4 blocks of the BCn formats.
+ * Every function takes / produces 16 texels in row-major order.
+ */
+namespace wvn::gfx::bc
+{
+	constexpr u32 BLOCK_DIM = 4;
+	constexpr u32 BLOCK_TEXELS = BLOCK_DIM * BLOCK_DIM;
+
+	bool is_block_compressed(TextureFormat format);
+	u32 block_bytes(TextureFormat format);
+	u64 level_size(TextureFormat format, u32 width, u32 height);
+
+	// texels with alpha under 128 become transparent when punch_through is set, otherwise alpha is ignored
+	void encode_bc1(const Colour* texels, byte* block, bool punch_through);
+	void encode_bc3(const Colour* texels, byte* block);
+	void encode_bc4(const u8* values, byte* block);
+	void encode_bc5(const Colour* texels, byte* block); // red & green channels
+	void encode_bc7(const Colour* texels, byte* block); // always mode 6 (single subset, rgba, 4 bit indices)
+
+	void decode_bc1(const byte* block, Colour* texels, bool always_opaque);
+	void decode_bc3(const byte* block, Colour* texels);
+	void decode_bc4(const byte* block, u8* values);
+	void decode_bc5(const byte* block, Colour* texels);
+	bool decode_bc7(const byte* block, Colour* texels); // only mode 6 is understood, returns false for anything else
+
+	void encode_block(TextureFormat format, const Colour* texels, byte* block);
+	void decode_block(TextureFormat format, const byte* block, Colour* texels);
+}
+
+#endif // BLOCK_COMPRESSION_H_
@@ -0,0 +1,279 @@
+#include <wvn/graphics/cascaded_shadow_map.h>
+#include <wvn/graphics/render_target_mgr.h>
+#include <wvn/graphics/mesh.h>
+#include <wvn/maths/calc.h>
+#include <wvn/camera.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+CascadedShadowMap::CascadedShadowMap()
+	: m_cascades{}
+	, m_cascade_count(0)
+	, m_light_dir(Vec3F::forward())
+	, m_light_right(Vec3F::right())
+	, m_light_up(Vec3F::up())
+{
+}
+
+CascadedShadowMap::~CascadedShadowMap()
+{
+}
+
+void CascadedShadowMap::update(const Light& light, const Camera& view_camera, const HashMap<RenderableObjectID, RenderableObject*>& objects, u64 static_generation)
+{
+	// only directional lights are worth splitting up, everything else gets a single cascade over the whole range
+	m_cascade_count = light.get_type() == LIGHT_TYPE_DIR ? light.get_shadow_cascade_count() : 1;
+
+	m_light_dir = light.get_orientation().vector().normalized();
+
+	Vec3F reference_up = CalcF::abs(Vec3F::dot(m_light_dir, Vec3F::up())) > 0.99f ? Vec3F::forward() : Vec3F::up();
+	m_light_right = Vec3F::cross(m_light_dir, reference_up).normalized();
+	m_light_up = Vec3F::cross(m_light_right, m_light_dir).normalized();
+
+	float splits[Light::MAX_SHADOW_CASCADES + 1] = {};
+
+	calc_splits(
+		view_camera.near,
+		CalcF::min(view_camera.far, light.get_shadow_distance()),
+		light.get_shadow_cascade_split_lambda(),
+		m_cascade_count,
+		splits
+	);
+
+	for (u32 i = 0; i < m_cascade_count; i++)
+	{
+		ShadowCascade& cascade = m_cascades[i];
+
+		cascade.split_near = splits[i];
+		cascade.split_far = splits[i + 1];
+
+		if (!cascade.shadow_map) {
+			cascade.shadow_map = RenderTargetMgr::get_singleton()->get_depth_only_target(Light::DEPTH_TEXTURE_WIDTH, Light::DEPTH_TEXTURE_HEIGHT);
+		}
+
+		fit_cascade(cascade, view_camera);
+		cull_casters(cascade, objects, static_generation);
+	}
+}
+
+bool CascadedShadowMap::needs_render(u32 idx) const
+{
+	return !m_cascades[idx].rendered || m_cascades[idx].current_hash != m_cascades[idx].cache_hash;
+}
+
+void CascadedShadowMap::mark_rendered(u32 idx)
+{
+	m_cascades[idx].cache_hash = m_cascades[idx].current_hash;
+	m_cascades[idx].rendered = true;
+}
+
+u32 CascadedShadowMap::select_cascade(const Vec3F& centre, float radius) const
+{
+	Vec3F ls = to_light_space(centre);
+
+	for (u32 i = 0; i < m_cascade_count; i++)
+	{
+		const ShadowCascade& cascade = m_cascades[i];
+
+		if (CalcF::abs(ls.x - cascade.centre.x) + radius <= cascade.radius &&
+			CalcF::abs(ls.y - cascade.centre.y) + radius <= cascade.radius &&
+			ls.z + radius <= cascade.centre.z + cascade.radius)
+		{
+			return i;
+		}
+	}
+
+	return m_cascade_count > 0 ? m_cascade_count - 1 : 0;
+}
+
+u32 CascadedShadowMap::cascade_count() const
+{
+	return m_cascade_count;
+}
+
+ShadowCascade& CascadedShadowMap::cascade(u32 idx)
+{
+	return m_cascades[idx];
+}
+
+const ShadowCascade& CascadedShadowMap::cascade(u32 idx) const
+{
+	return m_cascades[idx];
+}
+
+// "practical split scheme", blends between logarithmic splits (even texel density) and uniform splits
+void CascadedShadowMap::calc_splits(float near, float far, float lambda, u32 count, float* splits)
+{
+	near = CalcF::max(near, 0.01f);
+	far = CalcF::max(far, near + 0.01f);
+
+	splits[0] = near;
+
+	for (u32 i = 1; i <= count; i++)
+	{
+		float p = (float)i / (float)count;
+
+		float log_split = near * CalcF::pow(far / near, p);
+		float uniform_split = near + ((far - near) * p);
+
+		splits[i] = CalcF::lerp(uniform_split, log_split, lambda);
+	}
+}
+
+void CascadedShadowMap::calc_world_bounds(const RenderableObject& object, Vec3F* centre, float* radius)
+{
+	Vec3F min = Vec3F::zero();
+	Vec3F max = Vec3F::zero();
+
+	for (u64 i = 0; i < object.mesh->submesh_count(); i++)
+	{
+		const SubMesh* submesh = object.mesh->submesh(i);
+
+		if (i == 0) {
+			min = submesh->bounds_min();
+			max = submesh->bounds_max();
+			continue;
+		}
+
+		min = Vec3F(CalcF::min(min.x, submesh->bounds_min().x), CalcF::min(min.y, submesh->bounds_min().y), CalcF::min(min.z, submesh->bounds_min().z));
+		max = Vec3F(CalcF::max(max.x, submesh->bounds_max().x), CalcF::max(max.y, submesh->bounds_max().y), CalcF::max(max.z, submesh->bounds_max().z));
+	}
+
+	const Basis3D& basis = object.matrix.basis;
+
+	float max_scale = CalcF::max(
+		Vec3F(basis.m11, basis.m12, basis.m13).length(),
+		CalcF::max(
+			Vec3F(basis.m21, basis.m22, basis.m23).length(),
+			Vec3F(basis.m31, basis.m32, basis.m33).length()
+		)
+	);
+
+	(*centre) = Affine3D::transform((min + max) * 0.5f, object.matrix);
+	(*radius) = (max - min).length() * 0.5f * max_scale;
+}
+
+// bounding sphere of the frustum slice, its size doesn't change when the camera rotates
+// and it is snapped to whole texels so that moving the camera doesn't make the shadow edges shimmer
+void CascadedShadowMap::fit_cascade(ShadowCascade& cascade, const Camera& view_camera)
+{
+	Vec3F forward = view_camera.direction.normalized();
+	Vec3F right = Vec3F::cross(forward, view_camera.up).normalized();
+	Vec3F up = Vec3F::cross(right, forward).normalized();
+
+	float tan_half_fov = CalcF::tan(view_camera.fov * CalcF::DEG2RAD * 0.5f);
+	float aspect = view_camera.width / view_camera.height;
+
+	Vec3F corners[8];
+
+	for (int i = 0; i < 2; i++)
+	{
+		float depth = (i == 0) ? cascade.split_near : cascade.split_far;
+
+		float half_height = (view_camera.type == Camera::CAM_PERSP) ? depth * tan_half_fov : view_camera.height * 0.5f;
+		float half_width = (view_camera.type == Camera::CAM_PERSP) ? half_height * aspect : view_camera.width * 0.5f;
+
+		Vec3F slice_centre = view_camera.position + (forward * depth);
+
+		corners[(i * 4) + 0] = slice_centre - (right * half_width) - (up * half_height);
+		corners[(i * 4) + 1] = slice_centre + (right * half_width) - (up * half_height);
+		corners[(i * 4) + 2] = slice_centre - (right * half_width) + (up * half_height);
+		corners[(i * 4) + 3] = slice_centre + (right * half_width) + (up * half_height);
+	}
+
+	Vec3F centre = Vec3F::zero();
+
+	for (auto& corner : corners) {
+		centre += corner;
+	}
+
+	centre = centre * (1.0f / 8.0f);
+
+	float radius = 0.0f;
+
+	for (auto& corner : corners) {
+		radius = CalcF::max(radius, (corner - centre).length());
+	}
+
+	radius = CalcF::ceil(radius * 16.0f) / 16.0f;
+
+	float texel_size = (radius * 2.0f) / (float)Light::DEPTH_TEXTURE_WIDTH;
+
+	Vec3F ls = to_light_space(centre);
+	ls.x = CalcF::floor(ls.x / texel_size) * texel_size;
+	ls.y = CalcF::floor(ls.y / texel_size) * texel_size;
+
+	cascade.centre = ls;
+	cascade.radius = radius;
+}
+
+// casters only have to overlap the cascade when looked at from the light, anything between the
+// light and the slice can still throw a shadow into it so the depth range is stretched to fit them
+void CascadedShadowMap::cull_casters(ShadowCascade& cascade, const HashMap<RenderableObjectID, RenderableObject*>& objects, u64 static_generation)
+{
+	cascade.casters.clear();
+
+	float min_depth = cascade.centre.z - cascade.radius;
+	float max_depth = cascade.centre.z + cascade.radius;
+
+	u64 hash = 0;
+	u64 static_count = 0;
+
+	for (auto& [id, obj] : objects)
+	{
+		if (!obj->mesh) {
+			continue;
+		}
+
+		Vec3F centre;
+		float radius;
+		calc_world_bounds(*obj, &centre, &radius);
+
+		Vec3F ls = to_light_space(centre);
+		float reach = cascade.radius + radius;
+
+		if (CalcF::abs(ls.x - cascade.centre.x) > reach ||
+			CalcF::abs(ls.y - cascade.centre.y) > reach ||
+			ls.z - radius > max_depth)
+		{
+			continue;
+		}
+
+		cascade.casters.push_back(obj);
+		min_depth = CalcF::min(min_depth, ls.z - radius);
+
+		// static casters are covered by the generation counter, only dynamic ones have to be looked at
+		if (obj->is_static) {
+			static_count++;
+		} else {
+			hash::combine(&hash, &obj->id);
+			hash::combine(&hash, &obj->matrix);
+			hash::combine(&hash, &obj->mesh);
+		}
+	}
+
+	Vec3F eye =
+		(m_light_right * cascade.centre.x) +
+		(m_light_up * cascade.centre.y) +
+		(m_light_dir * min_depth);
+
+	cascade.view = Mat4x4::create_lookat(eye, eye + m_light_dir, m_light_up);
+	cascade.proj = Mat4x4::create_orthographic_ext(-cascade.radius, cascade.radius, -cascade.radius, cascade.radius, 0.0f, max_depth - min_depth);
+
+	hash::combine(&hash, &cascade.view);
+	hash::combine(&hash, &cascade.proj);
+	hash::combine(&hash, &static_count);
+	hash::combine(&hash, &static_generation);
+
+	cascade.current_hash = hash;
+}
+
+Vec3F CascadedShadowMap::to_light_space(const Vec3F& v) const
+{
+	return Vec3F(
+		Vec3F::dot(m_light_right, v),
+		Vec3F::dot(m_light_up, v),
+		Vec3F::dot(m_light_dir, v)
+	);
+}
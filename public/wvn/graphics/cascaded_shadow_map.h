@@ -0,0 +1,83 @@
+#ifndef CASCADED_SHADOW_MAP_H_
+#define CASCADED_SHADOW_MAP_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/container/hash_map.h>
+#include <wvn/maths/vec3.h>
+#include <wvn/maths/mat4x4.h>
+#include <wvn/graphics/light.h>
+#include <wvn/graphics/renderable_object.h>
+
+namespace wvn { class Camera; }
+
+namespace wvn::gfx
+{
+	class RenderTarget;
+
+	/**
+	 * A single slice of the view frustum along with the orthographic light camera that covers it.
+	 */
+	struct ShadowCascade
+	{
+		float split_near;
+		float split_far;
+
+		Mat4x4 view;
+		Mat4x4 proj;
+
+		// light space bounds of the cascade, used for culling casters & picking a cascade for receivers
+		Vec3F centre;
+		float radius;
+
+		RenderTarget* shadow_map;
+		Vector<const RenderableObject*> casters;
+
+		u64 current_hash; // everything that affects what the cascade would look like this frame
+		u64 cache_hash; // ... and when it was last rendered
+		bool rendered;
+	};
+
+	/**
+	 * Cascaded shadow maps for a single light.
+	 * Cascades are fitted to slices of the view camera's frustum & snapped to shadow map texels so they
+	 * stay stable as the camera moves. A cascade is only re-rendered when its light camera, the set of
+	 * static casters or one of the dynamic casters inside it has changed since it was last drawn.
+	 */
+	class CascadedShadowMap
+	{
+	public:
+		CascadedShadowMap();
+		~CascadedShadowMap();
+
+		void update(const Light& light, const Camera& view_camera, const HashMap<RenderableObjectID, RenderableObject*>& objects, u64 static_generation);
+
+		bool needs_render(u32 idx) const;
+		void mark_rendered(u32 idx);
+
+		// the first (highest resolution) cascade that fully contains the given sphere
+		u32 select_cascade(const Vec3F& centre, float radius) const;
+
+		u32 cascade_count() const;
+		ShadowCascade& cascade(u32 idx);
+		const ShadowCascade& cascade(u32 idx) const;
+
+		static void calc_splits(float near, float far, float lambda, u32 count, float* splits);
+		static void calc_world_bounds(const RenderableObject& object, Vec3F* centre, float* radius);
+
+	private:
+		void fit_cascade(ShadowCascade& cascade, const Camera& view_camera);
+		void cull_casters(ShadowCascade& cascade, const HashMap<RenderableObjectID, RenderableObject*>& objects, u64 static_generation);
+
+		Vec3F to_light_space(const Vec3F& v) const;
+
+		ShadowCascade m_cascades[Light::MAX_SHADOW_CASCADES];
+		u32 m_cascade_count;
+
+		Vec3F m_light_dir;
+		Vec3F m_light_right;
+		Vec3F m_light_up;
+	};
+}
+
+#endif // CASCADED_SHADOW_MAP_H_
@@ -0,0 +1,209 @@
+#include <wvn/graphics/cooked_texture.h>
+#include <wvn/graphics/block_compression.h>
+#include <wvn/graphics/texture_streamer.h>
+#include <wvn/io/file_stream.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+// streams don't report errors themselves, a read that came up short shows up as the position not moving far enough
+static bool read_exact(const io::Stream& stream, void* buffer, u64 length)
+{
+	if (length == 0) {
+		return true;
+	}
+
+	s64 start = stream.position();
+	stream.read(buffer, length);
+
+	return start >= 0 && stream.position() - start == (s64)length;
+}
+
+CookedTexture::CookedTexture()
+	: m_format(TEX_FORMAT_NONE)
+	, m_width(0)
+	, m_height(0)
+	, m_levels()
+	, m_data()
+{
+}
+
+CookedTexture::~CookedTexture()
+{
+}
+
+void CookedTexture::init(TextureFormat format, u32 width, u32 height)
+{
+	m_format = format;
+	m_width = width;
+	m_height = height;
+
+	m_levels.clear();
+	m_data.clear();
+}
+
+void CookedTexture::add_level(const byte* data, u64 size)
+{
+	u64 offset = (m_data.size() + LEVEL_ALIGNMENT - 1) & ~(LEVEL_ALIGNMENT - 1);
+
+	m_data.resize(offset + size);
+	mem::copy(m_data.data() + offset, data, size);
+
+	m_levels.push_back({ offset, size });
+}
+
+bool CookedTexture::load(const char* path)
+{
+	io::FileStream fs(path, "rb");
+	return load(fs);
+}
+
+// the header and level table come straight off disk, so nothing in them is trusted until it has been checked
+bool CookedTexture::load(const io::Stream& stream)
+{
+	Header header = {};
+
+	if (!read_exact(stream, &header, sizeof(Header))) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] File is too short to hold a cooked texture header.");
+		return false;
+	}
+
+	if (header.magic != MAGIC) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Not a cooked texture (bad magic: %x).", header.magic);
+		return false;
+	}
+
+	if (header.version != VERSION) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Unsupported cooked texture version: %d.", header.version);
+		return false;
+	}
+
+	TextureFormat format = (TextureFormat)header.format;
+
+	if (!bc::is_block_compressed(format)) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Cooked texture has an unsupported format: %d.", header.format);
+		return false;
+	}
+
+	if (header.width == 0 || header.height == 0) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Cooked texture has no size (%ux%u).", header.width, header.height);
+		return false;
+	}
+
+	if (header.mip_count == 0 || header.mip_count > TextureStreamer::calc_mip_count(header.width, header.height)) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Cooked texture has %u mips, a %ux%u texture can't have that many.", header.mip_count, header.width, header.height);
+		return false;
+	}
+
+	// check against what is left of the file before allocating anything, a corrupt size must not turn into a huge allocation
+	u64 table_size = sizeof(Level) * header.mip_count;
+	s64 remaining = stream.size() - stream.position();
+
+	if (remaining < 0 || header.data_size > (u64)remaining || table_size > (u64)remaining - header.data_size) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Cooked texture claims more data than the file holds.");
+		return false;
+	}
+
+	Vector<Level> levels(header.mip_count);
+
+	if (!read_exact(stream, levels.data(), table_size)) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Failed to read the level table.");
+		return false;
+	}
+
+	for (u32 i = 0; i < levels.size(); i++)
+	{
+		const Level& level = levels[i];
+
+		u32 width = CalcU::max(header.width >> i, 1);
+		u32 height = CalcU::max(header.height >> i, 1);
+
+		if (level.size != bc::level_size(format, width, height)) {
+			wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Level %u doesn't match the size of a %ux%u level.", i, width, height);
+			return false;
+		}
+
+		// written so that neither side can wrap around
+		if (level.offset > header.data_size || level.size > header.data_size - level.offset) {
+			wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Level %u runs past the end of the data.", i);
+			return false;
+		}
+	}
+
+	Vector<byte> data(header.data_size);
+
+	if (!read_exact(stream, data.data(), header.data_size)) {
+		wvn_ERROR("[GFX:COOKED TEXTURE|DEBUG] Failed to read the level data.");
+		return false;
+	}
+
+	// only replace what we had once the whole file is known to be good
+	m_format = format;
+	m_width = header.width;
+	m_height = header.height;
+	m_levels = levels;
+	m_data = data;
+
+	return true;
+}
+
+bool CookedTexture::save(const char* path) const
+{
+	io::FileStream fs(path, "wb");
+	return save(fs);
+}
+
+bool CookedTexture::save(const io::Stream& stream) const
+{
+	Header header = {
+		.magic = MAGIC,
+		.version = VERSION,
+		.format = (u32)m_format,
+		.width = m_width,
+		.height = m_height,
+		.mip_count = (u32)m_levels.size(),
+		.data_size = m_data.size()
+	};
+
+	stream.write(&header, sizeof(Header));
+	stream.write((void*)m_levels.data(), sizeof(Level) * m_levels.size());
+	stream.write((void*)m_data.data(), m_data.size());
+
+	return true;
+}
+
+TextureFormat CookedTexture::format() const
+{
+	return m_format;
+}
+
+u32 CookedTexture::width() const
+{
+	return m_width;
+}
+
+u32 CookedTexture::height() const
+{
+	return m_height;
+}
+
+u32 CookedTexture::mip_count() const
+{
+	return m_levels.size();
+}
+
+const byte* CookedTexture::level_data(u32 mip) const
+{
+	return m_data.data() + m_levels[mip].offset;
+}
+
+u64 CookedTexture::level_size(u32 mip) const
+{
+	return m_levels[mip].size;
+}
+
+u64 CookedTexture::data_size() const
+{
+	return m_data.size();
+}
@@ -0,0 +1,75 @@
+#ifndef COOKED_TEXTURE_H_
+#define COOKED_TEXTURE_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/graphics/texture.h>
+#include <wvn/io/stream.h>
+
+namespace wvn::gfx
+{
+	/**
+	 * Texture that has already been through the cooker: a complete mip chain in its final gpu format,
+	 * ready to be copied straight into a texture without any decoding or mip generation at load time.
+	 *
+	 * File layout (little endian), loosely modelled on KTX2:
+	 *   Header
+	 *   Level[mip_count] (mip 0 first, offsets relative to the start of the level data)
+	 *   level data, every level aligned to LEVEL_ALIGNMENT
+	 */
+	class CookedTexture
+	{
+		struct Header
+		{
+			u32 magic;
+			u32 version;
+			u32 format;
+			u32 width;
+			u32 height;
+			u32 mip_count;
+			u64 data_size;
+		};
+
+		struct Level
+		{
+			u64 offset;
+			u64 size;
+		};
+
+	public:
+		static constexpr u32 MAGIC = 0x58545657; // "WVTX"
+		static constexpr u32 VERSION = 1;
+		static constexpr u64 LEVEL_ALIGNMENT = 16;
+
+		CookedTexture();
+		~CookedTexture();
+
+		void init(TextureFormat format, u32 width, u32 height);
+		void add_level(const byte* data, u64 size);
+
+		bool load(const char* path);
+		bool load(const io::Stream& stream);
+
+		bool save(const char* path) const;
+		bool save(const io::Stream& stream) const;
+
+		TextureFormat format() const;
+		u32 width() const;
+		u32 height() const;
+		u32 mip_count() const;
+
+		const byte* level_data(u32 mip) const;
+		u64 level_size(u32 mip) const;
+		u64 data_size() const;
+
+	private:
+		TextureFormat m_format;
+		u32 m_width;
+		u32 m_height;
+
+		Vector<Level> m_levels;
+		Vector<byte> m_data;
+	};
+}
+
+#endif // COOKED_TEXTURE_H_
@@ -0,0 +1,19 @@
+#include <wvn/graphics/draw_chunks.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+// bounds are spread proportionally rather than rounding the chunk size up, which could leave the last chunk empty
+u32 gfx::split_draws(DrawChunk* chunks, u64 draw_count, u32 max_chunks, u64 min_draws)
+{
+	u64 chunk_count = Calc<u64>::clamp(draw_count / Calc<u64>::max(min_draws, 1), 1, Calc<u64>::max(max_chunks, 1));
+
+	for (u64 i = 0; i < chunk_count; i++)
+	{
+		chunks[i].begin = (draw_count * i) / chunk_count;
+		chunks[i].end = (draw_count * (i + 1)) / chunk_count;
+	}
+
+	return (u32)chunk_count;
+}
@@ -0,0 +1,25 @@
+#ifndef DRAW_CHUNKS_H_
+#define DRAW_CHUNKS_H_
+
+#include <wvn/common.h>
+
+namespace wvn::gfx
+{
+	/**
+	 * Range of a pass's draws that gets recorded on its own, into its own secondary command buffer.
+	 */
+	struct DrawChunk
+	{
+		u64 begin;
+		u64 end;
+	};
+
+	/*
+	 * Splits a pass's draws into at most max_chunks even ranges of no fewer than min_draws each and returns how many it made.
+	 * A single chunk means the pass is too small to be worth the cost of secondary buffers and handing work to other threads.
+	 * Doesn't depend on any backend so the policy can be measured headless.
+	 */
+	u32 split_draws(DrawChunk* chunks, u64 draw_count, u32 max_chunks, u64 min_draws);
+}
+
+#endif // DRAW_CHUNKS_H_
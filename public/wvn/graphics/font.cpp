@@ -1,28 +1,36 @@
 #include <wvn/graphics/font.h>
 #include <wvn/maths/calc.h>
 #include <wvn/io/file_stream.h>
-#include <wvn/graphics/texture.h>
-#include <wvn/graphics/texture_mgr.h>
 
 #define STB_TRUETYPE_IMPLEMENTATION
 #include <third_party/stb_truetype.h>
 
-#define wvn_FONT_ATLAS_W 1024
-#define wvn_FONT_ATLAS_H 512
-#define wvn_FONT_ATLAS_SIZE (wvn_FONT_ATLAS_W * wvn_FONT_ATLAS_H)
-#define wvn_FONT_CHARCOUNT 256
 #define M_INTERNAL_INFO ((stbtt_fontinfo*)m_internal_info)
 
 using namespace wvn;
 using namespace wvn::gfx;
 
+static constexpr u32 EMPTY_GLYPH_PAIR = 0xFFFFFFFF; // glyph indices never reach 0xFFFF so this pair can't exist
+
+static u32 hash_glyph_pair(u32 pair)
+{
+	u32 hash = pair * 0x9E3779B1;
+	return hash ^ (hash >> 16);
+}
+
+static u32 make_glyph_pair(int glyph0, int glyph1)
+{
+	return ((u32)glyph0 << 16) | ((u32)glyph1 & 0xFFFF);
+}
+
 Font::Font()
 	: m_info()
 	, m_internal_info(nullptr)
-	, m_kerning(nullptr)
+	, m_ttf_buffer(nullptr)
+	, m_scale(0.0f)
+	, m_kerning()
 	, m_kerning_count(0)
 	, m_characters(nullptr)
-	, m_atlas()
 {
 }
 
@@ -42,6 +50,8 @@ void Font::load(float size, const String& path)
 	wvn_ASSERT(!path.empty(), "Path must not be empty.");
 	wvn_ASSERT(size > 0.0f, "Size must be greater than 0.");
 
+	free();
+
 	FontType type = path.ends_with(".ttf") ? FONT_TYPE_TTF : FONT_TYPE_OTF;
 
 	m_info.size = size;
@@ -54,16 +64,18 @@ void Font::load(float size, const String& path)
 	else
 	{
 		io::FileStream fs(path.c_str(), "rb");
-		byte* ttf_buffer = new byte[fs.size()];
-		fs.read(ttf_buffer, fs.size());
+		m_ttf_buffer = new byte[fs.size()];
+		fs.read(m_ttf_buffer, fs.size());
 		fs.close();
 
 		m_internal_info = new stbtt_fontinfo();
 
-		if (!stbtt_InitFont(M_INTERNAL_INFO, ttf_buffer, stbtt_GetFontOffsetForIndex(ttf_buffer, 0))) {
-			wvn_ERROR("[GFX:FONT|DEBUG] OTF Loading is currently not supported.");
+		if (!stbtt_InitFont(M_INTERNAL_INFO, m_ttf_buffer, stbtt_GetFontOffsetForIndex(m_ttf_buffer, 0))) {
+			wvn_ERROR("[GFX:FONT|DEBUG] Failed to initialize font.");
 		}
 
+		m_scale = stbtt_ScaleForPixelHeight(M_INTERNAL_INFO, m_info.size);
+
 		stbtt_GetFontVMetrics(M_INTERNAL_INFO, &m_info.ascent, &m_info.descent, &m_info.line_gap);
 
 		int x0, y0, x1, y1;
@@ -75,93 +87,254 @@ void Font::load(float size, const String& path)
 			m_info.bbox.h = y1 - y0;
 		}
 
-		// store kerning data
-		m_kerning_count = stbtt_GetKerningTableLength(M_INTERNAL_INFO);
-		m_kerning = new Kerning[m_kerning_count];
+		// cache the metrics of the characters that make up nearly all text
+		m_characters = new Character[CACHED_CHARACTER_COUNT];
+
+		for (u32 i = 0; i < CACHED_CHARACTER_COUNT; i++) {
+			build_character(i, &m_characters[i]);
+		}
+
+		build_kerning_table();
+	}
+}
+
+void Font::free()
+{
+	delete M_INTERNAL_INFO;
+	delete[] m_ttf_buffer;
+	delete[] m_characters;
+
+	m_internal_info = nullptr;
+	m_ttf_buffer = nullptr;
+	m_characters = nullptr;
+
+	m_kerning.clear();
+	m_kerning_count = 0;
+}
+
+void Font::build_character(u32 codepoint, Character* character) const
+{
+	int glyph = stbtt_FindGlyphIndex(M_INTERNAL_INFO, codepoint);
+
+	int advance, lsb;
+	stbtt_GetGlyphHMetrics(M_INTERNAL_INFO, glyph, &advance, &lsb);
+
+	int x0, y0, x1, y1;
+	stbtt_GetGlyphBitmapBox(M_INTERNAL_INFO, glyph, m_scale, m_scale, &x0, &y0, &x1, &y1);
+
+	(*character) = {
+		.codepoint = (int)codepoint,
+		.glyph = glyph,
+		.bbox = RectI(x0, y0, x1 - x0, y1 - y0),
+		.advance_x = advance * m_scale,
+		.draw_offset = Vec2F(x0, y0),
+		.draw_offset2 = Vec2F(x1, y1)
+	};
+}
+
+// pairs are looked up for every character drawn, so they go into a hash table instead of being searched for
+void Font::build_kerning_table()
+{
+	int table_length = stbtt_GetKerningTableLength(M_INTERNAL_INFO);
+
+	// leave plenty of empty slots so probes stay short
+	u32 capacity = 64;
+
+	while (capacity < (u32)table_length * 2) {
+		capacity *= 2;
+	}
+
+	m_kerning.resize(capacity);
+
+	for (auto& kern : m_kerning) {
+		kern.glyph_pair = EMPTY_GLYPH_PAIR;
+	}
+
+	if (table_length > 0)
+	{
+		stbtt_kerningentry* kerning_tables = new stbtt_kerningentry[table_length];
+		table_length = stbtt_GetKerningTable(M_INTERNAL_INFO, kerning_tables, table_length);
+
+		for (int i = 0; i < table_length; i++) {
+			insert_kerning(kerning_tables[i].glyph1, kerning_tables[i].glyph2, kerning_tables[i].advance * m_scale);
+		}
+
+		delete[] kerning_tables;
+	}
+	else if (M_INTERNAL_INFO->gpos)
+	{
+		// newer fonts only kern through GPOS which can't be listed, so resolve the pairs between the cached characters up front
+		for (u32 i = 0; i < CACHED_CHARACTER_COUNT; i++)
 		{
-			stbtt_kerningentry* kerning_tables = new stbtt_kerningentry[m_kerning_count];
-			stbtt_GetKerningTable(M_INTERNAL_INFO, kerning_tables, m_kerning_count);
+			if (!m_characters[i].glyph) {
+				continue;
+			}
 
-			for (int i = 0; i < m_kerning_count; i++)
+			for (u32 j = 0; j < CACHED_CHARACTER_COUNT; j++)
 			{
-				m_kerning[i] = {
-					.advance = kerning_tables[i].advance,
-					.glyph0 = kerning_tables[i].glyph1,
-					.glyph1 = kerning_tables[i].glyph2
-				};
+				if (!m_characters[j].glyph) {
+					continue;
+				}
+
+				int advance = stbtt_GetGlyphKernAdvance(M_INTERNAL_INFO, m_characters[i].glyph, m_characters[j].glyph);
+
+				if (advance != 0) {
+					insert_kerning(m_characters[i].glyph, m_characters[j].glyph, advance * m_scale);
+				}
 			}
+		}
+	}
+}
+
+void Font::insert_kerning(int glyph0, int glyph1, float advance)
+{
+	if ((u32)(m_kerning_count + 1) * 2 > m_kerning.size())
+	{
+		Vector<Kerning> old_kerning = m_kerning;
+
+		m_kerning.resize(m_kerning.size() * 2);
 
-			delete[] kerning_tables;
+		for (auto& kern : m_kerning) {
+			kern.glyph_pair = EMPTY_GLYPH_PAIR;
 		}
 
-		// pack data into texture + store character data
-		byte* bitmap = new byte[wvn_FONT_ATLAS_SIZE];
-		{
-			stbtt_packedchar packed_chars[wvn_FONT_CHARCOUNT];
-			stbtt_pack_context pack_context = { 0 };
+		m_kerning_count = 0;
 
-			if (!stbtt_PackBegin(&pack_context, bitmap, wvn_FONT_ATLAS_W, wvn_FONT_ATLAS_H, wvn_FONT_ATLAS_W, 1, NULL)) {
-				wvn_ERROR("[GFX:FONT|DEBUG] Failed to initialize font.");
+		for (auto& kern : old_kerning)
+		{
+			if (kern.glyph_pair != EMPTY_GLYPH_PAIR) {
+				insert_kerning(kern.glyph_pair >> 16, kern.glyph_pair & 0xFFFF, kern.advance);
 			}
+		}
+	}
 
-			//stbtt_PackSetOversampling(&pack_context, m_info.oversample_x, m_info.oversample_y);
+	u32 pair = make_glyph_pair(glyph0, glyph1);
+	u32 mask = m_kerning.size() - 1;
 
-			if (!stbtt_PackFontRange(&pack_context, ttf_buffer, 0, m_info.size, 0, wvn_FONT_CHARCOUNT, packed_chars)) {
-				wvn_ERROR("[GFX:FONT|DEBUG] Failed to pack font.");
-			}
+	for (u32 i = hash_glyph_pair(pair) & mask;; i = (i + 1) & mask)
+	{
+		if (m_kerning[i].glyph_pair == pair) {
+			m_kerning[i].advance = advance;
+			return;
+		}
 
-			stbtt_PackEnd(&pack_context);
+		if (m_kerning[i].glyph_pair == EMPTY_GLYPH_PAIR)
+		{
+			m_kerning[i].glyph_pair = pair;
+			m_kerning[i].advance = advance;
+			m_kerning_count++;
+			return;
+		}
+	}
+}
+
+float Font::kern_advance_glyphs(int glyph0, int glyph1) const
+{
+	if (m_kerning_count == 0) {
+		return 0.0f;
+	}
 
-			m_atlas.texture = TextureMgr::get_singleton()->create(wvn_FONT_ATLAS_W, wvn_FONT_ATLAS_H, TEX_FORMAT_R8_UNORM, TEX_TILE_NONE, bitmap, wvn_FONT_ATLAS_W * wvn_FONT_ATLAS_H);
+	u32 pair = make_glyph_pair(glyph0, glyph1);
+	u32 mask = m_kerning.size() - 1;
 
-			m_characters = new Character[wvn_FONT_CHARCOUNT];
+	for (u32 i = hash_glyph_pair(pair) & mask;; i = (i + 1) & mask)
+	{
+		if (m_kerning[i].glyph_pair == pair) {
+			return m_kerning[i].advance;
+		}
 
-			for (int i = 0; i < wvn_FONT_CHARCOUNT; i++)
-			{
-				const auto& c = packed_chars[i];
-
-				m_characters[i] = {
-					.codepoint = i,
-					.bbox = RectI(c.x0, c.y0, c.x1 - c.x0, c.y1 - c.y0),
-					.advance_x = c.xadvance,
-					.draw_offset = Vec2F(c.xoff, c.yoff),
-					.draw_offset2 = Vec2F(c.xoff2, c.yoff2)
-				};
-			}
+		if (m_kerning[i].glyph_pair == EMPTY_GLYPH_PAIR) {
+			return 0.0f;
 		}
-		delete[] bitmap;
-		delete[] ttf_buffer;
 	}
 }
 
-void Font::free()
+float Font::kern_advance(int curr, int next) const
 {
-	delete M_INTERNAL_INFO;
-	delete m_atlas.texture;
-	delete[] m_kerning;
-	delete[] m_characters;
+	if (m_kerning_count == 0) {
+		return 0.0f;
+	}
+
+	int glyph0 = ((u32)curr < CACHED_CHARACTER_COUNT) ? m_characters[curr].glyph : stbtt_FindGlyphIndex(M_INTERNAL_INFO, curr);
+	int glyph1 = ((u32)next < CACHED_CHARACTER_COUNT) ? m_characters[next].glyph : stbtt_FindGlyphIndex(M_INTERNAL_INFO, next);
+
+	return kern_advance_glyphs(glyph0, glyph1);
 }
 
-int Font::kern_advance(int curr, int next) const
+Font::Character Font::get_character(u32 codepoint) const
 {
-	for (int i = 0; i < m_kerning_count; i++)
+	if (codepoint < CACHED_CHARACTER_COUNT) {
+		return m_characters[codepoint];
+	}
+
+	Character result;
+	build_character(codepoint, &result);
+	return result;
+}
+
+RectI Font::glyph_box(int glyph, GlyphRenderMode mode) const
+{
+	int x0, y0, x1, y1;
+	stbtt_GetGlyphBitmapBox(M_INTERNAL_INFO, glyph, m_scale, m_scale, &x0, &y0, &x1, &y1);
+
+	if (x0 == x1 || y0 == y1) {
+		return RectI(0, 0, 0, 0);
+	}
+
+	if (mode == GLYPH_RENDER_MODE_SDF)
 	{
-		auto kern = m_kerning[i];
+		x0 -= SDF_PADDING;
+		y0 -= SDF_PADDING;
+		x1 += SDF_PADDING;
+		y1 += SDF_PADDING;
+	}
 
-		if (kern.glyph0 == curr && kern.glyph1 == next) {
-			return kern.advance;
-		}
+	return RectI(x0, y0, x1 - x0, y1 - y0);
+}
+
+void Font::rasterise(int glyph, GlyphRenderMode mode, byte* dst, int dst_stride) const
+{
+	RectI box = glyph_box(glyph, mode);
+
+	if (box.w <= 0 || box.h <= 0) {
+		return;
 	}
 
-	return 0;
+	if (mode == GLYPH_RENDER_MODE_COVERAGE)
+	{
+		stbtt_MakeGlyphBitmap(M_INTERNAL_INFO, dst, box.w, box.h, dst_stride, m_scale, m_scale, glyph);
+		return;
+	}
+
+	// the distance field can only be rendered into its own allocation so copy it over afterwards
+	int w, h, xoff, yoff;
+	byte* sdf = stbtt_GetGlyphSDF(M_INTERNAL_INFO, m_scale, glyph, SDF_PADDING, SDF_ON_EDGE_VALUE, (float)SDF_ON_EDGE_VALUE / (float)SDF_PADDING, &w, &h, &xoff, &yoff);
+
+	if (!sdf) {
+		return;
+	}
+
+	for (int y = 0; y < h; y++) {
+		mem::copy(dst + y * dst_stride, sdf + y * w, w);
+	}
+
+	stbtt_FreeSDF(sdf, nullptr);
 }
 
 float Font::string_width(const char* str) const
 {
 	float result = 0.0f;
 
-	for (int i = 0; i < cstr::length(str); i++) {
-		result += m_characters[str[i]].advance_x + kern_advance(str[i], str[i + 1]);
+	for (int i = 0; str[i]; i++)
+	{
+		u8 curr = str[i];
+		u8 next = str[i + 1];
+
+		result += m_characters[curr].advance_x;
+
+		if (next) {
+			result += kern_advance_glyphs(m_characters[curr].glyph, m_characters[next].glyph);
+		}
 	}
 
 	return result;
@@ -172,9 +345,9 @@ float Font::string_height(const char* str) const
 	float hhh = 0.0f;
 	float max_bboxh = 0.0f;
 
-	for (int i = 0; i < cstr::length(str); i++)
+	for (int i = 0; str[i]; i++)
 	{
-		auto c = m_characters[str[i]];
+		auto c = m_characters[(u8)str[i]];
 		max_bboxh = CalcF::max(max_bboxh, c.bbox.h);
 		hhh = CalcF::max(hhh, c.bbox.h + c.draw_offset.y);
 	}
@@ -182,6 +355,6 @@ float Font::string_height(const char* str) const
 	return max_bboxh + hhh;
 }
 
+float Font::scale() const { return m_scale; }
 const Font::Info& Font::info() const { return m_info; }
-const Font::Atlas& Font::atlas() const { return m_atlas; }
-const Font::Character& Font::character(char ch) const { return m_characters[ch]; }
+const Font::Character& Font::character(char ch) const { return m_characters[(u8)ch]; }
@@ -1,15 +1,13 @@
 #ifndef FONT_H_
 #define FONT_H_
 
+#include <wvn/common.h>
 #include <wvn/container/string.h>
+#include <wvn/container/vector.h>
 #include <wvn/maths/rect.h>
 
 namespace wvn::gfx
 {
-	class Texture;
-
-	// todo: implement!
-
 	enum FontType
 	{
 		FONT_TYPE_NONE = 0,
@@ -18,12 +16,26 @@ namespace wvn::gfx
 		FONT_TYPE_MAX_ENUM
 	};
 
+	enum GlyphRenderMode
+	{
+		GLYPH_RENDER_MODE_COVERAGE = 0, // plain anti-aliased coverage, only looks right drawn at the size it was loaded at
+		GLYPH_RENDER_MODE_SDF,          // signed distance field, can be scaled freely
+		GLYPH_RENDER_MODE_MAX_ENUM
+	};
+
 	/**
-	 * Represents a bitmap font for drawing to the screen.
+	 * Represents a truetype font for drawing to the screen.
+	 * Holds the metrics & kerning, glyphs are rasterised on demand by whatever atlas they're drawn through.
 	 */
 	class Font
 	{
 	public:
+		// distance field padding around each glyph, in pixels at the loaded size
+		static constexpr int SDF_PADDING = 4;
+		static constexpr u8 SDF_ON_EDGE_VALUE = 128;
+
+		static constexpr u32 CACHED_CHARACTER_COUNT = 256;
+
 		struct Info
 		{
 			float size;
@@ -36,25 +48,20 @@ namespace wvn::gfx
 
 		struct Kerning
 		{
-			int advance;
-			int glyph0;
-			int glyph1;
+			u32 glyph_pair; // (glyph0 << 16) | glyph1
+			float advance;
 		};
 
 		struct Character
 		{
 			int codepoint;
-			RectI bbox;
+			int glyph;
+			RectI bbox; // coverage bitmap box relative to the pen on the baseline, in pixels
 			float advance_x;
 			Vec2F draw_offset;
 			Vec2F draw_offset2;
 		};
 
-		struct Atlas
-		{
-			Texture* texture;
-		};
-
 		Font();
 		Font(float size, const String& path);
 		~Font();
@@ -65,21 +72,38 @@ namespace wvn::gfx
 		float string_width(const char* str) const;
 		float string_height(const char* str) const;
 
-		int kern_advance(int curr, int next) const;
+		// both in codepoints, the result is already scaled to the loaded size
+		float kern_advance(int curr, int next) const;
+		float kern_advance_glyphs(int glyph0, int glyph1) const;
+
+		// unicode codepoints past the cached range are looked up from the font directly
+		Character get_character(u32 codepoint) const;
+
+		RectI glyph_box(int glyph, GlyphRenderMode mode) const;
+
+		// renders into dst at the size of glyph_box(), dst_stride is in bytes
+		void rasterise(int glyph, GlyphRenderMode mode, byte* dst, int dst_stride) const;
+
+		float scale() const;
 
 		const Info& info() const;
-		const Atlas& atlas() const;
 		const Character& character(char ch) const;
 
 	private:
+		void build_character(u32 codepoint, Character* character) const;
+		void build_kerning_table();
+		void insert_kerning(int glyph0, int glyph1, float advance);
+
 		Info m_info;
 		void* m_internal_info;
+		byte* m_ttf_buffer; // stb_truetype reads straight out of this so it has to outlive the font info
+		float m_scale;
 
-		Kerning* m_kerning;
+		// open addressing, the capacity is always a power of two
+		Vector<Kerning> m_kerning;
 		int m_kerning_count;
 
 		Character* m_characters;
-		Atlas m_atlas;
 	};
 }
 
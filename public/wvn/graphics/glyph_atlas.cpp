@@ -0,0 +1,411 @@
+#include <wvn/graphics/glyph_atlas.h>
+#include <wvn/graphics/texture.h>
+#include <wvn/graphics/texture_mgr.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+static constexpr u32 EMPTY_SLOT = 0xFFFFFFFF;
+static constexpr u32 MIN_INDEX_CAPACITY = 256;
+
+static u64 hash_glyph_key(const Font* font, u32 codepoint)
+{
+	u64 key = (u64)font ^ ((u64)codepoint * 0x9E3779B97F4A7C15);
+	key ^= key >> 31;
+	key *= 0xBF58476D1CE4E5B9;
+	key ^= key >> 29;
+	return key;
+}
+
+template <typename T>
+static void insert_at(Vector<T>& vector, u64 index, const T& item)
+{
+	vector.push_back(item);
+
+	for (u64 i = vector.size() - 1; i > index; i--) {
+		vector[i] = vector[i - 1];
+	}
+
+	vector[index] = item;
+}
+
+template <typename T>
+static void remove_at(Vector<T>& vector, u64 index)
+{
+	for (u64 i = index; i < vector.size() - 1; i++) {
+		vector[i] = vector[i + 1];
+	}
+
+	vector.pop_back();
+}
+
+GlyphAtlas::GlyphAtlas(GlyphRenderMode mode, u32 page_size, u32 max_pages)
+	: m_mode(mode)
+	, m_page_size(page_size)
+	, m_max_pages(max_pages)
+	, m_pages()
+	, m_glyphs()
+	, m_index()
+	, m_frame(0)
+	, m_eviction_count(0)
+{
+	wvn_ASSERT(page_size > 0, "[GLYPHATLAS|DEBUG] Page size must be greater than 0.");
+	wvn_ASSERT(max_pages > 0, "[GLYPHATLAS|DEBUG] Must allow at least one page.");
+
+	rebuild_index();
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	for (auto& page : m_pages) {
+		delete page.texture;
+	}
+}
+
+void GlyphAtlas::begin_frame()
+{
+	m_frame++;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::get(const Font* font, u32 codepoint)
+{
+	u32 slot = find_slot(font, codepoint);
+
+	if (m_index[slot] == EMPTY_SLOT) {
+		return add(font, codepoint);
+	}
+
+	const Glyph& glyph = m_glyphs[m_index[slot]];
+
+	if (glyph.page != NO_PAGE) {
+		m_pages[glyph.page].last_used_frame = m_frame;
+	}
+
+	return &glyph;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::add(const Font* font, u32 codepoint)
+{
+	Font::Character character = font->get_character(codepoint);
+	RectI box = font->glyph_box(character.glyph, m_mode);
+
+	Glyph glyph = {
+		.font = font,
+		.codepoint = codepoint,
+		.page = NO_PAGE,
+		.advance_x = character.advance_x,
+		.offset = Vec2F(box.x, box.y),
+		.size = Vec2F(box.w, box.h),
+		.uv0 = Vec2F::zero(),
+		.uv1 = Vec2F::zero()
+	};
+
+	if (box.w > 0 && box.h > 0)
+	{
+		u32 page_idx = 0;
+		u32 x = 0;
+		u32 y = 0;
+
+		if (!pack(box.w + GLYPH_SPACING, box.h + GLYPH_SPACING, &page_idx, &x, &y)) {
+			return nullptr;
+		}
+
+		Page& page = m_pages[page_idx];
+
+		font->rasterise(character.glyph, m_mode, page.bitmap.data() + (y * m_page_size) + x, m_page_size);
+
+		page.dirty = true;
+		page.last_used_frame = m_frame;
+
+		float inv_page_size = 1.0f / (float)m_page_size;
+
+		glyph.page = page_idx;
+		glyph.uv0 = Vec2F(x, y) * inv_page_size;
+		glyph.uv1 = Vec2F(x + box.w, y + box.h) * inv_page_size;
+	}
+
+	m_glyphs.push_back(glyph);
+	insert_into_index(m_glyphs.size() - 1);
+
+	return &m_glyphs.back();
+}
+
+bool GlyphAtlas::pack(u32 w, u32 h, u32* out_page, u32* out_x, u32* out_y)
+{
+	if (w > m_page_size || h > m_page_size) {
+		return false;
+	}
+
+	for (u32 i = 0; i < m_pages.size(); i++)
+	{
+		if (pack_into_page(m_pages[i], w, h, out_x, out_y)) {
+			(*out_page) = i;
+			return true;
+		}
+	}
+
+	if (m_pages.size() < m_max_pages)
+	{
+		m_pages.push_back(Page());
+		m_pages.back().texture = nullptr;
+
+		reset_page(m_pages.back());
+
+		(*out_page) = m_pages.size() - 1;
+		return pack_into_page(m_pages.back(), w, h, out_x, out_y);
+	}
+
+	u32 victim = find_eviction_victim();
+
+	if (victim == NO_PAGE) {
+		return false;
+	}
+
+	evict_page(victim);
+
+	(*out_page) = victim;
+	return pack_into_page(m_pages[victim], w, h, out_x, out_y);
+}
+
+// bottom-left skyline, picks whichever spot leaves the lowest top edge
+bool GlyphAtlas::pack_into_page(Page& page, u32 w, u32 h, u32* out_x, u32* out_y)
+{
+	u32 best_idx = EMPTY_SLOT;
+	u32 best_top = EMPTY_SLOT;
+	u32 best_width = EMPTY_SLOT;
+	u32 best_y = 0;
+
+	for (u32 i = 0; i < page.skyline.size(); i++)
+	{
+		u32 y = 0;
+
+		if (!skyline_fits(page, i, w, h, &y)) {
+			continue;
+		}
+
+		u32 top = y + h;
+
+		if (top < best_top || (top == best_top && page.skyline[i].w < best_width))
+		{
+			best_idx = i;
+			best_top = top;
+			best_width = page.skyline[i].w;
+			best_y = y;
+		}
+	}
+
+	if (best_idx == EMPTY_SLOT) {
+		return false;
+	}
+
+	SkylineNode node = { .x = page.skyline[best_idx].x, .y = best_y + h, .w = w };
+	insert_at(page.skyline, best_idx, node);
+
+	// whatever the new node now covers gets cut off the nodes after it
+	for (u32 i = best_idx + 1; i < page.skyline.size();)
+	{
+		const SkylineNode& prev = page.skyline[i - 1];
+		SkylineNode& curr = page.skyline[i];
+
+		u32 prev_end = prev.x + prev.w;
+
+		if (curr.x >= prev_end) {
+			break;
+		}
+
+		u32 shrink = prev_end - curr.x;
+
+		if (curr.w <= shrink) {
+			remove_at(page.skyline, i);
+			continue;
+		}
+
+		curr.x += shrink;
+		curr.w -= shrink;
+		break;
+	}
+
+	for (u32 i = 0; i + 1 < page.skyline.size();)
+	{
+		if (page.skyline[i].y == page.skyline[i + 1].y) {
+			page.skyline[i].w += page.skyline[i + 1].w;
+			remove_at(page.skyline, i + 1);
+		} else {
+			i++;
+		}
+	}
+
+	(*out_x) = node.x;
+	(*out_y) = best_y;
+
+	return true;
+}
+
+bool GlyphAtlas::skyline_fits(const Page& page, u32 node_idx, u32 w, u32 h, u32* out_y) const
+{
+	u32 x = page.skyline[node_idx].x;
+
+	if (x + w > m_page_size) {
+		return false;
+	}
+
+	u32 y = 0;
+	s64 width_left = w;
+
+	for (u32 i = node_idx; width_left > 0; i++)
+	{
+		y = CalcU::max(y, page.skyline[i].y);
+
+		if (y + h > m_page_size) {
+			return false;
+		}
+
+		width_left -= page.skyline[i].w;
+	}
+
+	(*out_y) = y;
+	return true;
+}
+
+u32 GlyphAtlas::find_eviction_victim() const
+{
+	u32 victim = NO_PAGE;
+	u64 oldest_frame = m_frame;
+
+	for (u32 i = 0; i < m_pages.size(); i++)
+	{
+		if (m_pages[i].last_used_frame < oldest_frame) {
+			victim = i;
+			oldest_frame = m_pages[i].last_used_frame;
+		}
+	}
+
+	return victim;
+}
+
+void GlyphAtlas::evict_page(u32 page_idx)
+{
+	reset_page(m_pages[page_idx]);
+
+	// drop every glyph that lived on the page, the rest keep their order
+	u64 kept = 0;
+
+	for (u64 i = 0; i < m_glyphs.size(); i++)
+	{
+		if (m_glyphs[i].page != page_idx) {
+			m_glyphs[kept++] = m_glyphs[i];
+		}
+	}
+
+	while (m_glyphs.size() > kept) {
+		m_glyphs.pop_back();
+	}
+
+	rebuild_index();
+
+	m_eviction_count++;
+}
+
+void GlyphAtlas::reset_page(Page& page)
+{
+	if (page.bitmap.empty()) {
+		page.bitmap.resize(m_page_size * m_page_size);
+	} else {
+		mem::set(page.bitmap.data(), 0, page.bitmap.size());
+	}
+
+	page.skyline.clear();
+	page.skyline.push_back({ .x = 0, .y = 0, .w = m_page_size });
+
+	page.last_used_frame = m_frame;
+	page.dirty = true;
+}
+
+void GlyphAtlas::clear()
+{
+	for (auto& page : m_pages) {
+		reset_page(page);
+	}
+
+	m_glyphs.clear();
+	rebuild_index();
+}
+
+void GlyphAtlas::upload()
+{
+	for (auto& page : m_pages)
+	{
+		if (!page.dirty) {
+			continue;
+		}
+
+		if (page.texture) {
+			TextureMgr::get_singleton()->update(page.texture, page.bitmap.data(), page.bitmap.size());
+		} else {
+			page.texture = TextureMgr::get_singleton()->create(m_page_size, m_page_size, TEX_FORMAT_R8_UNORM, TEX_TILE_NONE, page.bitmap.data(), page.bitmap.size());
+		}
+
+		page.dirty = false;
+	}
+}
+
+u32 GlyphAtlas::find_slot(const Font* font, u32 codepoint) const
+{
+	u32 mask = m_index.size() - 1;
+
+	for (u32 i = hash_glyph_key(font, codepoint) & mask;; i = (i + 1) & mask)
+	{
+		if (m_index[i] == EMPTY_SLOT) {
+			return i;
+		}
+
+		const Glyph& glyph = m_glyphs[m_index[i]];
+
+		if (glyph.font == font && glyph.codepoint == codepoint) {
+			return i;
+		}
+	}
+}
+
+void GlyphAtlas::insert_into_index(u32 glyph_idx)
+{
+	// keep at most half the slots full
+	if (m_glyphs.size() * 2 > m_index.size()) {
+		rebuild_index();
+		return;
+	}
+
+	const Glyph& glyph = m_glyphs[glyph_idx];
+	m_index[find_slot(glyph.font, glyph.codepoint)] = glyph_idx;
+}
+
+void GlyphAtlas::rebuild_index()
+{
+	u32 capacity = MIN_INDEX_CAPACITY;
+
+	while (capacity < m_glyphs.size() * 4) {
+		capacity *= 2;
+	}
+
+	m_index.clear();
+	m_index.resize(capacity);
+
+	for (auto& slot : m_index) {
+		slot = EMPTY_SLOT;
+	}
+
+	for (u32 i = 0; i < m_glyphs.size(); i++) {
+		m_index[find_slot(m_glyphs[i].font, m_glyphs[i].codepoint)] = i;
+	}
+}
+
+u32 GlyphAtlas::page_count() const { return m_pages.size(); }
+Texture* GlyphAtlas::page_texture(u32 page) const { return m_pages[page].texture; }
+const byte* GlyphAtlas::page_bitmap(u32 page) const { return m_pages[page].bitmap.data(); }
+
+u32 GlyphAtlas::page_size() const { return m_page_size; }
+GlyphRenderMode GlyphAtlas::render_mode() const { return m_mode; }
+
+u64 GlyphAtlas::glyph_count() const { return m_glyphs.size(); }
+u64 GlyphAtlas::eviction_count() const { return m_eviction_count; }
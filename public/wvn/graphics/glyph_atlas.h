@@ -0,0 +1,111 @@
+#ifndef GLYPH_ATLAS_H_
+#define GLYPH_ATLAS_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/maths/vec2.h>
+#include <wvn/graphics/font.h>
+
+namespace wvn::gfx
+{
+	class Texture;
+
+	/**
+	 * Glyphs are rasterised into the atlas the first time they're asked for and stay there until their page is evicted.
+	 * Pages are packed with a skyline packer. Once they're all full, the page that has gone the longest without being
+	 * drawn from is cleared and reused, pages used during the current frame are never evicted.
+	 */
+	class GlyphAtlas
+	{
+		struct SkylineNode
+		{
+			u32 x;
+			u32 y;
+			u32 w;
+		};
+
+		struct Page
+		{
+			Vector<byte> bitmap;
+			Vector<SkylineNode> skyline;
+			Texture* texture;
+			u64 last_used_frame;
+			bool dirty;
+		};
+
+	public:
+		static constexpr u32 NO_PAGE = 0xFFFFFFFF;
+
+		static constexpr u32 DEFAULT_PAGE_SIZE = 1024;
+		static constexpr u32 DEFAULT_MAX_PAGES = 4;
+
+		// empty texels left between glyphs so filtering doesn't bleed between them
+		static constexpr u32 GLYPH_SPACING = 1;
+
+		struct Glyph
+		{
+			const Font* font;
+			u32 codepoint;
+			u32 page; // NO_PAGE for glyphs with nothing to draw, like spaces
+			float advance_x;
+			Vec2F offset; // top left of the quad relative to the pen on the baseline, in pixels at the loaded size
+			Vec2F size;
+			Vec2F uv0;
+			Vec2F uv1;
+		};
+
+		GlyphAtlas(GlyphRenderMode mode = GLYPH_RENDER_MODE_SDF, u32 page_size = DEFAULT_PAGE_SIZE, u32 max_pages = DEFAULT_MAX_PAGES);
+		~GlyphAtlas();
+
+		void begin_frame();
+
+		// rasterises the glyph if it isn't in the atlas yet, null if there was no room for it this frame
+		// the result is only valid until the next call
+		const Glyph* get(const Font* font, u32 codepoint);
+
+		// pushes every page that changed since the last upload to the gpu
+		void upload();
+
+		void clear();
+
+		u32 page_count() const;
+		Texture* page_texture(u32 page) const;
+		const byte* page_bitmap(u32 page) const;
+
+		u32 page_size() const;
+		GlyphRenderMode render_mode() const;
+
+		u64 glyph_count() const;
+		u64 eviction_count() const;
+
+	private:
+		const Glyph* add(const Font* font, u32 codepoint);
+
+		bool pack(u32 w, u32 h, u32* out_page, u32* out_x, u32* out_y);
+		bool pack_into_page(Page& page, u32 w, u32 h, u32* out_x, u32* out_y);
+		bool skyline_fits(const Page& page, u32 node_idx, u32 w, u32 h, u32* out_y) const;
+
+		u32 find_eviction_victim() const;
+		void evict_page(u32 page_idx);
+		void reset_page(Page& page);
+
+		u32 find_slot(const Font* font, u32 codepoint) const;
+		void insert_into_index(u32 glyph_idx);
+		void rebuild_index();
+
+		GlyphRenderMode m_mode;
+		u32 m_page_size;
+		u32 m_max_pages;
+
+		Vector<Page> m_pages;
+		Vector<Glyph> m_glyphs;
+
+		// open addressing from (font, codepoint) to an index into m_glyphs, the capacity is always a power of two
+		Vector<u32> m_index;
+
+		u64 m_frame;
+		u64 m_eviction_count;
+	};
+}
+
+#endif // GLYPH_ATLAS_H_
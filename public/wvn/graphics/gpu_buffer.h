@@ -29,6 +29,7 @@ namespace wvn::gfx
 		virtual void write_data_to_memory(void* dst, u64 length, u64 offset) = 0;
 		virtual void write_to_buffer(const GPUBuffer* dst, u64 length, u64 src_offset, u64 dst_offset) = 0;
 		virtual void write_to_tex(const Texture* texture, u64 size, u64 offset = 0, u32 base_array_layer = 0) = 0;
+		virtual void upload_data(const void* src, u64 length, u64 offset) = 0;
 
 		virtual GPUBufferUsage usage() const = 0;
 	};
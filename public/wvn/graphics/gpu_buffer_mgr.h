@@ -19,6 +19,10 @@ namespace wvn::gfx
 		virtual GPUBuffer* create_vertex_buffer(u64 vertex_count) = 0;
 		virtual GPUBuffer* create_index_buffer(u64 index_count) = 0;
 		virtual GPUBuffer* create_uniform_buffer(u64 size) = 0;
+		virtual GPUBuffer* create_storage_buffer(u64 size) = 0;
+
+		// the buffer is only actually freed once no frame in flight can still be using it
+		virtual void destroy_buffer(GPUBuffer* buffer) = 0;
 	};
 }
 
@@ -1,4 +1,5 @@
 #include <wvn/graphics/image.h>
+#include <wvn/graphics/image_codec_registry.h>
 #include <wvn/io/file_stream.h>
 #include <wvn/devenv/log_mgr.h>
 #include <wvn/maths/calc.h>
@@ -48,6 +49,14 @@ Image::~Image()
 
 void Image::load(const char* path)
 {
+	free();
+
+	// go through whichever codec is registered for the format if we can
+	if (ImageCodecRegistry* registry = ImageCodecRegistry::get_singleton()) {
+		registry->load_batch(&path, this, 1, 1);
+		return;
+	}
+
 	this->m_stbi_management = true;
 
 	int w, h, nrc;
@@ -72,12 +81,23 @@ void Image::free()
 	m_pixels = nullptr;
 }
 
-void Image::paint(const Brush& brush)
+void Image::allocate(u32 width, u32 height, int nr_channels)
+{
+	free();
+
+	m_pixels = new Colour[width * height];
+	m_width = width;
+	m_height = height;
+	m_nr_channels = nr_channels;
+	m_stbi_management = false;
+}
+
+void Image::paint(Brush brush)
 {
 	paint(RectI(0, 0, m_width, m_height), brush);
 }
 
-void Image::paint(const RectI& rect, const Brush& brush)
+void Image::paint(const RectI& rect, Brush brush)
 {
 	for (int y = 0; y < rect.h; y++)
 	{
@@ -14,7 +14,7 @@ namespace wvn::gfx
 	class Image
 	{
 	public:
-		using Brush = Function<Colour(u32, u32)>;
+		using Brush = FunctionRef<Colour(u32, u32)>;
 
 		Image();
 		Image(const char* path);
@@ -24,8 +24,11 @@ namespace wvn::gfx
 		void load(const char* path);
 		void free();
 
-		void paint(const Brush& brush);
-		void paint(const RectI& rect, const Brush& brush);
+		// throws away the current pixels, the new ones are left uninitialized
+		void allocate(u32 width, u32 height, int nr_channels = 0);
+
+		void paint(Brush brush);
+		void paint(const RectI& rect, Brush brush);
 
 		void pixels(const Colour* data);
 		void pixels(const Colour* data, u64 pixel_count);
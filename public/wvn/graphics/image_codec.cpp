@@ -0,0 +1,53 @@
+#include <wvn/graphics/image_codec.h>
+
+// the implementation itself lives in image.cpp
+#include <third_party/stb_image.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+const char* StbImageCodec::name() const
+{
+	return "stb_image";
+}
+
+bool StbImageCodec::can_decode(const byte* data, u64 size) const
+{
+	int w, h, nrc;
+	return stbi_info_from_memory(data, (int)size, &w, &h, &nrc) != 0;
+}
+
+bool StbImageCodec::read_info(const byte* data, u64 size, ImageInfo* info) const
+{
+	int w, h, nrc;
+
+	if (!stbi_info_from_memory(data, (int)size, &w, &h, &nrc)) {
+		return false;
+	}
+
+	info->width = w;
+	info->height = h;
+	info->nr_channels = nrc;
+
+	return true;
+}
+
+bool StbImageCodec::decode(const byte* data, u64 size, const ImageInfo& info, Colour* output) const
+{
+	int w, h, nrc;
+	stbi_uc* pixels = stbi_load_from_memory(data, (int)size, &w, &h, &nrc, 4);
+
+	if (!pixels) {
+		return false;
+	}
+
+	bool matches = ((u32)w == info.width) && ((u32)h == info.height);
+
+	if (matches) {
+		mem::copy(output, pixels, sizeof(Colour) * info.pixel_count());
+	}
+
+	stbi_image_free(pixels);
+
+	return matches;
+}
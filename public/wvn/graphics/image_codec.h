@@ -0,0 +1,57 @@
+#ifndef IMAGE_CODEC_H_
+#define IMAGE_CODEC_H_
+
+#include <wvn/common.h>
+#include <wvn/maths/colour.h>
+
+namespace wvn::gfx
+{
+	struct ImageInfo
+	{
+		u32 width;
+		u32 height;
+		int nr_channels; // channels stored in the file, decoding always produces rgba8
+
+		u64 pixel_count() const { return (u64)width * height; }
+	};
+
+	/**
+	 * Decoder for one or more encoded image formats.
+	 * Must be safe to call from several threads at once as batches are decoded in parallel.
+	 */
+	class ImageCodec
+	{
+	public:
+		ImageCodec() = default;
+		virtual ~ImageCodec() = default;
+
+		virtual const char* name() const = 0;
+
+		// should only sniff the header, this is asked of every codec until one claims the data
+		virtual bool can_decode(const byte* data, u64 size) const = 0;
+
+		virtual bool read_info(const byte* data, u64 size, ImageInfo* info) const = 0;
+
+		// output is caller owned and holds exactly info.width * info.height pixels
+		virtual bool decode(const byte* data, u64 size, const ImageInfo& info, Colour* output) const = 0;
+	};
+
+	/**
+	 * Fallback codec built on stb_image, handles png, jpg, bmp, tga, gif, psd, hdr & pnm.
+	 * stb always decodes into its own allocation so this costs one extra copy per image.
+	 */
+	class StbImageCodec : public ImageCodec
+	{
+	public:
+		StbImageCodec() = default;
+		~StbImageCodec() override = default;
+
+		const char* name() const override;
+
+		bool can_decode(const byte* data, u64 size) const override;
+		bool read_info(const byte* data, u64 size, ImageInfo* info) const override;
+		bool decode(const byte* data, u64 size, const ImageInfo& info, Colour* output) const override;
+	};
+}
+
+#endif // IMAGE_CODEC_H_
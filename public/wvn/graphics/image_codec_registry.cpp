@@ -0,0 +1,200 @@
+#include <wvn/graphics/image_codec_registry.h>
+#include <wvn/io/file_stream.h>
+#include <wvn/devenv/log_mgr.h>
+#include <wvn/maths/calc.h>
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+wvn_IMPL_SINGLETON(ImageCodecRegistry);
+
+ImageCodecRegistry::ImageCodecRegistry()
+	: m_codecs()
+	, m_stb_codec()
+{
+	register_codec(&m_stb_codec);
+}
+
+ImageCodecRegistry::~ImageCodecRegistry()
+{
+}
+
+void ImageCodecRegistry::register_codec(ImageCodec* codec)
+{
+	for (auto& existing : m_codecs)
+	{
+		if (existing == codec) {
+			return;
+		}
+	}
+
+	m_codecs.push_back(codec);
+
+	dev::LogMgr::get_singleton()->print("[GFX:IMAGECODEC] Registered codec: %s", codec->name());
+}
+
+void ImageCodecRegistry::unregister_codec(ImageCodec* codec)
+{
+	Vector<ImageCodec*> remaining;
+
+	for (auto& existing : m_codecs)
+	{
+		if (existing != codec) {
+			remaining.push_back(existing);
+		}
+	}
+
+	m_codecs = remaining;
+}
+
+const ImageCodec* ImageCodecRegistry::find_codec(const byte* data, u64 size) const
+{
+	for (int i = (int)m_codecs.size() - 1; i >= 0; i--)
+	{
+		if (m_codecs[i]->can_decode(data, size)) {
+			return m_codecs[i];
+		}
+	}
+
+	return nullptr;
+}
+
+bool ImageCodecRegistry::read_info(const byte* data, u64 size, ImageInfo* info) const
+{
+	const ImageCodec* codec = find_codec(data, size);
+	return codec && codec->read_info(data, size, info);
+}
+
+bool ImageCodecRegistry::decode(const byte* data, u64 size, const ImageInfo& info, Colour* output) const
+{
+	const ImageCodec* codec = find_codec(data, size);
+	return codec && codec->decode(data, size, info, output);
+}
+
+// runs on a worker thread, failures are reported once the whole batch is done
+void ImageCodecRegistry::decode_request(u32 index, ImageDecodeRequest* request, const Allocator& allocator) const
+{
+	request->success = false;
+
+	Vector<byte> file_data;
+	const byte* data = request->data;
+	u64 size = request->size;
+
+	if (request->path)
+	{
+		io::FileStream fs(request->path, "rb");
+		s64 file_size = fs.size();
+
+		if (file_size <= 0) {
+			return;
+		}
+
+		file_data.resize(file_size);
+		fs.read(file_data.data(), file_size);
+
+		data = file_data.data();
+		size = file_size;
+	}
+
+	const ImageCodec* codec = find_codec(data, size);
+
+	if (!codec || !codec->read_info(data, size, &request->info)) {
+		return;
+	}
+
+	if (request->output)
+	{
+		if (request->output_capacity < request->info.pixel_count()) {
+			return;
+		}
+	}
+	else if (allocator)
+	{
+		request->output = allocator(index, request->info);
+	}
+
+	if (!request->output) {
+		return;
+	}
+
+	request->success = codec->decode(data, size, request->info, request->output);
+}
+
+// images take wildly different amounts of time to decode so workers pull the next one off a shared counter
+void ImageCodecRegistry::decode_batch(ImageDecodeRequest* requests, u32 count, const Allocator& allocator, u32 thread_count) const
+{
+	if (count == 0) {
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	if (thread_count == 0) {
+		thread_count = std::thread::hardware_concurrency();
+	}
+
+	thread_count = CalcU::clamp(thread_count, 1, count);
+
+	std::atomic<u32> next_request(0);
+
+	auto worker = [&]()
+	{
+		for (u32 i = next_request++; i < count; i = next_request++) {
+			decode_request(i, &requests[i], allocator);
+		}
+	};
+
+	Vector<std::thread*> workers;
+
+	for (u32 i = 1; i < thread_count; i++) {
+		workers.push_back(new std::thread(worker));
+	}
+
+	worker();
+
+	for (auto& thread : workers)
+	{
+		thread->join();
+		delete thread;
+	}
+
+	for (u32 i = 0; i < count; i++)
+	{
+		if (!requests[i].success) {
+			dev::LogMgr::get_singleton()->print("[GFX:IMAGECODEC] Failed to decode image: %s", requests[i].path ? requests[i].path : "<memory>");
+		}
+	}
+
+	if (count > 1)
+	{
+		double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		dev::LogMgr::get_singleton()->print("[GFX:IMAGECODEC] Decoded %d images on %d thread(s) in %.2fms.", count, thread_count, elapsed_ms);
+	}
+}
+
+bool ImageCodecRegistry::load_batch(const char* const* paths, Image* images, u32 count, u32 thread_count) const
+{
+	Vector<ImageDecodeRequest> requests(count);
+
+	for (u32 i = 0; i < count; i++) {
+		requests[i].path = paths[i];
+	}
+
+	// every image is its own allocation so the workers don't need to coordinate
+	decode_batch(requests.data(), count, [images](u32 index, const ImageInfo& info) -> Colour* {
+		images[index].allocate(info.width, info.height, info.nr_channels);
+		return images[index].pixels();
+	}, thread_count);
+
+	bool success = true;
+
+	for (auto& request : requests) {
+		success &= request.success;
+	}
+
+	return success;
+}
@@ -0,0 +1,67 @@
+#ifndef IMAGE_CODEC_REGISTRY_H_
+#define IMAGE_CODEC_REGISTRY_H_
+
+#include <wvn/singleton.h>
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/container/function.h>
+#include <wvn/graphics/image_codec.h>
+#include <wvn/graphics/image.h>
+
+namespace wvn::gfx
+{
+	struct ImageDecodeRequest
+	{
+		// either a path to read from...
+		const char* path = nullptr;
+
+		// ...or encoded bytes that are already in memory
+		const byte* data = nullptr;
+		u64 size = 0;
+
+		// where to decode to, when null the batch allocator is asked for somewhere once the size is known
+		Colour* output = nullptr;
+		u64 output_capacity = 0; // in pixels
+
+		ImageInfo info = {};
+		bool success = false;
+	};
+
+	/**
+	 * Picks the codec for encoded image data & decodes batches of independent images across worker threads.
+	 * Codecs registered later are asked first, so plugins can override the stb fallback for the formats they handle.
+	 * Codecs must not be (un)registered while a batch is being decoded.
+	 */
+	class ImageCodecRegistry : public Singleton<ImageCodecRegistry>
+	{
+		wvn_DEF_SINGLETON(ImageCodecRegistry);
+
+	public:
+		// called from the worker threads, with the index of the request & its header
+		using Allocator = Function<Colour*(u32, const ImageInfo&)>;
+
+		ImageCodecRegistry();
+		~ImageCodecRegistry();
+
+		void register_codec(ImageCodec* codec);
+		void unregister_codec(ImageCodec* codec);
+
+		const ImageCodec* find_codec(const byte* data, u64 size) const;
+
+		bool read_info(const byte* data, u64 size, ImageInfo* info) const;
+		bool decode(const byte* data, u64 size, const ImageInfo& info, Colour* output) const;
+
+		void decode_batch(ImageDecodeRequest* requests, u32 count, const Allocator& allocator = nullptr, u32 thread_count = 0) const;
+
+		// decodes every path into its matching image
+		bool load_batch(const char* const* paths, Image* images, u32 count, u32 thread_count = 0) const;
+
+	private:
+		void decode_request(u32 index, ImageDecodeRequest* request, const Allocator& allocator) const;
+
+		Vector<ImageCodec*> m_codecs;
+		StbImageCodec m_stb_codec;
+	};
+}
+
+#endif // IMAGE_CODEC_REGISTRY_H_
@@ -0,0 +1,835 @@
+#include <wvn/graphics/image_ops.h>
+#include <wvn/container/vector.h>
+#include <wvn/maths/calc.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define wvn_IMG_SSE 1
+#include <emmintrin.h>
+#else
+#define wvn_IMG_SSE 0
+#endif
+
+#if defined(__AVX2__)
+#define wvn_IMG_AVX2 1
+#else
+#define wvn_IMG_AVX2 0
+#endif
+
+// fma and f16c are separate extensions, gcc & clang only define these when they're enabled.
+// msvc has no macros for them but /arch:AVX2 allows both
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define wvn_IMG_FMA 1
+#else
+#define wvn_IMG_FMA 0
+#endif
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define wvn_IMG_F16C 1
+#else
+#define wvn_IMG_F16C 0
+#endif
+
+#if wvn_IMG_AVX2 || wvn_IMG_FMA || wvn_IMG_F16C
+#include <immintrin.h>
+#endif
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	struct ConversionTables
+	{
+		float to_float[512]; // [0, 256) decodes srgb, [256, 512) is plain unorm so alpha can share the same lookup
+		u8 from_linear[4096];
+		u16 to_half[256];
+
+		ConversionTables()
+		{
+			for (u32 i = 0; i < 256; i++)
+			{
+				float c = (float)i / 255.0f;
+
+				to_float[i] = (c <= 0.04045f) ? (c / 12.92f) : CalcF::pow((c + 0.055f) / 1.055f, 2.4f);
+				to_float[256 + i] = c;
+				to_half[i] = imgops::float_to_half(c);
+			}
+
+			for (u32 i = 0; i < 4096; i++)
+			{
+				float c = (float)i / 4095.0f;
+				float s = (c <= 0.0031308f) ? (c * 12.92f) : ((1.055f * CalcF::pow(c, 1.0f / 2.4f)) - 0.055f);
+
+				from_linear[i] = (u8)CalcF::clamp(CalcF::floor((s * 255.0f) + 0.5f), 0.0f, 255.0f);
+			}
+		}
+	};
+
+	const ConversionTables& tables()
+	{
+		static ConversionTables tables;
+		return tables;
+	}
+
+	union FloatBits
+	{
+		float f;
+		u32 u;
+	};
+
+	float saturate(float x)
+	{
+		// written so that nan ends up as 0
+		return (x > 0.0f) ? ((x < 1.0f) ? x : 1.0f) : 0.0f;
+	}
+
+	/*
+	 * Resampling.
+	 */
+
+	struct FilterWeights
+	{
+		Vector<u32> starts;
+		Vector<u32> counts;
+		Vector<float> weights; // 'taps' weights per output texel, unused ones are left at zero
+		u32 taps;
+	};
+
+	float sinc(float x)
+	{
+		if (CalcF::abs(x) < 1e-5f) {
+			return 1.0f;
+		}
+
+		return CalcF::sin(CalcF::PI * x) / (CalcF::PI * x);
+	}
+
+	float filter_radius(imgops::ResampleFilter filter)
+	{
+		switch (filter)
+		{
+		case imgops::RESAMPLE_FILTER_BOX:
+			return 0.5f;
+
+		case imgops::RESAMPLE_FILTER_TRIANGLE:
+			return 1.0f;
+
+		case imgops::RESAMPLE_FILTER_CATMULL_ROM:
+			return 2.0f;
+
+		case imgops::RESAMPLE_FILTER_LANCZOS3:
+			return 3.0f;
+
+		default:
+			return 1.0f;
+		}
+	}
+
+	float filter_eval(imgops::ResampleFilter filter, float t)
+	{
+		float x = CalcF::abs(t);
+
+		switch (filter)
+		{
+		case imgops::RESAMPLE_FILTER_BOX:
+			return (t >= -0.5f && t < 0.5f) ? 1.0f : 0.0f;
+
+		case imgops::RESAMPLE_FILTER_TRIANGLE:
+			return CalcF::max(1.0f - x, 0.0f);
+
+		case imgops::RESAMPLE_FILTER_CATMULL_ROM:
+			if (x < 1.0f) {
+				return ((1.5f * x - 2.5f) * x * x) + 1.0f;
+			} else if (x < 2.0f) {
+				return (((-0.5f * x + 2.5f) * x - 4.0f) * x) + 2.0f;
+			}
+			return 0.0f;
+
+		case imgops::RESAMPLE_FILTER_LANCZOS3:
+			return (x < 3.0f) ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+
+		default:
+			return 0.0f;
+		}
+	}
+
+	// the kernel is stretched out when shrinking so every source texel still contributes
+	void build_weights(imgops::ResampleFilter filter, u32 src_size, u32 dst_size, FilterWeights* out)
+	{
+		float scale = (float)dst_size / (float)src_size;
+		float kernel_scale = CalcF::min(scale, 1.0f);
+		float support = filter_radius(filter) / kernel_scale;
+
+		out->taps = (u32)CalcF::ceil(support * 2.0f) + 2;
+		out->starts = Vector<u32>(dst_size);
+		out->counts = Vector<u32>(dst_size);
+		out->weights = Vector<float>(dst_size * out->taps);
+
+		for (u32 i = 0; i < dst_size; i++)
+		{
+			float centre = ((float)i + 0.5f) / scale;
+
+			s32 lo = (s32)CalcF::floor(centre - support);
+			s32 hi = (s32)CalcF::ceil(centre + support);
+			s32 first = CalcI::clamp(lo, 0, (s32)src_size - 1);
+			s32 last = CalcI::clamp(hi, 0, (s32)src_size - 1);
+
+			float* weights = &out->weights[i * out->taps];
+			float total = 0.0f;
+
+			// taps that land outside of the image are folded onto the edge texel
+			for (s32 j = lo; j <= hi; j++)
+			{
+				float w = filter_eval(filter, (((float)j + 0.5f) - centre) * kernel_scale);
+
+				if (w == 0.0f) {
+					continue;
+				}
+
+				weights[CalcI::clamp(j, 0, (s32)src_size - 1) - first] += w;
+				total += w;
+			}
+
+			if (total != 0.0f)
+			{
+				for (s32 k = 0; k <= last - first; k++) {
+					weights[k] /= total;
+				}
+			}
+			else
+			{
+				weights[CalcI::clamp((s32)centre, first, last) - first] = 1.0f;
+			}
+
+			out->starts[i] = first;
+			out->counts[i] = (last - first) + 1;
+		}
+	}
+
+	void resample_rows(const float* src, u32 src_width, u32 height, float* dst, u32 dst_width, const FilterWeights& fw)
+	{
+		for (u32 y = 0; y < height; y++)
+		{
+			const float* row = src + ((u64)y * src_width * 4);
+			float* out = dst + ((u64)y * dst_width * 4);
+
+			for (u32 x = 0; x < dst_width; x++)
+			{
+				const float* weights = &fw.weights[x * fw.taps];
+				const float* texels = row + (fw.starts[x] * 4);
+				u32 count = fw.counts[x];
+
+#if wvn_IMG_SSE
+				__m128 acc = _mm_setzero_ps();
+
+				for (u32 k = 0; k < count; k++) {
+					acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(texels + (k * 4))));
+				}
+
+				_mm_storeu_ps(out + (x * 4), acc);
+#else
+				float acc[4] = {};
+
+				for (u32 k = 0; k < count; k++)
+				{
+					for (u32 c = 0; c < 4; c++) {
+						acc[c] += weights[k] * texels[(k * 4) + c];
+					}
+				}
+
+				mem::copy(out + (x * 4), acc, sizeof(acc));
+#endif
+			}
+		}
+	}
+
+	// acc += row * weight, over a whole row of floats
+	void accumulate_row(float* acc, const float* row, float weight, u64 count)
+	{
+		u64 i = 0;
+
+#if wvn_IMG_AVX2
+		__m256 w8 = _mm256_set1_ps(weight);
+
+		for (; i + 8 <= count; i += 8) {
+#if wvn_IMG_FMA
+			_mm256_storeu_ps(acc + i, _mm256_fmadd_ps(w8, _mm256_loadu_ps(row + i), _mm256_loadu_ps(acc + i)));
+#else
+			_mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(w8, _mm256_loadu_ps(row + i))));
+#endif
+		}
+#endif
+
+#if wvn_IMG_SSE
+		__m128 w4 = _mm_set1_ps(weight);
+
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(w4, _mm_loadu_ps(row + i))));
+		}
+#endif
+
+		for (; i < count; i++) {
+			acc[i] += row[i] * weight;
+		}
+	}
+
+	// filtering straight alpha lets the colour of invisible texels bleed into visible ones
+	void premultiply_floats(float* texels, u64 count)
+	{
+		for (u64 i = 0; i < count; i++)
+		{
+			float* t = texels + (i * 4);
+
+#if wvn_IMG_SSE
+			__m128 v = _mm_loadu_ps(t);
+			__m128 a = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 p = _mm_mul_ps(v, a);
+
+			// put the original alpha back in the last lane
+			_mm_storeu_ps(t, _mm_shuffle_ps(p, _mm_shuffle_ps(p, v, _MM_SHUFFLE(3, 3, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0)));
+#else
+			t[0] *= t[3];
+			t[1] *= t[3];
+			t[2] *= t[3];
+#endif
+		}
+	}
+
+	void unpremultiply_floats(float* texels, u64 count)
+	{
+		for (u64 i = 0; i < count; i++)
+		{
+			float* t = texels + (i * 4);
+
+			if (t[3] <= 0.0f) {
+				continue;
+			}
+
+			float inv = 1.0f / t[3];
+
+			t[0] *= inv;
+			t[1] *= inv;
+			t[2] *= inv;
+		}
+	}
+
+#if wvn_IMG_SSE
+	// exact round(x / 255) for 16 bit lanes holding products of two bytes
+	__m128i div255_epu16(__m128i x)
+	{
+		x = _mm_add_epi16(x, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+
+	__m128i float4x4_to_unorm(__m128 p0, __m128 p1, __m128 p2, __m128 p3)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+
+		__m128i i0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(p0, zero), one), scale));
+		__m128i i1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(p1, zero), one), scale));
+		__m128i i2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(p2, zero), one), scale));
+		__m128i i3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(p3, zero), one), scale));
+
+		return _mm_packus_epi16(_mm_packs_epi32(i0, i1), _mm_packs_epi32(i2, i3));
+	}
+#endif
+
+#if wvn_IMG_AVX2
+	__m256i div255_epu16(__m256i x)
+	{
+		x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+		return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+	}
+#endif
+}
+
+void imgops::resize(const Image& src, Image* dst, ResampleFilter filter, bool srgb)
+{
+	resize(src.pixels(), src.width(), src.height(), dst->pixels(), dst->width(), dst->height(), filter, srgb);
+}
+
+// separable, rows first then columns, on premultiplied floats
+void imgops::resize(const Colour* src, u32 src_width, u32 src_height, Colour* dst, u32 dst_width, u32 dst_height, ResampleFilter filter, bool srgb)
+{
+	if (src_width == 0 || src_height == 0 || dst_width == 0 || dst_height == 0) {
+		return;
+	}
+
+	FilterWeights h_weights;
+	FilterWeights v_weights;
+
+	build_weights(filter, src_width, dst_width, &h_weights);
+	build_weights(filter, src_height, dst_height, &v_weights);
+
+	Vector<float> source((u64)src_width * src_height * 4);
+
+	if (srgb) {
+		srgb_to_linear(src, source.data(), (u64)src_width * src_height);
+	} else {
+		unorm_to_float(src, source.data(), (u64)src_width * src_height);
+	}
+
+	premultiply_floats(source.data(), (u64)src_width * src_height);
+
+	Vector<float> rows((u64)dst_width * src_height * 4);
+	resample_rows(source.data(), src_width, src_height, rows.data(), dst_width, h_weights);
+
+	Vector<float> acc((u64)dst_width * 4);
+	u64 row_floats = (u64)dst_width * 4;
+
+	for (u32 y = 0; y < dst_height; y++)
+	{
+		mem::set(acc.data(), 0, row_floats * sizeof(float));
+
+		const float* weights = &v_weights.weights[y * v_weights.taps];
+
+		for (u32 k = 0; k < v_weights.counts[y]; k++) {
+			accumulate_row(acc.data(), rows.data() + ((v_weights.starts[y] + k) * row_floats), weights[k], row_floats);
+		}
+
+		unpremultiply_floats(acc.data(), dst_width);
+
+		if (srgb) {
+			linear_to_srgb(acc.data(), dst + ((u64)y * dst_width), dst_width);
+		} else {
+			float_to_unorm(acc.data(), dst + ((u64)y * dst_width), dst_width);
+		}
+	}
+}
+
+void imgops::srgb_to_linear(const Colour* src, float* dst, u64 count)
+{
+	const float* lut = tables().to_float;
+	u64 i = 0;
+
+#if wvn_IMG_AVX2
+	// two pixels per gather, the alpha lanes are pointed at the unorm half of the table
+	const __m256i alpha_offset = _mm256_setr_epi32(0, 0, 0, 256, 0, 0, 0, 256);
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m256i idx = _mm256_add_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i))), alpha_offset);
+		_mm256_storeu_ps(dst + (i * 4), _mm256_i32gather_ps(lut, idx, 4));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		dst[(i * 4) + 0] = lut[src[i].r];
+		dst[(i * 4) + 1] = lut[src[i].g];
+		dst[(i * 4) + 2] = lut[src[i].b];
+		dst[(i * 4) + 3] = lut[256 + src[i].a];
+	}
+}
+
+void imgops::linear_to_srgb(const float* src, Colour* dst, u64 count)
+{
+	const u8* lut = tables().from_linear;
+	u64 i = 0;
+
+#if wvn_IMG_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_setr_ps(4095.0f, 4095.0f, 4095.0f, 255.0f);
+
+	alignas(16) s32 idx[4];
+
+	for (; i < count; i++)
+	{
+		__m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + (i * 4)), zero), one);
+		_mm_store_si128((__m128i*)idx, _mm_cvtps_epi32(_mm_mul_ps(v, scale)));
+
+		dst[i] = Colour(lut[idx[0]], lut[idx[1]], lut[idx[2]], (u8)idx[3]);
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		const float* t = src + (i * 4);
+
+		dst[i] = Colour(
+			lut[(u32)((saturate(t[0]) * 4095.0f) + 0.5f)],
+			lut[(u32)((saturate(t[1]) * 4095.0f) + 0.5f)],
+			lut[(u32)((saturate(t[2]) * 4095.0f) + 0.5f)],
+			(u8)((saturate(t[3]) * 255.0f) + 0.5f)
+		);
+	}
+}
+
+void imgops::unorm_to_float(const Colour* src, float* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_AVX2
+	const __m256 scale8 = _mm256_set1_ps(1.0f / 255.0f);
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+		_mm256_storeu_ps(dst + (i * 4), _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale8));
+	}
+#endif
+
+#if wvn_IMG_SSE
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i px = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(px, zero);
+		__m128i hi = _mm_unpackhi_epi8(px, zero);
+
+		_mm_storeu_ps(dst + (i * 4) + 0,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + (i * 4) + 4,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + (i * 4) + 8,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+		_mm_storeu_ps(dst + (i * 4) + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+	}
+#endif
+
+	const float* lut = tables().to_float + 256;
+
+	for (; i < count; i++)
+	{
+		for (u32 c = 0; c < 4; c++) {
+			dst[(i * 4) + c] = lut[src[i].data[c]];
+		}
+	}
+}
+
+void imgops::float_to_unorm(const float* src, Colour* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		const float* p = src + (i * 4);
+
+		__m128i packed = float4x4_to_unorm(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), _mm_loadu_ps(p + 12));
+		_mm_storeu_si128((__m128i*)(dst + i), packed);
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		for (u32 c = 0; c < 4; c++) {
+			dst[i].data[c] = (u8)((saturate(src[(i * 4) + c]) * 255.0f) + 0.5f);
+		}
+	}
+}
+
+void imgops::rgba8_to_rgba16f(const Colour* src, u16* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_F16C && wvn_IMG_AVX2
+	const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m256 v = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)))), scale);
+		_mm_storeu_si128((__m128i*)(dst + (i * 4)), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+	}
+#endif
+
+	// every byte only has one possible half so a table is exact
+	const u16* lut = tables().to_half;
+
+	for (; i < count; i++)
+	{
+		for (u32 c = 0; c < 4; c++) {
+			dst[(i * 4) + c] = lut[src[i].data[c]];
+		}
+	}
+}
+
+void imgops::rgba16f_to_rgba8(const u16* src, Colour* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_F16C && wvn_IMG_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		const u16* p = src + (i * 4);
+
+		__m128 p0 = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(p + 0)));
+		__m128 p1 = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(p + 4)));
+		__m128 p2 = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(p + 8)));
+		__m128 p3 = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(p + 12)));
+
+		_mm_storeu_si128((__m128i*)(dst + i), float4x4_to_unorm(p0, p1, p2, p3));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		for (u32 c = 0; c < 4; c++) {
+			dst[i].data[c] = (u8)((saturate(half_to_float(src[(i * 4) + c])) * 255.0f) + 0.5f);
+		}
+	}
+}
+
+void imgops::rgba8_to_r8(const Colour* src, u8* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_SSE
+	const __m128i mask = _mm_set1_epi32(0xFF);
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i p0 = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i + 0)), mask);
+		__m128i p1 = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i + 4)), mask);
+		__m128i p2 = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i + 8)), mask);
+		__m128i p3 = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i + 12)), mask);
+
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+	}
+#endif
+
+	for (; i < count; i++) {
+		dst[i] = src[i].r;
+	}
+}
+
+void imgops::rgba8_to_rg8(const Colour* src, u8* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_SSE
+	for (; i + 8 <= count; i += 8)
+	{
+		// sign extending the low half keeps its bits intact through the signed pack
+		__m128i p0 = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i*)(src + i + 0)), 16), 16);
+		__m128i p1 = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i*)(src + i + 4)), 16), 16);
+
+		_mm_storeu_si128((__m128i*)(dst + (i * 2)), _mm_packs_epi32(p0, p1));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		dst[(i * 2) + 0] = src[i].r;
+		dst[(i * 2) + 1] = src[i].g;
+	}
+}
+
+void imgops::r8_to_rgba8(const u8* src, Colour* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_SSE
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i opaque = _mm_set1_epi16((short)0xFF00);
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i r = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(r, zero);
+		__m128i hi = _mm_unpackhi_epi8(r, zero);
+
+		_mm_storeu_si128((__m128i*)(dst + i + 0),  _mm_unpacklo_epi16(lo, opaque));
+		_mm_storeu_si128((__m128i*)(dst + i + 4),  _mm_unpackhi_epi16(lo, opaque));
+		_mm_storeu_si128((__m128i*)(dst + i + 8),  _mm_unpacklo_epi16(hi, opaque));
+		_mm_storeu_si128((__m128i*)(dst + i + 12), _mm_unpackhi_epi16(hi, opaque));
+	}
+#endif
+
+	for (; i < count; i++) {
+		dst[i] = Colour(src[i], 0, 0, 255);
+	}
+}
+
+void imgops::rg8_to_rgba8(const u8* src, Colour* dst, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_SSE
+	const __m128i opaque = _mm_set1_epi16((short)0xFF00);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i rg = _mm_loadu_si128((const __m128i*)(src + (i * 2)));
+
+		_mm_storeu_si128((__m128i*)(dst + i + 0), _mm_unpacklo_epi16(rg, opaque));
+		_mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(rg, opaque));
+	}
+#endif
+
+	for (; i < count; i++) {
+		dst[i] = Colour(src[(i * 2) + 0], src[(i * 2) + 1], 0, 255);
+	}
+}
+
+void imgops::premultiply_alpha(Colour* pixels, u64 count)
+{
+	u64 i = 0;
+
+#if wvn_IMG_AVX2
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i rgb_mask = _mm256_set1_epi64x(0x0000FFFFFFFFFFFFll);
+		const __m256i alpha_one = _mm256_set1_epi64x(0x00FF000000000000ll);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i px = _mm256_loadu_si256((const __m256i*)(pixels + i));
+			__m256i lo = _mm256_unpacklo_epi8(px, zero);
+			__m256i hi = _mm256_unpackhi_epi8(px, zero);
+
+			__m256i alpha_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m256i alpha_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+			lo = div255_epu16(_mm256_mullo_epi16(lo, _mm256_or_si256(_mm256_and_si256(alpha_lo, rgb_mask), alpha_one)));
+			hi = div255_epu16(_mm256_mullo_epi16(hi, _mm256_or_si256(_mm256_and_si256(alpha_hi, rgb_mask), alpha_one)));
+
+			_mm256_storeu_si256((__m256i*)(pixels + i), _mm256_packus_epi16(lo, hi));
+		}
+	}
+#endif
+
+#if wvn_IMG_SSE
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i rgb_mask = _mm_set1_epi64x(0x0000FFFFFFFFFFFFll);
+		const __m128i alpha_one = _mm_set1_epi64x(0x00FF000000000000ll);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i px = _mm_loadu_si128((const __m128i*)(pixels + i));
+			__m128i lo = _mm_unpacklo_epi8(px, zero);
+			__m128i hi = _mm_unpackhi_epi8(px, zero);
+
+			// alpha is multiplied by 255 so it comes back out unchanged
+			__m128i alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m128i alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+			lo = div255_epu16(_mm_mullo_epi16(lo, _mm_or_si128(_mm_and_si128(alpha_lo, rgb_mask), alpha_one)));
+			hi = div255_epu16(_mm_mullo_epi16(hi, _mm_or_si128(_mm_and_si128(alpha_hi, rgb_mask), alpha_one)));
+
+			_mm_storeu_si128((__m128i*)(pixels + i), _mm_packus_epi16(lo, hi));
+		}
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		u32 a = pixels[i].a;
+
+		for (u32 c = 0; c < 3; c++)
+		{
+			u32 x = (pixels[i].data[c] * a) + 128;
+			pixels[i].data[c] = (u8)((x + (x >> 8)) >> 8);
+		}
+	}
+}
+
+void imgops::premultiply_alpha(Image* image)
+{
+	premultiply_alpha(image->pixels(), (u64)image->width() * image->height());
+}
+
+void imgops::flip_vertical(Colour* pixels, u32 width, u32 height)
+{
+	Vector<Colour> tmp(width);
+	u64 row_size = sizeof(Colour) * width;
+
+	for (u32 y = 0; y < height / 2; y++)
+	{
+		Colour* top = pixels + ((u64)y * width);
+		Colour* bottom = pixels + ((u64)(height - 1 - y) * width);
+
+		mem::copy(tmp.data(), top, row_size);
+		mem::copy(top, bottom, row_size);
+		mem::copy(bottom, tmp.data(), row_size);
+	}
+}
+
+void imgops::flip_vertical(Image* image)
+{
+	flip_vertical(image->pixels(), image->width(), image->height());
+}
+
+// rounds to nearest even, out of range values become infinity
+u16 imgops::float_to_half(float value)
+{
+	FloatBits fb;
+	fb.f = value;
+
+	u32 bits = fb.u;
+
+	u32 sign = (bits >> 16) & 0x8000;
+	u32 exponent = (bits >> 23) & 0xFF;
+	u32 mantissa = bits & 0x7FFFFF;
+
+	if (exponent == 0xFF) {
+		return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+	}
+
+	s32 e = (s32)exponent - 127 + 15;
+
+	if (e >= 31) {
+		return sign | 0x7C00;
+	}
+
+	if (e <= 0)
+	{
+		if (e < -10) {
+			return sign;
+		}
+
+		mantissa |= 0x800000;
+
+		u32 shift = 14 - e;
+		u32 half = mantissa >> shift;
+		u32 rem = mantissa & ((1u << shift) - 1);
+		u32 halfway = 1u << (shift - 1);
+
+		if (rem > halfway || (rem == halfway && (half & 1))) {
+			half++;
+		}
+
+		return sign | half;
+	}
+
+	u32 half = ((u32)e << 10) | (mantissa >> 13);
+	u32 rem = mantissa & 0x1FFF;
+
+	// a carry out of the mantissa correctly bumps the exponent
+	if (rem > 0x1000 || (rem == 0x1000 && (half & 1))) {
+		half++;
+	}
+
+	return sign | half;
+}
+
+// no loops for subnormals, the fpu renormalises them by subtracting the implicit bit back off
+float imgops::half_to_float(u16 value)
+{
+	constexpr u32 SHIFTED_EXPONENT = 0x7C00 << 13;
+
+	FloatBits fb;
+	fb.u = (u32)(value & 0x7FFF) << 13;
+
+	u32 exponent = fb.u & SHIFTED_EXPONENT;
+
+	fb.u += (127 - 15) << 23;
+
+	if (exponent == SHIFTED_EXPONENT)
+	{
+		// inf / nan
+		fb.u += (128 - 16) << 23;
+	}
+	else if (exponent == 0)
+	{
+		fb.u += 1 << 23;
+		fb.f -= 6.103515625e-05f; // 2^-14
+	}
+
+	fb.u |= (u32)(value & 0x8000) << 16;
+
+	return fb.f;
+}
@@ -0,0 +1,53 @@
+#ifndef IMAGE_OPS_H_
+#define IMAGE_OPS_H_
+
+#include <wvn/common.h>
+#include <wvn/maths/colour.h>
+#include <wvn/graphics/image.h>
+
+/*
+ * Bulk operations over whole images / pixel buffers.
+ * Everything has an SSE2 path (AVX2 / FMA / F16C where the compiler targets them) and a scalar fallback,
+ * float buffers are always four floats per pixel (rgba) and half buffers four halves per pixel.
+ */
+namespace wvn::gfx::imgops
+{
+	enum ResampleFilter
+	{
+		RESAMPLE_FILTER_BOX,
+		RESAMPLE_FILTER_TRIANGLE,
+		RESAMPLE_FILTER_CATMULL_ROM,
+		RESAMPLE_FILTER_LANCZOS3,
+		RESAMPLE_FILTER_MAX_ENUM
+	};
+
+	// dst must already be allocated at the size to resize to, filtering happens in linear space when srgb is set
+	void resize(const Image& src, Image* dst, ResampleFilter filter, bool srgb = true);
+	void resize(const Colour* src, u32 src_width, u32 src_height, Colour* dst, u32 dst_width, u32 dst_height, ResampleFilter filter, bool srgb = true);
+
+	// alpha is never gamma encoded, it is only rescaled to / from [0, 1]
+	void srgb_to_linear(const Colour* src, float* dst, u64 count);
+	void linear_to_srgb(const float* src, Colour* dst, u64 count);
+	void unorm_to_float(const Colour* src, float* dst, u64 count);
+	void float_to_unorm(const float* src, Colour* dst, u64 count);
+
+	void rgba8_to_rgba16f(const Colour* src, u16* dst, u64 count);
+	void rgba16f_to_rgba8(const u16* src, Colour* dst, u64 count);
+
+	// single / dual channel formats keep the leading channels, widening fills the rest with (0, 0, 255)
+	void rgba8_to_r8(const Colour* src, u8* dst, u64 count);
+	void rgba8_to_rg8(const Colour* src, u8* dst, u64 count);
+	void r8_to_rgba8(const u8* src, Colour* dst, u64 count);
+	void rg8_to_rgba8(const u8* src, Colour* dst, u64 count);
+
+	void premultiply_alpha(Colour* pixels, u64 count);
+	void premultiply_alpha(Image* image);
+
+	void flip_vertical(Colour* pixels, u32 width, u32 height);
+	void flip_vertical(Image* image);
+
+	u16 float_to_half(float value);
+	float half_to_float(u16 value);
+}
+
+#endif // IMAGE_OPS_H_
@@ -3,6 +3,7 @@
 #include <wvn/graphics/render_target_mgr.h>
 #include <wvn/graphics/texture_mgr.h>
 #include <wvn/graphics/rendering_mgr.h>
+#include <wvn/maths/calc.h>
 
 using namespace wvn;
 using namespace wvn::gfx;
@@ -17,8 +18,12 @@ Light::Light(LightID id)
 	, m_shadow_near_clip(0.1f)
 	, m_shadow_far_clip(100.0f)
 	, m_shadow_map(nullptr)
+	, m_shadow_cascade_count(MAX_SHADOW_CASCADES)
+	, m_shadow_distance(50.0f)
+	, m_shadow_cascade_split_lambda(0.75f)
 	, m_intensity(1.0f)
 	, m_falloff(1.0f)
+	, m_range(10.0f)
 	, m_orientation()
 	, m_position()
 {
@@ -108,6 +113,36 @@ float Light::get_shadow_far_clip() const
 	return m_shadow_far_clip;
 }
 
+void Light::set_shadow_cascade_count(u32 count)
+{
+	m_shadow_cascade_count = CalcU::clamp(count, 1, MAX_SHADOW_CASCADES);
+}
+
+u32 Light::get_shadow_cascade_count() const
+{
+	return m_shadow_cascade_count;
+}
+
+void Light::set_shadow_distance(float distance)
+{
+	m_shadow_distance = distance;
+}
+
+float Light::get_shadow_distance() const
+{
+	return m_shadow_distance;
+}
+
+void Light::set_shadow_cascade_split_lambda(float lambda)
+{
+	m_shadow_cascade_split_lambda = CalcF::clamp(lambda, 0.0f, 1.0f);
+}
+
+float Light::get_shadow_cascade_split_lambda() const
+{
+	return m_shadow_cascade_split_lambda;
+}
+
 void Light::set_falloff(float falloff)
 {
 	m_falloff = falloff;
@@ -118,6 +153,16 @@ float Light::get_falloff() const
 	return m_falloff;
 }
 
+void Light::set_range(float range)
+{
+	m_range = CalcF::max(range, 0.0f);
+}
+
+float Light::get_range() const
+{
+	return m_range;
+}
+
 void Light::set_intensity(float intensity)
 {
 	m_intensity = intensity;
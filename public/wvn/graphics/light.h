@@ -32,6 +32,7 @@ namespace wvn::gfx
 
 		constexpr static u32 DEPTH_TEXTURE_WIDTH = 2048;
 		constexpr static u32 DEPTH_TEXTURE_HEIGHT = 2048;
+		constexpr static u32 MAX_SHADOW_CASCADES = 4;
 
 		Light(LightID id);
 		~Light();
@@ -60,9 +61,24 @@ namespace wvn::gfx
 		float get_shadow_far_clip() const;
 		void set_shadow_far_clip(float distance);
 
+		// directional lights split the view frustum up to the shadow distance into several cascades
+		u32 get_shadow_cascade_count() const;
+		void set_shadow_cascade_count(u32 count);
+
+		float get_shadow_distance() const;
+		void set_shadow_distance(float distance);
+
+		// 0 = uniform splits, 1 = logarithmic splits
+		float get_shadow_cascade_split_lambda() const;
+		void set_shadow_cascade_split_lambda(float lambda);
+
 		float get_falloff() const;
 		void set_falloff(float falloff);
 
+		// distance past which a point or spot light no longer contributes anything, used to bin it into clusters
+		float get_range() const;
+		void set_range(float range);
+
 		float get_intensity() const;
 		void set_intensity(float intensity);
 
@@ -85,9 +101,13 @@ namespace wvn::gfx
 		float m_shadow_near_clip;
 		float m_shadow_far_clip;
 		RenderTarget* m_shadow_map;
+		u32 m_shadow_cascade_count;
+		float m_shadow_distance;
+		float m_shadow_cascade_split_lambda;
 
 		float m_intensity;
 		float m_falloff;
+		float m_range;
 
 		Quat m_orientation;
 		Vec3F m_position;
@@ -0,0 +1,361 @@
+#include <wvn/graphics/light_cluster_grid.h>
+#include <wvn/maths/calc.h>
+
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define wvn_CLUSTER_SSE 1
+#include <emmintrin.h>
+#else
+#define wvn_CLUSTER_SSE 0
+#endif
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+static u32 tile_from_ndc(float ndc, u32 tile_count)
+{
+	float t = ((ndc * 0.5f) + 0.5f) * (float)tile_count;
+	return (u32)CalcF::clamp(t, 0.0f, (float)(tile_count - 1));
+}
+
+LightClusterGrid::LightClusterGrid()
+	: m_lights()
+	, m_light_indices()
+	, m_clusters(CLUSTER_COUNT)
+	, m_pos_x()
+	, m_pos_y()
+	, m_pos_z()
+	, m_radius()
+	, m_bounds()
+	, m_cursors(CLUSTER_COUNT)
+	, m_near(0.1f)
+	, m_far(100.0f)
+	, m_log_depth_ratio(1.0f)
+	, m_active_threads(1)
+	, m_build_time_ms(0.0)
+	, m_worker_pool(nullptr)
+	, m_thread_count(MAX_THREADS)
+{
+}
+
+LightClusterGrid::~LightClusterGrid()
+{
+}
+
+void LightClusterGrid::build(const LightClusterView& view, const Vector<ClusterLightData>& lights)
+{
+	auto build_start = std::chrono::steady_clock::now();
+
+	m_near = CalcF::max(view.near, 0.01f);
+	m_far = CalcF::max(view.far, m_near + 0.01f);
+	m_log_depth_ratio = CalcF::log(m_far / m_near);
+
+	m_lights = lights;
+
+	m_pos_x.clear();
+	m_pos_y.clear();
+	m_pos_z.clear();
+	m_radius.clear();
+
+	for (const ClusterLightData& light : m_lights)
+	{
+		m_pos_x.push_back(light.position[0]);
+		m_pos_y.push_back(light.position[1]);
+		m_pos_z.push_back(light.position[2]);
+		m_radius.push_back(light.range);
+	}
+
+	m_bounds.resize(m_lights.size());
+
+	calc_bounds(view);
+
+	m_active_threads = CalcU::clamp(m_lights.size() / MIN_LIGHTS_FOR_THREADING, 1, m_worker_pool ? CalcU::min(m_thread_count, m_worker_pool->thread_count()) : 1);
+
+	// count, turn the counts into offsets, then fill in the indices at those offsets
+	run_parallel(false);
+
+	u32 offset = 0;
+
+	for (u32 i = 0; i < CLUSTER_COUNT; i++)
+	{
+		m_clusters[i].offset = offset;
+		m_cursors[i] = offset;
+		offset += m_clusters[i].count;
+	}
+
+	m_light_indices.resize(offset);
+
+	run_parallel(true);
+
+	m_build_time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+}
+
+void LightClusterGrid::set_worker_pool(sys::WorkerPool* worker_pool)
+{
+	m_worker_pool = worker_pool;
+}
+
+void LightClusterGrid::set_thread_count(u32 thread_count)
+{
+	m_thread_count = CalcU::clamp(thread_count, 1, MAX_THREADS);
+}
+
+u32 LightClusterGrid::thread_count() const
+{
+	return m_thread_count;
+}
+
+const Vector<ClusterLightData>& LightClusterGrid::lights() const
+{
+	return m_lights;
+}
+
+const Vector<u32>& LightClusterGrid::light_indices() const
+{
+	return m_light_indices;
+}
+
+const Vector<LightCluster>& LightClusterGrid::clusters() const
+{
+	return m_clusters;
+}
+
+float LightClusterGrid::near() const
+{
+	return m_near;
+}
+
+float LightClusterGrid::log_depth_ratio() const
+{
+	return m_log_depth_ratio;
+}
+
+double LightClusterGrid::build_time_ms() const
+{
+	return m_build_time_ms;
+}
+
+u32 LightClusterGrid::cluster_index(u32 x, u32 y, u32 z)
+{
+	return x + (y * GRID_X) + (z * GRID_X * GRID_Y);
+}
+
+// view space bounding sphere -> range of tiles & slices it overlaps.
+// a sphere's projection is widest at the near end of the sphere when that side of it is off-centre,
+// and at the far end otherwise, so picking the right depth per side keeps the bounds conservative
+void LightClusterGrid::calc_bounds(const LightClusterView& view)
+{
+	Vec3F forward = view.direction.normalized();
+	Vec3F right = Vec3F::cross(forward, view.up).normalized();
+	Vec3F up = Vec3F::cross(right, forward).normalized();
+
+	bool perspective = view.perspective;
+
+	float tan_half_fov_y = CalcF::tan(view.fov * CalcF::DEG2RAD * 0.5f);
+	float tan_half_fov_x = tan_half_fov_y * view.aspect;
+
+	u64 count = m_lights.size();
+	u64 i = 0;
+
+	Vector<float> depth_min(count);
+	Vector<float> depth_max(count);
+
+#if wvn_CLUSTER_SSE
+	const __m128 rx = _mm_set1_ps(right.x), ry = _mm_set1_ps(right.y), rz = _mm_set1_ps(right.z);
+	const __m128 ux = _mm_set1_ps(up.x), uy = _mm_set1_ps(up.y), uz = _mm_set1_ps(up.z);
+	const __m128 fx = _mm_set1_ps(forward.x), fy = _mm_set1_ps(forward.y), fz = _mm_set1_ps(forward.z);
+	const __m128 ex = _mm_set1_ps(view.position.x), ey = _mm_set1_ps(view.position.y), ez = _mm_set1_ps(view.position.z);
+	const __m128 near = _mm_set1_ps(m_near);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 inv_tan_x = _mm_set1_ps(1.0f / tan_half_fov_x);
+	const __m128 inv_tan_y = _mm_set1_ps(1.0f / tan_half_fov_y);
+	const __m128 grid_x = _mm_set1_ps((float)GRID_X);
+	const __m128 grid_y = _mm_set1_ps((float)GRID_Y);
+	const __m128 max_x = _mm_set1_ps((float)(GRID_X - 1));
+	const __m128 max_y = _mm_set1_ps((float)(GRID_Y - 1));
+
+	// picks the depth that makes the projected coordinate as small (or large) as possible
+	auto project = [&](__m128 v, __m128 z_min, __m128 z_max, bool want_min) -> __m128
+	{
+		__m128 negative = _mm_cmplt_ps(v, zero);
+		__m128 z = want_min
+			? _mm_or_ps(_mm_and_ps(negative, z_min), _mm_andnot_ps(negative, z_max))
+			: _mm_or_ps(_mm_and_ps(negative, z_max), _mm_andnot_ps(negative, z_min));
+		return _mm_div_ps(v, z);
+	};
+
+	auto to_tile = [&](__m128 ndc, __m128 grid, __m128 grid_max) -> __m128i
+	{
+		__m128 t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ndc, half), half), grid);
+		return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(t, zero), grid_max));
+	};
+
+	if (perspective)
+	{
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(m_pos_x.data() + i), ex);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(m_pos_y.data() + i), ey);
+			__m128 dz = _mm_sub_ps(_mm_loadu_ps(m_pos_z.data() + i), ez);
+			__m128 r = _mm_loadu_ps(m_radius.data() + i);
+
+			__m128 vx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, rx), _mm_mul_ps(dy, ry)), _mm_mul_ps(dz, rz));
+			__m128 vy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, ux), _mm_mul_ps(dy, uy)), _mm_mul_ps(dz, uz));
+			__m128 vz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, fx), _mm_mul_ps(dy, fy)), _mm_mul_ps(dz, fz));
+
+			__m128 z_min = _mm_max_ps(_mm_sub_ps(vz, r), near);
+			__m128 z_max = _mm_max_ps(_mm_add_ps(vz, r), near);
+
+			__m128i tx0 = to_tile(_mm_mul_ps(project(_mm_sub_ps(vx, r), z_min, z_max, true),  inv_tan_x), grid_x, max_x);
+			__m128i tx1 = to_tile(_mm_mul_ps(project(_mm_add_ps(vx, r), z_min, z_max, false), inv_tan_x), grid_x, max_x);
+			__m128i ty0 = to_tile(_mm_mul_ps(project(_mm_sub_ps(vy, r), z_min, z_max, true),  inv_tan_y), grid_y, max_y);
+			__m128i ty1 = to_tile(_mm_mul_ps(project(_mm_add_ps(vy, r), z_min, z_max, false), inv_tan_y), grid_y, max_y);
+
+			alignas(16) u32 x0[4], x1[4], y0[4], y1[4];
+			_mm_store_si128((__m128i*)x0, tx0);
+			_mm_store_si128((__m128i*)x1, tx1);
+			_mm_store_si128((__m128i*)y0, ty0);
+			_mm_store_si128((__m128i*)y1, ty1);
+
+			_mm_storeu_ps(depth_min.data() + i, _mm_sub_ps(vz, r));
+			_mm_storeu_ps(depth_max.data() + i, _mm_add_ps(vz, r));
+
+			for (int j = 0; j < 4; j++)
+			{
+				m_bounds[i + j].min_x = x0[j];
+				m_bounds[i + j].max_x = x1[j];
+				m_bounds[i + j].min_y = y0[j];
+				m_bounds[i + j].max_y = y1[j];
+			}
+		}
+	}
+#endif // wvn_CLUSTER_SSE
+
+	// whatever didn't fit into a group of four (or everything, without sse)
+	for (; i < count; i++)
+	{
+		Vec3F d = Vec3F(m_pos_x[i], m_pos_y[i], m_pos_z[i]) - view.position;
+		float r = m_radius[i];
+
+		float vx = Vec3F::dot(d, right);
+		float vy = Vec3F::dot(d, up);
+		float vz = Vec3F::dot(d, forward);
+
+		depth_min[i] = vz - r;
+		depth_max[i] = vz + r;
+
+		if (!perspective)
+		{
+			m_bounds[i].min_x = 0;
+			m_bounds[i].max_x = GRID_X - 1;
+			m_bounds[i].min_y = 0;
+			m_bounds[i].max_y = GRID_Y - 1;
+			continue;
+		}
+
+		float z_min = CalcF::max(vz - r, m_near);
+		float z_max = CalcF::max(vz + r, m_near);
+
+		float x0 = vx - r, x1 = vx + r;
+		float y0 = vy - r, y1 = vy + r;
+
+		m_bounds[i].min_x = tile_from_ndc((x0 / (x0 < 0.0f ? z_min : z_max)) / tan_half_fov_x, GRID_X);
+		m_bounds[i].max_x = tile_from_ndc((x1 / (x1 < 0.0f ? z_max : z_min)) / tan_half_fov_x, GRID_X);
+		m_bounds[i].min_y = tile_from_ndc((y0 / (y0 < 0.0f ? z_min : z_max)) / tan_half_fov_y, GRID_Y);
+		m_bounds[i].max_y = tile_from_ndc((y1 / (y1 < 0.0f ? z_max : z_min)) / tan_half_fov_y, GRID_Y);
+	}
+
+	// the slices are exponential so this part stays scalar, lights outside of the depth range get an empty slice range
+	for (i = 0; i < count; i++)
+	{
+		if (depth_max[i] < m_near || depth_min[i] > m_far) {
+			m_bounds[i].min_z = 1;
+			m_bounds[i].max_z = 0;
+			continue;
+		}
+
+		m_bounds[i].min_z = slice_from_depth(depth_min[i]);
+		m_bounds[i].max_z = slice_from_depth(depth_max[i]);
+	}
+}
+
+void LightClusterGrid::bin_slices(u32 thread_idx)
+{
+	u32 slice_begin = (GRID_Z * thread_idx) / m_active_threads;
+	u32 slice_end = (GRID_Z * (thread_idx + 1)) / m_active_threads;
+
+	for (u32 c = cluster_index(0, 0, slice_begin); c < cluster_index(0, 0, slice_end); c++) {
+		m_clusters[c].count = 0;
+	}
+
+	for (u32 i = 0; i < m_bounds.size(); i++)
+	{
+		const LightBounds& b = m_bounds[i];
+
+		u32 z0 = CalcU::max(b.min_z, slice_begin);
+		u32 z1 = CalcU::min(b.max_z + 1, slice_end);
+
+		for (u32 z = z0; z < z1; z++) {
+			for (u32 y = b.min_y; y <= b.max_y; y++) {
+				for (u32 x = b.min_x; x <= b.max_x; x++) {
+					m_clusters[cluster_index(x, y, z)].count++;
+				}
+			}
+		}
+	}
+}
+
+// lights are visited in order, so every cluster's index list ends up sorted
+void LightClusterGrid::fill_slices(u32 thread_idx)
+{
+	u32 slice_begin = (GRID_Z * thread_idx) / m_active_threads;
+	u32 slice_end = (GRID_Z * (thread_idx + 1)) / m_active_threads;
+
+	for (u32 i = 0; i < m_bounds.size(); i++)
+	{
+		const LightBounds& b = m_bounds[i];
+
+		u32 z0 = CalcU::max(b.min_z, slice_begin);
+		u32 z1 = CalcU::min(b.max_z + 1, slice_end);
+
+		for (u32 z = z0; z < z1; z++) {
+			for (u32 y = b.min_y; y <= b.max_y; y++) {
+				for (u32 x = b.min_x; x <= b.max_x; x++) {
+					m_light_indices[m_cursors[cluster_index(x, y, z)]++] = i;
+				}
+			}
+		}
+	}
+}
+
+void LightClusterGrid::run_parallel(bool fill)
+{
+	if (m_active_threads <= 1)
+	{
+		if (fill) {
+			fill_slices(0);
+		} else {
+			bin_slices(0);
+		}
+
+		return;
+	}
+
+	m_worker_pool->run(m_active_threads, [this, fill](u32 thread_idx)
+	{
+		if (fill) {
+			fill_slices(thread_idx);
+		} else {
+			bin_slices(thread_idx);
+		}
+	});
+}
+
+u32 LightClusterGrid::slice_from_depth(float depth) const
+{
+	depth = CalcF::clamp(depth, m_near, m_far);
+	float slice = (CalcF::log(depth / m_near) / m_log_depth_ratio) * (float)GRID_Z;
+	return (u32)CalcF::clamp(slice, 0.0f, (float)(GRID_Z - 1));
+}
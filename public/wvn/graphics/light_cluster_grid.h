@@ -0,0 +1,142 @@
+#ifndef LIGHT_CLUSTER_GRID_H_
+#define LIGHT_CLUSTER_GRID_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/maths/vec3.h>
+#include <wvn/system/worker_pool.h>
+
+namespace wvn::gfx
+{
+	/**
+	 * Light as the shaders see it in the cluster light buffer (std430 friendly).
+	 */
+	struct ClusterLightData
+	{
+		float position[3];
+		float range;
+		float colour[3];
+		float intensity;
+		float direction[3];
+		u32 type;
+	};
+
+	/**
+	 * The part of a camera the grid is fitted to.
+	 */
+	struct LightClusterView
+	{
+		Vec3F position;
+		Vec3F direction;
+		Vec3F up;
+		float fov; // vertical, in degrees
+		float aspect;
+		float near;
+		float far;
+		bool perspective;
+	};
+
+	/**
+	 * Sits in front of the clusters in the cluster buffer, what a shader needs to find the cluster a fragment is in.
+	 */
+	struct LightClusterParams
+	{
+		float near;
+		float log_depth_ratio; // log(far / near)
+		float screen_width;
+		float screen_height;
+	};
+
+	/**
+	 * Slice of the light index list belonging to a single cluster.
+	 */
+	struct LightCluster
+	{
+		u32 offset;
+		u32 count;
+	};
+
+	/**
+	 * Bins lights into a grid of froxels (screen tiles x exponential depth slices) covering the camera frustum,
+	 * so that shading only has to look at the lights overlapping the cluster a pixel falls into.
+	 * Light bounds are worked out four at a time and the grid is filled in on a worker pool's threads,
+	 * each owning a range of depth slices so no two threads ever touch the same cluster.
+	 * Takes lights already packed into their shader layout and has no dependency on a rendering backend,
+	 * so it can be driven (and timed) headless.
+	 */
+	class LightClusterGrid
+	{
+		struct LightBounds
+		{
+			u32 min_x, max_x;
+			u32 min_y, max_y;
+			u32 min_z, max_z;
+		};
+
+	public:
+		static constexpr u32 GRID_X = 16;
+		static constexpr u32 GRID_Y = 9;
+		static constexpr u32 GRID_Z = 24;
+		static constexpr u32 CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+
+		static constexpr u32 MAX_THREADS = sys::WorkerPool::MAX_THREADS;
+		static constexpr u32 MIN_LIGHTS_FOR_THREADING = 256;
+
+		LightClusterGrid();
+		~LightClusterGrid();
+
+		void build(const LightClusterView& view, const Vector<ClusterLightData>& lights);
+
+		// without a pool the grid is built on the calling thread
+		void set_worker_pool(sys::WorkerPool* worker_pool);
+
+		// at most this many of the pool's threads are used, including the one calling build()
+		void set_thread_count(u32 thread_count);
+		u32 thread_count() const;
+
+		const Vector<ClusterLightData>& lights() const;
+		const Vector<u32>& light_indices() const;
+		const Vector<LightCluster>& clusters() const;
+
+		float near() const;
+		float log_depth_ratio() const;
+
+		double build_time_ms() const;
+
+		static u32 cluster_index(u32 x, u32 y, u32 z);
+
+	private:
+		void calc_bounds(const LightClusterView& view);
+		void bin_slices(u32 thread_idx);
+		void fill_slices(u32 thread_idx);
+
+		void run_parallel(bool fill);
+
+		u32 slice_from_depth(float depth) const;
+
+		Vector<ClusterLightData> m_lights;
+		Vector<u32> m_light_indices;
+		Vector<LightCluster> m_clusters;
+
+		// structure of arrays so the bounds can be calculated four lights at a time
+		Vector<float> m_pos_x;
+		Vector<float> m_pos_y;
+		Vector<float> m_pos_z;
+		Vector<float> m_radius;
+		Vector<LightBounds> m_bounds;
+
+		Vector<u32> m_cursors;
+
+		float m_near;
+		float m_far;
+		float m_log_depth_ratio;
+
+		u32 m_active_threads;
+		double m_build_time_ms;
+
+		sys::WorkerPool* m_worker_pool;
+		u32 m_thread_count;
+	};
+}
+
+#endif // LIGHT_CLUSTER_GRID_H_
@@ -1,9 +1,16 @@
 #include <wvn/graphics/material.h>
+#include <wvn/graphics/renderer_backend.h>
+#include <wvn/root.h>
 
 using namespace wvn;
 using namespace wvn::gfx;
 
 Material::Material()
+	: technique()
+	, parameters()
+	, textures()
+	, m_bindless_index(~0u)
+	, m_bindless_textures_hash(0)
 {
 }
 
@@ -24,3 +31,37 @@ void Material::set_texture(int idx, const Texture* texture, TextureSampler* samp
 	textures[idx].texture = texture;
 	textures[idx].sampler = sampler;
 }
+
+u32 Material::bindless_index() const
+{
+	RendererBackend* backend = Root::get_singleton()->renderer_backend();
+
+	if (!backend->properties().bindless_textures) {
+		return ~0u;
+	}
+
+	if (m_bindless_index == ~0u) {
+		m_bindless_index = backend->create_bindless_material();
+		m_bindless_textures_hash = 0;
+	}
+
+	// only touch the material buffer when the bound textures actually changed
+	u64 textures_hash = 0;
+	hash::combine(&textures_hash, &textures);
+
+	if (textures_hash != m_bindless_textures_hash)
+	{
+		BindlessMaterialData data = {};
+
+		for (int i = 0; i < wvn_MAX_BOUND_TEXTURES; i++) {
+			data.texture_indices[i] = backend->get_bindless_texture_index(textures[i].texture);
+			data.sampler_indices[i] = backend->get_bindless_sampler_index(textures[i].sampler);
+		}
+
+		backend->update_bindless_material(m_bindless_index, data);
+
+		m_bindless_textures_hash = textures_hash;
+	}
+
+	return m_bindless_index;
+}
@@ -22,6 +22,16 @@ namespace wvn::gfx
 		String technique;
 	};
 
+	/**
+	 * Per-material indices into the backend's bindless texture & sampler tables.
+	 * Laid out exactly as the shaders see it in the bindless material buffer.
+	 */
+	struct BindlessMaterialData
+	{
+		u32 texture_indices[wvn_MAX_BOUND_TEXTURES];
+		u32 sampler_indices[wvn_MAX_BOUND_TEXTURES];
+	};
+
 	/**
 	 * Material that packages together the required shaders, textures, and other
 	 * information required for drawing a material.
@@ -36,9 +46,16 @@ namespace wvn::gfx
 
 		void set_texture(int idx, const Texture* texture, TextureSampler* sampler);
 
+		// slot in the backend's bindless material buffer, kept in sync with the textures lazily
+		u32 bindless_index() const;
+
 		Technique technique;
 		ShaderParameters parameters;
 		Array<SampledTexture, wvn_MAX_BOUND_TEXTURES> textures;
+
+	private:
+		mutable u32 m_bindless_index;
+		mutable u64 m_bindless_textures_hash;
 	};
 }
 
@@ -1,5 +1,7 @@
 #include <wvn/graphics/material_system.h>
 #include <wvn/graphics/shader_mgr.h>
+#include <wvn/graphics/renderer_backend.h>
+#include <wvn/root.h>
 #include <wvn/devenv/log_mgr.h>
 
 using namespace wvn;
@@ -8,6 +10,9 @@ using namespace wvn::gfx;
 wvn_IMPL_SINGLETON(MaterialSystem);
 
 MaterialSystem::MaterialSystem()
+	: m_materials()
+	, m_techniques()
+	, m_object_parameter_layout()
 {
 	dev::LogMgr::get_singleton()->print("[MATERIAL] Initialized!");
 }
@@ -21,6 +26,19 @@ void MaterialSystem::load_default_techniques()
 	ShaderProgram* shd_update_depth_frag 	= ShaderMgr::get_singleton()->get_shader("../res/update_depth_fragment.spv", SHADER_TYPE_FRAGMENT);
 	ShaderProgram* shd_draw_depth_frag		= ShaderMgr::get_singleton()->get_shader("../res/draw_depth_fragment.spv", SHADER_TYPE_FRAGMENT);
 
+	// must be declared in the same order they appear in the shaders' uniform buffers
+	m_object_parameter_layout.add("model", ShaderParameter::PARAM_TYPE_MAT4X4F);
+	m_object_parameter_layout.add("normal_matrix", ShaderParameter::PARAM_TYPE_MAT4X4F);
+
+	// shaders built for bindless textures look their textures up through this index
+	if (Root::get_singleton()->renderer_backend()->properties().bindless_textures) {
+		m_object_parameter_layout.add("material_index", ShaderParameter::PARAM_TYPE_U32);
+	}
+
+	for (ShaderProgram* shader : { shd_generic_vtx, shd_fragment_box, shd_out_fragment, shd_sky_fragment, shd_update_depth_frag, shd_draw_depth_frag }) {
+		shader->params.set_layout(&m_object_parameter_layout);
+	}
+
 	ShaderEffect* depth_update_effect = ShaderMgr::get_singleton()->build_effect();
 	depth_update_effect->add_stage(shd_generic_vtx);
 	depth_update_effect->add_stage(shd_update_depth_frag);
@@ -90,3 +108,8 @@ void MaterialSystem::add_technique(const String &name, const Technique &techniqu
 {
 	m_techniques.insert(Pair(name, technique));
 }
+
+const ShaderParameterLayout& MaterialSystem::object_parameter_layout() const
+{
+	return m_object_parameter_layout;
+}
@@ -26,9 +26,14 @@ namespace wvn::gfx
 		Material* build_material(const MaterialData& data);
 		void add_technique(const String& name, const Technique& technique);
 
+		const ShaderParameterLayout& object_parameter_layout() const;
+
 	private:
 		Vector<Material*> m_materials;
 		HashMap<String, Technique> m_techniques;
+
+		// per-object uniforms shared by every default shader stage
+		ShaderParameterLayout m_object_parameter_layout;
 	};
 }
 
@@ -2,7 +2,7 @@
 #define MODEL_H_
 
 #include <wvn/maths/transform_3d.h>
-#include <wvn/container/vector.h>
+#include <wvn/container/small_vector.h>
 #include <wvn/graphics/sub_mesh.h>
 
 namespace wvn::gfx
@@ -19,7 +19,7 @@ namespace wvn::gfx
 		SubMesh* submesh(int idx) const;
 
 	private:
-		Vector<SubMesh*> m_meshes;
+		SmallVector<SubMesh*, 1> m_meshes; // almost always just the one
 	};
 }
 
@@ -0,0 +1,445 @@
+#include <wvn/graphics/render_graph.h>
+#include <wvn/graphics/renderer_backend.h>
+#include <wvn/graphics/render_target.h>
+#include <wvn/graphics/render_target_mgr.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+static constexpr u32 INVALID_IDX = ~0u;
+
+static bool is_write_state(RenderResourceState state)
+{
+	return state == RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT || state == RENDER_RESOURCE_STATE_DEPTH_ATTACHMENT;
+}
+
+RenderGraphBuilder::RenderGraphBuilder(RenderGraph* graph, u32 pass_idx)
+	: m_graph(graph)
+	, m_pass_idx(pass_idx)
+{
+}
+
+RenderGraphResource RenderGraphBuilder::create(const char* name, const RenderGraphTargetDesc& desc)
+{
+	return m_graph->add_resource(name, desc, nullptr, RENDER_RESOURCE_STATE_UNDEFINED);
+}
+
+RenderGraphResource RenderGraphBuilder::read(RenderGraphResource resource)
+{
+	m_graph->m_passes[m_pass_idx]->reads.push_back({
+		.resource = resource,
+		.state = RENDER_RESOURCE_STATE_SHADER_READ,
+		.producer = m_graph->last_writer(resource)
+	});
+
+	return resource;
+}
+
+RenderGraphResource RenderGraphBuilder::write(RenderGraphResource resource)
+{
+	wvn_ASSERT(m_graph->m_passes[m_pass_idx]->writes.empty(), "[RENDER_GRAPH|DEBUG] A pass can only write to a single render target.");
+
+	m_graph->m_passes[m_pass_idx]->writes.push_back({
+		.resource = resource,
+		.state = m_graph->m_resources[resource].desc.depth_only ? RENDER_RESOURCE_STATE_DEPTH_ATTACHMENT : RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT,
+		.producer = m_graph->last_writer(resource)
+	});
+
+	return resource;
+}
+
+void RenderGraphBuilder::set_side_effects()
+{
+	m_graph->m_passes[m_pass_idx]->side_effects = true;
+}
+
+RenderGraph::RenderGraph()
+	: m_passes()
+	, m_resources()
+	, m_pass_order()
+	, m_physical_descs()
+	, m_target_pool()
+	, m_physical_targets()
+	, m_compiled(false)
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+	clear();
+}
+
+RenderGraphResource RenderGraph::import_target(const char* name, RenderTarget* target, bool depth_only, RenderResourceState initial_state)
+{
+	return add_resource(name, { target->width(), target->height(), depth_only }, target, initial_state);
+}
+
+// outputs are never culled, anything that (indirectly) feeds into them is kept alive
+RenderGraphResource RenderGraph::import_output(const char* name, RenderTarget* target)
+{
+	RenderGraphResource resource = add_resource(name, { target->width(), target->height(), false }, target, RENDER_RESOURCE_STATE_UNDEFINED);
+	m_resources[resource].is_output = true;
+	return resource;
+}
+
+void RenderGraph::add_pass(const char* name, SetupFn setup, ExecuteFn execute)
+{
+	Pass* pass = new Pass({
+		.name = name,
+		.execute = std::move(execute),
+		.reads = {},
+		.writes = {},
+		.side_effects = false,
+		.culled = false,
+		.barriers = {}
+	});
+
+	m_passes.push_back(pass);
+
+	RenderGraphBuilder builder(this, m_passes.size() - 1);
+	setup(builder);
+
+	m_compiled = false;
+}
+
+void RenderGraph::compile()
+{
+	cull_passes();
+	compute_lifetimes();
+	alias_transients();
+	build_barriers();
+
+	m_compiled = true;
+}
+
+void RenderGraph::execute(RendererBackend* backend)
+{
+	if (!m_compiled) {
+		compile();
+	}
+
+	realise_transients();
+
+	for (u32 pass_idx : m_pass_order)
+	{
+		const Pass* pass = m_passes[pass_idx];
+
+		for (auto& barrier : pass->barriers) {
+			backend->resource_barrier(get_texture(barrier.resource), barrier.before, barrier.after);
+		}
+
+		RenderTarget* target = pass->writes.any() ? get_target(pass->writes[0].resource) : nullptr;
+
+		if (target) {
+			backend->set_render_target(target);
+			backend->begin_render();
+		}
+
+		if (pass->execute) {
+			pass->execute(*this);
+		}
+
+		if (target) {
+			backend->end_render();
+		}
+	}
+}
+
+// the pool of physical targets is kept so they can be reused next frame
+void RenderGraph::clear()
+{
+	for (auto& pass : m_passes) {
+		delete pass;
+	}
+
+	m_passes.clear();
+	m_resources.clear();
+	m_pass_order.clear();
+	m_physical_descs.clear();
+	m_physical_targets.clear();
+
+	m_compiled = false;
+}
+
+RenderTarget* RenderGraph::get_target(RenderGraphResource resource) const
+{
+	const Resource& res = m_resources[resource];
+
+	if (res.imported) {
+		return res.imported;
+	}
+
+	if (res.physical_idx == INVALID_IDX || res.physical_idx >= m_physical_targets.size()) {
+		return nullptr;
+	}
+
+	return m_physical_targets[res.physical_idx];
+}
+
+const Texture* RenderGraph::get_texture(RenderGraphResource resource) const
+{
+	const RenderTarget* target = get_target(resource);
+
+	if (!target) {
+		return nullptr;
+	}
+
+	return m_resources[resource].desc.depth_only ? target->get_depth_attachment() : target->get_attachment(0);
+}
+
+const Vector<RenderGraph::Pass*>& RenderGraph::passes() const { return m_passes; }
+const Vector<RenderGraph::Resource>& RenderGraph::resources() const { return m_resources; }
+const Vector<u32>& RenderGraph::pass_order() const { return m_pass_order; }
+u32 RenderGraph::physical_target_count() const { return m_physical_descs.size(); }
+
+RenderGraphResource RenderGraph::add_resource(const char* name, const RenderGraphTargetDesc& desc, RenderTarget* imported, RenderResourceState initial_state)
+{
+	m_resources.push_back({
+		.name = name,
+		.desc = desc,
+		.imported = imported,
+		.initial_state = initial_state,
+		.is_output = false,
+		.first_use = INVALID_IDX,
+		.last_use = INVALID_IDX,
+		.physical_idx = INVALID_IDX
+	});
+
+	return m_resources.size() - 1;
+}
+
+u32 RenderGraph::last_writer(RenderGraphResource resource) const
+{
+	// the pass currently being set up is always the last one, so skip it
+	for (int i = (int)m_passes.size() - 2; i >= 0; i--)
+	{
+		for (auto& write : m_passes[i]->writes) {
+			if (write.resource == resource) {
+				return i;
+			}
+		}
+	}
+
+	return INVALID_IDX;
+}
+
+// producers always come before their consumers, so a single backwards sweep finds everything that is needed
+void RenderGraph::cull_passes()
+{
+	SmallVector<bool, 32> needed(m_passes.size(), false);
+
+	for (int i = (int)m_passes.size() - 1; i >= 0; i--)
+	{
+		Pass* pass = m_passes[i];
+
+		if (pass->side_effects) {
+			needed[i] = true;
+		}
+
+		for (auto& write : pass->writes) {
+			if (m_resources[write.resource].is_output) {
+				needed[i] = true;
+			}
+		}
+
+		pass->culled = !needed[i];
+
+		if (pass->culled) {
+			continue;
+		}
+
+		for (auto& read : pass->reads) {
+			if (read.producer != INVALID_IDX) {
+				needed[read.producer] = true;
+			}
+		}
+
+		// previous contents may be loaded, so whoever wrote them first has to stay
+		for (auto& write : pass->writes) {
+			if (write.producer != INVALID_IDX) {
+				needed[write.producer] = true;
+			}
+		}
+	}
+
+	// declaration order is already a valid topological order as reads can only see earlier writes
+	m_pass_order.clear();
+
+	for (u32 i = 0; i < m_passes.size(); i++) {
+		if (!m_passes[i]->culled) {
+			m_pass_order.push_back(i);
+		}
+	}
+}
+
+void RenderGraph::compute_lifetimes()
+{
+	for (auto& res : m_resources) {
+		res.first_use = INVALID_IDX;
+		res.last_use = INVALID_IDX;
+	}
+
+	for (u32 order = 0; order < m_pass_order.size(); order++)
+	{
+		const Pass* pass = m_passes[m_pass_order[order]];
+
+		auto touch = [&](const Access& access) -> void
+		{
+			Resource& res = m_resources[access.resource];
+
+			if (res.first_use == INVALID_IDX) {
+				res.first_use = order;
+			}
+
+			res.last_use = order;
+		};
+
+		for (auto& read : pass->reads) {
+			touch(read);
+		}
+
+		for (auto& write : pass->writes) {
+			touch(write);
+		}
+	}
+}
+
+// greedy interval packing: each transient takes the first physical target that matches its description
+// and whose previous occupant is already dead by the time it is first used
+void RenderGraph::alias_transients()
+{
+	m_physical_descs.clear();
+
+	SmallVector<u32, 16> slot_last_use;
+	SmallVector<u32, 32> sorted;
+
+	for (u32 i = 0; i < m_resources.size(); i++)
+	{
+		m_resources[i].physical_idx = INVALID_IDX;
+
+		if (m_resources[i].imported || m_resources[i].first_use == INVALID_IDX) {
+			continue;
+		}
+
+		// insertion sort by first use, graphs are small
+		u32 insert_at = sorted.size();
+
+		while (insert_at > 0 && m_resources[sorted[insert_at - 1]].first_use > m_resources[i].first_use) {
+			insert_at--;
+		}
+
+		sorted.push_back(i);
+
+		for (u32 j = sorted.size() - 1; j > insert_at; j--) {
+			sorted[j] = sorted[j - 1];
+		}
+
+		sorted[insert_at] = i;
+	}
+
+	for (u32 res_idx : sorted)
+	{
+		Resource& res = m_resources[res_idx];
+
+		u32 slot = INVALID_IDX;
+
+		for (u32 j = 0; j < m_physical_descs.size(); j++) {
+			if (m_physical_descs[j] == res.desc && slot_last_use[j] < res.first_use) {
+				slot = j;
+				break;
+			}
+		}
+
+		if (slot == INVALID_IDX) {
+			slot = m_physical_descs.size();
+			m_physical_descs.push_back(res.desc);
+			slot_last_use.push_back(0);
+		}
+
+		slot_last_use[slot] = res.last_use;
+		res.physical_idx = slot;
+	}
+}
+
+// transients that alias the same physical target share its state, so the first barrier of a new occupant
+// waits on however the previous occupant was last used rather than starting from nothing
+void RenderGraph::build_barriers()
+{
+	SmallVector<RenderResourceState, 32> current_states(m_resources.size());
+	SmallVector<RenderResourceState, 16> physical_states(m_physical_descs.size(), RENDER_RESOURCE_STATE_UNDEFINED);
+
+	for (u32 i = 0; i < m_resources.size(); i++) {
+		current_states[i] = m_resources[i].imported ? m_resources[i].initial_state : RENDER_RESOURCE_STATE_UNDEFINED;
+	}
+
+	auto state_of = [&](RenderGraphResource resource) -> RenderResourceState&
+	{
+		const Resource& res = m_resources[resource];
+
+		if (res.imported || res.physical_idx == INVALID_IDX) {
+			return current_states[resource];
+		}
+
+		return physical_states[res.physical_idx];
+	};
+
+	for (u32 pass_idx : m_pass_order)
+	{
+		Pass* pass = m_passes[pass_idx];
+		pass->barriers.clear();
+
+		auto transition = [&](const Access& access) -> void
+		{
+			RenderResourceState& state = state_of(access.resource);
+			RenderResourceState before = state;
+
+			// read -> read needs nothing, but back to back writes still have to be ordered
+			if (before != access.state || is_write_state(access.state)) {
+				pass->barriers.push_back({ access.resource, before, access.state });
+			}
+
+			state = access.state;
+		};
+
+		for (auto& read : pass->reads) {
+			transition(read);
+		}
+
+		for (auto& write : pass->writes) {
+			transition(write);
+		}
+	}
+}
+
+void RenderGraph::realise_transients()
+{
+	m_physical_targets.clear();
+
+	SmallVector<bool, 32> claimed(m_target_pool.size(), false);
+
+	for (auto& desc : m_physical_descs)
+	{
+		RenderTarget* target = nullptr;
+
+		for (u32 i = 0; i < m_target_pool.size(); i++)
+		{
+			if (!claimed[i] && m_target_pool[i].desc == desc) {
+				claimed[i] = true;
+				target = m_target_pool[i].target;
+				break;
+			}
+		}
+
+		if (!target)
+		{
+			target = desc.depth_only
+				? RenderTargetMgr::get_singleton()->get_depth_only_target(desc.width, desc.height)
+				: RenderTargetMgr::get_singleton()->get_target(desc.width, desc.height);
+
+			m_target_pool.push_back({ desc, target });
+			claimed.push_back(true);
+		}
+
+		m_physical_targets.push_back(target);
+	}
+}
@@ -0,0 +1,178 @@
+#ifndef RENDER_GRAPH_H_
+#define RENDER_GRAPH_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/container/small_vector.h>
+#include <wvn/container/function.h>
+
+namespace wvn::gfx
+{
+	class RenderTarget;
+	class RendererBackend;
+	class Texture;
+
+	/**
+	 * How a resource is being used by a render graph pass.
+	 * Barriers are generated whenever this changes between passes.
+	 */
+	enum RenderResourceState
+	{
+		RENDER_RESOURCE_STATE_UNDEFINED = 0,
+		RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT,
+		RENDER_RESOURCE_STATE_DEPTH_ATTACHMENT,
+		RENDER_RESOURCE_STATE_SHADER_READ,
+		RENDER_RESOURCE_STATE_PRESENT,
+		RENDER_RESOURCE_STATE_MAX_ENUM
+	};
+
+	using RenderGraphResource = u32;
+	static constexpr RenderGraphResource RENDER_GRAPH_INVALID_RESOURCE = ~0u;
+
+	/**
+	 * Description of a transient render target owned by the render graph.
+	 * Transients with matching descriptions and non-overlapping lifetimes share the same physical target.
+	 */
+	struct RenderGraphTargetDesc
+	{
+		u32 width;
+		u32 height;
+		bool depth_only;
+
+		bool operator == (const RenderGraphTargetDesc& other) const
+		{
+			return width == other.width && height == other.height && depth_only == other.depth_only;
+		}
+	};
+
+	/**
+	 * Memory / execution dependency that has to be satisfied before a pass begins.
+	 */
+	struct RenderGraphBarrier
+	{
+		RenderGraphResource resource;
+		RenderResourceState before;
+		RenderResourceState after;
+	};
+
+	class RenderGraph;
+
+	/**
+	 * Handed to a pass while it is being set up so it can declare what it reads & writes.
+	 */
+	class RenderGraphBuilder
+	{
+	public:
+		RenderGraphBuilder(RenderGraph* graph, u32 pass_idx);
+
+		RenderGraphResource create(const char* name, const RenderGraphTargetDesc& desc);
+		RenderGraphResource read(RenderGraphResource resource);
+		RenderGraphResource write(RenderGraphResource resource);
+
+		void set_side_effects();
+
+	private:
+		RenderGraph* m_graph;
+		u32 m_pass_idx;
+	};
+
+	/**
+	 * Declarative description of a frame.
+	 * Passes declare their inputs & outputs up front, then compile() culls any pass whose output is never used,
+	 * works out resource lifetimes, aliases transient targets and generates the barriers required between passes.
+	 * Compilation is purely cpu-side and never touches the renderer backend, only execute() does.
+	 */
+	class RenderGraph
+	{
+		friend class RenderGraphBuilder;
+
+	public:
+		using SetupFn = FunctionRef<void(RenderGraphBuilder&)>;
+		using ExecuteFn = Function<void(const RenderGraph&)>;
+
+		struct Resource
+		{
+			const char* name;
+			RenderGraphTargetDesc desc;
+			RenderTarget* imported;
+			RenderResourceState initial_state;
+			bool is_output;
+
+			// filled in by compile()
+			u32 first_use;
+			u32 last_use;
+			u32 physical_idx;
+		};
+
+		struct Access
+		{
+			RenderGraphResource resource;
+			RenderResourceState state;
+			u32 producer; // pass that last wrote to the resource before this access
+		};
+
+		struct Pass
+		{
+			const char* name;
+			ExecuteFn execute;
+			SmallVector<Access, 8> reads;
+			SmallVector<Access, 1> writes;
+			bool side_effects;
+
+			// filled in by compile()
+			bool culled;
+			SmallVector<RenderGraphBarrier, 8> barriers;
+		};
+
+		RenderGraph();
+		~RenderGraph();
+
+		RenderGraphResource import_target(const char* name, RenderTarget* target, bool depth_only, RenderResourceState initial_state = RENDER_RESOURCE_STATE_UNDEFINED);
+		RenderGraphResource import_output(const char* name, RenderTarget* target);
+
+		void add_pass(const char* name, SetupFn setup, ExecuteFn execute);
+
+		void compile();
+		void execute(RendererBackend* backend);
+
+		void clear();
+
+		RenderTarget* get_target(RenderGraphResource resource) const;
+		const Texture* get_texture(RenderGraphResource resource) const;
+
+		const Vector<Pass*>& passes() const;
+		const Vector<Resource>& resources() const;
+		const Vector<u32>& pass_order() const;
+		u32 physical_target_count() const;
+
+	private:
+		struct PhysicalTarget
+		{
+			RenderGraphTargetDesc desc;
+			RenderTarget* target;
+		};
+
+		RenderGraphResource add_resource(const char* name, const RenderGraphTargetDesc& desc, RenderTarget* imported, RenderResourceState initial_state);
+		u32 last_writer(RenderGraphResource resource) const;
+
+		void cull_passes();
+		void compute_lifetimes();
+		void alias_transients();
+		void build_barriers();
+
+		void realise_transients();
+
+		Vector<Pass*> m_passes;
+		Vector<Resource> m_resources;
+		Vector<u32> m_pass_order;
+		Vector<RenderGraphTargetDesc> m_physical_descs;
+
+		// persists across frames so transient targets are only created once
+		Vector<PhysicalTarget> m_target_pool;
+		Vector<RenderTarget*> m_physical_targets;
+
+		bool m_compiled;
+	};
+}
+
+#endif // RENDER_GRAPH_H_
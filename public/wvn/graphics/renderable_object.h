@@ -3,6 +3,7 @@
 
 #include <wvn/common.h>
 #include <wvn/maths/affine_3d.h>
+#include <wvn/maths/transform_hierarchy.h>
 #include <wvn/graphics/mesh.h>
 #include <wvn/graphics/light.h>
 
@@ -19,14 +20,24 @@ namespace wvn::gfx
 		RenderableObject(RenderableObjectID id)
 			: id(id)
 			, matrix()
+			, transform_node(TransformHierarchy::NULL_ID)
 			, mesh(nullptr)
+			, is_static(false)
 		{
 		}
 
 		~RenderableObject() = default;
 
 		Affine3D matrix;
+
+		// when set, matrix follows this node in the entity manager's transform hierarchy
+		TransformNodeID transform_node;
+
 		const Mesh* mesh;
+
+		// static objects are assumed never to move, so shadow cascades they are in can be cached.
+		// call RenderingMgr::mark_static_objects_dirty() if one does.
+		bool is_static;
 	};
 
 	class RenderableObjectHandle
@@ -7,8 +7,10 @@
 #include <wvn/graphics/sub_mesh.h>
 #include <wvn/graphics/render_pass.h>
 #include <wvn/graphics/render_target.h>
+#include <wvn/graphics/render_graph.h>
 #include <wvn/graphics/backbuffer.h>
 #include <wvn/graphics/texture.h>
+#include <wvn/graphics/gpu_buffer.h>
 #include <wvn/graphics/blend.h>
 
 #include <wvn/maths/colour.h>
@@ -32,6 +34,22 @@ namespace wvn::gfx
 	struct RendererBackendProperties
 	{
 		bool y_positive_down;
+		bool bindless_textures; // materials are bound by index into one global texture table instead of per-material descriptors
+	};
+
+	/**
+	 * Timings & counters gathered by the backend over the last submitted frame.
+	 */
+	struct RendererBackendFrameStats
+	{
+		double cpu_wait_ms; // time the cpu spent blocked waiting for the gpu to free up a frame
+		u32 pass_count;
+		u32 draw_count;
+		double record_ms; // time spent recording draws into command buffers
+		u32 recording_threads;
+		u32 descriptor_allocations; // descriptor sets allocated this frame, ideally zero once everything has been seen once
+		u32 descriptor_cache_hits;
+		u32 cached_descriptor_sets;
 	};
 
 	/**
@@ -44,12 +62,16 @@ namespace wvn::gfx
 		virtual ~RendererBackend() = default;
 
 		virtual RendererBackendProperties properties() = 0;
+		virtual RendererBackendFrameStats frame_stats() const = 0;
 
 		virtual void begin_render() = 0;
 		virtual void render(const RenderOp& op) = 0;
 		virtual void end_render() = 0;
 		virtual void swap_buffers() = 0;
 
+		// ensures work done on a resource in one state is visible to the next pass using it in another
+		virtual void resource_barrier(const Texture* texture, RenderResourceState before, RenderResourceState after) = 0;
+
         virtual Backbuffer* create_backbuffer() = 0;
 		virtual void set_render_target(RenderTarget* target) = 0;
 
@@ -78,11 +100,20 @@ namespace wvn::gfx
 
 		void clear_texture(u32 idx) { set_texture(idx, nullptr); }
 
+		// read-only storage buffers, bound after every texture slot so their bindings don't move with the number of textures
+		virtual void set_storage_buffer(u32 idx, const GPUBuffer* buffer) = 0;
+
+		// only meaningful when properties().bindless_textures is set, otherwise these return ~0u / do nothing
+		virtual u32 get_bindless_texture_index(const Texture* texture) = 0;
+		virtual u32 get_bindless_sampler_index(TextureSampler* sampler) = 0;
+		virtual u32 create_bindless_material() = 0;
+		virtual void update_bindless_material(u32 idx, const BindlessMaterialData& data) = 0;
+
 		virtual void bind_shader(const ShaderProgram* shader) = 0;
-		virtual void bind_shader_params(ShaderProgramType shader_type, ShaderParameters& params) = 0;
+		virtual void bind_shader_params(ShaderProgramType shader_type, const ShaderParameters& params) = 0;
 
 		// some (vulkan) but not all rendering backends have support for "push constants"
-		virtual void set_push_constants(ShaderParameters& params) = 0;
+		virtual void set_push_constants(const ShaderParameters& params) = 0;
 		virtual void reset_push_constants() = 0;
 
 		virtual void on_window_resize(int width, int height) = 0;
@@ -1,11 +1,14 @@
 #include <wvn/graphics/rendering_mgr.h>
 #include <wvn/graphics/renderer_backend.h>
 #include <wvn/graphics/texture_mgr.h>
+#include <wvn/graphics/image_codec_registry.h>
 #include <wvn/graphics/render_target_mgr.h>
 #include <wvn/graphics/material_system.h>
 #include <wvn/graphics/mesh_mgr.h>
 #include <wvn/graphics/mesh.h>
 #include <wvn/graphics/light.h>
+#include <wvn/graphics/gpu_buffer_mgr.h>
+#include <wvn/maths/calc.h>
 #include <wvn/input/input.h>
 #include <wvn/devenv/log_mgr.h>
 #include <wvn/entity/entity_mgr.h>
@@ -23,12 +26,31 @@ wvn_IMPL_SINGLETON(RenderingMgr);
 
 RenderingMgr::RenderingMgr()
 	: m_backbuffer()
+	, m_render_graph()
+	, m_shadow_maps()
+	, m_shadow_cascades()
+	, m_static_object_generation(0)
+	, m_push_constant_layout()
+	, m_push_constants()
+	, m_view_param()
+	, m_proj_param()
+	, m_light_view_param()
+	, m_light_proj_param()
+	, m_camera_position_and_time_param()
+	, m_model_param()
+	, m_normal_matrix_param()
+	, m_material_index_param()
 	, m_skybox_texture()
 	, m_skybox_sampler()
 	, m_skybox_mesh()
 	, m_curr_light_id()
 	, m_lights()
 	, m_light_shadow_sampler(nullptr)
+	, m_fallback_shadow_map(nullptr)
+	, m_fallback_shadow_map_cleared(false)
+	, m_light_clusters()
+	, m_light_cluster_buffers{}
+	, m_light_cluster_buffer_idx(0)
 	, m_curr_object_id()
 	, m_objects()
 {
@@ -37,6 +59,19 @@ RenderingMgr::RenderingMgr()
 
 	MaterialSystem::get_singleton()->load_default_techniques();
 
+	m_model_param = MaterialSystem::get_singleton()->object_parameter_layout().find("model");
+	m_normal_matrix_param = MaterialSystem::get_singleton()->object_parameter_layout().find("normal_matrix");
+	m_material_index_param = MaterialSystem::get_singleton()->object_parameter_layout().find("material_index");
+
+	// push constants must be declared *IN THE ORDER* that they appear in the shader
+	m_view_param = m_push_constant_layout.add("view", ShaderParameter::PARAM_TYPE_MAT4X4F);
+	m_proj_param = m_push_constant_layout.add("proj", ShaderParameter::PARAM_TYPE_MAT4X4F);
+	m_light_view_param = m_push_constant_layout.add("light_view", ShaderParameter::PARAM_TYPE_MAT4X4F);
+	m_light_proj_param = m_push_constant_layout.add("light_proj", ShaderParameter::PARAM_TYPE_MAT4X4F);
+	m_camera_position_and_time_param = m_push_constant_layout.add("camera_position_and_time", ShaderParameter::PARAM_TYPE_VEC4F);
+
+	m_push_constants.set_layout(&m_push_constant_layout);
+
 	// shadow map sampler
 	m_light_shadow_sampler = TextureMgr::get_singleton()->register_sampler(
 		"light_sampler",
@@ -49,9 +84,14 @@ RenderingMgr::RenderingMgr()
 
 	create_skybox();
 
+	m_light_clusters.set_worker_pool(Root::get_singleton()->worker_pool());
+
+	for (auto& buffers : m_light_cluster_buffers) {
+		buffers.clusters = GPUBufferMgr::get_singleton()->create_storage_buffer(sizeof(LightClusterParams) + (sizeof(LightCluster) * LightClusterGrid::CLUSTER_COUNT));
+	}
+
 	// todo: temp, add a light
 	auto it = create_light(true);
-	it->set_shadow_map(RenderTargetMgr::get_singleton()->get_depth_only_target(Light::DEPTH_TEXTURE_WIDTH, Light::DEPTH_TEXTURE_HEIGHT));
 	it->set_type(LIGHT_TYPE_DIR);
 	it->set_colour(Colour::white());
 	it->toggle_ambient(true);
@@ -68,6 +108,16 @@ RenderingMgr::RenderingMgr()
 
 RenderingMgr::~RenderingMgr()
 {
+	for (auto& [id, cascades] : m_shadow_cascades) {
+		delete cascades;
+	}
+
+	for (auto& buffers : m_light_cluster_buffers) {
+		delete buffers.lights;
+		delete buffers.light_indices;
+		delete buffers.clusters;
+	}
+
 	dev::LogMgr::get_singleton()->print("[RENDERING] Destroyed!");
 }
 
@@ -116,39 +166,182 @@ Light* RenderingMgr::fetch_light(const LightHandle& light)
 	return m_lights[light.id()];
 }
 
-Camera RenderingMgr::get_light_camera(const Light& light) const
+void RenderingMgr::mark_static_objects_dirty()
+{
+	m_static_object_generation++;
+}
+
+const LightClusterGrid& RenderingMgr::light_clusters() const
+{
+	return m_light_clusters;
+}
+
+const RenderingMgr::LightClusterBuffers& RenderingMgr::light_cluster_buffers() const
+{
+	return m_light_cluster_buffers[m_light_cluster_buffer_idx];
+}
+
+void RenderingMgr::sync_object_transforms()
+{
+	const TransformHierarchy& transforms = ent::EntityMgr::get_singleton()->transforms();
+
+	for (auto& [id, obj] : m_objects)
+	{
+		if (!transforms.is_valid(obj->transform_node)) {
+			continue;
+		}
+
+		obj->matrix = transforms.world(obj->transform_node);
+
+		// a static object that moved anyway invalidates the cached shadow cascades
+		if (obj->is_static && transforms.was_updated(obj->transform_node)) {
+			mark_static_objects_dirty();
+		}
+	}
+}
+
+// bin every point & spot light into the view frustum's clusters and upload the result for the forward pass,
+// directional lights reach every cluster so they aren't part of the grid
+void RenderingMgr::update_light_clusters()
+{
+	Vector<ClusterLightData> lights;
+
+	for (auto& [id, light] : m_lights)
+	{
+		if (light->get_type() != LIGHT_TYPE_POINT && light->get_type() != LIGHT_TYPE_SPOT) {
+			continue;
+		}
+
+		const Vec3F& position = light->get_position();
+		Vec3F direction = light->get_orientation().vector();
+
+		float colour[4];
+		light->get_colour().export_to_float(colour);
+
+		lights.push_back({
+			.position = { position.x, position.y, position.z },
+			.range = light->get_range(),
+			.colour = { colour[0], colour[1], colour[2] },
+			.intensity = light->get_intensity(),
+			.direction = { direction.x, direction.y, direction.z },
+			.type = (u32)light->get_type()
+		});
+	}
+
+	LightClusterView view = {
+		.position = maincam.position,
+		.direction = maincam.direction,
+		.up = maincam.up,
+		.fov = maincam.fov,
+		.aspect = maincam.width / maincam.height,
+		.near = maincam.near,
+		.far = maincam.far,
+		.perspective = maincam.type == Camera::CAM_PERSP
+	};
+
+	m_light_clusters.build(view, lights);
+
+	m_light_cluster_buffer_idx = (m_light_cluster_buffer_idx + 1) % LIGHT_CLUSTER_BUFFER_COUNT;
+	LightClusterBuffers& buffers = m_light_cluster_buffers[m_light_cluster_buffer_idx];
+
+	const Vector<ClusterLightData>& light_data = m_light_clusters.lights();
+	const Vector<u32>& light_indices = m_light_clusters.light_indices();
+
+	// grow geometrically so a slowly rising light count doesn't recreate the buffers every frame
+	if (light_data.size() > buffers.light_capacity || !buffers.lights)
+	{
+		GPUBufferMgr::get_singleton()->destroy_buffer(buffers.lights);
+
+		buffers.light_capacity = CalcU::max(light_data.size() * 2, 64);
+		buffers.lights = GPUBufferMgr::get_singleton()->create_storage_buffer(sizeof(ClusterLightData) * buffers.light_capacity);
+	}
+
+	if (light_indices.size() > buffers.light_index_capacity || !buffers.light_indices)
+	{
+		GPUBufferMgr::get_singleton()->destroy_buffer(buffers.light_indices);
+
+		buffers.light_index_capacity = CalcU::max(light_indices.size() * 2, 1024);
+		buffers.light_indices = GPUBufferMgr::get_singleton()->create_storage_buffer(sizeof(u32) * buffers.light_index_capacity);
+	}
+
+	if (light_data.size() > 0) {
+		buffers.lights->read_data_from_memory(light_data.data(), sizeof(ClusterLightData) * light_data.size(), 0);
+	}
+
+	if (light_indices.size() > 0) {
+		buffers.light_indices->read_data_from_memory(light_indices.data(), sizeof(u32) * light_indices.size(), 0);
+	}
+
+	LightClusterParams params = {
+		.near = m_light_clusters.near(),
+		.log_depth_ratio = m_light_clusters.log_depth_ratio(),
+		.screen_width = (float)Root::get_singleton()->config().width,
+		.screen_height = (float)Root::get_singleton()->config().height
+	};
+
+	buffers.clusters->read_data_from_memory(&params, sizeof(LightClusterParams), 0);
+	buffers.clusters->read_data_from_memory(m_light_clusters.clusters().data(), sizeof(LightCluster) * LightClusterGrid::CLUSTER_COUNT, sizeof(LightClusterParams));
+}
+
+// rough size of the object on screen in pixels, fed back to the texture streamer so it knows which mips are needed
+void RenderingMgr::report_texture_usage(const Mesh* mesh, const Vec3F& centre, float radius)
+{
+	float screen_size = 0.0f;
+
+	if (maincam.type == Camera::CAM_PERSP)
+	{
+		float distance = CalcF::max((centre - maincam.position).length() - radius, maincam.near);
+		screen_size = (radius / (distance * CalcF::tan(maincam.fov * CalcF::DEG2RAD * 0.5f))) * maincam.height;
+	}
+	else
+	{
+		screen_size = (radius * 2.0f / maincam.height) * (float)Root::get_singleton()->config().height;
+	}
+
+	for (int i = 0; i < mesh->submesh_count(); i++)
+	{
+		const Material* material = mesh->submesh(i)->material();
+
+		if (!material) {
+			continue;
+		}
+
+		for (auto& sampled : material->textures) {
+			TextureMgr::get_singleton()->report_texture_usage(sampled.texture, screen_size);
+		}
+	}
+}
+
+CascadedShadowMap* RenderingMgr::get_shadow_cascades(const Light* light)
 {
-	Camera light_camera(Camera::CAM_ORTHO, 5.0f, 5.0f);
-	light_camera.up = Vec3F::up();
-	light_camera.near = light.get_shadow_near_clip();
-	light_camera.far = light.get_shadow_far_clip();
-	light_camera.direction = light.get_orientation().vector();
-	light_camera.position = light.get_position();
-
-	return light_camera;
+	LightID id = LightHandle(light).id();
+
+	if (!m_shadow_cascades.contains(id)) {
+		m_shadow_cascades.insert(Pair(id, new CascadedShadowMap()));
+	}
+
+	return m_shadow_cascades[id];
 }
 
 void RenderingMgr::render_scene_and_swap_buffers()
 {
-	// push constants must be initialized *IN THE ORDER* that they appear in the shader
-	// on initial initialisation, they should be added in the order they appear in the uniform buffer of the shader
-	ShaderParameters push_constants;
-	push_constants.set("view", Mat4x4::identity());
-	push_constants.set("proj", Mat4x4::identity());
-	push_constants.set("light_view", Mat4x4::identity());
-	push_constants.set("light_proj", Mat4x4::identity());
-	push_constants.set("camera_position_and_time", { maincam.position.x, maincam.position.y, maincam.position.z, (float)time::elapsed });
-
-	// iterate through all shadow-casting lights
-	// and update their shadow maps to reflect the scene
-	perform_shadow_pass(push_constants);
+	m_push_constants.set(m_view_param, Mat4x4::identity());
+	m_push_constants.set(m_proj_param, Mat4x4::identity());
+	m_push_constants.set(m_light_view_param, Mat4x4::identity());
+	m_push_constants.set(m_light_proj_param, Mat4x4::identity());
+	m_push_constants.set(m_camera_position_and_time_param, Vec4F { maincam.position.x, maincam.position.y, maincam.position.z, (float)time::elapsed });
 
-	// render the world to the actual game window
-	backend->set_render_target(m_backbuffer);
-	backend->set_cull_mode(CULL_MODE_BACK);
-	backend->begin_render();
-	perform_forward_pass(push_constants);
-	backend->end_render();
+	// residency changes are based on the usage reported while drawing the previous frame
+	TextureMgr::get_singleton()->update_streaming();
+
+	sync_object_transforms();
+	update_light_clusters();
+
+	// the graph is rebuilt every frame, the targets it allocates are pooled internally
+	m_render_graph.clear();
+	build_render_graph(m_push_constants);
+	m_render_graph.compile();
+	m_render_graph.execute(backend);
 
 //	backend->set_render_target(m_backbuffer);
 //	backend->set_cull_mode(CULL_MODE_BACK);
@@ -177,8 +370,8 @@ void RenderingMgr::render_scene_and_swap_buffers()
 
 void RenderingMgr::perform_forward_pass(ShaderParameters& push_constants)
 {
-	push_constants.set("view", maincam.view_matrix().basis());
-	push_constants.set("proj", maincam.proj_matrix());
+	push_constants.set(m_view_param, maincam.view_matrix().basis());
+	push_constants.set(m_proj_param, maincam.proj_matrix());
 	backend->set_push_constants(push_constants);
 
 	backend->set_depth_params(false, false);
@@ -189,18 +382,56 @@ void RenderingMgr::perform_forward_pass(ShaderParameters& push_constants)
 		Affine3D::identity()
 	);
 
-	push_constants.set("view", maincam.view_matrix());
+	push_constants.set(m_view_param, maincam.view_matrix());
 	backend->set_push_constants(push_constants);
 
 	backend->set_depth_params(true, true);
 
+	// point & spot lights are looked up through the cluster the fragment falls into
+	const LightClusterBuffers& cluster_buffers = light_cluster_buffers();
+	backend->set_storage_buffer(LIGHT_CLUSTER_LIGHTS_SLOT, cluster_buffers.lights);
+	backend->set_storage_buffer(LIGHT_CLUSTER_INDICES_SLOT, cluster_buffers.light_indices);
+	backend->set_storage_buffer(LIGHT_CLUSTER_CLUSTERS_SLOT, cluster_buffers.clusters);
+
+	// the forward shader samples the shadow map of a single light, so take the first one that casts shadows
+	const CascadedShadowMap* cascades = nullptr;
+
+	for (auto& [id, light] : m_lights) {
+		if (light->is_shadow_caster()) {
+			cascades = get_shadow_cascades(light);
+			break;
+		}
+	}
+
+	// without one every fragment projects to depth 0 in the cleared fallback map, so nothing ends up in shadow
+	// the fallback only exists when there are no shadow maps, so it mustn't be touched otherwise
+	Mat4x4 light_view = Mat4x4::identity();
+	Mat4x4 light_proj = Mat4x4::create_scale(0.0f, 0.0f, 0.0f);
+	const Texture* shadow_map = cascades ? nullptr : m_fallback_shadow_map->get_depth_attachment();
+
 	for (auto& [id, obj] : m_objects)
 	{
 		if (obj->mesh)
 		{
-			Camera cam = get_light_camera(*m_lights.first()->data.second);
-			push_constants.set("light_view", cam.view_matrix());
-			push_constants.set("light_proj", cam.proj_matrix());
+			// the forward shader samples a single shadow map, so each object picks the
+			// highest resolution cascade that fully contains it
+			Vec3F centre;
+			float radius;
+			CascadedShadowMap::calc_world_bounds(*obj, &centre, &radius);
+
+			if (cascades)
+			{
+				const ShadowCascade& cascade = cascades->cascade(cascades->select_cascade(centre, radius));
+
+				light_view = cascade.view;
+				light_proj = cascade.proj;
+				shadow_map = cascade.shadow_map->get_depth_attachment();
+			}
+
+			report_texture_usage(obj->mesh, centre, radius);
+
+			push_constants.set(m_light_view_param, light_view);
+			push_constants.set(m_light_proj_param, light_proj);
 			backend->set_push_constants(push_constants);
 
 			obj->mesh->submesh(0)->material()->set_texture(1,
@@ -209,7 +440,7 @@ void RenderingMgr::perform_forward_pass(ShaderParameters& push_constants)
 			);
 
 			obj->mesh->submesh(0)->material()->set_texture(2,
-				m_lights.first()->data.second->get_shadow_map()->get_depth_attachment(),
+				shadow_map,
 				m_light_shadow_sampler
 			);
 
@@ -220,41 +451,132 @@ void RenderingMgr::perform_forward_pass(ShaderParameters& push_constants)
 			);
 		}
 	}
+
+	backend->set_storage_buffer(LIGHT_CLUSTER_LIGHTS_SLOT, nullptr);
+	backend->set_storage_buffer(LIGHT_CLUSTER_INDICES_SLOT, nullptr);
+	backend->set_storage_buffer(LIGHT_CLUSTER_CLUSTERS_SLOT, nullptr);
 }
 
-void RenderingMgr::perform_shadow_pass(ShaderParameters& push_constants)
+void RenderingMgr::build_render_graph(ShaderParameters& push_constants)
 {
+	m_shadow_maps.clear();
+
+	RenderGraphResource backbuffer = m_render_graph.import_output("backbuffer", m_backbuffer);
+
+	// iterate through all shadow-casting lights and update the cascades of their shadow maps
+	// cascades are persistent targets, those whose contents wouldn't change this frame keep last frame's render
 	for (auto& [id, light] : m_lights)
 	{
 		if (!light->is_shadow_caster()) {
 			continue;
 		}
 
-		backend->set_render_target(light->get_shadow_map());
-		backend->set_cull_mode(CULL_MODE_FRONT);
-		backend->begin_render();
+		CascadedShadowMap* cascades = get_shadow_cascades(light);
+		cascades->update(*light, maincam, m_objects, m_static_object_generation);
+
+		light->set_shadow_map(cascades->cascade(0).shadow_map);
+
+		for (u32 i = 0; i < cascades->cascade_count(); i++)
+		{
+			const ShadowCascade& cascade = cascades->cascade(i);
+
+			RenderGraphResource shadow_map = m_render_graph.import_target(
+				"shadow_cascade",
+				cascade.shadow_map,
+				true,
+				cascade.rendered ? RENDER_RESOURCE_STATE_SHADER_READ : RENDER_RESOURCE_STATE_UNDEFINED
+			);
+
+			m_shadow_maps.push_back({ light, cascades, i, shadow_map });
+
+			if (!cascades->needs_render(i)) {
+				continue;
+			}
+
+			u64 shadow_idx = m_shadow_maps.size() - 1;
 
-		Camera cam = get_light_camera(*light);
-		perform_single_shadow_pass(push_constants, cam);
+			m_render_graph.add_pass(
+				"shadow",
+				[shadow_map](RenderGraphBuilder& builder) -> void
+				{
+					builder.write(shadow_map);
+				},
+				[this, &push_constants, shadow_idx](const RenderGraph&) -> void
+				{
+					ShadowCascadePass& pass = m_shadow_maps[shadow_idx];
 
-		backend->end_render();
+					backend->set_cull_mode(CULL_MODE_FRONT);
+
+					perform_single_shadow_pass(push_constants, pass.cascades->cascade(pass.cascade_idx));
+					pass.cascades->mark_rendered(pass.cascade_idx);
+				}
+			);
+		}
+	}
+
+	// the forward shader always samples a shadow map, so without any casters it gets a 1x1 one cleared to the far plane
+	if (m_shadow_maps.empty())
+	{
+		if (!m_fallback_shadow_map) {
+			m_fallback_shadow_map = RenderTargetMgr::get_singleton()->get_depth_only_target(1, 1);
+		}
+
+		RenderGraphResource shadow_map = m_render_graph.import_target(
+			"shadow_fallback",
+			m_fallback_shadow_map,
+			true,
+			m_fallback_shadow_map_cleared ? RENDER_RESOURCE_STATE_SHADER_READ : RENDER_RESOURCE_STATE_UNDEFINED
+		);
+
+		m_shadow_maps.push_back({ nullptr, nullptr, 0, shadow_map });
+
+		// beginning the pass is what clears it, there is nothing to draw
+		if (!m_fallback_shadow_map_cleared)
+		{
+			m_render_graph.add_pass(
+				"shadow_fallback",
+				[shadow_map](RenderGraphBuilder& builder) -> void
+				{
+					builder.write(shadow_map);
+				},
+				[this](const RenderGraph&) -> void
+				{
+					m_fallback_shadow_map_cleared = true;
+				}
+			);
+		}
 	}
+
+	// render the world to the actual game window
+	m_render_graph.add_pass(
+		"forward",
+		[this, backbuffer](RenderGraphBuilder& builder) -> void
+		{
+			for (auto& pass : m_shadow_maps) {
+				builder.read(pass.shadow_map);
+			}
+
+			builder.write(backbuffer);
+		},
+		[this, &push_constants](const RenderGraph&) -> void
+		{
+			backend->set_cull_mode(CULL_MODE_BACK);
+			perform_forward_pass(push_constants);
+		}
+	);
 }
 
-void RenderingMgr::perform_single_shadow_pass(ShaderParameters& push_constants, const Camera& camera)
+void RenderingMgr::perform_single_shadow_pass(ShaderParameters& push_constants, const ShadowCascade& cascade)
 {
-	push_constants.set("view", camera.view_matrix());
-	push_constants.set("proj", camera.proj_matrix());
+	push_constants.set(m_view_param, cascade.view);
+	push_constants.set(m_proj_param, cascade.proj);
 	backend->set_push_constants(push_constants);
 
 	backend->set_depth_params(true, true);
 
-	for (auto& [obj_id, obj] : m_objects)
+	// only what was found to overlap the cascade when it was fitted
+	for (const RenderableObject* obj : cascade.casters)
 	{
-		if (!obj->mesh) {
-			continue;
-		}
-
 		render_mesh(
 			SHADER_PASS_SHADOW,
 			obj->mesh,
@@ -270,15 +592,21 @@ void RenderingMgr::render_mesh(int pass_id, const Mesh* mesh, const Affine3D& mo
 		const SubMesh* submesh = mesh->submesh(i);
 		const Material* material = submesh->material();
 
-		if (pass_id == SHADER_PASS_SHADOW) {
-			for (int j = 0; j < material->textures.size(); j++) { // todo: figure out why i need to call this... at all. shouldn't the shadow pass be an empty material that would reset all textures anyways?
-				backend->set_texture(j, nullptr);
-			}
-		} else {
-			for (int j = 0; j < material->textures.size(); j++) {
-				backend->set_texture(j, material->textures[j].texture);
-				if (material->textures[j].sampler) {
-					backend->set_sampler(j, material->textures[j].sampler);
+		bool bindless = m_material_index_param.is_valid();
+
+		// with bindless textures the material is just an index, so the descriptor set stays the same for every draw
+		if (!bindless)
+		{
+			if (pass_id == SHADER_PASS_SHADOW) {
+				for (int j = 0; j < material->textures.size(); j++) { // todo: figure out why i need to call this... at all. shouldn't the shadow pass be an empty material that would reset all textures anyways?
+					backend->set_texture(j, nullptr);
+				}
+			} else {
+				for (int j = 0; j < material->textures.size(); j++) {
+					backend->set_texture(j, material->textures[j].texture);
+					if (material->textures[j].sampler) {
+						backend->set_sampler(j, material->textures[j].sampler);
+					}
 				}
 			}
 		}
@@ -288,8 +616,12 @@ void RenderingMgr::render_mesh(int pass_id, const Mesh* mesh, const Affine3D& mo
 
 		for (int k = 0; k < shader->stages.size(); k++)
 		{
-			shader->stages[k]->params.set("model", model_matrix.build_transformation_matrix());
-			shader->stages[k]->params.set("normal_matrix", normal_matrix);
+			shader->stages[k]->params.set(m_model_param, model_matrix.build_transformation_matrix());
+			shader->stages[k]->params.set(m_normal_matrix_param, normal_matrix);
+
+			if (bindless) {
+				shader->stages[k]->params.set(m_material_index_param, material->bindless_index());
+			}
 
 			backend->bind_shader(shader->stages[k]);
 			backend->bind_shader_params(shader->stages[k]->type, shader->stages[k]->params);
@@ -322,8 +654,8 @@ void RenderingMgr::primitive_forward_render(const Mesh* mesh)
 
 		for (int k = 0; k < shader->stages.size(); k++)
 		{
-			shader->stages[k]->params.set("model", Mat4x4::identity());
-			shader->stages[k]->params.set("normal_matrix", Mat4x4::identity());
+			shader->stages[k]->params.set(m_model_param, Mat4x4::identity());
+			shader->stages[k]->params.set(m_normal_matrix_param, Mat4x4::identity());
 
 			backend->bind_shader(shader->stages[k]);
 			backend->bind_shader_params(shader->stages[k]->type, shader->stages[k]->params);
@@ -338,21 +670,27 @@ void RenderingMgr::primitive_forward_render(const Mesh* mesh)
 
 void RenderingMgr::create_skybox()
 {
-	Image img_rt("../res/skyboxes/skybox6/posx.jpg");
-	Image img_lf("../res/skyboxes/skybox6/negx.jpg");
-	Image img_tp("../res/skyboxes/skybox6/posy.jpg");
-	Image img_bt("../res/skyboxes/skybox6/negy.jpg");
-	Image img_ft("../res/skyboxes/skybox6/negz.jpg");
-	Image img_bk("../res/skyboxes/skybox6/posz.jpg");
+	const char* faces[] = {
+		"../res/skyboxes/skybox6/posx.jpg",
+		"../res/skyboxes/skybox6/negx.jpg",
+		"../res/skyboxes/skybox6/posy.jpg",
+		"../res/skyboxes/skybox6/negy.jpg",
+		"../res/skyboxes/skybox6/negz.jpg",
+		"../res/skyboxes/skybox6/posz.jpg"
+	};
+
+	// all six faces decode at the same time
+	Image images[6];
+	ImageCodecRegistry::get_singleton()->load_batch(faces, images, 6);
 
 	m_skybox_texture = TextureMgr::get_singleton()->register_cube_map("skybox",
 		TEX_FORMAT_R8G8B8A8_SRGB,
-		img_rt,
-		img_lf,
-		img_tp,
-		img_bt,
-		img_ft,
-		img_bk
+		images[0],
+		images[1],
+		images[2],
+		images[3],
+		images[4],
+		images[5]
 	);
 
 	m_skybox_sampler = TextureMgr::get_singleton()->register_sampler("skybox_sampler", TEX_FILTER_LINEAR);
@@ -10,6 +10,10 @@
 #include <wvn/graphics/light.h>
 #include <wvn/graphics/renderable_object.h>
 #include <wvn/graphics/render_target.h>
+#include <wvn/graphics/render_graph.h>
+#include <wvn/graphics/cascaded_shadow_map.h>
+#include <wvn/graphics/light_cluster_grid.h>
+#include <wvn/graphics/gpu_buffer.h>
 
 namespace wvn { class Camera; }
 
@@ -23,7 +27,32 @@ namespace wvn::gfx
 	{
 		wvn_DEF_SINGLETON(RenderingMgr);
 
+		struct ShadowCascadePass
+		{
+			Light* light;
+			CascadedShadowMap* cascades;
+			u32 cascade_idx;
+			RenderGraphResource shadow_map;
+		};
+
 	public:
+		// one set of cluster buffers per frame in flight so the cpu never writes into one the gpu is reading
+		constexpr static u32 LIGHT_CLUSTER_BUFFER_COUNT = 3;
+
+		// storage buffer slots the forward pass binds them to
+		constexpr static u32 LIGHT_CLUSTER_LIGHTS_SLOT = 0;
+		constexpr static u32 LIGHT_CLUSTER_INDICES_SLOT = 1;
+		constexpr static u32 LIGHT_CLUSTER_CLUSTERS_SLOT = 2;
+
+		struct LightClusterBuffers
+		{
+			GPUBuffer* lights;
+			GPUBuffer* light_indices;
+			GPUBuffer* clusters; // LightClusterParams followed by every LightCluster
+			u64 light_capacity;
+			u64 light_index_capacity;
+		};
+
 		RenderingMgr();
 		~RenderingMgr();
 
@@ -37,20 +66,45 @@ namespace wvn::gfx
 		bool is_valid_light(const LightHandle& light);
 		Light* fetch_light(const LightHandle& light);
 
+		// must be called whenever a static object is moved, invalidates every cached shadow cascade
+		void mark_static_objects_dirty();
+
+		const LightClusterGrid& light_clusters() const;
+		const LightClusterBuffers& light_cluster_buffers() const; // the buffers filled in for the current frame
+
 	private:
+		void sync_object_transforms();
+		void update_light_clusters();
+		void report_texture_usage(const Mesh* mesh, const Vec3F& centre, float radius);
+
 		void perform_forward_pass(ShaderParameters& push_constants);
 
-		void perform_shadow_pass(ShaderParameters& push_constants);
-		void perform_single_shadow_pass(ShaderParameters& push_constants, const Camera& camera);
+		void build_render_graph(ShaderParameters& push_constants);
+		void perform_single_shadow_pass(ShaderParameters& push_constants, const ShadowCascade& cascade);
 
 		void create_skybox();
 
 		void render_mesh(int pass_id, const Mesh* mesh, const Affine3D& model_matrix);
 		void primitive_forward_render(const Mesh* mesh);
 
-		Camera get_light_camera(const Light& light) const;
+		CascadedShadowMap* get_shadow_cascades(const Light* light);
 
 		RenderTarget* m_backbuffer;
+		RenderGraph m_render_graph;
+		Vector<ShadowCascadePass> m_shadow_maps;
+		HashMap<LightID, CascadedShadowMap*> m_shadow_cascades;
+		u64 m_static_object_generation;
+
+		ShaderParameterLayout m_push_constant_layout;
+		ShaderParameters m_push_constants;
+		ShaderParameterID m_view_param;
+		ShaderParameterID m_proj_param;
+		ShaderParameterID m_light_view_param;
+		ShaderParameterID m_light_proj_param;
+		ShaderParameterID m_camera_position_and_time_param;
+		ShaderParameterID m_model_param;
+		ShaderParameterID m_normal_matrix_param;
+		ShaderParameterID m_material_index_param; // only valid with bindless textures
 
 		Texture* m_skybox_texture;
 		TextureSampler* m_skybox_sampler;
@@ -61,6 +115,12 @@ namespace wvn::gfx
 		Vector<Light*> m_shadow_casting_lights;
 //		LightShadowMapMgr m_light_shadow_map_mgr;
 		TextureSampler* m_light_shadow_sampler;
+		RenderTarget* m_fallback_shadow_map; // cleared once and bound when no light casts shadows
+		bool m_fallback_shadow_map_cleared;
+
+		LightClusterGrid m_light_clusters;
+		LightClusterBuffers m_light_cluster_buffers[LIGHT_CLUSTER_BUFFER_COUNT];
+		u32 m_light_cluster_buffer_idx;
 
 		RenderableObjectID m_curr_object_id;
 		HashMap<RenderableObjectID, RenderableObject*> m_objects;
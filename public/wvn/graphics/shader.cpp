@@ -3,32 +3,127 @@
 using namespace wvn;
 using namespace wvn::gfx;
 
-const ShaderParameters::PackedConstants& ShaderParameters::get_packed_constants()
+ShaderParameterLayout::ShaderParameterLayout()
+	: m_entries()
+	, m_size(0)
 {
-	if (m_dirty_constants) {
-		rebuild_packed_constant_data();
-		m_dirty_constants = false;
+}
+
+ShaderParameterID ShaderParameterLayout::add(const char* name, ShaderParameter::ParameterType type)
+{
+	u64 name_hash = hash_name(name);
+
+	wvn_ASSERT(!find(name_hash).is_valid(), "[SHADER|DEBUG] Parameter declared twice in the same layout.");
+
+	m_entries.push_back({
+		.name_hash = name_hash,
+		.type = type,
+		.offset = (u32)m_size
+	});
+
+	m_size += ShaderParameter::type_alignment_offset(type);
+
+	return { (u32)m_entries.size() - 1 };
+}
+
+ShaderParameterID ShaderParameterLayout::find(const char* name) const
+{
+	return find(hash_name(name));
+}
+
+// layouts only hold a handful of entries, a linear scan over the hashes beats anything fancier
+ShaderParameterID ShaderParameterLayout::find(u64 name_hash) const
+{
+	for (u32 i = 0; i < m_entries.size(); i++) {
+		if (m_entries[i].name_hash == name_hash) {
+			return { i };
+		}
 	}
 
-	return m_packed_constants;
+	return {};
+}
+
+const ShaderParameterLayout::Entry& ShaderParameterLayout::entry(ShaderParameterID id) const
+{
+	wvn_ASSERT(id.index < m_entries.size(), "[SHADER|DEBUG] Parameter id out of range.");
+	return m_entries[id.index];
+}
+
+u32 ShaderParameterLayout::entry_count() const
+{
+	return m_entries.size();
+}
+
+u64 ShaderParameterLayout::size() const
+{
+	return m_size;
 }
 
-void ShaderParameters::rebuild_packed_constant_data()
+u64 ShaderParameterLayout::hash_name(const char* name)
 {
+	return hash::calc(0, name);
+}
+
+ShaderParameters::ShaderParameters()
+	: m_shared_layout(nullptr)
+	, m_implicit_layout()
+	, m_packed_constants()
+{
+}
+
+ShaderParameters::ShaderParameters(const ShaderParameterLayout* layout)
+	: m_shared_layout(nullptr)
+	, m_implicit_layout()
+	, m_packed_constants()
+{
+	set_layout(layout);
+}
+
+void ShaderParameters::set_layout(const ShaderParameterLayout* layout)
+{
+	m_shared_layout = layout;
+	m_implicit_layout = ShaderParameterLayout();
+
 	m_packed_constants.clear();
 
-	u64 aligned_size = 0;
-	for (auto& [name, param] : m_constants) {
-		aligned_size += param.alignment_offset();
+	if (layout && layout->size() > 0) {
+		m_packed_constants.resize(layout->size());
 	}
+}
+
+const ShaderParameterLayout& ShaderParameters::layout() const
+{
+	return m_shared_layout ? *m_shared_layout : m_implicit_layout;
+}
 
-	m_packed_constants.resize(aligned_size);
+// already packed, nothing to do
+const ShaderParameters::PackedConstants& ShaderParameters::get_packed_constants() const
+{
+	return m_packed_constants;
+}
+
+void ShaderParameters::reset()
+{
+	set_layout(m_shared_layout);
+}
 
-	u64 offset = 0;
-	for (auto& [name, param] : m_constants) {
-		mem::copy(m_packed_constants.data() + offset, &param.data, param.size());
-		offset += param.alignment_offset();
+ShaderParameterID ShaderParameters::find_or_declare(const char* name, ShaderParameter::ParameterType type)
+{
+	ShaderParameterID id = layout().find(name);
+
+	if (id.is_valid()) {
+		return id;
+	}
+
+	if (m_shared_layout) {
+		wvn_ERROR("[SHADER|DEBUG] Parameter '%s' is not part of the shader's layout.", name);
+		return {};
 	}
+
+	id = m_implicit_layout.add(name, type);
+	m_packed_constants.resize(m_implicit_layout.size());
+
+	return id;
 }
 
 ShaderProgram::ShaderProgram()
@@ -3,6 +3,7 @@
 
 #include <wvn/common.h>
 #include <wvn/container/vector.h>
+#include <wvn/container/small_vector.h>
 #include <wvn/container/hash_map.h>
 #include <wvn/container/string.h>
 #include <wvn/maths/mat4x4.h>
@@ -65,7 +66,10 @@ namespace wvn::gfx
 		ParameterType type;
 		byte data[MAX_PARAMETER_SIZE];
 
-		constexpr u64 alignment_offset() const
+		constexpr u64 alignment_offset() const { return type_alignment_offset(type); }
+		constexpr u64 size() const { return type_size(type); }
+
+		static constexpr u64 type_alignment_offset(ParameterType type)
 		{
 			switch (type)
 			{
@@ -95,7 +99,7 @@ namespace wvn::gfx
 			}
 		}
 
-		constexpr u64 size() const
+		static constexpr u64 type_size(ParameterType type)
 		{
 			switch (type)
 			{
@@ -126,77 +130,148 @@ namespace wvn::gfx
 		}
 	};
 
+	/**
+	 * Index of a parameter inside of a ShaderParameterLayout.
+	 * Looked up once by name, after which writes go straight to a known offset.
+	 */
+	struct ShaderParameterID
+	{
+		static constexpr u32 INVALID = ~0u;
+
+		u32 index = INVALID;
+
+		bool is_valid() const { return index != INVALID; }
+	};
+
+	/**
+	 * Compiled layout of a block of shader parameters.
+	 * Every parameter gets a fixed byte offset, in the order they are declared,
+	 * which has to match the order they appear in within the shader.
+	 */
+	class ShaderParameterLayout
+	{
+	public:
+		struct Entry
+		{
+			u64 name_hash;
+			ShaderParameter::ParameterType type;
+			u32 offset;
+		};
+
+		ShaderParameterLayout();
+		~ShaderParameterLayout() = default;
+
+		ShaderParameterID add(const char* name, ShaderParameter::ParameterType type);
+		ShaderParameterID find(const char* name) const;
+		ShaderParameterID find(u64 name_hash) const;
+
+		const Entry& entry(ShaderParameterID id) const;
+		u32 entry_count() const;
+		u64 size() const;
+
+		static u64 hash_name(const char* name);
+
+	private:
+		SmallVector<Entry, 8> m_entries;
+		u64 m_size;
+	};
+
 	struct Vec4F { float r,g,b,a; };
 
 	/**
-	 * Represents a list of a shader program parameters
+	 * Represents a list of a shader program parameters.
+	 * Values are written directly into a persistent, already packed block at offsets given by the layout.
+	 * If no shared layout is set, one is built up implicitly in the order parameters are first set.
 	 */
 	class ShaderParameters
 	{
 	public:
-		using PackedConstants = Vector<byte>;
+		// big enough for the engine's push constants (four matrices and a vec4) to never touch the heap
+		using PackedConstants = SmallVector<byte, 512>;
 
-		ShaderParameters() = default;
+		ShaderParameters();
+		ShaderParameters(const ShaderParameterLayout* layout);
 		~ShaderParameters() = default;
 
-		const PackedConstants& get_packed_constants();
-
-		void reset()
-		{
-			m_constants.clear();
-			m_packed_constants.clear();
-			m_dirty_constants = true;
-		}
-
-		void set(const String& name, s8 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_S8); }
-		void set(const String& name, s16 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_S16); }
-		void set(const String& name, s32 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_S32); }
-		void set(const String& name, s64 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_S64); }
-		void set(const String& name, u8 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_U8); }
-		void set(const String& name, u16 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_U16); }
-		void set(const String& name, u32 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_U32); }
-		void set(const String& name, u64 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_U64); }
-		void set(const String& name, f32 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_F32); }
-		void set(const String& name, f64 val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_F64); }
-		void set(const String& name, bool val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_BOOL); }
-		void set(const String& name, const Vec2F& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_VEC2F); }
-		void set(const String& name, const Vec3F& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_VEC3F); }
-		void set(const String& name, const Vec4F& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_VEC4F); }
-//		void set(const String& name, const Basis3D& val)	{ _set(name, val, ShaderParameter::PARAM_TYPE_MAT3X3F); }
-		void set(const String& name, const Mat4x4& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_MAT4X4F); }
+		void set_layout(const ShaderParameterLayout* layout);
+		const ShaderParameterLayout& layout() const;
+
+		const PackedConstants& get_packed_constants() const;
+
+		void reset();
+
+		void set(ShaderParameterID id, s8 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_S8); }
+		void set(ShaderParameterID id, s16 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_S16); }
+		void set(ShaderParameterID id, s32 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_S32); }
+		void set(ShaderParameterID id, s64 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_S64); }
+		void set(ShaderParameterID id, u8 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_U8); }
+		void set(ShaderParameterID id, u16 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_U16); }
+		void set(ShaderParameterID id, u32 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_U32); }
+		void set(ShaderParameterID id, u64 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_U64); }
+		void set(ShaderParameterID id, f32 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_F32); }
+		void set(ShaderParameterID id, f64 val)				{ _set(id, val, ShaderParameter::PARAM_TYPE_F64); }
+		void set(ShaderParameterID id, bool val)			{ _set(id, val, ShaderParameter::PARAM_TYPE_BOOL); }
+		void set(ShaderParameterID id, const Vec2F& val)	{ _set(id, val, ShaderParameter::PARAM_TYPE_VEC2F); }
+		void set(ShaderParameterID id, const Vec3F& val)	{ _set(id, val, ShaderParameter::PARAM_TYPE_VEC3F); }
+		void set(ShaderParameterID id, const Vec4F& val)	{ _set(id, val, ShaderParameter::PARAM_TYPE_VEC4F); }
+		void set(ShaderParameterID id, const Mat4x4& val)	{ _set(id, val, ShaderParameter::PARAM_TYPE_MAT4X4F); }
+
+		void set(const char* name, s8 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_S8); }
+		void set(const char* name, s16 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_S16); }
+		void set(const char* name, s32 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_S32); }
+		void set(const char* name, s64 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_S64); }
+		void set(const char* name, u8 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_U8); }
+		void set(const char* name, u16 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_U16); }
+		void set(const char* name, u32 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_U32); }
+		void set(const char* name, u64 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_U64); }
+		void set(const char* name, f32 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_F32); }
+		void set(const char* name, f64 val)					{ _set(name, val, ShaderParameter::PARAM_TYPE_F64); }
+		void set(const char* name, bool val)				{ _set(name, val, ShaderParameter::PARAM_TYPE_BOOL); }
+		void set(const char* name, const Vec2F& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_VEC2F); }
+		void set(const char* name, const Vec3F& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_VEC3F); }
+		void set(const char* name, const Vec4F& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_VEC4F); }
+//		void set(const char* name, const Basis3D& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_MAT3X3F); }
+		void set(const char* name, const Mat4x4& val)		{ _set(name, val, ShaderParameter::PARAM_TYPE_MAT4X4F); }
 
 	private:
+		// ids and types are checked in release builds too, as a bad one would otherwise write outside of the block
 		template <typename T>
-		void _set(const String& name, const T& val, ShaderParameter::ParameterType type)
+		void _set(ShaderParameterID id, const T& val, ShaderParameter::ParameterType type)
 		{
-			int i = 0;
+			if (!id.is_valid() || id.index >= layout().entry_count()) {
+				wvn_ERROR("[SHADER|DEBUG] Parameter id out of range.");
+				return;
+			}
 
-			for (; i <= m_constants.size(); i++) {
-				if (i == m_constants.size()) {
-					break;
-				}
+			const ShaderParameterLayout::Entry& entry = layout().entry(id);
 
-				if (m_constants[i].first == name) {
-					break;
-				}
+			if (entry.type != type) {
+				wvn_ERROR("[SHADER|DEBUG] Parameter written with a different type than it was declared with.");
+				return;
 			}
 
-			if (i < m_constants.size()) {
-				mem::copy(m_constants[i].second.data, &val, sizeof(T));
-			} else {
-				ShaderParameter p = {};
-				p.type = type;
-				mem::copy(p.data, &val, sizeof(T));
-				m_constants.push_back(Pair(name, p));
+			wvn_ASSERT(sizeof(T) <= ShaderParameter::type_alignment_offset(type), "[SHADER|DEBUG] Parameter value does not fit in its slot.");
+			wvn_ASSERT(entry.offset + sizeof(T) <= m_packed_constants.size(), "[SHADER|DEBUG] Parameter block is smaller than its layout.");
+
+			mem::copy(m_packed_constants.data() + entry.offset, &val, sizeof(T));
+		}
+
+		template <typename T>
+		void _set(const char* name, const T& val, ShaderParameter::ParameterType type)
+		{
+			ShaderParameterID id = find_or_declare(name, type);
+
+			if (!id.is_valid()) {
+				return;
 			}
 
-			m_dirty_constants = true;
+			_set(id, val, type);
 		}
 
-		void rebuild_packed_constant_data();
+		ShaderParameterID find_or_declare(const char* name, ShaderParameter::ParameterType type);
 
-		Vector<Pair<String, ShaderParameter>> m_constants; // the reason we don't use a hashmap here is because we need to PRESERVE THE ORDER of the elements! the hashmap inherently is unordered.
-		bool m_dirty_constants;
+		const ShaderParameterLayout* m_shared_layout;
+		ShaderParameterLayout m_implicit_layout;
 		PackedConstants m_packed_constants;
 	};
 
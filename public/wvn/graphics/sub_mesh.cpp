@@ -1,4 +1,5 @@
 #include <wvn/graphics/sub_mesh.h>
+#include <wvn/maths/calc.h>
 
 using namespace wvn;
 using namespace wvn::gfx;
@@ -10,6 +11,8 @@ SubMesh::SubMesh()
 	, m_index_buffer(nullptr)
 	, m_material(nullptr)
 	, m_parent(nullptr)
+	, m_bounds_min(Vec3F::zero())
+	, m_bounds_max(Vec3F::zero())
 {
 }
 
@@ -22,18 +25,20 @@ void SubMesh::build(const Vector<Vertex>& vtx, const Vector<u16>& idx)
 	m_vertices = vtx;
 	m_indices = idx;
 
-	m_vertex_buffer = GPUBufferMgr::get_singleton()->create_vertex_buffer(vtx.size());
-	m_index_buffer = GPUBufferMgr::get_singleton()->create_index_buffer(idx.size());
-
-	GPUBuffer* stage = GPUBufferMgr::get_singleton()->create_staging_buffer(vtx.size() * sizeof(Vertex) + idx.size() * sizeof(u16));
+	m_bounds_min = vtx.any() ? vtx[0].pos : Vec3F::zero();
+	m_bounds_max = m_bounds_min;
 
-	stage->read_data_from_memory(vtx.data(), vtx.size() * sizeof(Vertex), 0);
-	stage->read_data_from_memory(idx.data(), idx.size() * sizeof(u16), vtx.size() * sizeof(Vertex));
+	for (auto& v : vtx)
+	{
+		m_bounds_min = Vec3F(CalcF::min(m_bounds_min.x, v.pos.x), CalcF::min(m_bounds_min.y, v.pos.y), CalcF::min(m_bounds_min.z, v.pos.z));
+		m_bounds_max = Vec3F(CalcF::max(m_bounds_max.x, v.pos.x), CalcF::max(m_bounds_max.y, v.pos.y), CalcF::max(m_bounds_max.z, v.pos.z));
+	}
 
-	stage->write_to_buffer(m_vertex_buffer, vtx.size() * sizeof(Vertex), 0, 0);
-	stage->write_to_buffer(m_index_buffer, idx.size() * sizeof(u16), vtx.size() * sizeof(Vertex), 0);
+	m_vertex_buffer = GPUBufferMgr::get_singleton()->create_vertex_buffer(vtx.size());
+	m_index_buffer = GPUBufferMgr::get_singleton()->create_index_buffer(idx.size());
 
-	delete stage;
+	m_vertex_buffer->upload_data(vtx.data(), vtx.size() * sizeof(Vertex), 0);
+	m_index_buffer->upload_data(idx.data(), idx.size() * sizeof(u16), 0);
 }
 
 const Mesh* SubMesh::parent() const { return m_parent; }
@@ -54,3 +59,6 @@ Vector<u16>& SubMesh::indices() { return m_indices; }
 const Vector<u16>& SubMesh::indices() const { return m_indices; }
 
 u64 SubMesh::index_count() const { return m_indices.size(); }
+
+const Vec3F& SubMesh::bounds_min() const { return m_bounds_min; }
+const Vec3F& SubMesh::bounds_max() const { return m_bounds_max; }
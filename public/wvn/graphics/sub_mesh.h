@@ -46,6 +46,10 @@ namespace wvn::gfx
 
 		u64 index_count() const;
 
+		// local space bounding box, worked out once when the mesh is built
+		const Vec3F& bounds_min() const;
+		const Vec3F& bounds_max() const;
+
 	private:
 		const Mesh* m_parent;
 
@@ -55,6 +59,9 @@ namespace wvn::gfx
 		GPUBuffer* m_index_buffer;
 		Vector<Vertex> m_vertices;
 		Vector<u16> m_indices;
+
+		Vec3F m_bounds_min;
+		Vec3F m_bounds_max;
 	};
 }
 
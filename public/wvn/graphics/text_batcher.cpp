@@ -0,0 +1,261 @@
+#include <wvn/graphics/text_batcher.h>
+#include <wvn/graphics/gpu_buffer.h>
+#include <wvn/graphics/gpu_buffer_mgr.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+static constexpr u32 REPLACEMENT_CODEPOINT = 0xFFFD;
+static constexpr u64 MIN_QUAD_CAPACITY = 256;
+
+// malformed sequences come out as a single replacement character so a bad string can't stall the batcher
+static u32 decode_utf8(const char** str)
+{
+	const u8* s = (const u8*)(*str);
+
+	u32 codepoint = 0;
+	u32 length = 0;
+
+	if (s[0] < 0x80) {
+		codepoint = s[0];
+		length = 1;
+	} else if ((s[0] & 0xE0) == 0xC0) {
+		codepoint = s[0] & 0x1F;
+		length = 2;
+	} else if ((s[0] & 0xF0) == 0xE0) {
+		codepoint = s[0] & 0x0F;
+		length = 3;
+	} else if ((s[0] & 0xF8) == 0xF0) {
+		codepoint = s[0] & 0x07;
+		length = 4;
+	} else {
+		(*str)++;
+		return REPLACEMENT_CODEPOINT;
+	}
+
+	for (u32 i = 1; i < length; i++)
+	{
+		if ((s[i] & 0xC0) != 0x80) {
+			(*str) += i;
+			return REPLACEMENT_CODEPOINT;
+		}
+
+		codepoint = (codepoint << 6) | (s[i] & 0x3F);
+	}
+
+	(*str) += length;
+	return codepoint;
+}
+
+TextBatcher::TextBatcher(GlyphAtlas* atlas)
+	: m_atlas(atlas)
+	, m_page_vertices()
+	, m_page_buffers()
+	, m_buffer_set_idx(0)
+	, m_index_buffer(nullptr)
+	, m_batches()
+	, m_quad_count(0)
+	, m_dropped_glyph_count(0)
+{
+}
+
+// vertex & index buffers belong to the buffer manager and are released along with it
+TextBatcher::~TextBatcher()
+{
+}
+
+void TextBatcher::begin()
+{
+	for (auto& vertices : m_page_vertices) {
+		vertices.clear();
+	}
+
+	m_batches.clear();
+
+	m_quad_count = 0;
+	m_dropped_glyph_count = 0;
+}
+
+void TextBatcher::draw(const Font* font, const char* text, const Vec2F& position, float size, const DisplayColour& colour)
+{
+	if (!text) {
+		return;
+	}
+
+	const Font::Info& info = font->info();
+
+	float ratio = size / info.size;
+	float pixel_scale = font->scale() * ratio;
+	float line_height = (info.ascent - info.descent + info.line_gap) * pixel_scale;
+
+	Vec2F pen(position.x, position.y + (info.ascent * pixel_scale));
+	u32 prev_codepoint = 0;
+
+	for (const char* c = text; *c;)
+	{
+		u32 codepoint = decode_utf8(&c);
+
+		if (codepoint == '\n')
+		{
+			pen.x = position.x;
+			pen.y += line_height;
+			prev_codepoint = 0;
+			continue;
+		}
+
+		if (prev_codepoint) {
+			pen.x += font->kern_advance(prev_codepoint, codepoint) * ratio;
+		}
+
+		prev_codepoint = codepoint;
+
+		const GlyphAtlas::Glyph* glyph = m_atlas->get(font, codepoint);
+
+		if (!glyph)
+		{
+			pen.x += font->get_character(codepoint).advance_x * ratio;
+			m_dropped_glyph_count++;
+			continue;
+		}
+
+		if (glyph->page != GlyphAtlas::NO_PAGE)
+		{
+			if (m_page_vertices.size() <= glyph->page) {
+				m_page_vertices.resize(glyph->page + 1);
+			}
+
+			Vector<Vertex>& vertices = m_page_vertices[glyph->page];
+
+			u64 first = vertices.size();
+			vertices.resize(first + 4);
+
+			float x0 = pen.x + (glyph->offset.x * ratio);
+			float y0 = pen.y + (glyph->offset.y * ratio);
+			float x1 = x0 + (glyph->size.x * ratio);
+			float y1 = y0 + (glyph->size.y * ratio);
+
+			Vertex* quad = vertices.data() + first;
+
+			quad[0] = { .pos = Vec3F(x0, y0, 0.0f), .uv = Vec2F(glyph->uv0.x, glyph->uv0.y), .col = colour, .norm = Vec3F::backward() };
+			quad[1] = { .pos = Vec3F(x1, y0, 0.0f), .uv = Vec2F(glyph->uv1.x, glyph->uv0.y), .col = colour, .norm = Vec3F::backward() };
+			quad[2] = { .pos = Vec3F(x1, y1, 0.0f), .uv = Vec2F(glyph->uv1.x, glyph->uv1.y), .col = colour, .norm = Vec3F::backward() };
+			quad[3] = { .pos = Vec3F(x0, y1, 0.0f), .uv = Vec2F(glyph->uv0.x, glyph->uv1.y), .col = colour, .norm = Vec3F::backward() };
+
+			m_quad_count++;
+		}
+
+		pen.x += glyph->advance_x * ratio;
+	}
+}
+
+Vec2F TextBatcher::measure(const Font* font, const char* text, float size) const
+{
+	if (!text) {
+		return Vec2F::zero();
+	}
+
+	const Font::Info& info = font->info();
+
+	float ratio = size / info.size;
+	float line_height = (info.ascent - info.descent + info.line_gap) * font->scale() * ratio;
+
+	float width = 0.0f;
+	float line_width = 0.0f;
+	float height = line_height;
+	u32 prev_codepoint = 0;
+
+	for (const char* c = text; *c;)
+	{
+		u32 codepoint = decode_utf8(&c);
+
+		if (codepoint == '\n')
+		{
+			width = CalcF::max(width, line_width);
+			line_width = 0.0f;
+			height += line_height;
+			prev_codepoint = 0;
+			continue;
+		}
+
+		if (prev_codepoint) {
+			line_width += font->kern_advance(prev_codepoint, codepoint) * ratio;
+		}
+
+		line_width += font->get_character(codepoint).advance_x * ratio;
+		prev_codepoint = codepoint;
+	}
+
+	return Vec2F(CalcF::max(width, line_width), height);
+}
+
+void TextBatcher::end()
+{
+	// glyphs added while drawing have to reach the gpu before anything samples them
+	m_atlas->upload();
+
+	if (!m_index_buffer)
+	{
+		Vector<u16> indices(MAX_QUADS_PER_DRAW * 6);
+
+		for (u32 i = 0; i < MAX_QUADS_PER_DRAW; i++)
+		{
+			u16 base = i * 4;
+
+			indices[(i * 6) + 0] = base + 0;
+			indices[(i * 6) + 1] = base + 1;
+			indices[(i * 6) + 2] = base + 2;
+			indices[(i * 6) + 3] = base + 2;
+			indices[(i * 6) + 4] = base + 3;
+			indices[(i * 6) + 5] = base + 0;
+		}
+
+		m_index_buffer = GPUBufferMgr::get_singleton()->create_index_buffer(indices.size());
+		m_index_buffer->upload_data(indices.data(), sizeof(u16) * indices.size(), 0);
+	}
+
+	m_buffer_set_idx = (m_buffer_set_idx + 1) % BUFFER_SET_COUNT;
+	Vector<PageBuffer>& page_buffers = m_page_buffers[m_buffer_set_idx];
+
+	for (u32 page = 0; page < m_page_vertices.size(); page++)
+	{
+		const Vector<Vertex>& vertices = m_page_vertices[page];
+		u64 quad_count = vertices.size() / 4;
+
+		if (quad_count == 0) {
+			continue;
+		}
+
+		while (page_buffers.size() <= page) {
+			page_buffers.push_back({ .vertex_buffer = nullptr, .quad_capacity = 0 });
+		}
+
+		PageBuffer& buffer = page_buffers[page];
+
+		// grow geometrically so a slowly rising amount of text doesn't recreate the buffer every frame
+		if (quad_count > buffer.quad_capacity || !buffer.vertex_buffer)
+		{
+			// the old one may still be read by the frame that last used this set
+			GPUBufferMgr::get_singleton()->destroy_buffer(buffer.vertex_buffer);
+
+			buffer.quad_capacity = CalcU::max(quad_count * 2, MIN_QUAD_CAPACITY);
+			buffer.vertex_buffer = GPUBufferMgr::get_singleton()->create_vertex_buffer(buffer.quad_capacity * 4);
+		}
+
+		buffer.vertex_buffer->upload_data(vertices.data(), sizeof(Vertex) * vertices.size(), 0);
+
+		m_batches.push_back({
+			.texture = m_atlas->page_texture(page),
+			.vertex_buffer = buffer.vertex_buffer,
+			.quad_count = (u32)quad_count
+		});
+	}
+}
+
+const Vector<TextBatch>& TextBatcher::batches() const { return m_batches; }
+GPUBuffer* TextBatcher::index_buffer() const { return m_index_buffer; }
+
+u64 TextBatcher::quad_count() const { return m_quad_count; }
+u64 TextBatcher::dropped_glyph_count() const { return m_dropped_glyph_count; }
+
+const Vector<Vertex>& TextBatcher::page_vertices(u32 page) const { return m_page_vertices[page]; }
@@ -0,0 +1,83 @@
+#ifndef TEXT_BATCHER_H_
+#define TEXT_BATCHER_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/maths/vec2.h>
+#include <wvn/maths/colour.h>
+#include <wvn/graphics/vertex.h>
+#include <wvn/graphics/glyph_atlas.h>
+
+namespace wvn::gfx
+{
+	class Texture;
+	class GPUBuffer;
+
+	/**
+	 * Every glyph drawn from one atlas page during a frame, as quads in a single vertex buffer.
+	 * Quads are drawn with the batcher's shared index buffer, at most MAX_QUADS_PER_DRAW per draw call.
+	 */
+	struct TextBatch
+	{
+		Texture* texture;
+		GPUBuffer* vertex_buffer;
+		u32 quad_count;
+	};
+
+	/**
+	 * Collects text drawn during a frame and builds one vertex buffer per atlas page out of it.
+	 * Positions are in pixels with y going down, text is placed with the top of its first line at the given position.
+	 * The atlas has to have begin_frame() called on it once per frame before any batcher using it begins.
+	 */
+	class TextBatcher
+	{
+		struct PageBuffer
+		{
+			GPUBuffer* vertex_buffer;
+			u64 quad_capacity;
+		};
+
+	public:
+		// one set of vertex buffers per frame in flight so the cpu never writes into one the gpu is reading
+		constexpr static u32 BUFFER_SET_COUNT = 3;
+
+		// indices are 16 bit
+		constexpr static u32 MAX_QUADS_PER_DRAW = 65536 / 4;
+
+		TextBatcher(GlyphAtlas* atlas);
+		~TextBatcher();
+
+		void begin();
+		void end();
+
+		// text is utf-8, size is the pixel height to draw it at
+		void draw(const Font* font, const char* text, const Vec2F& position, float size, const DisplayColour& colour);
+
+		Vec2F measure(const Font* font, const char* text, float size) const;
+
+		const Vector<TextBatch>& batches() const;
+		GPUBuffer* index_buffer() const;
+
+		// quads built since begin(), and glyphs skipped because the atlas had no room left for them
+		u64 quad_count() const;
+		u64 dropped_glyph_count() const;
+
+		// cpu side quads for one page, valid until the next begin()
+		const Vector<Vertex>& page_vertices(u32 page) const;
+
+	private:
+		GlyphAtlas* m_atlas;
+
+		Vector<Vector<Vertex>> m_page_vertices; // indexed by atlas page
+		Vector<PageBuffer> m_page_buffers[BUFFER_SET_COUNT];
+		u32 m_buffer_set_idx;
+
+		GPUBuffer* m_index_buffer;
+		Vector<TextBatch> m_batches;
+
+		u64 m_quad_count;
+		u64 m_dropped_glyph_count;
+	};
+}
+
+#endif // TEXT_BATCHER_H_
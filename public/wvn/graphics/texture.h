@@ -141,6 +141,13 @@ namespace wvn::gfx
 		TEX_FORMAT_D32_SFLOAT_S8_UINT,
 		TEX_FORMAT_D24_UNORM_S8_UINT,
 		TEX_FORMAT_S8_UINT,
+		TEX_FORMAT_BC1_RGBA_UNORM,
+		TEX_FORMAT_BC1_RGBA_SRGB,
+		TEX_FORMAT_BC3_UNORM,
+		TEX_FORMAT_BC3_SRGB,
+		TEX_FORMAT_BC5_UNORM,
+		TEX_FORMAT_BC7_UNORM,
+		TEX_FORMAT_BC7_SRGB,
 		TEX_FORMAT_MAX_ENUM
 	};
 
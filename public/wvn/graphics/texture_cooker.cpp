@@ -0,0 +1,455 @@
+#include <wvn/graphics/texture_cooker.h>
+#include <wvn/graphics/block_compression.h>
+#include <wvn/maths/calc.h>
+
+#include <thread>
+#include <chrono>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	struct SRGBTables
+	{
+		float to_linear[256];
+		u8 from_linear[4096];
+
+		SRGBTables()
+		{
+			for (u32 i = 0; i < 256; i++)
+			{
+				float c = (float)i / 255.0f;
+				to_linear[i] = (c <= 0.04045f) ? (c / 12.92f) : CalcF::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+
+			for (u32 i = 0; i < 4096; i++)
+			{
+				float c = (float)i / 4095.0f;
+				float s = (c <= 0.0031308f) ? (c * 12.92f) : ((1.055f * CalcF::pow(c, 1.0f / 2.4f)) - 0.055f);
+				from_linear[i] = (u8)CalcF::clamp(CalcF::floor((s * 255.0f) + 0.5f), 0.0f, 255.0f);
+			}
+		}
+	};
+
+	const SRGBTables& srgb_tables()
+	{
+		static SRGBTables tables;
+		return tables;
+	}
+
+	struct FilterTaps
+	{
+		s32 offsets[6];
+		float weights[6];
+		u32 count;
+	};
+
+	float bessel_i0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+
+		for (u32 k = 1; k < 16; k++)
+		{
+			term *= (x / (2.0f * k)) * (x / (2.0f * k));
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	float sinc(float x)
+	{
+		if (CalcF::abs(x) < 1e-5f) {
+			return 1.0f;
+		}
+
+		return CalcF::sin(CalcF::PI * x) / (CalcF::PI * x);
+	}
+
+	// taps around source texel 2x for a 2:1 reduction, the destination texel sits halfway between 2x and 2x+1
+	FilterTaps make_taps(TextureMipFilter filter, u32 src_size)
+	{
+		FilterTaps taps = {};
+
+		if (src_size <= 1)
+		{
+			taps.offsets[0] = 0;
+			taps.weights[0] = 1.0f;
+			taps.count = 1;
+			return taps;
+		}
+
+		if (filter == TEX_MIP_FILTER_BOX)
+		{
+			taps.offsets[0] = 0;
+			taps.offsets[1] = 1;
+			taps.weights[0] = 0.5f;
+			taps.weights[1] = 0.5f;
+			taps.count = 2;
+			return taps;
+		}
+
+		// kaiser windowed sinc, wide enough to reach three texels either side
+		const float alpha = 4.0f;
+		const float radius = 3.0f;
+
+		float total = 0.0f;
+
+		for (u32 i = 0; i < 6; i++)
+		{
+			float t = (float)((s32)i - 2) - 0.5f;
+			float x = t / radius;
+
+			taps.offsets[i] = (s32)i - 2;
+			taps.weights[i] = sinc(t * 0.5f) * (bessel_i0(alpha * CalcF::sqrt(1.0f - (x * x))) / bessel_i0(alpha));
+
+			total += taps.weights[i];
+		}
+
+		for (u32 i = 0; i < 6; i++) {
+			taps.weights[i] /= total;
+		}
+
+		taps.count = 6;
+
+		return taps;
+	}
+
+	u32 resolve_thread_count(u32 thread_count)
+	{
+		if (thread_count == 0) {
+			thread_count = std::thread::hardware_concurrency();
+		}
+
+		return CalcU::max(thread_count, 1);
+	}
+
+	// splits [0, count) into one contiguous range per thread, the calling thread takes the first one
+	template <typename Fn>
+	void parallel_for(u32 count, u32 thread_count, const Fn& fn)
+	{
+		if (count == 0) {
+			return;
+		}
+
+		thread_count = CalcU::min(thread_count, count);
+
+		if (thread_count <= 1) {
+			fn(0, count);
+			return;
+		}
+
+		std::thread* workers = new std::thread[thread_count - 1];
+
+		for (u32 t = 1; t < thread_count; t++)
+		{
+			u32 begin = (count * t) / thread_count;
+			u32 end = (count * (t + 1)) / thread_count;
+
+			workers[t - 1] = std::thread([&fn, begin, end]() { fn(begin, end); });
+		}
+
+		fn(0, count / thread_count);
+
+		for (u32 t = 0; t < thread_count - 1; t++) {
+			workers[t].join();
+		}
+
+		delete[] workers;
+	}
+
+	void downsample(const Vector<float>& src, u32 src_width, u32 src_height, Vector<float>* dst, u32 dst_width, u32 dst_height, TextureMipFilter filter, u32 thread_count)
+	{
+		FilterTaps h_taps = make_taps(filter, src_width);
+		FilterTaps v_taps = make_taps(filter, src_height);
+
+		u32 h_step = src_width > 1 ? 2 : 1;
+		u32 v_step = src_height > 1 ? 2 : 1;
+
+		Vector<float> tmp(dst_width * src_height * 4);
+		dst->resize(dst_width * dst_height * 4);
+
+		parallel_for(src_height, thread_count, [&](u32 begin, u32 end)
+		{
+			for (u32 y = begin; y < end; y++)
+			{
+				for (u32 x = 0; x < dst_width; x++)
+				{
+					float sum[4] = {};
+
+					for (u32 i = 0; i < h_taps.count; i++)
+					{
+						s32 sx = CalcI::clamp((s32)(x * h_step) + h_taps.offsets[i], 0, (s32)src_width - 1);
+						const float* texel = &src[((y * src_width) + sx) * 4];
+
+						for (u32 c = 0; c < 4; c++) {
+							sum[c] += texel[c] * h_taps.weights[i];
+						}
+					}
+
+					mem::copy(&tmp[((y * dst_width) + x) * 4], sum, sizeof(sum));
+				}
+			}
+		});
+
+		parallel_for(dst_height, thread_count, [&](u32 begin, u32 end)
+		{
+			for (u32 y = begin; y < end; y++)
+			{
+				for (u32 x = 0; x < dst_width; x++)
+				{
+					float sum[4] = {};
+
+					for (u32 i = 0; i < v_taps.count; i++)
+					{
+						s32 sy = CalcI::clamp((s32)(y * v_step) + v_taps.offsets[i], 0, (s32)src_height - 1);
+						const float* texel = &tmp[((sy * dst_width) + x) * 4];
+
+						for (u32 c = 0; c < 4; c++) {
+							sum[c] += texel[c] * v_taps.weights[i];
+						}
+					}
+
+					// the sinc lobes can overshoot
+					for (u32 c = 0; c < 4; c++) {
+						(*dst)[(((y * dst_width) + x) * 4) + c] = CalcF::clamp(sum[c], 0.0f, 1.0f);
+					}
+				}
+			}
+		});
+	}
+
+	void to_colours(const Vector<float>& linear, bool srgb, Vector<Colour>* colours)
+	{
+		const SRGBTables& tables = srgb_tables();
+
+		colours->resize(linear.size() / 4);
+
+		for (u64 i = 0; i < colours->size(); i++)
+		{
+			const float* texel = &linear[i * 4];
+			u8 rgb[3];
+
+			for (u32 c = 0; c < 3; c++) {
+				rgb[c] = srgb
+					? tables.from_linear[(u32)((texel[c] * 4095.0f) + 0.5f)]
+					: (u8)((texel[c] * 255.0f) + 0.5f);
+			}
+
+			(*colours)[i] = Colour(rgb[0], rgb[1], rgb[2], (u8)((texel[3] * 255.0f) + 0.5f));
+		}
+	}
+
+	bool is_srgb(TextureFormat format)
+	{
+		return format == TEX_FORMAT_BC1_RGBA_SRGB || format == TEX_FORMAT_BC3_SRGB || format == TEX_FORMAT_BC7_SRGB;
+	}
+}
+
+TextureCooker::TextureCooker()
+	: m_stats()
+{
+}
+
+TextureCooker::~TextureCooker()
+{
+}
+
+bool TextureCooker::cook(const Image& image, const TextureCookSettings& settings, CookedTexture* output)
+{
+	if (!bc::is_block_compressed(settings.format)) {
+		wvn_ERROR("[GFX:TEXTURE COOKER|DEBUG] Can only cook into block compressed formats, got: %d", settings.format);
+		return false;
+	}
+
+	m_stats = {};
+
+	u32 thread_count = resolve_thread_count(settings.thread_count);
+
+	auto mip_start = std::chrono::steady_clock::now();
+
+	Vector<Vector<Colour>> mips;
+
+	if (settings.generate_mips) {
+		generate_mips(image, settings.mip_filter, is_srgb(settings.format), thread_count, &mips);
+	} else {
+		mips.push_back(Vector<Colour>((Colour*)image.pixels(), image.width() * image.height()));
+	}
+
+	auto encode_start = std::chrono::steady_clock::now();
+
+	output->init(settings.format, image.width(), image.height());
+
+	Vector<byte> encoded;
+	u64 texel_count = 0;
+
+	for (u32 i = 0; i < mips.size(); i++)
+	{
+		u32 width = CalcU::max(image.width() >> i, 1);
+		u32 height = CalcU::max(image.height() >> i, 1);
+
+		encoded.resize(bc::level_size(settings.format, width, height));
+		encode_level(settings.format, mips[i].data(), width, height, thread_count, encoded.data());
+
+		output->add_level(encoded.data(), encoded.size());
+
+		texel_count += (u64)width * height;
+	}
+
+	auto encode_end = std::chrono::steady_clock::now();
+
+	m_stats.mip_ms = std::chrono::duration<double, std::milli>(encode_start - mip_start).count();
+	m_stats.encode_ms = std::chrono::duration<double, std::milli>(encode_end - encode_start).count();
+	m_stats.megapixels_per_second = ((double)texel_count / 1000000.0) / CalcD::max(m_stats.encode_ms / 1000.0, 1e-9);
+
+	if (settings.measure_quality) {
+		m_stats.psnr = calc_psnr(settings.format, mips[0].data(), image.width(), image.height(), output->level_data(0));
+	}
+
+	return true;
+}
+
+const TextureCookStats& TextureCooker::stats() const
+{
+	return m_stats;
+}
+
+// filtering happens on floats in linear space the whole way down so
+// rounding errors don't pile up & dark / bright areas keep their brightness
+void TextureCooker::generate_mips(const Image& image, TextureMipFilter filter, bool srgb, u32 thread_count, Vector<Vector<Colour>>* mips)
+{
+	const SRGBTables& tables = srgb_tables();
+
+	thread_count = resolve_thread_count(thread_count);
+
+	u32 width = image.width();
+	u32 height = image.height();
+
+	Vector<float> level(width * height * 4);
+
+	for (u64 i = 0; i < (u64)width * height; i++)
+	{
+		const Colour& texel = image.pixels()[i];
+
+		for (u32 c = 0; c < 3; c++) {
+			level[(i * 4) + c] = srgb ? tables.to_linear[texel.data[c]] : texel.data[c] / 255.0f;
+		}
+
+		level[(i * 4) + 3] = texel.a / 255.0f;
+	}
+
+	mips->clear();
+	mips->push_back(Vector<Colour>((Colour*)image.pixels(), width * height));
+
+	Vector<float> next;
+
+	while (width > 1 || height > 1)
+	{
+		u32 next_width = CalcU::max(width >> 1, 1);
+		u32 next_height = CalcU::max(height >> 1, 1);
+
+		downsample(level, width, height, &next, next_width, next_height, filter, thread_count);
+
+		Vector<Colour> colours;
+		to_colours(next, srgb, &colours);
+		mips->push_back(colours);
+
+		level = next;
+		width = next_width;
+		height = next_height;
+	}
+}
+
+// texels outside of the level (for sizes that aren't a multiple of four) repeat the edge
+void TextureCooker::encode_level(TextureFormat format, const Colour* texels, u32 width, u32 height, u32 thread_count, byte* output)
+{
+	u32 blocks_x = (width + bc::BLOCK_DIM - 1) / bc::BLOCK_DIM;
+	u32 blocks_y = (height + bc::BLOCK_DIM - 1) / bc::BLOCK_DIM;
+	u32 block_size = bc::block_bytes(format);
+
+	parallel_for(blocks_y, resolve_thread_count(thread_count), [&](u32 begin, u32 end)
+	{
+		Colour block[bc::BLOCK_TEXELS];
+
+		for (u32 by = begin; by < end; by++)
+		{
+			for (u32 bx = 0; bx < blocks_x; bx++)
+			{
+				for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+				{
+					u32 x = CalcU::min((bx * bc::BLOCK_DIM) + (i % bc::BLOCK_DIM), width - 1);
+					u32 y = CalcU::min((by * bc::BLOCK_DIM) + (i / bc::BLOCK_DIM), height - 1);
+
+					block[i] = texels[(y * width) + x];
+				}
+
+				bc::encode_block(format, block, output + (((by * blocks_x) + bx) * block_size));
+			}
+		}
+	});
+}
+
+double TextureCooker::calc_psnr(TextureFormat format, const Colour* texels, u32 width, u32 height, const byte* encoded)
+{
+	u32 blocks_x = (width + bc::BLOCK_DIM - 1) / bc::BLOCK_DIM;
+	u32 blocks_y = (height + bc::BLOCK_DIM - 1) / bc::BLOCK_DIM;
+	u32 block_size = bc::block_bytes(format);
+
+	// only the channels the format actually stores, bc1 cuts out texels below half alpha entirely so their colour doesn't count
+	u32 channels = 4;
+	bool punch_through = false;
+
+	if (format == TEX_FORMAT_BC5_UNORM) {
+		channels = 2;
+	} else if (format == TEX_FORMAT_BC1_RGBA_UNORM || format == TEX_FORMAT_BC1_RGBA_SRGB) {
+		channels = 3;
+		punch_through = true;
+	}
+
+	double squared_error = 0.0;
+	u64 samples = 0;
+
+	Colour decoded[bc::BLOCK_TEXELS];
+
+	for (u32 by = 0; by < blocks_y; by++)
+	{
+		for (u32 bx = 0; bx < blocks_x; bx++)
+		{
+			bc::decode_block(format, encoded + (((by * blocks_x) + bx) * block_size), decoded);
+
+			for (u32 i = 0; i < bc::BLOCK_TEXELS; i++)
+			{
+				u32 x = (bx * bc::BLOCK_DIM) + (i % bc::BLOCK_DIM);
+				u32 y = (by * bc::BLOCK_DIM) + (i / bc::BLOCK_DIM);
+
+				if (x >= width || y >= height) {
+					continue;
+				}
+
+				const Colour& source = texels[(y * width) + x];
+
+				if (punch_through && source.a < 128) {
+					continue;
+				}
+
+				for (u32 c = 0; c < channels; c++)
+				{
+					double d = (double)source.data[c] - (double)decoded[i].data[c];
+					squared_error += d * d;
+				}
+
+				samples += channels;
+			}
+		}
+	}
+
+	double mse = squared_error / (double)CalcU::max(samples, 1);
+
+	if (mse <= 0.0) {
+		return 99.0;
+	}
+
+	return 10.0 * CalcD::log10((255.0 * 255.0) / mse);
+}
@@ -0,0 +1,61 @@
+#ifndef TEXTURE_COOKER_H_
+#define TEXTURE_COOKER_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/graphics/texture.h>
+#include <wvn/graphics/image.h>
+#include <wvn/graphics/cooked_texture.h>
+
+namespace wvn::gfx
+{
+	enum TextureMipFilter
+	{
+		TEX_MIP_FILTER_BOX,
+		TEX_MIP_FILTER_KAISER,
+		TEX_MIP_FILTER_MAX_ENUM
+	};
+
+	struct TextureCookSettings
+	{
+		TextureFormat format = TEX_FORMAT_BC7_SRGB;
+		TextureMipFilter mip_filter = TEX_MIP_FILTER_KAISER;
+		bool generate_mips = true;
+		bool measure_quality = true; // decode mip 0 again afterwards and compare it against the source
+		u32 thread_count = 0; // 0 = one per hardware thread
+	};
+
+	struct TextureCookStats
+	{
+		double mip_ms;
+		double encode_ms;
+		double megapixels_per_second; // encode throughput over every level
+		double psnr; // of mip 0 in db, 0 when not measured
+	};
+
+	/**
+	 * Offline texture processing, turns an image into a cooked texture with a full mip chain
+	 * that has been encoded into one of the BCn formats.
+	 * Mips are filtered in linear space for sRGB formats, levels are split up into rows of
+	 * blocks which are encoded on several threads at once.
+	 */
+	class TextureCooker
+	{
+	public:
+		TextureCooker();
+		~TextureCooker();
+
+		bool cook(const Image& image, const TextureCookSettings& settings, CookedTexture* output);
+
+		const TextureCookStats& stats() const;
+
+		static void generate_mips(const Image& image, TextureMipFilter filter, bool srgb, u32 thread_count, Vector<Vector<Colour>>* mips);
+		static void encode_level(TextureFormat format, const Colour* texels, u32 width, u32 height, u32 thread_count, byte* output);
+		static double calc_psnr(TextureFormat format, const Colour* texels, u32 width, u32 height, const byte* encoded);
+
+	private:
+		TextureCookStats m_stats;
+	};
+}
+
+#endif // TEXTURE_COOKER_H_
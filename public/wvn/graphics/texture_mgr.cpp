@@ -1,4 +1,5 @@
 #include <wvn/graphics/texture_mgr.h>
+#include <wvn/maths/calc.h>
 
 using namespace wvn;
 using namespace wvn::gfx;
@@ -8,6 +9,10 @@ wvn_IMPL_SINGLETON(TextureMgr);
 TextureMgr::TextureMgr()
 	: m_texture_cache()
 	, m_sampler_cache()
+	, m_streamer()
+	, m_streamed_textures()
+	, m_stream_ids()
+	, m_streaming_changes()
 {
 }
 
@@ -83,6 +88,154 @@ Texture* TextureMgr::register_cube_map(const String& name, TextureFormat format,
 	return texture;
 }
 
+Texture* TextureMgr::register_cooked_texture(const String& name, const CookedTexture& cooked)
+{
+	if (m_texture_cache.contains(name)) {
+		return m_texture_cache[name];
+	}
+
+	Vector<const byte*> levels(cooked.mip_count());
+	Vector<u64> level_sizes(cooked.mip_count());
+
+	for (u32 i = 0; i < cooked.mip_count(); i++)
+	{
+		levels[i] = cooked.level_data(i);
+		level_sizes[i] = cooked.level_size(i);
+	}
+
+	Texture* texture = create_from_levels(cooked.width(), cooked.height(), cooked.format(), levels.data(), level_sizes.data(), cooked.mip_count());
+
+	if (!texture) {
+		return nullptr;
+	}
+
+	m_texture_cache.insert(Pair(name, texture));
+
+	return texture;
+}
+
+// 2x2 box filter, odd edges just repeat their last row / column
+static void build_mip_chain(const Image& image, u32 mip_count, Vector<Vector<Colour>>* mips)
+{
+	mips->clear();
+	mips->push_back(Vector<Colour>((Colour*)image.pixels(), image.width() * image.height()));
+
+	u32 src_width = image.width();
+	u32 src_height = image.height();
+
+	for (u32 i = 1; i < mip_count; i++)
+	{
+		const Vector<Colour>& src = mips->back();
+
+		u32 dst_width = CalcU::max(src_width >> 1, 1);
+		u32 dst_height = CalcU::max(src_height >> 1, 1);
+
+		Vector<Colour> dst(dst_width * dst_height);
+
+		for (u32 y = 0; y < dst_height; y++)
+		{
+			u32 y0 = CalcU::min(y * 2, src_height - 1);
+			u32 y1 = CalcU::min((y * 2) + 1, src_height - 1);
+
+			for (u32 x = 0; x < dst_width; x++)
+			{
+				u32 x0 = CalcU::min(x * 2, src_width - 1);
+				u32 x1 = CalcU::min((x * 2) + 1, src_width - 1);
+
+				const Colour& a = src[(y0 * src_width) + x0];
+				const Colour& b = src[(y0 * src_width) + x1];
+				const Colour& c = src[(y1 * src_width) + x0];
+				const Colour& d = src[(y1 * src_width) + x1];
+
+				dst[(y * dst_width) + x] = Colour(
+					(a.r + b.r + c.r + d.r + 2) / 4,
+					(a.g + b.g + c.g + d.g + 2) / 4,
+					(a.b + b.b + c.b + d.b + 2) / 4,
+					(a.a + b.a + c.a + d.a + 2) / 4
+				);
+			}
+		}
+
+		mips->push_back(dst);
+
+		src_width = dst_width;
+		src_height = dst_height;
+	}
+}
+
+Texture* TextureMgr::register_streamed_texture(const String& name, const Image& image)
+{
+	if (m_texture_cache.contains(name)) {
+		return m_texture_cache[name];
+	}
+
+	TextureStreamID id = m_streamer.add(image.width(), image.height(), sizeof(Colour));
+
+	if (m_streamed_textures.size() < id) {
+		m_streamed_textures.resize(id);
+	}
+
+	StreamedTexture& streamed = m_streamed_textures[id - 1];
+	build_mip_chain(image, m_streamer.mip_count(id), &streamed.mips);
+
+	u32 mip = m_streamer.resident_mip(id);
+	const Vector<Colour>& pixels = streamed.mips[mip];
+
+	streamed.texture = create_streamed(
+		CalcU::max(image.width() >> mip, 1),
+		CalcU::max(image.height() >> mip, 1),
+		m_streamer.mip_count(id) - mip,
+		(const byte*)pixels.data(),
+		pixels.size() * sizeof(Colour)
+	);
+
+	m_stream_ids.insert(Pair((const Texture*)streamed.texture, id));
+	m_texture_cache.insert(Pair(name, streamed.texture));
+
+	return streamed.texture;
+}
+
+// assumes the texture is stretched once across whatever was drawn, so the mip needed is
+// however many times the texture has to be halved to end up as big as it is on screen
+void TextureMgr::report_texture_usage(const Texture* texture, float screen_size)
+{
+	if (!texture || !m_stream_ids.contains(texture)) {
+		return;
+	}
+
+	TextureStreamID id = m_stream_ids[texture];
+
+	float texture_size = (float)CalcU::max(m_streamer.width(id), m_streamer.height(id));
+	float mip = CalcF::log(texture_size / CalcF::max(screen_size, 1.0f)) / CalcF::log(2.0f);
+
+	m_streamer.request(id, (u32)CalcF::max(CalcF::floor(mip), 0.0f));
+}
+
+void TextureMgr::update_streaming()
+{
+	m_streamer.update(&m_streaming_changes);
+
+	for (auto& change : m_streaming_changes)
+	{
+		StreamedTexture& streamed = m_streamed_textures[change.id - 1];
+		const Vector<Colour>& pixels = streamed.mips[change.resident_mip];
+
+		update_streamed(
+			streamed.texture,
+			CalcU::max(m_streamer.width(change.id) >> change.resident_mip, 1),
+			CalcU::max(m_streamer.height(change.id) >> change.resident_mip, 1),
+			m_streamer.mip_count(change.id) - change.resident_mip,
+			(const byte*)pixels.data(),
+			pixels.size() * sizeof(Colour)
+		);
+	}
+}
+
+TextureStreamer& TextureMgr::streamer()
+{
+	return m_streamer;
+}
+
 TextureSampler* TextureMgr::get_sampler(const String& name)
 {
 	if (m_sampler_cache.contains(name)) {
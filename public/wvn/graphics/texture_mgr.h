@@ -8,6 +8,8 @@
 #include <wvn/container/string.h>
 #include <wvn/graphics/texture.h>
 #include <wvn/graphics/image.h>
+#include <wvn/graphics/texture_streamer.h>
+#include <wvn/graphics/cooked_texture.h>
 
 namespace wvn::gfx
 {
@@ -18,6 +20,12 @@ namespace wvn::gfx
 	{
 		wvn_DEF_SINGLETON(TextureMgr);
 
+		struct StreamedTexture
+		{
+			Texture* texture;
+			Vector<Vector<Colour>> mips; // full chain kept in system memory, mip 0 first
+		};
+
 	public:
 		TextureMgr();
 		virtual ~TextureMgr();
@@ -34,6 +42,26 @@ namespace wvn::gfx
 		virtual Texture* create_attachment(u32 width, u32 height, TextureFormat format, TextureTiling tiling) = 0;
 		virtual Texture* create_cube_map(TextureFormat format, const Image& right, const Image& left, const Image& top, const Image& bottom, const Image& front, const Image& back) = 0;
 
+		// replaces the contents of the whole texture, frames still in flight keep drawing with the old contents
+		virtual void update(Texture* texture, const byte* data, u64 size) = 0;
+
+		// cooked textures already carry their whole mip chain so they go straight to the gpu
+		Texture* register_cooked_texture(const String& name, const CookedTexture& cooked);
+
+		virtual Texture* create_from_levels(u32 width, u32 height, TextureFormat format, const byte* const* levels, const u64* level_sizes, u32 level_count) = 0;
+
+		// only the low detail mips are uploaded up front, the rest are streamed in as draws ask for them
+		Texture* register_streamed_texture(const String& name, const Image& image);
+
+		// should be called by anything that draws with a texture, screen_size is roughly how many pixels across it ended up
+		void report_texture_usage(const Texture* texture, float screen_size);
+		void update_streaming();
+
+		TextureStreamer& streamer();
+
+		virtual Texture* create_streamed(u32 width, u32 height, u32 mip_levels, const byte* data, u64 size) = 0;
+		virtual void update_streamed(Texture* texture, u32 width, u32 height, u32 mip_levels, const byte* data, u64 size) = 0;
+
 		TextureSampler* get_sampler(const String& name);
 		TextureSampler* register_sampler(const String& name, const TextureSampler::Style& style);
 		virtual TextureSampler* create_sampler(const TextureSampler::Style& style) = 0;
@@ -41,6 +69,11 @@ namespace wvn::gfx
 	private:
 		HashMap<String, Texture*> m_texture_cache;
 		HashMap<String, TextureSampler*> m_sampler_cache;
+
+		TextureStreamer m_streamer;
+		Vector<StreamedTexture> m_streamed_textures; // indexed by stream id - 1
+		HashMap<const Texture*, TextureStreamID> m_stream_ids;
+		Vector<TextureStreamingChange> m_streaming_changes;
 	};
 }
 #endif // TEXTURE_MGR_H_
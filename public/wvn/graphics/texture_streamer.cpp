@@ -0,0 +1,324 @@
+#include <wvn/graphics/texture_streamer.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+TextureStreamer::TextureStreamer()
+	: m_entries()
+	, m_free_ids()
+	, m_budget(256ull * 1024 * 1024)
+	, m_upload_limit(16ull * 1024 * 1024)
+	, m_resident_bytes(0)
+	, m_frame(1)
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+}
+
+TextureStreamID TextureStreamer::add(u32 width, u32 height, u32 bytes_per_pixel)
+{
+	Entry entry = {};
+	entry.width = width;
+	entry.height = height;
+	entry.bytes_per_pixel = bytes_per_pixel;
+	entry.mip_count = calc_mip_count(width, height);
+	entry.pinned_mip = entry.mip_count - 1;
+	entry.last_used_frame = m_frame;
+	entry.active = true;
+	entry.changed = false;
+
+	for (u32 i = 0; i < entry.mip_count; i++)
+	{
+		if (CalcU::max(width >> i, height >> i) <= MIN_RESIDENT_SIZE) {
+			entry.pinned_mip = i;
+			break;
+		}
+	}
+
+	entry.resident_mip = entry.pinned_mip;
+	entry.wanted_mip = entry.mip_count - 1;
+
+	// the pinned mips are resident from the start, even if that puts us over budget
+	m_resident_bytes += resident_size(entry);
+
+	if (m_free_ids.any())
+	{
+		TextureStreamID id = m_free_ids.back();
+		m_free_ids.pop_back();
+
+		get(id) = entry;
+		return id;
+	}
+
+	m_entries.push_back(entry);
+	return m_entries.size();
+}
+
+void TextureStreamer::remove(TextureStreamID id)
+{
+	Entry& entry = get(id);
+
+	if (!entry.active) {
+		return;
+	}
+
+	m_resident_bytes -= resident_size(entry);
+
+	entry.active = false;
+	m_free_ids.push_back(id);
+}
+
+void TextureStreamer::request(TextureStreamID id, u32 mip)
+{
+	Entry& entry = get(id);
+
+	entry.wanted_mip = CalcU::min(entry.wanted_mip, CalcU::min(mip, entry.mip_count - 1));
+	entry.last_used_frame = m_frame;
+}
+
+// works off the requests made since the last update, loads go to whichever mip is cheapest to bring in so
+// that every texture in view gets its low detail mips before any of them gets its full resolution one
+void TextureStreamer::update(Vector<TextureStreamingChange>* changes)
+{
+	changes->clear();
+
+	// the budget may have been lowered since the last update
+	make_room(0, NULL_ID);
+
+	Vector<bool> stalled(m_entries.size(), false);
+	u64 uploaded = 0;
+
+	while (true)
+	{
+		TextureStreamID best = NULL_ID;
+		u64 best_cost = 0;
+
+		for (u32 i = 0; i < m_entries.size(); i++)
+		{
+			const Entry& entry = m_entries[i];
+
+			if (!entry.active || stalled[i] || entry.last_used_frame != m_frame || entry.wanted_mip >= entry.resident_mip) {
+				continue;
+			}
+
+			u64 cost = next_mip_size(entry);
+
+			if (best == NULL_ID || cost < best_cost) {
+				best = i + 1;
+				best_cost = cost;
+			}
+		}
+
+		if (best == NULL_ID) {
+			break;
+		}
+
+		// always let at least one mip through, otherwise a mip bigger than the limit would never load
+		if (uploaded > 0 && uploaded + best_cost > m_upload_limit) {
+			break;
+		}
+
+		if (!make_room(best_cost, best)) {
+			stalled[best - 1] = true;
+			continue;
+		}
+
+		Entry& entry = get(best);
+		entry.resident_mip--;
+		entry.changed = true;
+
+		m_resident_bytes += best_cost;
+		uploaded += best_cost;
+	}
+
+	for (u32 i = 0; i < m_entries.size(); i++)
+	{
+		Entry& entry = m_entries[i];
+
+		if (entry.active && entry.changed) {
+			changes->push_back({ i + 1, entry.resident_mip });
+		}
+
+		entry.changed = false;
+		entry.wanted_mip = entry.mip_count - 1;
+	}
+
+	m_frame++;
+}
+
+void TextureStreamer::set_budget(u64 bytes)
+{
+	m_budget = bytes;
+}
+
+u64 TextureStreamer::budget() const
+{
+	return m_budget;
+}
+
+void TextureStreamer::set_upload_limit(u64 bytes_per_frame)
+{
+	m_upload_limit = bytes_per_frame;
+}
+
+u64 TextureStreamer::upload_limit() const
+{
+	return m_upload_limit;
+}
+
+u64 TextureStreamer::resident_bytes() const
+{
+	return m_resident_bytes;
+}
+
+u32 TextureStreamer::resident_mip(TextureStreamID id) const
+{
+	return get(id).resident_mip;
+}
+
+u32 TextureStreamer::mip_count(TextureStreamID id) const
+{
+	return get(id).mip_count;
+}
+
+u32 TextureStreamer::width(TextureStreamID id) const
+{
+	return get(id).width;
+}
+
+u32 TextureStreamer::height(TextureStreamID id) const
+{
+	return get(id).height;
+}
+
+u32 TextureStreamer::calc_mip_count(u32 width, u32 height)
+{
+	u32 size = CalcU::max(width, height);
+	u32 count = 1;
+
+	while (size > 1) {
+		size >>= 1;
+		count++;
+	}
+
+	return count;
+}
+
+u64 TextureStreamer::calc_mip_size(u32 width, u32 height, u32 bytes_per_pixel, u32 mip)
+{
+	return (u64)CalcU::max(width >> mip, 1) * (u64)CalcU::max(height >> mip, 1) * bytes_per_pixel;
+}
+
+// evicts mips until the given amount of bytes would fit in the budget.
+// when they can't be made to fit nothing is evicted, dropping detail for a load that then doesn't happen would be for nothing.
+// the budget being lowered (bytes = 0) is the exception, that still evicts as much as it can
+bool TextureStreamer::make_room(u64 bytes, TextureStreamID keep)
+{
+	if (bytes > 0 && m_resident_bytes + bytes > m_budget && (m_resident_bytes - evictable_bytes(keep)) + bytes > m_budget) {
+		return false;
+	}
+
+	while (m_resident_bytes + bytes > m_budget)
+	{
+		TextureStreamID victim = find_eviction_victim(keep);
+
+		if (victim == NULL_ID) {
+			return false;
+		}
+
+		Entry& entry = get(victim);
+
+		m_resident_bytes -= calc_mip_size(entry.width, entry.height, entry.bytes_per_pixel, entry.resident_mip);
+
+		entry.resident_mip++;
+		entry.changed = true;
+	}
+
+	return true;
+}
+
+// least recently used texture first, then textures that were used but hold more detail than they were asked for.
+// a texture that was used and only holds what it asked for is never evicted, so two textures can't keep swapping each other out
+TextureStreamID TextureStreamer::find_eviction_victim(TextureStreamID keep) const
+{
+	TextureStreamID unused = NULL_ID;
+	TextureStreamID over_resident = NULL_ID;
+
+	for (u32 i = 0; i < m_entries.size(); i++)
+	{
+		const Entry& entry = m_entries[i];
+		TextureStreamID id = i + 1;
+
+		if (!entry.active || id == keep || entry.resident_mip >= entry.pinned_mip) {
+			continue;
+		}
+
+		if (entry.last_used_frame != m_frame)
+		{
+			if (unused == NULL_ID || entry.last_used_frame < get(unused).last_used_frame) {
+				unused = id;
+			}
+		}
+		else if (entry.resident_mip < entry.wanted_mip)
+		{
+			if (over_resident == NULL_ID) {
+				over_resident = id;
+			}
+		}
+	}
+
+	return unused != NULL_ID ? unused : over_resident;
+}
+
+// everything find_eviction_victim() would hand out if it were called until it ran dry
+u64 TextureStreamer::evictable_bytes(TextureStreamID keep) const
+{
+	u64 bytes = 0;
+
+	for (u32 i = 0; i < m_entries.size(); i++)
+	{
+		const Entry& entry = m_entries[i];
+
+		if (!entry.active || i + 1 == keep) {
+			continue;
+		}
+
+		// unused textures go all the way down to their pinned mip, used ones only down to the one they asked for
+		u32 floor_mip = entry.last_used_frame != m_frame ? entry.pinned_mip : CalcU::min(entry.wanted_mip, entry.pinned_mip);
+
+		for (u32 mip = entry.resident_mip; mip < floor_mip; mip++) {
+			bytes += calc_mip_size(entry.width, entry.height, entry.bytes_per_pixel, mip);
+		}
+	}
+
+	return bytes;
+}
+
+u64 TextureStreamer::resident_size(const Entry& entry) const
+{
+	u64 size = 0;
+
+	for (u32 i = entry.resident_mip; i < entry.mip_count; i++) {
+		size += calc_mip_size(entry.width, entry.height, entry.bytes_per_pixel, i);
+	}
+
+	return size;
+}
+
+u64 TextureStreamer::next_mip_size(const Entry& entry) const
+{
+	return calc_mip_size(entry.width, entry.height, entry.bytes_per_pixel, entry.resident_mip - 1);
+}
+
+TextureStreamer::Entry& TextureStreamer::get(TextureStreamID id)
+{
+	return m_entries[id - 1];
+}
+
+const TextureStreamer::Entry& TextureStreamer::get(TextureStreamID id) const
+{
+	return m_entries[id - 1];
+}
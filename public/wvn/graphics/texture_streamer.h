@@ -0,0 +1,94 @@
+#ifndef TEXTURE_STREAMER_H_
+#define TEXTURE_STREAMER_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+
+namespace wvn::gfx
+{
+	using TextureStreamID = u32;
+
+	/**
+	 * A texture whose resident mip range has to change, everything from resident_mip down to the smallest mip should be on the gpu.
+	 */
+	struct TextureStreamingChange
+	{
+		TextureStreamID id;
+		u32 resident_mip;
+	};
+
+	/**
+	 * Decides which mips of which textures should be resident on the gpu.
+	 * Every texture always keeps its smallest mips resident, larger ones are streamed in one at a time (cheapest
+	 * first) as draws ask for them and the least recently used ones are evicted again once the budget runs out.
+	 * Knows nothing about the gpu, it only hands back the changes that have to be made.
+	 */
+	class TextureStreamer
+	{
+		struct Entry
+		{
+			u32 width;
+			u32 height;
+			u32 bytes_per_pixel;
+			u32 mip_count;
+			u32 pinned_mip; // this one and all smaller mips are never evicted
+			u32 resident_mip;
+			u32 wanted_mip; // most detailed mip asked for during the current frame
+			u64 last_used_frame;
+			bool active;
+			bool changed;
+		};
+
+	public:
+		static constexpr TextureStreamID NULL_ID = 0;
+		static constexpr u32 MIN_RESIDENT_SIZE = 64;
+
+		TextureStreamer();
+		~TextureStreamer();
+
+		TextureStreamID add(u32 width, u32 height, u32 bytes_per_pixel);
+		void remove(TextureStreamID id);
+
+		// usage feedback, the texture was drawn at a size that needs this mip
+		void request(TextureStreamID id, u32 mip);
+
+		void update(Vector<TextureStreamingChange>* changes);
+
+		void set_budget(u64 bytes);
+		u64 budget() const;
+
+		void set_upload_limit(u64 bytes_per_frame);
+		u64 upload_limit() const;
+
+		u64 resident_bytes() const;
+
+		u32 resident_mip(TextureStreamID id) const;
+		u32 mip_count(TextureStreamID id) const;
+		u32 width(TextureStreamID id) const;
+		u32 height(TextureStreamID id) const;
+
+		static u32 calc_mip_count(u32 width, u32 height);
+		static u64 calc_mip_size(u32 width, u32 height, u32 bytes_per_pixel, u32 mip);
+
+	private:
+		bool make_room(u64 bytes, TextureStreamID keep);
+		TextureStreamID find_eviction_victim(TextureStreamID keep) const;
+		u64 evictable_bytes(TextureStreamID keep) const;
+
+		u64 resident_size(const Entry& entry) const;
+		u64 next_mip_size(const Entry& entry) const;
+
+		Entry& get(TextureStreamID id);
+		const Entry& get(TextureStreamID id) const;
+
+		Vector<Entry> m_entries; // indexed by id - 1, removed entries are just marked inactive
+		Vector<TextureStreamID> m_free_ids;
+
+		u64 m_budget;
+		u64 m_upload_limit;
+		u64 m_resident_bytes;
+		u64 m_frame;
+	};
+}
+
+#endif // TEXTURE_STREAMER_H_
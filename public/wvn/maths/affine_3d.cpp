@@ -2,6 +2,7 @@
 #include <wvn/maths/mat4x4.h>
 #include <wvn/maths/quat.h>
 #include <wvn/maths/vec3.h>
+#include <wvn/maths/simd.h>
 
 using namespace wvn;
 
@@ -11,12 +12,6 @@ Affine3D::Affine3D()
 {
 }
 
-Affine3D::Affine3D(const Affine3D& other)
-	: basis(other.basis)
-	, origin(other.origin)
-{
-}
-
 Affine3D::Affine3D(float diag)
 	: basis(diag)
 	, origin(0.0f, 0.0f, 0.0f)
@@ -108,6 +103,8 @@ Affine3D Affine3D::create_translation(float x, float y, float z)
 	);
 }
 
+// same as translate(-origin) * scale * rotate * translate(position), but built directly instead of through three full products
+// a zero scale or rotation is skipped, as if it were the identity
 Affine3D Affine3D::create_transform(
 	const Vec3F& position,
 	const Quat& quat,
@@ -115,25 +112,23 @@ Affine3D Affine3D::create_transform(
 	const Vec3F& origin
 )
 {
-	Affine3D mat = Affine3D::identity();
-
-	if (origin != Vec3F::zero()) {
-		mat *= create_translation(-origin);
-	}
+	Vec3F s = (scale != Vec3F::zero()) ? scale : Vec3F::one();
+	Basis3D rotation = (quat != Quat::zero()) ? Basis3D::create_rotation(quat) : Basis3D::identity();
 
-	if (scale != Vec3F::zero()) {
-		mat *= create_scale(scale);
-	}
-
-	if (quat != Quat::zero()) {
-		mat *= create_rotation(quat);
-	}
+	// scaling first multiplies each row of the rotation by one component of the scale
+	Basis3D basis = rotation;
 
-	if (position != Vec3F::zero()) {
-		mat *= create_translation(position);
+	for (int i = 0; i < 9; i += 3)
+	{
+		basis.data[i + 0] *= s.x;
+		basis.data[i + 1] *= s.y;
+		basis.data[i + 2] *= s.z;
 	}
 
-	return mat;
+	return Affine3D(
+		basis,
+		Basis3D::transform(-origin * s, rotation) + position
+	);
 }
 
 float Affine3D::determinant() const
@@ -147,7 +142,7 @@ Affine3D Affine3D::inverse() const
 
 	return Affine3D(
 		inv,
-		Basis3D::transform(origin, inv)
+		-Basis3D::transform(origin, inv)
 	);
 }
 
@@ -167,12 +162,31 @@ Affine3D Affine3D::operator + (const Affine3D& other) const
 	);
 }
 
+// the columns are three floats apart, so each load picks up the first element of the next column (or origin.x) as a fourth lane
+// that lane is never used, storing the columns back in order overwrites it and origin is written last
 Affine3D Affine3D::operator * (const Affine3D& other) const
 {
-	return Affine3D(
-		this->basis * other.basis,
-		Basis3D::transform(origin, other.basis) + other.origin
-	);
+	const float* a = basis.data;
+	const float* b = other.basis.data;
+
+	simd::Float4 a0 = simd::loadu(a + 0);
+	simd::Float4 a1 = simd::loadu(a + 3);
+	simd::Float4 a2 = simd::loadu(a + 6);
+
+	Affine3D result;
+
+	for (int i = 0; i < 9; i += 3)
+	{
+		simd::Float4 col = simd::mul(a0, simd::splat(b[i + 0]));
+		col = simd::madd(a1, simd::splat(b[i + 1]), col);
+		col = simd::madd(a2, simd::splat(b[i + 2]), col);
+
+		simd::storeu(result.basis.data + i, col);
+	}
+
+	result.origin = Basis3D::transform(origin, other.basis) + other.origin;
+
+	return result;
 }
 
 Affine3D Affine3D::operator * (float scalar) const
@@ -12,13 +12,13 @@ namespace wvn
 	/**
 	 * Affine 3D transformation matrix.
 	 */
-	struct Affine3D
+	struct alignas(16) Affine3D
 	{
 		Basis3D basis;
 		Vec3F origin;
 
 		Affine3D();
-		Affine3D(const Affine3D& other);
+		Affine3D(const Affine3D& other) = default;
 		Affine3D(float diag);
 		Affine3D(const Basis3D& basis, const Vec3F& origin);
 
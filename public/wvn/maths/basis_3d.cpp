@@ -13,13 +13,6 @@ Basis3D::Basis3D()
 {
 }
 
-Basis3D::Basis3D(const Basis3D& other)
-	: m11(other.m11), m12(other.m12), m13(other.m13)
-	, m21(other.m21), m22(other.m22), m23(other.m23)
-	, m31(other.m31), m32(other.m32), m33(other.m33)
-{
-}
-
 Basis3D::Basis3D(float diag)
 	: m11(diag), m12(0), m13(0)
 	, m21(0), m22(diag), m23(0)
@@ -29,7 +29,7 @@ namespace wvn
 		};
 
 		Basis3D();
-		Basis3D(const Basis3D& other);
+		Basis3D(const Basis3D& other) = default;
 		Basis3D(float diag);
 		Basis3D(
 			float m11, float m12, float m13,
@@ -0,0 +1,242 @@
+#include <wvn/maths/batch_ease.h>
+#include <wvn/maths/simd.h>
+
+using namespace wvn;
+
+// sin(x) for |x| up to a few hundred, reduced to [-pi/2, pi/2] around the nearest multiple of pi
+static simd::Float4 sin4(simd::Float4 x)
+{
+	// pi split in two so k * PI_HI is exact for any k that comes up here
+	constexpr float PI_HI = 3.140625f;
+	constexpr float PI_LO = 9.67653589793e-4f;
+
+	simd::Float4 k = simd::floor(simd::madd(x, simd::splat(1.0f / CalcF::PI), simd::splat(0.5f)));
+	simd::Float4 r = simd::sub(simd::sub(x, simd::mul(k, simd::splat(PI_HI))), simd::mul(k, simd::splat(PI_LO)));
+	simd::Float4 r2 = simd::mul(r, r);
+
+	// taylor series up to r^11, which is already under float precision at pi/2
+	simd::Float4 p = simd::splat(-1.0f / 39916800.0f);
+	p = simd::madd(p, r2, simd::splat(1.0f / 362880.0f));
+	p = simd::madd(p, r2, simd::splat(-1.0f / 5040.0f));
+	p = simd::madd(p, r2, simd::splat(1.0f / 120.0f));
+	p = simd::madd(p, r2, simd::splat(-1.0f / 6.0f));
+	p = simd::madd(simd::mul(p, r2), r, r);
+
+	// sin(r + k * pi) flips sign for odd k
+	simd::Float4 half = simd::mul(k, simd::splat(0.5f));
+	simd::Mask4 odd = simd::not_equal(simd::floor(half), half);
+
+	return simd::select(odd, simd::sub(simd::splat(0.0f), p), p);
+}
+
+static simd::Float4 cos4(simd::Float4 x)
+{
+	return sin4(simd::add(x, simd::splat(CalcF::PI * 0.5f)));
+}
+
+// 2^x as 2^round(x) * 2^fraction, with the fraction in [-0.5, 0.5] (coefficients from cephes' exp2f)
+static simd::Float4 exp2_4(simd::Float4 x)
+{
+	x = simd::max(simd::min(x, simd::splat(126.0f)), simd::splat(-126.0f));
+
+	simd::Float4 n = simd::floor(simd::add(x, simd::splat(0.5f)));
+	simd::Float4 f = simd::sub(x, n);
+
+	simd::Float4 p = simd::splat(1.535336188319500e-4f);
+	p = simd::madd(p, f, simd::splat(1.339887440266574e-3f));
+	p = simd::madd(p, f, simd::splat(9.618437357674640e-3f));
+	p = simd::madd(p, f, simd::splat(5.550332471162809e-2f));
+	p = simd::madd(p, f, simd::splat(2.402264791363012e-1f));
+	p = simd::madd(p, f, simd::splat(6.931472028550421e-1f));
+	p = simd::madd(p, f, simd::splat(1.0f));
+
+	return simd::mul(p, simd::pow2i(n));
+}
+
+// both halves get worked out for every lane, then the right one is picked
+static simd::Float4 in_out(simd::Float4 t, simd::Float4 in, simd::Float4 out)
+{
+	return simd::select(simd::less(t, simd::splat(0.5f)), in, out);
+}
+
+template <typename Fn>
+static void ease_loop(float* dst, const float* t, u64 count, Fn fn)
+{
+	u64 i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		simd::storeu(dst + i, fn(simd::loadu(t + i)));
+	}
+
+	if (i < count)
+	{
+		float tmp[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		for (u64 k = 0; i + k < count; k++) {
+			tmp[k] = t[i + k];
+		}
+
+		simd::storeu(tmp, fn(simd::loadu(tmp)));
+
+		for (u64 k = 0; i + k < count; k++) {
+			dst[i + k] = tmp[k];
+		}
+	}
+}
+
+void batch::ease(float* dst, const float* t, u64 count, EaseType type)
+{
+	using namespace simd;
+
+	const Float4 zero = splat(0.0f);
+	const Float4 one = splat(1.0f);
+	const Float4 two = splat(2.0f);
+	const Float4 half = splat(0.5f);
+	const Float4 elastic = splat(13.0f * CalcF::PI * 0.5f);
+
+	switch (type)
+	{
+	case EASE_LINEAR:
+		if (dst != t) {
+			mem::copy(dst, t, sizeof(float) * count);
+		}
+		break;
+
+	case EASE_ELASTIC_IN:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return mul(sin4(mul(elastic, x)), exp2_4(mul(splat(10.0f), sub(x, one))));
+		});
+		break;
+
+	case EASE_ELASTIC_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 s = sin4(mul(sub(zero, elastic), add(x, one)));
+			return madd(s, exp2_4(mul(splat(-10.0f), x)), one);
+		});
+		break;
+
+	case EASE_ELASTIC_IN_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 u = mul(two, x);
+			Float4 e = mul(splat(10.0f), sub(u, one));
+			Float4 lo = mul(half, mul(sin4(mul(elastic, u)), exp2_4(e)));
+			Float4 hi = mul(half, madd(sin4(mul(sub(zero, elastic), u)), exp2_4(sub(zero, e)), two));
+			return in_out(x, lo, hi);
+		});
+		break;
+
+	case EASE_QUADRATIC_IN:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return mul(x, x);
+		});
+		break;
+
+	case EASE_QUADRATIC_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return mul(sub(zero, x), sub(x, two));
+		});
+		break;
+
+	case EASE_QUADRATIC_IN_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 x2 = mul(x, x);
+			Float4 lo = mul(two, x2);
+			Float4 hi = sub(madd(splat(4.0f), x, mul(splat(-2.0f), x2)), one);
+			return in_out(x, lo, hi);
+		});
+		break;
+
+	case EASE_SINE_IN:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return sub(one, cos4(mul(x, splat(CalcF::PI * 0.5f))));
+		});
+		break;
+
+	case EASE_SINE_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return sin4(mul(x, splat(CalcF::PI * 0.5f)));
+		});
+		break;
+
+	case EASE_SINE_IN_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return sub(half, mul(cos4(mul(x, splat(CalcF::PI))), half));
+		});
+		break;
+
+	case EASE_EXP_IN:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return exp2_4(mul(splat(10.0f), sub(x, one)));
+		});
+		break;
+
+	case EASE_EXP_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return sub(one, exp2_4(mul(splat(-10.0f), x)));
+		});
+		break;
+
+	case EASE_EXP_IN_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 e = mul(splat(10.0f), sub(mul(two, x), one));
+			Float4 lo = mul(exp2_4(e), half);
+			Float4 hi = mul(sub(two, exp2_4(sub(zero, e))), half);
+			return in_out(x, lo, hi);
+		});
+		break;
+
+	case EASE_BACK_IN:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 x2 = mul(x, x);
+			return sub(mul(splat(2.70158f), mul(x2, x)), mul(splat(1.70158f), x2));
+		});
+		break;
+
+	case EASE_BACK_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 u = sub(x, one);
+			Float4 u2 = mul(u, u);
+			return add(one, madd(splat(2.70158f), mul(u2, u), mul(splat(1.70158f), u2)));
+		});
+		break;
+
+	case EASE_BACK_IN_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 u = mul(two, x);
+			Float4 v = sub(u, two);
+			Float4 lo = mul(mul(mul(u, u), sub(mul(splat(3.5949095f), u), splat(2.5949095f))), half);
+			Float4 hi = mul(madd(mul(v, v), madd(splat(3.5949095f), v, splat(2.5949095f)), two), half);
+			return in_out(x, lo, hi);
+		});
+		break;
+
+	case EASE_CIRC_IN:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			return sub(one, sqrt(sub(one, mul(x, x))));
+		});
+		break;
+
+	case EASE_CIRC_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 u = sub(x, one);
+			return sqrt(sub(one, mul(u, u)));
+		});
+		break;
+
+	case EASE_CIRC_IN_OUT:
+		ease_loop(dst, t, count, [&](Float4 x) {
+			Float4 u = mul(two, x);
+			Float4 v = sub(two, u);
+
+			// the half that isn't picked takes the sqrt of a negative, clamp it rather than make nans
+			Float4 lo = mul(sub(one, sqrt(max(sub(one, mul(u, u)), zero))), half);
+			Float4 hi = mul(add(sqrt(max(sub(one, mul(v, v)), zero)), one), half);
+			return in_out(x, lo, hi);
+		});
+		break;
+
+	default:
+		wvn_ERROR("[BATCH EASE|DEBUG] Unknown ease type.");
+		break;
+	}
+}
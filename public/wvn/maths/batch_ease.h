@@ -0,0 +1,21 @@
+#ifndef BATCH_EASE_H_
+#define BATCH_EASE_H_
+
+#include <wvn/common.h>
+#include <wvn/maths/ease.h>
+
+namespace wvn
+{
+	namespace batch
+	{
+		/*
+		 * Ease<float>::evaluate() on a whole array, four values at a time.
+		 * sin() and pow() are replaced with polynomial approximations, so results can be a few ulps off the
+		 * single value version, which is far below anything that could be seen on screen.
+		 * dst can be the same array as t, but otherwise they must not overlap.
+		 */
+		void ease(float* dst, const float* t, u64 count, EaseType type);
+	}
+}
+
+#endif // BATCH_EASE_H_
@@ -0,0 +1,303 @@
+#include <wvn/maths/batch_transform.h>
+#include <wvn/maths/transform_3d.h>
+#include <wvn/maths/simd.h>
+
+#include <cstddef>
+
+using namespace wvn;
+
+static_assert(sizeof(Affine3D) == 12 * sizeof(float) && offsetof(Affine3D, origin) == 9 * sizeof(float), "Affine3D is expected to be twelve packed floats.");
+
+// rows of the basis (x, y & z get multiplied by one each) and the origin, with zero in the last lane
+struct AffineRows
+{
+	simd::Float4 r1;
+	simd::Float4 r2;
+	simd::Float4 r3;
+	simd::Float4 origin;
+};
+
+static AffineRows load_rows(const Affine3D& mat)
+{
+	const Basis3D& b = mat.basis;
+
+	return {
+		.r1 = simd::set(b.m11, b.m12, b.m13, 0.0f),
+		.r2 = simd::set(b.m21, b.m22, b.m23, 0.0f),
+		.r3 = simd::set(b.m31, b.m32, b.m33, 0.0f),
+		.origin = simd::set(mat.origin.x, mat.origin.y, mat.origin.z, 0.0f)
+	};
+}
+
+void batch::transform_points(Vec3F* dst, const Vec3F* src, u64 count, const Affine3D& mat)
+{
+	AffineRows rows = load_rows(mat);
+
+	for (u64 i = 0; i < count; i++)
+	{
+		simd::Float4 r = simd::mul(simd::splat(src[i].x), rows.r1);
+		r = simd::madd(simd::splat(src[i].y), rows.r2, r);
+		r = simd::madd(simd::splat(src[i].z), rows.r3, r);
+		r = simd::add(r, rows.origin);
+
+		// only three lanes, the next point might still need reading if this is in place
+		simd::store3(dst[i].data, r);
+	}
+}
+
+void batch::transform_points(
+	float* dst_x, float* dst_y, float* dst_z,
+	const float* src_x, const float* src_y, const float* src_z,
+	u64 count, const Affine3D& mat
+)
+{
+	const Basis3D& b = mat.basis;
+
+	simd::Float4 m11 = simd::splat(b.m11), m12 = simd::splat(b.m12), m13 = simd::splat(b.m13);
+	simd::Float4 m21 = simd::splat(b.m21), m22 = simd::splat(b.m22), m23 = simd::splat(b.m23);
+	simd::Float4 m31 = simd::splat(b.m31), m32 = simd::splat(b.m32), m33 = simd::splat(b.m33);
+	simd::Float4 ox = simd::splat(mat.origin.x), oy = simd::splat(mat.origin.y), oz = simd::splat(mat.origin.z);
+
+	u64 i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		simd::Float4 x = simd::loadu(src_x + i);
+		simd::Float4 y = simd::loadu(src_y + i);
+		simd::Float4 z = simd::loadu(src_z + i);
+
+		simd::storeu(dst_x + i, simd::add(simd::madd(z, m31, simd::madd(y, m21, simd::mul(x, m11))), ox));
+		simd::storeu(dst_y + i, simd::add(simd::madd(z, m32, simd::madd(y, m22, simd::mul(x, m12))), oy));
+		simd::storeu(dst_z + i, simd::add(simd::madd(z, m33, simd::madd(y, m23, simd::mul(x, m13))), oz));
+	}
+
+	for (; i < count; i++)
+	{
+		float x = src_x[i];
+		float y = src_y[i];
+		float z = src_z[i];
+
+		dst_x[i] = (x * b.m11) + (y * b.m21) + (z * b.m31) + mat.origin.x;
+		dst_y[i] = (x * b.m12) + (y * b.m22) + (z * b.m32) + mat.origin.y;
+		dst_z[i] = (x * b.m13) + (y * b.m23) + (z * b.m33) + mat.origin.z;
+	}
+}
+
+void batch::transform_points(Vec3F* dst, const Vec3F* src, u64 count, const Mat4x4& mat)
+{
+	simd::Float4 c1 = simd::load(mat.data + 0);
+	simd::Float4 c2 = simd::load(mat.data + 4);
+	simd::Float4 c3 = simd::load(mat.data + 8);
+	simd::Float4 c4 = simd::load(mat.data + 12);
+
+	for (u64 i = 0; i < count; i++)
+	{
+		simd::Float4 r = simd::mul(simd::splat(src[i].x), c1);
+		r = simd::madd(simd::splat(src[i].y), c2, r);
+		r = simd::madd(simd::splat(src[i].z), c3, r);
+		r = simd::add(r, c4);
+		r = simd::div(r, simd::broadcast<3>(r));
+
+		simd::store3(dst[i].data, r);
+	}
+}
+
+void batch::transform_vectors(Vec3F* dst, const Vec3F* src, u64 count, const Affine3D& mat)
+{
+	AffineRows rows = load_rows(mat);
+
+	for (u64 i = 0; i < count; i++)
+	{
+		simd::Float4 r = simd::mul(simd::splat(src[i].x), rows.r1);
+		r = simd::madd(simd::splat(src[i].y), rows.r2, r);
+		r = simd::madd(simd::splat(src[i].z), rows.r3, r);
+
+		simd::store3(dst[i].data, r);
+	}
+}
+
+// treats the origin as a fourth row of lhs, so each result column (plus one origin component in its last lane) is a single chain of multiply-adds
+static void multiply_one(float* dst, const float* a, const float* b)
+{
+	// columns of a with the matching origin component moved into the last lane
+	simd::Float4 o = simd::loadu(a + 8); // m33, origin.x, origin.y, origin.z
+	simd::Float4 a1 = simd::loadu(a + 0);
+	simd::Float4 a2 = simd::loadu(a + 3);
+	simd::Float4 a3 = simd::loadu(a + 6);
+
+	a1 = simd::shuffle<0, 1, 0, 2>(a1, simd::shuffle<2, 2, 1, 1>(a1, o));
+	a2 = simd::shuffle<0, 1, 0, 2>(a2, simd::shuffle<2, 2, 2, 2>(a2, o));
+	a3 = simd::shuffle<0, 1, 0, 2>(a3, simd::shuffle<2, 2, 3, 3>(a3, o));
+
+	simd::Float4 w = simd::set(0.0f, 0.0f, 0.0f, 1.0f);
+	simd::Float4 c[3];
+
+	for (int j = 0; j < 3; j++)
+	{
+		simd::Float4 col = simd::mul(a1, simd::splat(b[(j * 3) + 0]));
+		col = simd::madd(a2, simd::splat(b[(j * 3) + 1]), col);
+		col = simd::madd(a3, simd::splat(b[(j * 3) + 2]), col);
+		c[j] = simd::madd(w, simd::splat(b[9 + j]), col);
+	}
+
+	// everything is read by now so dst can be either input
+	// each store spills one float into the next column (or origin.x), which gets written properly afterwards
+	simd::storeu(dst + 0, c[0]);
+	simd::storeu(dst + 3, c[1]);
+	simd::storeu(dst + 6, c[2]);
+
+	dst[9] = simd::first(simd::broadcast<3>(c[0]));
+	dst[10] = simd::first(simd::broadcast<3>(c[1]));
+	dst[11] = simd::first(simd::broadcast<3>(c[2]));
+}
+
+void batch::multiply(Affine3D* dst, const Affine3D* lhs, const Affine3D* rhs, u64 count)
+{
+	for (u64 i = 0; i < count; i++) {
+		multiply_one((float*)&dst[i], (const float*)&lhs[i], (const float*)&rhs[i]);
+	}
+}
+
+void batch::multiply(Affine3D* dst, const Affine3D* lhs, const Affine3D& rhs, u64 count)
+{
+	// copied so writing to dst can't change it partway through if it happens to be one of the elements
+	Affine3D b = rhs;
+
+	for (u64 i = 0; i < count; i++) {
+		multiply_one((float*)&dst[i], (const float*)&lhs[i], (const float*)&b);
+	}
+}
+
+// builds four transforms at once, one per lane, from parameters that already have the zero scale & rotation cases replaced
+// only the first 'n' results are written
+static void create_transforms_4(Affine3D* dst, u64 n, const Vec3F* positions, const Quat* rotations, const Vec3F* scales, const Vec3F* origins)
+{
+	simd::Float4 qw = simd::load(rotations[0].data);
+	simd::Float4 qx = simd::load(rotations[1].data);
+	simd::Float4 qy = simd::load(rotations[2].data);
+	simd::Float4 qz = simd::load(rotations[3].data);
+	simd::transpose(qw, qx, qy, qz);
+
+	simd::Float4 sx = simd::set(scales[0].x, scales[1].x, scales[2].x, scales[3].x);
+	simd::Float4 sy = simd::set(scales[0].y, scales[1].y, scales[2].y, scales[3].y);
+	simd::Float4 sz = simd::set(scales[0].z, scales[1].z, scales[2].z, scales[3].z);
+
+	simd::Float4 one = simd::splat(1.0f);
+	simd::Float4 two = simd::splat(2.0f);
+
+	// Basis3D::create_rotation(), a lane at a time
+	simd::Float4 xx = simd::mul(qx, qx), yy = simd::mul(qy, qy), zz = simd::mul(qz, qz);
+	simd::Float4 xy = simd::mul(qx, qy), xz = simd::mul(qx, qz), yz = simd::mul(qy, qz);
+	simd::Float4 xw = simd::mul(qx, qw), yw = simd::mul(qy, qw), zw = simd::mul(qz, qw);
+
+	simd::Float4 r11 = simd::sub(one, simd::mul(two, simd::add(yy, zz)));
+	simd::Float4 r12 = simd::mul(two, simd::sub(xy, zw));
+	simd::Float4 r13 = simd::mul(two, simd::add(xz, yw));
+	simd::Float4 r21 = simd::mul(two, simd::add(xy, zw));
+	simd::Float4 r22 = simd::sub(one, simd::mul(two, simd::add(xx, zz)));
+	simd::Float4 r23 = simd::mul(two, simd::sub(yz, xw));
+	simd::Float4 r31 = simd::mul(two, simd::sub(xz, yw));
+	simd::Float4 r32 = simd::mul(two, simd::add(yz, xw));
+	simd::Float4 r33 = simd::sub(one, simd::mul(two, simd::add(xx, yy)));
+
+	// -origin * scale, taken through the unscaled rotation
+	simd::Float4 vx = simd::mul(simd::set(-origins[0].x, -origins[1].x, -origins[2].x, -origins[3].x), sx);
+	simd::Float4 vy = simd::mul(simd::set(-origins[0].y, -origins[1].y, -origins[2].y, -origins[3].y), sy);
+	simd::Float4 vz = simd::mul(simd::set(-origins[0].z, -origins[1].z, -origins[2].z, -origins[3].z), sz);
+
+	simd::Float4 px = simd::set(positions[0].x, positions[1].x, positions[2].x, positions[3].x);
+	simd::Float4 py = simd::set(positions[0].y, positions[1].y, positions[2].y, positions[3].y);
+	simd::Float4 pz = simd::set(positions[0].z, positions[1].z, positions[2].z, positions[3].z);
+
+	// in memory order: the basis column by column, then the origin
+	simd::Float4 out[12] = {
+		simd::mul(r11, sx), simd::mul(r21, sy), simd::mul(r31, sz),
+		simd::mul(r12, sx), simd::mul(r22, sy), simd::mul(r32, sz),
+		simd::mul(r13, sx), simd::mul(r23, sy), simd::mul(r33, sz),
+		simd::add(simd::madd(vz, r31, simd::madd(vy, r21, simd::mul(vx, r11))), px),
+		simd::add(simd::madd(vz, r32, simd::madd(vy, r22, simd::mul(vx, r12))), py),
+		simd::add(simd::madd(vz, r33, simd::madd(vy, r23, simd::mul(vx, r13))), pz)
+	};
+
+	// lanes to transforms
+	for (int k = 0; k < 12; k += 4) {
+		simd::transpose(out[k + 0], out[k + 1], out[k + 2], out[k + 3]);
+	}
+
+	for (u64 i = 0; i < n; i++)
+	{
+		float* result = (float*)&dst[i];
+
+		simd::store(result + 0, out[i + 0]);
+		simd::store(result + 4, out[i + 4]);
+		simd::store(result + 8, out[i + 8]);
+	}
+}
+
+void batch::create_transforms(
+	Affine3D* dst,
+	const Vec3F* positions, const Quat* rotations, const Vec3F* scales, const Vec3F* origins,
+	u64 count
+)
+{
+	Vec3F p[4], s[4], o[4];
+	Quat q[4];
+
+	for (u64 i = 0; i < count; i += 4)
+	{
+		u64 n = (count - i < 4) ? count - i : 4;
+
+		// unused lanes get harmless identity parameters
+		for (u64 k = 0; k < 4; k++)
+		{
+			bool used = k < n;
+
+			p[k] = used ? positions[i + k] : Vec3F::zero();
+			q[k] = (used && rotations[i + k] != Quat::zero()) ? rotations[i + k] : Quat::identity();
+			s[k] = (used && scales[i + k] != Vec3F::zero()) ? scales[i + k] : Vec3F::one();
+			o[k] = (used && origins) ? origins[i + k] : Vec3F::zero();
+		}
+
+		create_transforms_4(dst + i, n, p, q, s, o);
+	}
+}
+
+void batch::create_transforms(Affine3D* dst, const Transform3D* transforms, u64 count)
+{
+	Vec3F p[4], s[4], o[4];
+	Quat q[4];
+
+	for (u64 i = 0; i < count; i += 4)
+	{
+		u64 n = (count - i < 4) ? count - i : 4;
+
+		for (u64 k = 0; k < 4; k++)
+		{
+			if (k >= n)
+			{
+				p[k] = Vec3F::zero();
+				q[k] = Quat::identity();
+				s[k] = Vec3F::one();
+				o[k] = Vec3F::zero();
+				continue;
+			}
+
+			const Transform3D& transform = transforms[i + k];
+
+			p[k] = transform.position();
+			q[k] = transform.rotation();
+			s[k] = transform.scale();
+			o[k] = transform.origin();
+
+			if (q[k] == Quat::zero()) {
+				q[k] = Quat::identity();
+			}
+
+			if (s[k] == Vec3F::zero()) {
+				s[k] = Vec3F::one();
+			}
+		}
+
+		create_transforms_4(dst + i, n, p, q, s, o);
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef BATCH_TRANSFORM_H_
+#define BATCH_TRANSFORM_H_
+
+#include <wvn/common.h>
+#include <wvn/maths/vec3.h>
+#include <wvn/maths/quat.h>
+#include <wvn/maths/mat4x4.h>
+#include <wvn/maths/affine_3d.h>
+
+namespace wvn
+{
+	struct Transform3D;
+
+	/*
+	 * Array versions of the single value transforms, for anything that pushes lots of points or matrices through at once.
+	 * The results match calling the single value versions in a loop (bit for bit unless the compiler fuses multiply-adds).
+	 * dst can be the same array as a source, but otherwise they must not overlap.
+	 * Nothing here is shared between calls, so splitting an array into ranges and handing them to different threads is safe.
+	 */
+	namespace batch
+	{
+		// same as Affine3D::transform() on every point
+		void transform_points(Vec3F* dst, const Vec3F* src, u64 count, const Affine3D& mat);
+
+		// same as above with the coordinates stored in separate arrays
+		void transform_points(
+			float* dst_x, float* dst_y, float* dst_z,
+			const float* src_x, const float* src_y, const float* src_z,
+			u64 count, const Affine3D& mat
+		);
+
+		// mat * (x, y, z, 1) with the usual divide by w, for projection matrices
+		void transform_points(Vec3F* dst, const Vec3F* src, u64 count, const Mat4x4& mat);
+
+		// like transform_points() but ignores the translation, for directions and velocities
+		void transform_vectors(Vec3F* dst, const Vec3F* src, u64 count, const Affine3D& mat);
+
+		// dst[i] = lhs[i] * rhs[i]
+		void multiply(Affine3D* dst, const Affine3D* lhs, const Affine3D* rhs, u64 count);
+
+		// dst[i] = lhs[i] * rhs, e.g. a set of local transforms into their shared parent's space
+		void multiply(Affine3D* dst, const Affine3D* lhs, const Affine3D& rhs, u64 count);
+
+		// same as Affine3D::create_transform() on every set of parameters, origins can be nullptr if none of them have one
+		void create_transforms(
+			Affine3D* dst,
+			const Vec3F* positions, const Quat* rotations, const Vec3F* scales, const Vec3F* origins,
+			u64 count
+		);
+
+		// the matrices the transforms would give, without touching their cached ones
+		void create_transforms(Affine3D* dst, const Transform3D* transforms, u64 count);
+	}
+}
+
+#endif // BATCH_TRANSFORM_H_
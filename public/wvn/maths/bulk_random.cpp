@@ -0,0 +1,147 @@
+#include <wvn/maths/bulk_random.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace wvn;
+
+BulkRandom::BulkRandom(u64 seed, u64 stream)
+	: m_state()
+{
+	this->seed(seed, stream);
+}
+
+BulkRandom::~BulkRandom()
+{
+}
+
+void BulkRandom::seed(u64 seed, u64 stream)
+{
+	Xoshiro256 rng(seed, stream);
+
+	for (int lane = 0; lane < LANES; lane++)
+	{
+		for (int i = 0; i < 4; i++) {
+			m_state[i][lane] = rng.m_state[i];
+		}
+
+		rng.jump();
+	}
+}
+
+// xoshiro256** written out lane by lane with nothing crossing between lanes, so every loop vectorises
+// sse2 has no 64 bit multiply, but the ones here are by 5 & 9 and can be spelled out as shifts and adds
+static void next_block(u64 (&s)[4][BulkRandom::LANES], u64* dst)
+{
+	constexpr int LANES = BulkRandom::LANES;
+
+	for (int lane = 0; lane < LANES; lane++)
+	{
+		// * 5, rotate, * 9
+		u64 r = s[1][lane] + (s[1][lane] << 2);
+		r = (r << 7) | (r >> 57);
+		dst[lane] = r + (r << 3);
+	}
+
+	for (int lane = 0; lane < LANES; lane++)
+	{
+		u64 t = s[1][lane] << 17;
+
+		s[2][lane] ^= s[0][lane];
+		s[3][lane] ^= s[1][lane];
+		s[1][lane] ^= s[2][lane];
+		s[0][lane] ^= s[3][lane];
+		s[2][lane] ^= t;
+		s[3][lane] = (s[3][lane] << 45) | (s[3][lane] >> 19);
+	}
+}
+
+// each lane's result is used as two 32 bit values, low half first
+template <typename Fn>
+void BulkRandom::fill_generic(u64 count, Fn fn)
+{
+	// worked on in a local copy so the compiler knows nothing else can see it until the end
+	alignas(64) u64 state[4][LANES];
+	alignas(64) u64 block[LANES];
+
+	mem::copy(state, m_state, sizeof(state));
+
+	u64 i = 0;
+
+	for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE)
+	{
+		next_block(state, block);
+
+		for (int k = 0; k < LANES; k++)
+		{
+			fn(i + (k * 2) + 0, (u32)block[k]);
+			fn(i + (k * 2) + 1, (u32)(block[k] >> 32));
+		}
+	}
+
+	// whatever is left of the last block is thrown away
+	if (i < count)
+	{
+		next_block(state, block);
+
+		for (u64 k = 0; i + k < count; k++) {
+			fn(i + k, (u32)(block[k / 2] >> ((k & 1) * 32)));
+		}
+	}
+
+	mem::copy(m_state, state, sizeof(state));
+}
+
+void BulkRandom::fill(u32* dst, u64 count)
+{
+	fill_generic(count, [dst](u64 i, u32 bits) {
+		dst[i] = bits;
+	});
+}
+
+void BulkRandom::fill(float* dst, u64 count)
+{
+	fill_generic(count, [dst](u64 i, u32 bits) {
+		dst[i] = (float)(bits >> 8) * 0x1.0p-24f;
+	});
+}
+
+void BulkRandom::fill(float* dst, u64 count, float min, float max)
+{
+	wvn_ASSERT(min < max, "[BULK RANDOM|DEBUG] Min must be less than max.");
+
+	// a multiple of BLOCK_SIZE, so splitting the fill up doesn't change the sequence
+	constexpr u64 CHUNK_SIZE = 1024;
+
+	float range = max - min;
+
+	// min + u * range can round up to exactly max, those get pulled back to the float just below it.
+	// the clamp keeps the per-value lambda from vectorising, so it's done as a second pass while the chunk is still in cache
+	float below_max = std::nextafter(max, min);
+
+	for (u64 begin = 0; begin < count; begin += CHUNK_SIZE)
+	{
+		float* chunk = dst + begin;
+		u64 chunk_count = std::min(CHUNK_SIZE, count - begin);
+
+		fill(chunk, chunk_count);
+
+		for (u64 i = 0; i < chunk_count; i++) {
+			chunk[i] = std::min(min + (chunk[i] * range), below_max);
+		}
+	}
+}
+
+// multiply & keep the top half instead of a modulo, it's about as biased but needs no divide
+void BulkRandom::fill(int* dst, u64 count, int min, int max)
+{
+	wvn_ASSERT(min <= max, "[BULK RANDOM|DEBUG] Min must not be more than max.");
+
+	// everything is done in 64 bits, the span of the full int range doesn't fit in an int and neither do some of the sums
+	u64 range = (u64)((s64)max - (s64)min) + 1;
+	s64 base = min;
+
+	fill_generic(count, [dst, base, range](u64 i, u32 bits) {
+		dst[i] = (int)(base + (s64)(((u64)bits * range) >> 32));
+	});
+}
@@ -0,0 +1,49 @@
+#ifndef BULK_RANDOM_H_
+#define BULK_RANDOM_H_
+
+#include <wvn/common.h>
+#include <wvn/maths/random_engines.h>
+
+namespace wvn
+{
+	/**
+	 * Fills whole arrays with random numbers, from LANES xoshiro256** generators stepped side by side
+	 * so the compiler can keep them in vector registers. Each lane is one jump() further along than the last.
+	 * Different streams from the same seed are long_jump()s apart, so every worker thread can have its own
+	 * and the results don't depend on how the work ends up being split.
+	 */
+	class BulkRandom
+	{
+	public:
+		constexpr static int LANES = 8;
+
+		BulkRandom(u64 seed, u64 stream = 0);
+		~BulkRandom();
+
+		void seed(u64 seed, u64 stream = 0);
+
+		// raw bits
+		void fill(u32* dst, u64 count);
+
+		// [0, 1) with 24 bits of precision
+		void fill(float* dst, u64 count);
+
+		// [min, max), max itself never comes out even when rounding would land on it
+		void fill(float* dst, u64 count, float min, float max);
+
+		// [min, max], any range up to the full int one, the bias towards lower values is at most (max - min + 1) / 2^32
+		void fill(int* dst, u64 count, int min, int max);
+
+	private:
+		// two 32 bit results out of each lane
+		constexpr static int BLOCK_SIZE = LANES * 2;
+
+		template <typename Fn>
+		void fill_generic(u64 count, Fn fn);
+
+		// the four state words, each one for every lane side by side
+		alignas(64) u64 m_state[4][LANES];
+	};
+}
+
+#endif // BULK_RANDOM_H_
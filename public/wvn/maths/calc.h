@@ -86,7 +86,7 @@ namespace wvn
 	template <typename T>
 	T Calc<T>::mod(T x, T y)
 	{
-		return std::fmodf(x, y);
+		return std::fmod(x, y);
 	}
 
 	template <typename T>
@@ -192,7 +192,7 @@ namespace wvn
 	template <typename T>
 	bool Calc<T>::within_epsilon(T lhs, T rhs, T epsilon)
 	{
-		return std::fabsf(rhs - lhs) <= epsilon;
+		return std::fabs(rhs - lhs) <= epsilon;
 	}
 
 	template <typename T>
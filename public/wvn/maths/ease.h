@@ -1,12 +1,47 @@
 #ifndef EASE_H_
 #define EASE_H_
 
+#include <wvn/common.h>
 #include <wvn/maths/calc.h>
 
 // credit: equations taken from easings.net!
 
 namespace wvn
 {
+	/**
+	 * Picks one of the easing functions at runtime, for when it's stored as data.
+	 */
+	enum EaseType
+	{
+		EASE_LINEAR,
+
+		EASE_ELASTIC_IN,
+		EASE_ELASTIC_OUT,
+		EASE_ELASTIC_IN_OUT,
+
+		EASE_QUADRATIC_IN,
+		EASE_QUADRATIC_OUT,
+		EASE_QUADRATIC_IN_OUT,
+
+		EASE_SINE_IN,
+		EASE_SINE_OUT,
+		EASE_SINE_IN_OUT,
+
+		EASE_EXP_IN,
+		EASE_EXP_OUT,
+		EASE_EXP_IN_OUT,
+
+		EASE_BACK_IN,
+		EASE_BACK_OUT,
+		EASE_BACK_IN_OUT,
+
+		EASE_CIRC_IN,
+		EASE_CIRC_OUT,
+		EASE_CIRC_IN_OUT,
+
+		EASE_MAX_ENUM
+	};
+
 	/**
 	 * Generic utility functions for easing
 	 * from 0->1 over a time value 't'
@@ -40,6 +75,8 @@ namespace wvn
 		static T circ_in(T t);
 		static T circ_out(T t);
 		static T circ_in_out(T t);
+
+		static T evaluate(EaseType type, T t);
 	};
 
 	using EaseF   = Ease<float>;
@@ -94,7 +131,7 @@ namespace wvn
 			return 2.0 * t * t;
 		}
 
-		return 1.0 - (2.0 * t * t);
+		return (-2.0 * t * t) + (4.0 * t) - 1.0;
 	}
 
 	template <typename T>
@@ -134,7 +171,7 @@ namespace wvn
 			return Calc<T>::pow(2.0, 10.0 * ((2.0 * t) - 1.0)) * 0.5;
 		}
 
-		return -(Calc<T>::pow(2.0, -10.0 * ((2.0 * t) - 1.0)) + 2.0) * 0.5;
+		return (-Calc<T>::pow(2.0, -10.0 * ((2.0 * t) - 1.0)) + 2.0) * 0.5;
 	}
 
 	template <typename T>
@@ -180,6 +217,43 @@ namespace wvn
 
 		return (Calc<T>::sqrt(1 - Calc<T>::pow((-2.0 * t) + 2.0, 2.0)) + 1) * 0.5;
 	}
+
+	template <typename T>
+	T Ease<T>::evaluate(EaseType type, T t)
+	{
+		switch (type)
+		{
+		case EASE_LINEAR: return linear(t);
+
+		case EASE_ELASTIC_IN: return elastic_in(t);
+		case EASE_ELASTIC_OUT: return elastic_out(t);
+		case EASE_ELASTIC_IN_OUT: return elastic_in_out(t);
+
+		case EASE_QUADRATIC_IN: return quadratic_in(t);
+		case EASE_QUADRATIC_OUT: return quadratic_out(t);
+		case EASE_QUADRATIC_IN_OUT: return quadratic_in_out(t);
+
+		case EASE_SINE_IN: return sine_in(t);
+		case EASE_SINE_OUT: return sine_out(t);
+		case EASE_SINE_IN_OUT: return sine_in_out(t);
+
+		case EASE_EXP_IN: return exp_in(t);
+		case EASE_EXP_OUT: return exp_out(t);
+		case EASE_EXP_IN_OUT: return exp_in_out(t);
+
+		case EASE_BACK_IN: return back_in(t);
+		case EASE_BACK_OUT: return back_out(t);
+		case EASE_BACK_IN_OUT: return back_in_out(t);
+
+		case EASE_CIRC_IN: return circ_in(t);
+		case EASE_CIRC_OUT: return circ_out(t);
+		case EASE_CIRC_IN_OUT: return circ_in_out(t);
+
+		default:
+			wvn_ERROR("[EASE|DEBUG] Unknown ease type.");
+			return t;
+		}
+	}
 }
 
 #endif // EASE_H_
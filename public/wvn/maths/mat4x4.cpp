@@ -1,6 +1,7 @@
 #include <wvn/maths/mat4x4.h>
 #include <wvn/maths/vec3.h>
 #include <wvn/maths/calc.h>
+#include <wvn/maths/simd.h>
 
 // fixes the orthographic and perspective projections by flipping y-axis
 #include <wvn/root.h>
@@ -16,14 +17,6 @@ Mat4x4::Mat4x4()
 {
 }
 
-Mat4x4::Mat4x4(const Mat4x4& other)
-	: m11(other.m11), m12(other.m12), m13(other.m13), m14(other.m14)
-	, m21(other.m21), m22(other.m22), m23(other.m23), m24(other.m24)
-	, m31(other.m31), m32(other.m32), m33(other.m33), m34(other.m34)
-	, m41(other.m41), m42(other.m42), m43(other.m43), m44(other.m44)
-{
-}
-
 Mat4x4::Mat4x4(float diag)
 	: m11(diag), m12(0), m13(0), m14(0)
 	, m21(0), m22(diag), m23(0), m24(0)
@@ -209,127 +202,133 @@ float Mat4x4::determinant() const
 	);
 }
 
-Mat4x4 Mat4x4::inverse() const
+// 2x2 matrices packed as (m11, m12, m21, m22)
+static simd::Float4 mat2_mul(simd::Float4 a, simd::Float4 b)
 {
-	float A2323 = (this->m33 * this->m44) - (this->m34 * this->m43);
-	float A1323 = (this->m32 * this->m44) - (this->m34 * this->m42);
-	float A1223 = (this->m32 * this->m43) - (this->m33 * this->m42);
-	float A0323 = (this->m31 * this->m44) - (this->m34 * this->m41);
-	float A0223 = (this->m31 * this->m43) - (this->m33 * this->m41);
-	float A0123 = (this->m31 * this->m42) - (this->m32 * this->m41);
-	float A2313 = (this->m23 * this->m44) - (this->m24 * this->m43);
-	float A1313 = (this->m22 * this->m44) - (this->m24 * this->m42);
-	float A1213 = (this->m22 * this->m43) - (this->m23 * this->m42);
-	float A2312 = (this->m23 * this->m34) - (this->m24 * this->m33);
-	float A1312 = (this->m22 * this->m34) - (this->m24 * this->m32);
-	float A1212 = (this->m22 * this->m33) - (this->m23 * this->m32);
-	float A0313 = (this->m21 * this->m44) - (this->m24 * this->m41);
-	float A0213 = (this->m21 * this->m43) - (this->m23 * this->m41);
-	float A0312 = (this->m21 * this->m34) - (this->m24 * this->m31);
-	float A0212 = (this->m21 * this->m33) - (this->m23 * this->m31);
-	float A0113 = (this->m21 * this->m42) - (this->m22 * this->m41);
-	float A0112 = (this->m21 * this->m32) - (this->m22 * this->m31);
-
-	float inv_det = 1.0f / (
-		this->m11 * ((this->m22 * A2323) - (this->m23 * A1323) + (this->m24 * A1223)) -
-		this->m12 * ((this->m21 * A2323) - (this->m23 * A0323) + (this->m24 * A0223)) +
-		this->m13 * ((this->m21 * A1323) - (this->m22 * A0323) + (this->m24 * A0123)) -
-		this->m14 * ((this->m21 * A1223) - (this->m22 * A0223) + (this->m23 * A0123))
+	return simd::add(
+		simd::mul(a, simd::swizzle<0, 3, 0, 3>(b)),
+		simd::mul(simd::swizzle<1, 0, 3, 2>(a), simd::swizzle<2, 1, 2, 1>(b))
 	);
+}
 
-	return Mat4x4(
-		inv_det *   ((this->m22 * A2323) - (this->m23 * A1323) + (this->m24 * A1223)),
-		inv_det * - ((this->m12 * A2323) - (this->m13 * A1323) + (this->m14 * A1223)),
-		inv_det *   ((this->m12 * A2313) - (this->m13 * A1313) + (this->m14 * A1213)),
-		inv_det * - ((this->m12 * A2312) - (this->m13 * A1312) + (this->m14 * A1212)),
-		inv_det * - ((this->m21 * A2323) - (this->m23 * A0323) + (this->m24 * A0223)),
-		inv_det *   ((this->m11 * A2323) - (this->m13 * A0323) + (this->m14 * A0223)),
-		inv_det * - ((this->m11 * A2313) - (this->m13 * A0313) + (this->m14 * A0213)),
-		inv_det *   ((this->m11 * A2312) - (this->m13 * A0312) + (this->m14 * A0212)),
-		inv_det *   ((this->m21 * A1323) - (this->m22 * A0323) + (this->m24 * A0123)),
-		inv_det * - ((this->m11 * A1323) - (this->m12 * A0323) + (this->m14 * A0123)),
-		inv_det *   ((this->m11 * A1313) - (this->m12 * A0313) + (this->m14 * A0113)),
-		inv_det * - ((this->m11 * A1312) - (this->m12 * A0312) + (this->m14 * A0112)),
-		inv_det * - ((this->m21 * A1223) - (this->m22 * A0223) + (this->m23 * A0123)),
-		inv_det *   ((this->m11 * A1223) - (this->m12 * A0223) + (this->m13 * A0123)),
-		inv_det * - ((this->m11 * A1213) - (this->m12 * A0213) + (this->m13 * A0113)),
-		inv_det *   ((this->m11 * A1212) - (this->m12 * A0212) + (this->m13 * A0112))
+// adj(a) * b
+static simd::Float4 mat2_adj_mul(simd::Float4 a, simd::Float4 b)
+{
+	return simd::sub(
+		simd::mul(simd::swizzle<3, 3, 0, 0>(a), b),
+		simd::mul(simd::swizzle<1, 1, 2, 2>(a), simd::swizzle<2, 3, 0, 1>(b))
 	);
 }
 
-Mat4x4 Mat4x4::operator - (const Mat4x4& other) const
+// a * adj(b)
+static simd::Float4 mat2_mul_adj(simd::Float4 a, simd::Float4 b)
 {
-	return Mat4x4(
-		m11 - other.m11,
-		m12 - other.m12,
-		m13 - other.m13,
-		m14 - other.m14,
-
-		m21 - other.m21,
-		m22 - other.m22,
-		m23 - other.m23,
-		m24 - other.m24,
-
-		m31 - other.m31,
-		m32 - other.m32,
-		m33 - other.m33,
-		m34 - other.m34,
-
-		m41 - other.m41,
-		m42 - other.m42,
-		m43 - other.m43,
-		m44 - other.m44
+	return simd::sub(
+		simd::mul(a, simd::swizzle<3, 0, 3, 0>(b)),
+		simd::mul(simd::swizzle<1, 0, 3, 2>(a), simd::swizzle<2, 1, 2, 1>(b))
 	);
 }
 
-Mat4x4 Mat4x4::operator + (const Mat4x4& other) const
+// inverts block-wise as four 2x2 matrices
+// runs on the columns as if they were rows, which works out the same since inverse(transpose(M)) = transpose(inverse(M))
+Mat4x4 Mat4x4::inverse() const
 {
-	return Mat4x4(
-		m11 + other.m11,
-		m12 + other.m12,
-		m13 + other.m13,
-		m14 + other.m14,
-
-		m21 + other.m21,
-		m22 + other.m22,
-		m23 + other.m23,
-		m24 + other.m24,
-
-		m31 + other.m31,
-		m32 + other.m32,
-		m33 + other.m33,
-		m34 + other.m34,
-
-		m41 + other.m41,
-		m42 + other.m42,
-		m43 + other.m43,
-		m44 + other.m44
+	simd::Float4 c0 = simd::load(data + 0);
+	simd::Float4 c1 = simd::load(data + 4);
+	simd::Float4 c2 = simd::load(data + 8);
+	simd::Float4 c3 = simd::load(data + 12);
+
+	simd::Float4 a = simd::shuffle<0, 1, 0, 1>(c0, c1);
+	simd::Float4 b = simd::shuffle<2, 3, 2, 3>(c0, c1);
+	simd::Float4 c = simd::shuffle<0, 1, 0, 1>(c2, c3);
+	simd::Float4 d = simd::shuffle<2, 3, 2, 3>(c2, c3);
+
+	// determinants of all four blocks at once
+	simd::Float4 det_sub = simd::sub(
+		simd::mul(simd::shuffle<0, 2, 0, 2>(c0, c2), simd::shuffle<1, 3, 1, 3>(c1, c3)),
+		simd::mul(simd::shuffle<1, 3, 1, 3>(c0, c2), simd::shuffle<0, 2, 0, 2>(c1, c3))
 	);
+
+	simd::Float4 det_a = simd::broadcast<0>(det_sub);
+	simd::Float4 det_b = simd::broadcast<1>(det_sub);
+	simd::Float4 det_c = simd::broadcast<2>(det_sub);
+	simd::Float4 det_d = simd::broadcast<3>(det_sub);
+
+	simd::Float4 d_c = mat2_adj_mul(d, c);
+	simd::Float4 a_b = mat2_adj_mul(a, b);
+
+	simd::Float4 x = simd::sub(simd::mul(det_d, a), mat2_mul(b, d_c));
+	simd::Float4 w = simd::sub(simd::mul(det_a, d), mat2_mul(c, a_b));
+	simd::Float4 y = simd::sub(simd::mul(det_b, c), mat2_mul_adj(d, a_b));
+	simd::Float4 z = simd::sub(simd::mul(det_c, b), mat2_mul_adj(a, d_c));
+
+	// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+	simd::Float4 trace = simd::mul(a_b, simd::swizzle<0, 2, 1, 3>(d_c));
+	trace = simd::add(trace, simd::swizzle<1, 0, 3, 2>(trace));
+	trace = simd::add(trace, simd::swizzle<2, 3, 0, 1>(trace));
+
+	simd::Float4 det = simd::sub(simd::add(simd::mul(det_a, det_d), simd::mul(det_b, det_c)), trace);
+	simd::Float4 inv_det = simd::div(simd::set(1.0f, -1.0f, -1.0f, 1.0f), det);
+
+	x = simd::mul(x, inv_det);
+	y = simd::mul(y, inv_det);
+	z = simd::mul(z, inv_det);
+	w = simd::mul(w, inv_det);
+
+	// the last adjugate swap and the reassembly into columns fold into the same shuffles
+	Mat4x4 result;
+
+	simd::store(result.data + 0,  simd::shuffle<3, 1, 3, 1>(x, y));
+	simd::store(result.data + 4,  simd::shuffle<2, 0, 2, 0>(x, y));
+	simd::store(result.data + 8,  simd::shuffle<3, 1, 3, 1>(z, w));
+	simd::store(result.data + 12, simd::shuffle<2, 0, 2, 0>(z, w));
+
+	return result;
+}
+
+Mat4x4 Mat4x4::operator - (const Mat4x4& other) const
+{
+	Mat4x4 result;
+
+	for (int i = 0; i < 16; i += 4) {
+		simd::store(result.data + i, simd::sub(simd::load(data + i), simd::load(other.data + i)));
+	}
+
+	return result;
+}
+
+Mat4x4 Mat4x4::operator + (const Mat4x4& other) const
+{
+	Mat4x4 result;
+
+	for (int i = 0; i < 16; i += 4) {
+		simd::store(result.data + i, simd::add(simd::load(data + i), simd::load(other.data + i)));
+	}
+
+	return result;
 }
 
+// each column of the result is this matrix's columns weighted by the matching column of the other
 Mat4x4 Mat4x4::operator * (const Mat4x4& other) const
 {
-	return Mat4x4(
-		(this->m11 * other.m11) + (this->m12 * other.m21) + (this->m13 * other.m31) + (this->m14 * other.m41),
-		(this->m11 * other.m12) + (this->m12 * other.m22) + (this->m13 * other.m32) + (this->m14 * other.m42),
-		(this->m11 * other.m13) + (this->m12 * other.m23) + (this->m13 * other.m33) + (this->m14 * other.m43),
-		(this->m11 * other.m14) + (this->m12 * other.m24) + (this->m13 * other.m34) + (this->m14 * other.m44),
-
-		(this->m21 * other.m11) + (this->m22 * other.m21) + (this->m23 * other.m31) + (this->m24 * other.m41),
-		(this->m21 * other.m12) + (this->m22 * other.m22) + (this->m23 * other.m32) + (this->m24 * other.m42),
-		(this->m21 * other.m13) + (this->m22 * other.m23) + (this->m23 * other.m33) + (this->m24 * other.m43),
-		(this->m21 * other.m14) + (this->m22 * other.m24) + (this->m23 * other.m34) + (this->m24 * other.m44),
-
-		(this->m31 * other.m11) + (this->m32 * other.m21) + (this->m33 * other.m31) + (this->m34 * other.m41),
-		(this->m31 * other.m12) + (this->m32 * other.m22) + (this->m33 * other.m32) + (this->m34 * other.m42),
-		(this->m31 * other.m13) + (this->m32 * other.m23) + (this->m33 * other.m33) + (this->m34 * other.m43),
-		(this->m31 * other.m14) + (this->m32 * other.m24) + (this->m33 * other.m34) + (this->m34 * other.m44),
-
-		(this->m41 * other.m11) + (this->m42 * other.m21) + (this->m43 * other.m31) + (this->m44 * other.m41),
-		(this->m41 * other.m12) + (this->m42 * other.m22) + (this->m43 * other.m32) + (this->m44 * other.m42),
-		(this->m41 * other.m13) + (this->m42 * other.m23) + (this->m43 * other.m33) + (this->m44 * other.m43),
-		(this->m41 * other.m14) + (this->m42 * other.m24) + (this->m43 * other.m34) + (this->m44 * other.m44)
-	);
+	simd::Float4 c0 = simd::load(data + 0);
+	simd::Float4 c1 = simd::load(data + 4);
+	simd::Float4 c2 = simd::load(data + 8);
+	simd::Float4 c3 = simd::load(data + 12);
+
+	Mat4x4 result;
+
+	for (int i = 0; i < 16; i += 4)
+	{
+		simd::Float4 col = simd::mul(c0, simd::splat(other.data[i + 0]));
+		col = simd::madd(c1, simd::splat(other.data[i + 1]), col);
+		col = simd::madd(c2, simd::splat(other.data[i + 2]), col);
+		col = simd::madd(c3, simd::splat(other.data[i + 3]), col);
+
+		simd::store(result.data + i, col);
+	}
+
+	return result;
 }
 
 Mat4x4& Mat4x4::operator -= (const Mat4x4& other)
@@ -11,8 +11,9 @@ namespace wvn
 
 	/**
 	 * 4x4 general purpose matrix.
+	 * Stored column by column and aligned so each column loads straight into a simd register.
 	 */
-	struct Mat4x4
+	struct alignas(16) Mat4x4
 	{
 		union
 		{
@@ -29,7 +30,7 @@ namespace wvn
 		};
 
 		Mat4x4();
-		Mat4x4(const Mat4x4& other);
+		Mat4x4(const Mat4x4& other) = default;
 		Mat4x4(float diag);
 		Mat4x4(
 			float m11, float m12, float m13, float m14,
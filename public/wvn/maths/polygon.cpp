@@ -47,7 +47,7 @@ void Polygon2D::project(const Vec2F& axis, float* min, float* max) const
 	}
 }
 
-void Polygon2D::foreach_point(const Function<void(int, Vec2F&, Vec2F&)>& fn)
+void Polygon2D::foreach_point(FunctionRef<void(int, Vec2F&, Vec2F&)> fn)
 {
 	for (int i = 0; i < vertices.size(); i++)
 	{
@@ -103,7 +103,7 @@ void Polygon3D::project(const Vec3F& axis, float* min, float* max) const
 	}
 }
 
-void Polygon3D::foreach_point(const Function<void(int, Vec3F&, Vec3F&)>& fn)
+void Polygon3D::foreach_point(FunctionRef<void(int, Vec3F&, Vec3F&)> fn)
 {
 	for (int i = 0; i < vertices.size(); i++)
 	{
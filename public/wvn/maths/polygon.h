@@ -21,7 +21,7 @@ namespace wvn
 		static bool axis_overlaps(const Polygon2D& a, const Polygon2D& b, const Vec2F& axis, float* amount);
 
 		void project(const Vec2F& axis, float* min, float* max) const;
-		void foreach_point(const Function<void(int, Vec2F&, Vec2F&)>& fn);
+		void foreach_point(FunctionRef<void(int, Vec2F&, Vec2F&)> fn);
 	};
 
 	/**
@@ -37,7 +37,7 @@ namespace wvn
 		static bool axis_overlaps(const Polygon3D& a, const Polygon3D& b, const Vec3F& axis, float* amount);
 
 		void project(const Vec3F& axis, float* min, float* max) const;
-		void foreach_point(const Function<void(int, Vec3F&, Vec3F&)>& fn);
+		void foreach_point(FunctionRef<void(int, Vec3F&, Vec3F&)> fn);
 	};
 }
 
@@ -1,6 +1,7 @@
 #include <wvn/maths/quat.h>
 #include <wvn/maths/calc.h>
 #include <wvn/maths/vec3.h>
+#include <wvn/maths/simd.h>
 
 using namespace wvn;
 
@@ -24,11 +25,6 @@ Quat::Quat(float w, float x, float y, float z)
 {
 }
 
-Quat::Quat(const Quat& other)
-		: w(other.w), x(other.x), y(other.y), z(other.z)
-{
-}
-
 Quat Quat::from_axis_angle(const Vec3F& axis, float angle)
 {
 	Quat q = Quat::zero();
@@ -74,7 +70,45 @@ Vec3F Quat::to_euler(const Quat& quat)
 
 float Quat::dot(const Quat& a, const Quat& b)
 {
-	return (a.w * b.w) + (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
+	return simd::first(simd::dot4(simd::load(a.data), simd::load(b.data)));
+}
+
+Quat Quat::slerp(const Quat& from, const Quat& to, float amount)
+{
+	float cos_theta = Quat::dot(from, to);
+	float sign = 1.0f;
+
+	// q and -q are the same rotation, flip one so we take the short way around
+	if (cos_theta < 0.0f) {
+		cos_theta = -cos_theta;
+		sign = -1.0f;
+	}
+
+	float from_weight = 1.0f - amount;
+	float to_weight = amount;
+
+	// sin(theta) heads to zero as they line up, a normalized lerp is indistinguishable by then
+	if (cos_theta < 0.9995f)
+	{
+		float theta = CalcF::acos(cos_theta);
+		float inv_sin_theta = 1.0f / CalcF::sin(theta);
+
+		from_weight = CalcF::sin(from_weight * theta) * inv_sin_theta;
+		to_weight = CalcF::sin(to_weight * theta) * inv_sin_theta;
+	}
+
+	simd::Float4 result = simd::madd(
+		simd::load(from.data), simd::splat(from_weight),
+		simd::mul(simd::load(to.data), simd::splat(to_weight * sign))
+	);
+
+	if (cos_theta >= 0.9995f) {
+		result = simd::div(result, simd::sqrt(simd::dot4(result, result)));
+	}
+
+	Quat q;
+	simd::store(q.data, result);
+	return q;
 }
 
 Vec3F Quat::vector() const
@@ -84,7 +118,11 @@ Vec3F Quat::vector() const
 
 Quat Quat::normalized() const
 {
-	return (*this) / length();
+	simd::Float4 q = simd::load(data);
+
+	Quat result;
+	simd::store(result.data, simd::div(q, simd::sqrt(simd::dot4(q, q))));
+	return result;
 }
 
 Quat Quat::inverse() const
@@ -142,32 +180,35 @@ bool Quat::operator != (const Quat& other) const
 
 Quat Quat::operator + (const Quat& other) const
 {
-	return Quat(
-		this->w + other.w,
-		this->x + other.x,
-		this->y + other.y,
-		this->z + other.z
-	);
+	Quat result;
+	simd::store(result.data, simd::add(simd::load(data), simd::load(other.data)));
+	return result;
 }
 
 Quat Quat::operator - (const Quat& other) const
 {
-	return Quat(
-		this->w - other.w,
-		this->x - other.x,
-		this->y - other.y,
-		this->z - other.z
-	);
+	Quat result;
+	simd::store(result.data, simd::sub(simd::load(data), simd::load(other.data)));
+	return result;
 }
 
+// every component of other, weighted by one component of this and with the signs of the hamilton product
 Quat Quat::operator * (const Quat& other) const
 {
-	return Quat(
-		(this->w * other.w) - (this->x * other.x) - (this->y * other.y) - (this->z * other.z),
-		(this->w * other.x) + (this->x * other.w) + (this->y * other.z) - (this->z * other.y),
-		(this->w * other.y) - (this->x * other.z) + (this->y * other.w) + (this->z * other.x),
-		(this->w * other.z) + (this->x * other.y) - (this->y * other.x) + (this->z * other.w)
-	);
+	simd::Float4 b = simd::load(other.data);
+
+	simd::Float4 bx = simd::mul(simd::swizzle<1, 0, 3, 2>(b), simd::set(-1.0f,  1.0f, -1.0f,  1.0f));
+	simd::Float4 by = simd::mul(simd::swizzle<2, 3, 0, 1>(b), simd::set(-1.0f,  1.0f,  1.0f, -1.0f));
+	simd::Float4 bz = simd::mul(simd::swizzle<3, 2, 1, 0>(b), simd::set(-1.0f, -1.0f,  1.0f,  1.0f));
+
+	simd::Float4 r = simd::mul(simd::splat(w), b);
+	r = simd::madd(simd::splat(x), bx, r);
+	r = simd::madd(simd::splat(y), by, r);
+	r = simd::madd(simd::splat(z), bz, r);
+
+	Quat result;
+	simd::store(result.data, r);
+	return result;
 }
 
 Quat Quat::operator / (float scalar) const
@@ -9,8 +9,9 @@ namespace wvn
 
 	/**
 	 * Used for representing rotations by black magic.
+	 * Aligned so all four components load into a single simd register.
 	 */
-	struct Quat
+	struct alignas(16) Quat
 	{
 		union
 		{
@@ -29,7 +30,7 @@ namespace wvn
 		Quat(const Vec3F& xyz);
 		Quat(float x, float y, float z);
 		Quat(float w, float x, float y, float z);
-        Quat(const Quat& other);
+        Quat(const Quat& other) = default;
 
 		static const Quat& zero();
         static const Quat& one();
@@ -42,6 +43,9 @@ namespace wvn
 
 		static float dot(const Quat& a, const Quat& b);
 
+		// spherical interpolation along the shorter arc, both have to be normalized
+		static Quat slerp(const Quat& from, const Quat& to, float amount);
+
 		Vec3F vector() const;
 
 		Quat normalized() const;
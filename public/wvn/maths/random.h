@@ -2,6 +2,7 @@
 #define RANDOM_H_
 
 #include <wvn/common.h>
+#include <wvn/maths/random_engines.h>
 
 #include <random>
 #include <ctime>
@@ -10,8 +11,11 @@ namespace wvn
 {
 	/**
 	 * Used for generating random numbers given a seed.
+	 * Engine can be anything from random_engines.h or the standard library.
+	 * The default used to be std::mt19937, so a seed gives a different sequence than it did before the switch to
+	 * Xoshiro256. Pass std::mt19937 explicitly anywhere the old sequences need to be reproduced.
 	 */
-	template <class Engine = std::mt19937>
+	template <class Engine = Xoshiro256>
 	class Random
 	{
 	public:
@@ -29,6 +33,9 @@ namespace wvn
 		template <typename TDist, typename T>
 		T generic_range(T min, T max);
 
+		// for jumping ahead or copying the state out to another thread
+		Engine& engine();
+
 	private:
 		Engine m_rng;
 	};
@@ -74,6 +81,12 @@ namespace wvn
 		return generic_range<std::uniform_real_distribution<double>>(min, max);
 	}
 
+	template <class Engine>
+	Engine& Random<Engine>::engine()
+	{
+		return m_rng;
+	}
+
 	template <class Engine>
 	template <typename TDist, typename T>
 	T Random<Engine>::generic_range(T min, T max)
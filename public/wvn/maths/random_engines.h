@@ -0,0 +1,207 @@
+#ifndef RANDOM_ENGINES_H_
+#define RANDOM_ENGINES_H_
+
+#include <wvn/common.h>
+
+namespace wvn
+{
+	/*
+	 * Small, fast random engines that can be used with Random<> or anything else wanting a std style engine.
+	 * None of them are any good for cryptography.
+	 */
+
+	/**
+	 * SplitMix64: a single 64 bit counter put through a mixing function.
+	 * Mostly for turning one seed into the larger states of the other engines.
+	 */
+	class SplitMix64
+	{
+	public:
+		using result_type = u64;
+
+		SplitMix64() : m_state(0) { }
+		SplitMix64(u64 seed) : m_state(seed) { }
+
+		void seed(u64 seed) { m_state = seed; }
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return ~(u64)0; }
+
+		result_type operator () ()
+		{
+			u64 z = (m_state += 0x9E3779B97F4A7C15ULL);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31);
+		}
+
+	private:
+		u64 m_state;
+	};
+
+	/**
+	 * PCG32 (XSH-RR): 64 bits of state giving 32 bit results.
+	 * Different streams give unrelated sequences from the same seed, and advance() skips ahead in O(log n).
+	 */
+	class PCG32
+	{
+	public:
+		using result_type = u32;
+
+		PCG32() : PCG32(0, 0) { }
+		PCG32(u64 seed, u64 stream = 0) : m_state(0), m_inc(0) { this->seed(seed, stream); }
+
+		void seed(u64 seed, u64 stream = 0)
+		{
+			m_state = 0;
+			m_inc = (stream << 1) | 1;
+			(*this)();
+			m_state += seed;
+			(*this)();
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return ~(u32)0; }
+
+		result_type operator () ()
+		{
+			u64 old = m_state;
+			m_state = (old * MULTIPLIER) + m_inc;
+
+			u32 xorshifted = (u32)(((old >> 18) ^ old) >> 27);
+			u32 rot = (u32)(old >> 59);
+
+			return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+		}
+
+		// same as calling the engine 'delta' times, by squaring the step
+		void advance(u64 delta)
+		{
+			u64 cur_mult = MULTIPLIER;
+			u64 cur_plus = m_inc;
+			u64 acc_mult = 1;
+			u64 acc_plus = 0;
+
+			while (delta > 0)
+			{
+				if (delta & 1)
+				{
+					acc_mult *= cur_mult;
+					acc_plus = (acc_plus * cur_mult) + cur_plus;
+				}
+
+				cur_plus = (cur_mult + 1) * cur_plus;
+				cur_mult *= cur_mult;
+				delta >>= 1;
+			}
+
+			m_state = (acc_mult * m_state) + acc_plus;
+		}
+
+	private:
+		constexpr static u64 MULTIPLIER = 6364136223846793005ULL;
+
+		u64 m_state;
+		u64 m_inc;
+	};
+
+	/**
+	 * xoshiro256**: 256 bits of state giving 64 bit results, the default engine for Random<>.
+	 * jump() skips 2^128 results and long_jump() 2^192, which gives threads non-overlapping streams from one seed.
+	 */
+	class Xoshiro256
+	{
+		friend class BulkRandom;
+
+	public:
+		using result_type = u64;
+
+		Xoshiro256() : Xoshiro256(0) { }
+		Xoshiro256(u64 seed) : m_state() { this->seed(seed); }
+
+		// the stream'th long_jump() along from the seed, for giving each thread its own
+		Xoshiro256(u64 seed, u64 stream)
+			: Xoshiro256(seed)
+		{
+			for (u64 i = 0; i < stream; i++) {
+				long_jump();
+			}
+		}
+
+		// all zero is the one state it can never leave, splitmix can't produce four zeroes in a row
+		void seed(u64 seed)
+		{
+			SplitMix64 sm(seed);
+
+			for (int i = 0; i < 4; i++) {
+				m_state[i] = sm();
+			}
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return ~(u64)0; }
+
+		result_type operator () ()
+		{
+			u64 result = rotl(m_state[1] * 5, 7) * 9;
+			u64 t = m_state[1] << 17;
+
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = rotl(m_state[3], 45);
+
+			return result;
+		}
+
+		void jump()
+		{
+			constexpr u64 JUMP[4] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+			apply_jump(JUMP);
+		}
+
+		void long_jump()
+		{
+			constexpr u64 LONG_JUMP[4] = { 0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL };
+			apply_jump(LONG_JUMP);
+		}
+
+	private:
+		static u64 rotl(u64 x, int k)
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+
+		// the jump polynomial evaluated against the state, one step per bit
+		void apply_jump(const u64* poly)
+		{
+			u64 s[4] = { 0, 0, 0, 0 };
+
+			for (int i = 0; i < 4; i++)
+			{
+				for (int b = 0; b < 64; b++)
+				{
+					if (poly[i] & ((u64)1 << b))
+					{
+						s[0] ^= m_state[0];
+						s[1] ^= m_state[1];
+						s[2] ^= m_state[2];
+						s[3] ^= m_state[3];
+					}
+
+					(*this)();
+				}
+			}
+
+			for (int i = 0; i < 4; i++) {
+				m_state[i] = s[i];
+			}
+		}
+
+		u64 m_state[4];
+	};
+}
+
+#endif // RANDOM_ENGINES_H_
@@ -0,0 +1,371 @@
+#ifndef SIMD_H_
+#define SIMD_H_
+
+#include <wvn/common.h>
+
+#include <cmath>
+
+// defining wvn_SIMD_SCALAR forces the plain-array fallback, e.g. to check it against the simd paths
+#if !defined(wvn_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define wvn_SIMD_SSE 1
+#include <emmintrin.h>
+#else
+#define wvn_SIMD_SSE 0
+#endif
+
+#if !defined(wvn_SIMD_SCALAR) && !wvn_SIMD_SSE && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define wvn_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define wvn_SIMD_NEON 0
+#endif
+
+#if wvn_SIMD_SSE && defined(__FMA__)
+#define wvn_SIMD_FMA 1
+#include <immintrin.h>
+#else
+#define wvn_SIMD_FMA 0
+#endif
+
+namespace wvn::simd
+{
+	/*
+	 * Four floats in one register, with just the handful of operations the maths types need.
+	 * SSE2 on x86, NEON on arm and plain arrays everywhere else, selected when compiling.
+	 * Lane 0 is the lowest address when loading and storing.
+	 */
+#if wvn_SIMD_SSE
+	using Float4 = __m128;
+#elif wvn_SIMD_NEON
+	using Float4 = float32x4_t;
+#else
+	struct Float4 { float v[4]; };
+#endif
+
+	inline Float4 load(const float* p)
+	{
+#if wvn_SIMD_SSE
+		return _mm_load_ps(p);
+#elif wvn_SIMD_NEON
+		return vld1q_f32(p);
+#else
+		return { { p[0], p[1], p[2], p[3] } };
+#endif
+	}
+
+	inline Float4 loadu(const float* p)
+	{
+#if wvn_SIMD_SSE
+		return _mm_loadu_ps(p);
+#elif wvn_SIMD_NEON
+		return vld1q_f32(p);
+#else
+		return { { p[0], p[1], p[2], p[3] } };
+#endif
+	}
+
+	inline void store(float* p, Float4 v)
+	{
+#if wvn_SIMD_SSE
+		_mm_store_ps(p, v);
+#elif wvn_SIMD_NEON
+		vst1q_f32(p, v);
+#else
+		p[0] = v.v[0]; p[1] = v.v[1]; p[2] = v.v[2]; p[3] = v.v[3];
+#endif
+	}
+
+	inline void storeu(float* p, Float4 v)
+	{
+#if wvn_SIMD_SSE
+		_mm_storeu_ps(p, v);
+#elif wvn_SIMD_NEON
+		vst1q_f32(p, v);
+#else
+		p[0] = v.v[0]; p[1] = v.v[1]; p[2] = v.v[2]; p[3] = v.v[3];
+#endif
+	}
+
+	// the first three lanes only, leaving whatever comes after them alone
+	inline void store3(float* p, Float4 v)
+	{
+#if wvn_SIMD_SSE
+		_mm_storel_pi((__m64*)p, v);
+		_mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+#elif wvn_SIMD_NEON
+		vst1_f32(p, vget_low_f32(v));
+		vst1q_lane_f32(p + 2, v, 2);
+#else
+		p[0] = v.v[0]; p[1] = v.v[1]; p[2] = v.v[2];
+#endif
+	}
+
+	inline Float4 set(float x, float y, float z, float w)
+	{
+#if wvn_SIMD_SSE
+		return _mm_setr_ps(x, y, z, w);
+#elif wvn_SIMD_NEON
+		float tmp[4] = { x, y, z, w };
+		return vld1q_f32(tmp);
+#else
+		return { { x, y, z, w } };
+#endif
+	}
+
+	inline Float4 splat(float s)
+	{
+#if wvn_SIMD_SSE
+		return _mm_set1_ps(s);
+#elif wvn_SIMD_NEON
+		return vdupq_n_f32(s);
+#else
+		return { { s, s, s, s } };
+#endif
+	}
+
+	inline float first(Float4 v)
+	{
+#if wvn_SIMD_SSE
+		return _mm_cvtss_f32(v);
+#elif wvn_SIMD_NEON
+		return vgetq_lane_f32(v, 0);
+#else
+		return v.v[0];
+#endif
+	}
+
+	inline Float4 add(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_add_ps(a, b);
+#elif wvn_SIMD_NEON
+		return vaddq_f32(a, b);
+#else
+		return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+#endif
+	}
+
+	inline Float4 sub(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_sub_ps(a, b);
+#elif wvn_SIMD_NEON
+		return vsubq_f32(a, b);
+#else
+		return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+#endif
+	}
+
+	inline Float4 mul(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_mul_ps(a, b);
+#elif wvn_SIMD_NEON
+		return vmulq_f32(a, b);
+#else
+		return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+#endif
+	}
+
+	inline Float4 div(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_div_ps(a, b);
+#elif wvn_SIMD_NEON && defined(__aarch64__)
+		return vdivq_f32(a, b);
+#elif wvn_SIMD_NEON
+		float x[4], y[4];
+		vst1q_f32(x, a);
+		vst1q_f32(y, b);
+		float r[4] = { x[0] / y[0], x[1] / y[1], x[2] / y[2], x[3] / y[3] };
+		return vld1q_f32(r);
+#else
+		return { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } };
+#endif
+	}
+
+	// a * b + c, fused where the target has it
+	inline Float4 madd(Float4 a, Float4 b, Float4 c)
+	{
+#if wvn_SIMD_FMA
+		return _mm_fmadd_ps(a, b, c);
+#elif wvn_SIMD_SSE
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+#elif wvn_SIMD_NEON && defined(__aarch64__)
+		return vfmaq_f32(c, a, b);
+#elif wvn_SIMD_NEON
+		return vmlaq_f32(c, a, b);
+#else
+		return add(mul(a, b), c);
+#endif
+	}
+
+	inline Float4 sqrt(Float4 v)
+	{
+#if wvn_SIMD_SSE
+		return _mm_sqrt_ps(v);
+#elif wvn_SIMD_NEON && defined(__aarch64__)
+		return vsqrtq_f32(v);
+#else
+		float x[4];
+		storeu(x, v);
+		return set(std::sqrt(x[0]), std::sqrt(x[1]), std::sqrt(x[2]), std::sqrt(x[3]));
+#endif
+	}
+
+	inline Float4 min(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_min_ps(a, b);
+#elif wvn_SIMD_NEON
+		return vminq_f32(a, b);
+#else
+		return { { a.v[0] < b.v[0] ? a.v[0] : b.v[0], a.v[1] < b.v[1] ? a.v[1] : b.v[1], a.v[2] < b.v[2] ? a.v[2] : b.v[2], a.v[3] < b.v[3] ? a.v[3] : b.v[3] } };
+#endif
+	}
+
+	inline Float4 max(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_max_ps(a, b);
+#elif wvn_SIMD_NEON
+		return vmaxq_f32(a, b);
+#else
+		return { { a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1], a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3] } };
+#endif
+	}
+
+	/*
+	 * Comparisons give a mask with every bit of a lane set where it holds and clear where it doesn't,
+	 * which is only meant to be passed on to select().
+	 */
+#if wvn_SIMD_SSE
+	using Mask4 = __m128;
+#elif wvn_SIMD_NEON
+	using Mask4 = uint32x4_t;
+#else
+	struct Mask4 { bool v[4]; };
+#endif
+
+	inline Mask4 less(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_cmplt_ps(a, b);
+#elif wvn_SIMD_NEON
+		return vcltq_f32(a, b);
+#else
+		return { { a.v[0] < b.v[0], a.v[1] < b.v[1], a.v[2] < b.v[2], a.v[3] < b.v[3] } };
+#endif
+	}
+
+	inline Mask4 not_equal(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_cmpneq_ps(a, b);
+#elif wvn_SIMD_NEON
+		return vmvnq_u32(vceqq_f32(a, b));
+#else
+		return { { a.v[0] != b.v[0], a.v[1] != b.v[1], a.v[2] != b.v[2], a.v[3] != b.v[3] } };
+#endif
+	}
+
+	// a where the mask is set, b where it isn't
+	inline Float4 select(Mask4 mask, Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#elif wvn_SIMD_NEON
+		return vbslq_f32(mask, a, b);
+#else
+		return { { mask.v[0] ? a.v[0] : b.v[0], mask.v[1] ? a.v[1] : b.v[1], mask.v[2] ? a.v[2] : b.v[2], mask.v[3] ? a.v[3] : b.v[3] } };
+#endif
+	}
+
+	// only for values that fit in an int, which is all anything here needs
+	inline Float4 floor(Float4 v)
+	{
+#if wvn_SIMD_SSE
+		// truncating rounds negative values up, so take one off wherever that happened
+		Float4 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+		return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, v), _mm_set1_ps(1.0f)));
+#elif wvn_SIMD_NEON && defined(__aarch64__)
+		return vrndmq_f32(v);
+#else
+		float x[4];
+		storeu(x, v);
+		return set(std::floor(x[0]), std::floor(x[1]), std::floor(x[2]), std::floor(x[3]));
+#endif
+	}
+
+	// 2^n for whole numbers n between -126 and 127, built straight from the exponent bits
+	inline Float4 pow2i(Float4 n)
+	{
+#if wvn_SIMD_SSE
+		return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23));
+#elif wvn_SIMD_NEON
+		return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23));
+#else
+		return { { std::ldexp(1.0f, (int)n.v[0]), std::ldexp(1.0f, (int)n.v[1]), std::ldexp(1.0f, (int)n.v[2]), std::ldexp(1.0f, (int)n.v[3]) } };
+#endif
+	}
+
+	// (a[X], a[Y], b[Z], b[W])
+	template <int X, int Y, int Z, int W>
+	inline Float4 shuffle(Float4 a, Float4 b)
+	{
+#if wvn_SIMD_SSE
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+#elif wvn_SIMD_NEON
+		// plain lane moves rather than __builtin_shufflevector so msvc can build it, they still end up as dup / ins
+		float32x4_t r = vdupq_n_f32(vgetq_lane_f32(a, X));
+		r = vsetq_lane_f32(vgetq_lane_f32(a, Y), r, 1);
+		r = vsetq_lane_f32(vgetq_lane_f32(b, Z), r, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(b, W), r, 3);
+#else
+		return { { a.v[X], a.v[Y], b.v[Z], b.v[W] } };
+#endif
+	}
+
+	// (v[X], v[Y], v[Z], v[W])
+	template <int X, int Y, int Z, int W>
+	inline Float4 swizzle(Float4 v)
+	{
+#if wvn_SIMD_SSE
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+#elif wvn_SIMD_NEON
+		return shuffle<X, Y, Z, W>(v, v);
+#else
+		return { { v.v[X], v.v[Y], v.v[Z], v.v[W] } };
+#endif
+	}
+
+	template <int Lane>
+	inline Float4 broadcast(Float4 v)
+	{
+		return swizzle<Lane, Lane, Lane, Lane>(v);
+	}
+
+	// rows become columns
+	inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d)
+	{
+		Float4 ab_lo = shuffle<0, 1, 0, 1>(a, b);
+		Float4 ab_hi = shuffle<2, 3, 2, 3>(a, b);
+		Float4 cd_lo = shuffle<0, 1, 0, 1>(c, d);
+		Float4 cd_hi = shuffle<2, 3, 2, 3>(c, d);
+
+		a = shuffle<0, 2, 0, 2>(ab_lo, cd_lo);
+		b = shuffle<1, 3, 1, 3>(ab_lo, cd_lo);
+		c = shuffle<0, 2, 0, 2>(ab_hi, cd_hi);
+		d = shuffle<1, 3, 1, 3>(ab_hi, cd_hi);
+	}
+
+	// dot product of all four lanes, in every lane
+	inline Float4 dot4(Float4 a, Float4 b)
+	{
+		Float4 m = mul(a, b);
+		m = add(m, swizzle<1, 0, 3, 2>(m));
+		return add(m, swizzle<2, 3, 0, 1>(m));
+	}
+}
+
+#endif // SIMD_H_
@@ -0,0 +1,348 @@
+#include <wvn/maths/transform_hierarchy.h>
+
+using namespace wvn;
+
+TransformHierarchy::TransformHierarchy()
+	: m_positions()
+	, m_rotations()
+	, m_scales()
+	, m_world()
+	, m_parents()
+	, m_flags()
+	, m_ids()
+	, m_index_of()
+	, m_generations()
+	, m_free_slots()
+	, m_level_offsets()
+	, m_structure_changed(false)
+	, m_any_dirty(false)
+	, m_any_updated(false)
+{
+	// NULL_ID never points anywhere
+	m_index_of.push_back(NO_INDEX);
+	m_generations.push_back(0);
+	m_level_offsets.push_back(0);
+}
+
+TransformHierarchy::~TransformHierarchy()
+{
+}
+
+TransformNodeID TransformHierarchy::create(TransformNodeID parent)
+{
+	u32 slot = 0;
+
+	if (m_free_slots.any())
+	{
+		slot = m_free_slots.back();
+		m_free_slots.pop_back();
+	}
+	else
+	{
+		slot = m_index_of.size();
+		m_index_of.push_back(NO_INDEX);
+		m_generations.push_back(1);
+	}
+
+	TransformNodeID id = ((u64)m_generations[slot] << 32) | slot;
+	u32 idx = m_ids.size();
+
+	m_positions.push_back(Vec3F::zero());
+	m_rotations.push_back(Quat::identity());
+	m_scales.push_back(Vec3F::one());
+	m_world.push_back(Affine3D::identity());
+	m_parents.push_back(parent != NULL_ID ? index_of(parent) : NO_INDEX);
+	m_flags.push_back(NODE_DIRTY);
+	m_ids.push_back(id);
+
+	m_index_of[slot] = idx;
+
+	m_any_dirty = true;
+	m_structure_changed = true;
+
+	return id;
+}
+
+void TransformHierarchy::destroy(TransformNodeID node)
+{
+	m_flags[index_of(node)] |= NODE_DESTROYED;
+	m_structure_changed = true;
+}
+
+bool TransformHierarchy::is_valid(TransformNodeID node) const
+{
+	u32 slot = (u32)node;
+
+	if (node == NULL_ID || slot >= m_index_of.size() || m_generations[slot] != (u32)(node >> 32)) {
+		return false;
+	}
+
+	u32 idx = m_index_of[slot];
+
+	return idx != NO_INDEX && !(m_flags[idx] & NODE_DESTROYED);
+}
+
+void TransformHierarchy::set_parent(TransformNodeID node, TransformNodeID parent)
+{
+	u32 idx = index_of(node);
+	u32 parent_idx = (parent != NULL_ID) ? index_of(parent) : NO_INDEX;
+
+	for (u32 ancestor = parent_idx; ancestor != NO_INDEX; ancestor = m_parents[ancestor])
+	{
+		if (ancestor == idx) {
+			wvn_ERROR("[TRANSFORM HIERARCHY|DEBUG] A node can't be parented to itself or anything below it.");
+		}
+	}
+
+	m_parents[idx] = parent_idx;
+
+	mark_dirty(idx);
+	m_structure_changed = true;
+}
+
+TransformNodeID TransformHierarchy::parent(TransformNodeID node) const
+{
+	u32 parent_idx = m_parents[index_of(node)];
+	return (parent_idx != NO_INDEX) ? m_ids[parent_idx] : NULL_ID;
+}
+
+void TransformHierarchy::set_local(TransformNodeID node, const Vec3F& position, const Quat& rotation, const Vec3F& scale)
+{
+	u32 idx = index_of(node);
+
+	m_positions[idx] = position;
+	m_rotations[idx] = rotation;
+	m_scales[idx] = scale;
+
+	mark_dirty(idx);
+}
+
+void TransformHierarchy::set_position(TransformNodeID node, const Vec3F& position)
+{
+	u32 idx = index_of(node);
+	m_positions[idx] = position;
+	mark_dirty(idx);
+}
+
+void TransformHierarchy::set_rotation(TransformNodeID node, const Quat& rotation)
+{
+	u32 idx = index_of(node);
+	m_rotations[idx] = rotation;
+	mark_dirty(idx);
+}
+
+void TransformHierarchy::set_scale(TransformNodeID node, const Vec3F& scale)
+{
+	u32 idx = index_of(node);
+	m_scales[idx] = scale;
+	mark_dirty(idx);
+}
+
+Vec3F TransformHierarchy::position(TransformNodeID node) const { return m_positions[index_of(node)]; }
+Quat TransformHierarchy::rotation(TransformNodeID node) const { return m_rotations[index_of(node)]; }
+Vec3F TransformHierarchy::scale(TransformNodeID node) const { return m_scales[index_of(node)]; }
+
+const Affine3D& TransformHierarchy::world(TransformNodeID node) const
+{
+	return m_world[index_of(node)];
+}
+
+bool TransformHierarchy::was_updated(TransformNodeID node) const
+{
+	return (m_flags[index_of(node)] & NODE_UPDATED) != 0;
+}
+
+void TransformHierarchy::update()
+{
+	begin_update();
+
+	// nothing moved this frame or last frame, so there aren't even any updated flags to clear
+	if (!m_any_dirty && !m_any_updated) {
+		return;
+	}
+
+	for (u32 level = 0; level < level_count(); level++) {
+		update_range(level_begin(level), level_end(level));
+	}
+
+	end_update();
+}
+
+void TransformHierarchy::begin_update()
+{
+	if (m_structure_changed)
+	{
+		rebuild();
+		m_structure_changed = false;
+	}
+}
+
+void TransformHierarchy::update_range(u32 begin, u32 end)
+{
+	for (u32 i = begin; i < end; i++)
+	{
+		u32 parent = m_parents[i];
+
+		// parents are always earlier in the order, so by now their flag says whether they moved this update
+		bool changed = (m_flags[i] & NODE_DIRTY) || (parent != NO_INDEX && (m_flags[parent] & NODE_UPDATED));
+
+		m_flags[i] = changed ? NODE_UPDATED : 0;
+
+		if (!changed) {
+			continue;
+		}
+
+		Affine3D local = Affine3D::create_transform(m_positions[i], m_rotations[i], m_scales[i], Vec3F::zero());
+
+		if (parent != NO_INDEX) {
+			m_world[i] = local * m_world[parent];
+		} else {
+			m_world[i] = local;
+		}
+	}
+}
+
+void TransformHierarchy::end_update()
+{
+	m_any_updated = m_any_dirty;
+	m_any_dirty = false;
+}
+
+u32 TransformHierarchy::level_count() const { return m_level_offsets.size() - 1; }
+u32 TransformHierarchy::level_begin(u32 level) const { return m_level_offsets[level]; }
+u32 TransformHierarchy::level_end(u32 level) const { return m_level_offsets[level + 1]; }
+
+u32 TransformHierarchy::size() const
+{
+	return m_ids.size();
+}
+
+u32 TransformHierarchy::index_of(TransformNodeID node) const
+{
+	wvn_ASSERT(is_valid(node), "[TRANSFORM HIERARCHY|DEBUG] Node must be valid.");
+	return m_index_of[(u32)node];
+}
+
+void TransformHierarchy::mark_dirty(u32 idx)
+{
+	m_flags[idx] |= NODE_DIRTY;
+	m_any_dirty = true;
+}
+
+void TransformHierarchy::rebuild()
+{
+	u32 count = m_ids.size();
+
+	// depth of every node, and whether it goes along with a destroyed ancestor
+	Vector<u32> depths(count, NO_INDEX);
+	Vector<u32> chain;
+
+	for (u32 i = 0; i < count; i++)
+	{
+		// walk up until a node that's already known (or past the root), then fill in the chain on the way back down
+		u32 idx = i;
+
+		while (idx != NO_INDEX && depths[idx] == NO_INDEX)
+		{
+			chain.push_back(idx);
+			idx = m_parents[idx];
+		}
+
+		u32 depth = (idx != NO_INDEX) ? depths[idx] + 1 : 0;
+		bool destroyed = (idx != NO_INDEX) && (m_flags[idx] & NODE_DESTROYED);
+
+		while (chain.any())
+		{
+			u32 node = chain.back();
+			chain.pop_back();
+
+			if (destroyed || (m_flags[node] & NODE_DESTROYED))
+			{
+				m_flags[node] |= NODE_DESTROYED;
+				destroyed = true;
+			}
+
+			depths[node] = depth;
+			depth++;
+		}
+	}
+
+	// counting sort by depth, keeping the existing order within a level
+	u32 levels = 0;
+
+	for (u32 i = 0; i < count; i++)
+	{
+		if (!(m_flags[i] & NODE_DESTROYED)) {
+			levels = CalcU::max(levels, depths[i] + 1);
+		}
+	}
+
+	m_level_offsets = Vector<u32>(levels + 1, 0);
+
+	for (u32 i = 0; i < count; i++)
+	{
+		if (!(m_flags[i] & NODE_DESTROYED)) {
+			m_level_offsets[depths[i] + 1]++;
+		}
+	}
+
+	for (u32 level = 0; level < levels; level++) {
+		m_level_offsets[level + 1] += m_level_offsets[level];
+	}
+
+	u32 live_count = m_level_offsets[levels];
+
+	Vector<u32> cursors(m_level_offsets);
+	Vector<u32> new_index(count, NO_INDEX);
+
+	for (u32 i = 0; i < count; i++)
+	{
+		if (!(m_flags[i] & NODE_DESTROYED)) {
+			new_index[i] = cursors[depths[i]]++;
+		}
+	}
+
+	Vector<Vec3F> positions(live_count);
+	Vector<Quat> rotations(live_count);
+	Vector<Vec3F> scales(live_count);
+	Vector<Affine3D> world(live_count);
+	Vector<u32> parents(live_count);
+	Vector<u8> flags(live_count);
+	Vector<TransformNodeID> ids(live_count);
+
+	for (u32 i = 0; i < count; i++)
+	{
+		u32 idx = new_index[i];
+
+		if (idx == NO_INDEX)
+		{
+			// bumping the generation means any id still held for this node won't match whatever reuses the slot
+			u32 slot = (u32)m_ids[i];
+
+			m_index_of[slot] = NO_INDEX;
+			m_generations[slot]++;
+			m_free_slots.push_back(slot);
+
+			continue;
+		}
+
+		// a destroyed parent would have taken this node with it, so the parent always has a new index
+		positions[idx] = m_positions[i];
+		rotations[idx] = m_rotations[i];
+		scales[idx] = m_scales[i];
+		world[idx] = m_world[i];
+		parents[idx] = (m_parents[i] != NO_INDEX) ? new_index[m_parents[i]] : NO_INDEX;
+		flags[idx] = m_flags[i];
+		ids[idx] = m_ids[i];
+
+		m_index_of[(u32)m_ids[i]] = idx;
+	}
+
+	m_positions = std::move(positions);
+	m_rotations = std::move(rotations);
+	m_scales = std::move(scales);
+	m_world = std::move(world);
+	m_parents = std::move(parents);
+	m_flags = std::move(flags);
+	m_ids = std::move(ids);
+}
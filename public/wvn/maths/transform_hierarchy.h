@@ -0,0 +1,106 @@
+#ifndef TRANSFORM_HIERARCHY_H_
+#define TRANSFORM_HIERARCHY_H_
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+#include <wvn/maths/vec3.h>
+#include <wvn/maths/quat.h>
+#include <wvn/maths/affine_3d.h>
+
+namespace wvn
+{
+	// slot in the bottom half, generation in the top half so an id stops matching once its node is destroyed
+	using TransformNodeID = u64;
+
+	/**
+	 * Parent/child transforms stored as flat arrays sorted by depth, so every parent comes before its children.
+	 * Changing a local transform only marks that node dirty, update() then goes through the arrays once and
+	 * recomputes the world matrix of every dirty node and everything below it, leaving the rest untouched.
+	 * Creating, destroying and reparenting nodes are applied by re-sorting at the start of the next update().
+	 */
+	class TransformHierarchy
+	{
+	public:
+		constexpr static TransformNodeID NULL_ID = 0;
+
+		TransformHierarchy();
+		~TransformHierarchy();
+
+		TransformNodeID create(TransformNodeID parent = NULL_ID);
+
+		// takes everything below the node with it
+		void destroy(TransformNodeID node);
+
+		bool is_valid(TransformNodeID node) const;
+
+		void set_parent(TransformNodeID node, TransformNodeID parent);
+		TransformNodeID parent(TransformNodeID node) const;
+
+		void set_local(TransformNodeID node, const Vec3F& position, const Quat& rotation, const Vec3F& scale);
+		void set_position(TransformNodeID node, const Vec3F& position);
+		void set_rotation(TransformNodeID node, const Quat& rotation);
+		void set_scale(TransformNodeID node, const Vec3F& scale);
+
+		Vec3F position(TransformNodeID node) const;
+		Quat rotation(TransformNodeID node) const;
+		Vec3F scale(TransformNodeID node) const;
+
+		// as of the last update(), new nodes are the identity until then
+		const Affine3D& world(TransformNodeID node) const;
+
+		// whether the world matrix changed during the last update()
+		bool was_updated(TransformNodeID node) const;
+
+		void update();
+
+		/*
+		 * update() split up so it can be spread over threads.
+		 * After begin_update(), every node in a level only reads from nodes in earlier levels,
+		 * so the ranges of one level can go to different threads as long as each level finishes before the next starts.
+		 */
+		void begin_update();
+		void update_range(u32 begin, u32 end);
+		void end_update();
+
+		u32 level_count() const;
+		u32 level_begin(u32 level) const;
+		u32 level_end(u32 level) const;
+
+		u32 size() const;
+
+	private:
+		constexpr static u32 NO_INDEX = ~0u;
+
+		enum NodeFlags : u8
+		{
+			NODE_DIRTY = 1 << 0,
+			NODE_UPDATED = 1 << 1,
+			NODE_DESTROYED = 1 << 2
+		};
+
+		u32 index_of(TransformNodeID node) const;
+		void mark_dirty(u32 idx);
+		void rebuild();
+
+		// everything below is indexed by position in the depth order, except m_index_of and m_generations which go by id slot
+		Vector<Vec3F> m_positions;
+		Vector<Quat> m_rotations;
+		Vector<Vec3F> m_scales;
+		Vector<Affine3D> m_world;
+		Vector<u32> m_parents;
+		Vector<u8> m_flags;
+		Vector<TransformNodeID> m_ids;
+
+		Vector<u32> m_index_of;
+		Vector<u32> m_generations;
+		Vector<u32> m_free_slots;
+
+		Vector<u32> m_level_offsets; // level i is [m_level_offsets[i], m_level_offsets[i + 1])
+
+		bool m_structure_changed;
+		bool m_any_dirty;
+		bool m_any_updated;
+	};
+}
+
+#endif // TRANSFORM_HIERARCHY_H_
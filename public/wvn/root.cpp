@@ -4,6 +4,7 @@
 #include <wvn/plugin/plugin_loader.h>
 
 #include <wvn/system/system_backend.h>
+#include <wvn/system/worker_pool.h>
 #include <wvn/graphics/renderer_backend.h>
 #include <wvn/audio/audio_backend.h>
 
@@ -15,6 +16,7 @@
 #include <wvn/graphics/rendering_mgr.h>
 #include <wvn/graphics/mesh_mgr.h>
 #include <wvn/graphics/material_system.h>
+#include <wvn/graphics/image_codec_registry.h>
 #include <wvn/network/network_mgr.h>
 #include <wvn/animation/animation_mgr.h>
 #include <wvn/resource/resource_mgr.h>
@@ -42,6 +44,13 @@ Root::Root(const Config& cfg)
 
 	time::delta = 1.0 / (double)m_config.target_fps;
 
+	// exists before the plugins so the backends can record on it
+	m_worker_pool = new sys::WorkerPool();
+	m_worker_pool->set_thread_count(std::thread::hardware_concurrency());
+
+	// exists before the plugins so they can register their own codecs
+	m_image_codec_registry = new gfx::ImageCodecRegistry();
+
 	m_plugins = plug::PluginLoader::load_plugins();
 	install_plugins();
 
@@ -120,6 +129,10 @@ Root::~Root()
 
 	uninstall_plugins();
 
+	delete gfx::ImageCodecRegistry::get_singleton();
+
+	delete m_worker_pool;
+
 	m_log_mgr->print("[ROOT] Destroyed!");
 
 #if wvn_DEBUG
@@ -233,6 +246,11 @@ void Root::set_audio_backend(sfx::AudioBackend* backend)
 	m_audio_backend = backend;
 }
 
+sys::WorkerPool* Root::worker_pool()
+{
+	return m_worker_pool;
+}
+
 void Root::install_plugins()
 {
 	for (auto it = m_plugins.begin(); it != m_plugins.end(); it++) {
@@ -23,8 +23,8 @@ namespace wvn
 
 	namespace ent  { class EntityMgr; class EventMgr; }
 	namespace phys { class PhysicsMgr; }
-	namespace gfx { class RenderingMgr; class RendererBackend; class MeshMgr; class MaterialSystem; }
-	namespace sys { class SystemBackend; }
+	namespace gfx { class RenderingMgr; class RendererBackend; class MeshMgr; class MaterialSystem; class ImageCodecRegistry; }
+	namespace sys { class SystemBackend; class WorkerPool; }
 	namespace sfx { class AudioMgr; class AudioBackend; }
 	namespace net { class NetworkMgr; }
 	namespace anim { class AnimationMgr; }
@@ -39,10 +39,11 @@ namespace wvn
 		{
 			FLAG_NONE,
 
-			FLAG_RESIZABLE      = 1 << 0,
-			FLAG_VSYNC          = 1 << 1,
-			FLAG_CURSOR_VISIBLE = 1 << 2,
-			FLAG_CENTRE_WINDOW  = 1 << 3,
+			FLAG_RESIZABLE         = 1 << 0,
+			FLAG_VSYNC             = 1 << 1,
+			FLAG_CURSOR_VISIBLE    = 1 << 2,
+			FLAG_CENTRE_WINDOW     = 1 << 3,
+			FLAG_BINDLESS_TEXTURES = 1 << 4,
 
 			FLAG_MAX_ENUM
 		};
@@ -91,6 +92,9 @@ namespace wvn
 		sfx::AudioBackend* audio_backend();
 		void set_audio_backend(sfx::AudioBackend* backend);
 
+		// shared by every system that spreads its work over threads
+		sys::WorkerPool* worker_pool();
+
 		Random<> random;
 		Camera main_camera;
 
@@ -98,6 +102,8 @@ namespace wvn
 		void install_plugins();
 		void uninstall_plugins();
 
+		sys::WorkerPool* m_worker_pool;
+		gfx::ImageCodecRegistry* m_image_codec_registry;
 		phys::PhysicsMgr* m_physics_mgr;
 		ent::EntityMgr* m_entity_mgr;
 		ent::EventMgr* m_event_mgr;
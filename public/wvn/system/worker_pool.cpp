@@ -0,0 +1,141 @@
+#include <wvn/system/worker_pool.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::sys;
+
+WorkerPool::WorkerPool()
+	: m_thread_count(1)
+	, m_workers{}
+	, m_mutex()
+	, m_work_cv()
+	, m_done_cv()
+	, m_job(nullptr)
+	, m_job_generation(0)
+	, m_job_threads(0)
+	, m_jobs_remaining(0)
+	, m_shutting_down(false)
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+	stop_workers();
+}
+
+void WorkerPool::set_thread_count(u32 thread_count)
+{
+	thread_count = CalcU::clamp(thread_count, 1, MAX_THREADS);
+
+	if (thread_count == m_thread_count) {
+		return;
+	}
+
+	stop_workers();
+
+	m_thread_count = thread_count;
+
+	start_workers();
+}
+
+u32 WorkerPool::thread_count() const
+{
+	return m_thread_count;
+}
+
+void WorkerPool::run(u32 job_threads, FunctionRef<void(u32)> job)
+{
+	wvn_ASSERT(!m_job, "[WORKER POOL|DEBUG] Can't start a job while another is running.");
+
+	job_threads = CalcU::clamp(job_threads, 1, m_thread_count);
+
+	if (job_threads == 1)
+	{
+		job(0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_job = &job;
+		m_job_threads = job_threads;
+		m_jobs_remaining = job_threads - 1;
+		m_job_generation++;
+	}
+
+	m_work_cv.notify_all();
+
+	job(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done_cv.wait(lock, [this]() { return m_jobs_remaining == 0; });
+
+	m_job = nullptr;
+}
+
+void WorkerPool::start_workers()
+{
+	m_shutting_down = false;
+
+	for (u32 i = 1; i < m_thread_count; i++) {
+		m_workers[i] = new std::thread(&WorkerPool::worker_loop, this, i, m_job_generation);
+	}
+}
+
+void WorkerPool::stop_workers()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_shutting_down = true;
+	}
+
+	m_work_cv.notify_all();
+
+	for (u32 i = 1; i < MAX_THREADS; i++)
+	{
+		if (!m_workers[i]) {
+			continue;
+		}
+
+		m_workers[i]->join();
+
+		delete m_workers[i];
+		m_workers[i] = nullptr;
+	}
+}
+
+// the generation is handed over at creation, reading it once the thread is up could already see the first job's
+void WorkerPool::worker_loop(u32 thread_idx, u64 seen_generation)
+{
+	while (true)
+	{
+		const FunctionRef<void(u32)>* job = nullptr;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_work_cv.wait(lock, [&]() { return m_shutting_down || m_job_generation != seen_generation; });
+
+			if (m_shutting_down) {
+				return;
+			}
+
+			seen_generation = m_job_generation;
+
+			// not every thread is wanted for every job
+			if (thread_idx >= m_job_threads) {
+				continue;
+			}
+
+			job = m_job;
+		}
+
+		(*job)(thread_idx);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs_remaining--;
+		}
+
+		m_done_cv.notify_one();
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef WORKER_POOL_H_
+#define WORKER_POOL_H_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <wvn/common.h>
+#include <wvn/container/function.h>
+
+namespace wvn::sys
+{
+	/**
+	 * A handful of threads kept asleep between jobs, for systems that split their per frame work up by thread.
+	 * run() hands the same job to every thread it uses along with that thread's index, with the calling thread
+	 * taking index 0 and doing its share rather than sitting idle, and only returns once all of them have finished.
+	 * Thread indices are stable for the lifetime of the pool, so they can be used to pick per thread resources.
+	 * Root owns the one the engine's systems share, one job at a time, so they never compete for cores.
+	 * Jobs are expected to come from one thread at a time, and a job can't run() another.
+	 */
+	class WorkerPool
+	{
+	public:
+		static constexpr u32 MAX_THREADS = 8;
+
+		WorkerPool();
+		~WorkerPool();
+
+		// includes the thread calling run(), clamped to [1, MAX_THREADS]
+		void set_thread_count(u32 thread_count);
+		u32 thread_count() const;
+
+		// calls job(thread_idx) on the first job_threads threads (capped to the thread count) and waits for them
+		void run(u32 job_threads, FunctionRef<void(u32)> job);
+
+	private:
+		void start_workers();
+		void stop_workers();
+		void worker_loop(u32 thread_idx, u64 seen_generation);
+
+		u32 m_thread_count;
+
+		// shared with the worker threads, guarded by m_mutex
+		std::thread* m_workers[MAX_THREADS];
+		std::mutex m_mutex;
+		std::condition_variable m_work_cv;
+		std::condition_variable m_done_cv;
+		const FunctionRef<void(u32)>* m_job;
+		u64 m_job_generation;
+		u32 m_job_threads;
+		u32 m_jobs_remaining;
+		bool m_shutting_down;
+	};
+}
+
+#endif // WORKER_POOL_H_
@@ -0,0 +1,154 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+
+#include <wvn/container/vector.h>
+#include <wvn/animation/animator.h>
+#include <wvn/maths/calc.h>
+#include <wvn/system/worker_pool.h>
+
+using namespace wvn;
+using namespace wvn::anim;
+
+// a crowd of characters updated the way AnimationMgr::update_animators() does it,
+// the manager itself drags in the rest of the engine so its loop is repeated here
+namespace
+{
+	constexpr u32 JOINT_COUNT = 64;
+	constexpr u32 ANIMATORS_PER_JOB = 8; // AnimationMgr::ANIMATORS_PER_JOB
+	constexpr float DT = 1.0f / 60.0f;
+
+	Skeleton make_skeleton()
+	{
+		Skeleton skeleton;
+
+		for (u32 i = 0; i < JOINT_COUNT; i++) {
+			skeleton.add_joint("joint", i == 0 ? NO_JOINT : (i - 1) / 2, Vec3F(0.0f, 0.25f, 0.0f), Quat::identity());
+		}
+
+		return skeleton;
+	}
+
+	// every joint swinging at its own rate so compression can't throw the keys away
+	void make_clip(AnimationClip& clip, float rate)
+	{
+		RawClip raw;
+		raw.sample_rate = 30.0f;
+		raw.frame_count = 60;
+		raw.joint_count = JOINT_COUNT;
+
+		for (u32 f = 0; f < raw.frame_count; f++)
+		{
+			for (u32 j = 0; j < JOINT_COUNT; j++)
+			{
+				float angle = CalcF::sin(((float)f / raw.sample_rate) * rate * (1.0f + (float)j * 0.05f));
+
+				raw.positions.push_back(Vec3F(0.0f, 0.25f, 0.0f));
+				raw.rotations.push_back(Quat::from_axis_angle(Vec3F::right(), angle));
+				raw.scales.push_back(Vec3F::one());
+			}
+		}
+
+		clip.compress(raw);
+	}
+
+	struct Crowd
+	{
+		Skeleton skeleton;
+		AnimationClip walk;
+		AnimationClip wave;
+		Vector<Animator*> animators;
+
+		Crowd(u32 count)
+			: skeleton(make_skeleton())
+			, walk()
+			, wave()
+			, animators()
+		{
+			make_clip(walk, 3.0f);
+			make_clip(wave, 7.0f);
+
+			for (u32 i = 0; i < count; i++)
+			{
+				Animator* animator = new Animator(&skeleton);
+				animator->play(0, &walk);
+				animator->play(1, &wave, 0.5f);
+				animator->set_time(0, (float)i * 0.1f);
+				animators.push_back(animator);
+			}
+		}
+
+		~Crowd()
+		{
+			for (auto& animator : animators) {
+				delete animator;
+			}
+		}
+	};
+}
+
+static void BM_AnimatorUpdate(benchmark::State& state)
+{
+	Crowd crowd(state.range(0));
+
+	sys::WorkerPool pool;
+	pool.set_thread_count(state.range(1));
+
+	std::atomic<u32> next_job = 0;
+	u32 count = crowd.animators.size();
+
+	for (auto _ : state)
+	{
+		next_job = 0;
+
+		pool.run(pool.thread_count(), [&](u32)
+		{
+			while (true)
+			{
+				u32 begin = next_job.fetch_add(ANIMATORS_PER_JOB);
+
+				if (begin >= count) {
+					return;
+				}
+
+				u32 end = CalcU::min(begin + ANIMATORS_PER_JOB, count);
+
+				for (u32 i = begin; i < end; i++) {
+					crowd.animators[i]->update(DT);
+				}
+			}
+		});
+
+		benchmark::DoNotOptimize(crowd.animators[0]->skinning_matrices());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_AnimatorUpdate)
+	->ArgNames({ "animators", "threads" })
+	->ArgsProduct({ { 16, 64, 256 }, { 1, 4 } })
+	->Unit(benchmark::kMicrosecond)
+	->UseRealTime();
+
+// the cost of handing a job out and waiting for it, with nothing to do in it
+static void BM_WorkerPoolRun(benchmark::State& state)
+{
+	sys::WorkerPool pool;
+	pool.set_thread_count(state.range(0));
+
+	std::atomic<u32> calls = 0;
+
+	for (auto _ : state) {
+		pool.run(pool.thread_count(), [&](u32) { calls++; });
+	}
+
+	state.counters["calls"] = calls.load();
+}
+
+BENCHMARK(BM_WorkerPoolRun)
+	->ArgNames({ "threads" })
+	->Arg(1)
+	->Arg(4)
+	->Unit(benchmark::kMicrosecond)
+	->UseRealTime();
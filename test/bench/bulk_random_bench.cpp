@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <wvn/container/vector.h>
+#include <wvn/maths/bulk_random.h>
+#include <wvn/maths/random.h>
+
+using namespace wvn;
+
+// filling arrays through BulkRandom against the same loop over a scalar engine,
+// Random<std::mt19937> is what Random<> used to be before it switched to Xoshiro256
+namespace
+{
+	constexpr u64 SEED = 0x5eed;
+}
+
+static void BM_BulkBits(benchmark::State& state)
+{
+	Vector<u32> out(state.range(0));
+	BulkRandom rng(SEED);
+
+	for (auto _ : state)
+	{
+		rng.fill(out.data(), out.size());
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BulkUnitFloat(benchmark::State& state)
+{
+	Vector<float> out(state.range(0));
+	BulkRandom rng(SEED);
+
+	for (auto _ : state)
+	{
+		rng.fill(out.data(), out.size());
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BulkFloatRange(benchmark::State& state)
+{
+	Vector<float> out(state.range(0));
+	BulkRandom rng(SEED);
+
+	for (auto _ : state)
+	{
+		rng.fill(out.data(), out.size(), -10.0f, 10.0f);
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BulkIntRange(benchmark::State& state)
+{
+	Vector<int> out(state.range(0));
+	BulkRandom rng(SEED);
+
+	for (auto _ : state)
+	{
+		rng.fill(out.data(), out.size(), 1, 6);
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Engine>
+static void BM_ScalarBits(benchmark::State& state)
+{
+	Vector<u32> out(state.range(0));
+	Engine rng(SEED);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < out.size(); i++) {
+			out[i] = (u32)rng();
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Engine>
+static void BM_RandomFloatRange(benchmark::State& state)
+{
+	Vector<float> out(state.range(0));
+	Random<Engine> rng(SEED);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < out.size(); i++) {
+			out[i] = rng.real32(-10.0f, 10.0f);
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Engine>
+static void BM_RandomIntRange(benchmark::State& state)
+{
+	Vector<int> out(state.range(0));
+	Random<Engine> rng(SEED);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < out.size(); i++) {
+			out[i] = rng.integer(1, 6);
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BulkSeed(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		BulkRandom rng(SEED, state.range(0));
+		benchmark::DoNotOptimize(&rng);
+	}
+}
+
+BENCHMARK(BM_BulkBits)->Arg(4096);
+BENCHMARK(BM_BulkUnitFloat)->Arg(4096);
+BENCHMARK(BM_BulkFloatRange)->Arg(4096);
+BENCHMARK(BM_BulkIntRange)->Arg(4096);
+
+BENCHMARK_TEMPLATE(BM_ScalarBits, Xoshiro256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ScalarBits, PCG32)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ScalarBits, std::mt19937)->Arg(4096);
+
+BENCHMARK_TEMPLATE(BM_RandomFloatRange, Xoshiro256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RandomFloatRange, std::mt19937)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RandomIntRange, Xoshiro256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RandomIntRange, std::mt19937)->Arg(4096);
+
+BENCHMARK(BM_BulkSeed)->Arg(0)->Arg(3);
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <functional>
+
+#include <wvn/container/function.h>
+
+using namespace wvn;
+
+// constructing (and destroying) a wrapper around a lambda is where the inline storage pays off,
+// calling through one should cost about the same as std::function either way
+namespace
+{
+	// fits inline in both wrappers
+	struct SmallCapture
+	{
+		int* a;
+		int* b;
+	};
+
+	// fits inline in Function, but is past what std::function keeps inline in the common standard libraries
+	struct MediumCapture
+	{
+		int* a;
+		int* b;
+		int* c;
+		int* d;
+	};
+
+	// bigger than the inline storage, so both wrappers have to allocate
+	struct LargeCapture
+	{
+		int values[32];
+	};
+}
+
+template <typename Wrapper>
+static void BM_ConstructSmall(benchmark::State& state)
+{
+	int a = 1, b = 2;
+	SmallCapture capture = { &a, &b };
+
+	for (auto _ : state)
+	{
+		Wrapper fn = [capture](int x) -> int { return *capture.a + *capture.b + x; };
+		benchmark::DoNotOptimize(fn);
+	}
+}
+
+template <typename Wrapper>
+static void BM_ConstructMedium(benchmark::State& state)
+{
+	int a = 1, b = 2, c = 3, d = 4;
+	MediumCapture capture = { &a, &b, &c, &d };
+
+	for (auto _ : state)
+	{
+		Wrapper fn = [capture](int x) -> int { return *capture.a + *capture.b + *capture.c + *capture.d + x; };
+		benchmark::DoNotOptimize(fn);
+	}
+}
+
+template <typename Wrapper>
+static void BM_ConstructLarge(benchmark::State& state)
+{
+	LargeCapture capture = {};
+
+	for (auto _ : state)
+	{
+		Wrapper fn = [capture](int x) -> int { return capture.values[x & 31]; };
+		benchmark::DoNotOptimize(fn);
+	}
+}
+
+template <typename Wrapper>
+static void BM_Copy(benchmark::State& state)
+{
+	int a = 1, b = 2;
+	SmallCapture capture = { &a, &b };
+
+	Wrapper fn = [capture](int x) -> int { return *capture.a + *capture.b + x; };
+
+	for (auto _ : state)
+	{
+		Wrapper copy = fn;
+		benchmark::DoNotOptimize(copy);
+	}
+}
+
+template <typename Wrapper>
+static void BM_Call(benchmark::State& state)
+{
+	int a = 1, b = 2;
+	SmallCapture capture = { &a, &b };
+
+	Wrapper fn = [capture](int x) -> int { return *capture.a + *capture.b + x; };
+	int x = 0;
+
+	for (auto _ : state)
+	{
+		x = fn(x);
+		benchmark::DoNotOptimize(x);
+	}
+}
+
+static void BM_CallFunctionRef(benchmark::State& state)
+{
+	int a = 1, b = 2;
+	auto lambda = [&a, &b](int x) -> int { return a + b + x; };
+
+	FunctionRef<int(int)> fn = lambda;
+	int x = 0;
+
+	for (auto _ : state)
+	{
+		x = fn(x);
+		benchmark::DoNotOptimize(x);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_ConstructSmall, Function<int(int)>);
+BENCHMARK_TEMPLATE(BM_ConstructSmall, UniqueFunction<int(int)>);
+BENCHMARK_TEMPLATE(BM_ConstructSmall, std::function<int(int)>);
+
+BENCHMARK_TEMPLATE(BM_ConstructMedium, Function<int(int)>);
+BENCHMARK_TEMPLATE(BM_ConstructMedium, std::function<int(int)>);
+
+BENCHMARK_TEMPLATE(BM_ConstructLarge, Function<int(int)>);
+BENCHMARK_TEMPLATE(BM_ConstructLarge, std::function<int(int)>);
+
+BENCHMARK_TEMPLATE(BM_Copy, Function<int(int)>);
+BENCHMARK_TEMPLATE(BM_Copy, std::function<int(int)>);
+
+BENCHMARK_TEMPLATE(BM_Call, Function<int(int)>);
+BENCHMARK_TEMPLATE(BM_Call, UniqueFunction<int(int)>);
+BENCHMARK_TEMPLATE(BM_Call, std::function<int(int)>);
+BENCHMARK(BM_CallFunctionRef);
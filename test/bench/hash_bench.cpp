@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+#include <wvn/common.h>
+#include <wvn/container/vector.h>
+
+using namespace wvn;
+
+// std::hash on a string_view is the baseline, on libstdc++ that's murmur2 and on msvc it's fnv-1a
+namespace
+{
+	Vector<char> make_input(u64 size)
+	{
+		Vector<char> input(size);
+
+		for (u64 i = 0; i < size; i++) {
+			input[i] = (char)('a' + (i * 7) % 26);
+		}
+
+		return input;
+	}
+}
+
+static void BM_HashBytes(benchmark::State& state)
+{
+	Vector<char> input = make_input(state.range(0));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(input.data());
+		benchmark::DoNotOptimize(hash::bytes(0, input.data(), input.size()));
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdHash(benchmark::State& state)
+{
+	Vector<char> input = make_input(state.range(0));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(input.data());
+		benchmark::DoNotOptimize(std::hash<std::string_view>()(std::string_view(input.data(), input.size())));
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// hashing a u32 id, the common case for the engine's hash maps
+static void BM_HashInteger(benchmark::State& state)
+{
+	u32 key = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(hash::calc(&key));
+		key++;
+	}
+}
+
+BENCHMARK(BM_HashBytes)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK(BM_StdHash)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK(BM_HashInteger);
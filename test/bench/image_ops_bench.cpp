@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <wvn/graphics/image_ops.h>
+#include <wvn/container/vector.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+// the simd paths only kick in for what the compiler targets, configure with e.g. -DCMAKE_CXX_FLAGS=-march=native to time them
+namespace
+{
+	constexpr u64 PIXEL_COUNT = 1024 * 1024;
+
+	Vector<Colour> make_pixels(u64 count)
+	{
+		std::mt19937 rng(1234);
+		Vector<Colour> pixels(count);
+
+		for (u64 i = 0; i < count; i++) {
+			u32 bits = rng();
+			pixels[i] = Colour(bits & 0xFF, (bits >> 8) & 0xFF, (bits >> 16) & 0xFF, (bits >> 24) & 0xFF);
+		}
+
+		return pixels;
+	}
+}
+
+static void BM_SrgbToLinear(benchmark::State& state)
+{
+	Vector<Colour> src = make_pixels(PIXEL_COUNT);
+	Vector<float> dst(PIXEL_COUNT * 4);
+
+	for (auto _ : state)
+	{
+		imgops::srgb_to_linear(src.data(), dst.data(), PIXEL_COUNT);
+		benchmark::DoNotOptimize(dst.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * PIXEL_COUNT);
+}
+
+static void BM_LinearToSrgb(benchmark::State& state)
+{
+	Vector<Colour> pixels = make_pixels(PIXEL_COUNT);
+	Vector<float> src(PIXEL_COUNT * 4);
+	Vector<Colour> dst(PIXEL_COUNT);
+
+	imgops::srgb_to_linear(pixels.data(), src.data(), PIXEL_COUNT);
+
+	for (auto _ : state)
+	{
+		imgops::linear_to_srgb(src.data(), dst.data(), PIXEL_COUNT);
+		benchmark::DoNotOptimize(dst.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * PIXEL_COUNT);
+}
+
+static void BM_Rgba8ToRgba16f(benchmark::State& state)
+{
+	Vector<Colour> src = make_pixels(PIXEL_COUNT);
+	Vector<u16> dst(PIXEL_COUNT * 4);
+
+	for (auto _ : state)
+	{
+		imgops::rgba8_to_rgba16f(src.data(), dst.data(), PIXEL_COUNT);
+		benchmark::DoNotOptimize(dst.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * PIXEL_COUNT);
+}
+
+static void BM_Rgba16fToRgba8(benchmark::State& state)
+{
+	Vector<Colour> pixels = make_pixels(PIXEL_COUNT);
+	Vector<u16> src(PIXEL_COUNT * 4);
+	Vector<Colour> dst(PIXEL_COUNT);
+
+	imgops::rgba8_to_rgba16f(pixels.data(), src.data(), PIXEL_COUNT);
+
+	for (auto _ : state)
+	{
+		imgops::rgba16f_to_rgba8(src.data(), dst.data(), PIXEL_COUNT);
+		benchmark::DoNotOptimize(dst.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * PIXEL_COUNT);
+}
+
+static void BM_PremultiplyAlpha(benchmark::State& state)
+{
+	Vector<Colour> src = make_pixels(PIXEL_COUNT);
+	Vector<Colour> pixels(PIXEL_COUNT);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		pixels = src;
+		state.ResumeTiming();
+
+		imgops::premultiply_alpha(pixels.data(), PIXEL_COUNT);
+		benchmark::DoNotOptimize(pixels.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * PIXEL_COUNT);
+}
+
+// halving a 1024x1024 image with each filter
+static void BM_Resize(benchmark::State& state)
+{
+	constexpr u32 SRC_SIZE = 1024;
+	constexpr u32 DST_SIZE = SRC_SIZE / 2;
+
+	Vector<Colour> src = make_pixels(SRC_SIZE * SRC_SIZE);
+	Vector<Colour> dst(DST_SIZE * DST_SIZE);
+
+	imgops::ResampleFilter filter = (imgops::ResampleFilter)state.range(0);
+	bool srgb = state.range(1) != 0;
+
+	for (auto _ : state)
+	{
+		imgops::resize(src.data(), SRC_SIZE, SRC_SIZE, dst.data(), DST_SIZE, DST_SIZE, filter, srgb);
+		benchmark::DoNotOptimize(dst.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * SRC_SIZE * SRC_SIZE);
+}
+
+BENCHMARK(BM_SrgbToLinear)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LinearToSrgb)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Rgba8ToRgba16f)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Rgba16fToRgba8)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PremultiplyAlpha)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Resize)
+	->ArgNames({ "filter", "srgb" })
+	->ArgsProduct({ { imgops::RESAMPLE_FILTER_BOX, imgops::RESAMPLE_FILTER_TRIANGLE, imgops::RESAMPLE_FILTER_CATMULL_ROM, imgops::RESAMPLE_FILTER_LANCZOS3 }, { 0, 1 } })
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <wvn/graphics/light_cluster_grid.h>
+#include <wvn/graphics/light.h>
+#include <wvn/system/worker_pool.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	LightClusterView make_view()
+	{
+		return {
+			.position = Vec3F::zero(),
+			.direction = Vec3F::forward(),
+			.up = Vec3F::up(),
+			.fov = 75.0f,
+			.aspect = 16.0f / 9.0f,
+			.near = 0.1f,
+			.far = 200.0f,
+			.perspective = true
+		};
+	}
+
+	// point lights scattered through a box in front of the camera, roughly what a busy scene would bin
+	Vector<ClusterLightData> make_lights(u32 count)
+	{
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> lateral(-60.0f, 60.0f);
+		std::uniform_real_distribution<float> depth(1.0f, 180.0f);
+		std::uniform_real_distribution<float> range(1.0f, 8.0f);
+
+		Vector<ClusterLightData> lights;
+
+		for (u32 i = 0; i < count; i++)
+		{
+			Vec3F position = (Vec3F::forward() * depth(rng)) + Vec3F(lateral(rng), lateral(rng) * 0.5f, 0.0f);
+
+			ClusterLightData light = {};
+			light.position[0] = position.x;
+			light.position[1] = position.y;
+			light.position[2] = position.z;
+			light.range = range(rng);
+			light.colour[0] = light.colour[1] = light.colour[2] = 1.0f;
+			light.intensity = 1.0f;
+			light.type = LIGHT_TYPE_POINT;
+
+			lights.push_back(light);
+		}
+
+		return lights;
+	}
+}
+
+static void BM_LightClusterBuild(benchmark::State& state)
+{
+	LightClusterView view = make_view();
+	Vector<ClusterLightData> lights = make_lights(state.range(0));
+
+	sys::WorkerPool pool;
+	pool.set_thread_count(state.range(1));
+
+	LightClusterGrid grid;
+	grid.set_worker_pool(&pool);
+
+	for (auto _ : state)
+	{
+		grid.build(view, lights);
+		benchmark::DoNotOptimize(grid.light_indices().data());
+	}
+
+	state.counters["indices"] = grid.light_indices().size();
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_LightClusterBuild)
+	->ArgNames({ "lights", "threads" })
+	->ArgsProduct({ { 64, 256, 1024, 4096 }, { 1, 4 } })
+	->Unit(benchmark::kMicrosecond)
+	->UseRealTime();
@@ -0,0 +1,230 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <wvn/container/vector.h>
+#include <wvn/maths/mat4x4.h>
+#include <wvn/maths/quat.h>
+#include <wvn/maths/affine_3d.h>
+#include <wvn/maths/batch_transform.h>
+
+using namespace wvn;
+
+// built twice, once as is and once with wvn_SIMD_SCALAR defined (maths_scalar_bench),
+// so comparing the two runs gives the simd paths against the plain-array reference.
+// every iteration goes over a whole array so the inputs can't be folded away or kept in registers
+namespace
+{
+	constexpr u64 COUNT = 1024;
+
+	struct Inputs
+	{
+		Vector<Mat4x4> matrices;
+		Vector<Quat> quats;
+		Vector<Affine3D> affines;
+		Vector<Vec3F> vectors;
+		Vector<float> amounts;
+	};
+
+	const Inputs& inputs()
+	{
+		static Inputs result = []() {
+			std::mt19937 rng(5489);
+			std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+			Inputs in;
+
+			for (u64 i = 0; i < COUNT; i++)
+			{
+				Mat4x4 m;
+
+				for (int k = 0; k < 16; k++) {
+					m.data[k] = dist(rng);
+				}
+
+				// keep it comfortably invertible
+				m.m11 += 4.0f; m.m22 += 4.0f; m.m33 += 4.0f; m.m44 += 4.0f;
+
+				Affine3D a;
+
+				for (int k = 0; k < 9; k++) {
+					a.basis.data[k] = dist(rng);
+				}
+
+				a.origin = Vec3F(dist(rng), dist(rng), dist(rng)) * 100.0f;
+
+				in.matrices.push_back(m);
+				in.quats.push_back(Quat(dist(rng), dist(rng), dist(rng), dist(rng)).normalized());
+				in.affines.push_back(a);
+				in.vectors.push_back(Vec3F(dist(rng), dist(rng), dist(rng)) * 100.0f);
+				in.amounts.push_back((dist(rng) + 1.0f) * 0.5f);
+			}
+
+			return in;
+		}();
+
+		return result;
+	}
+}
+
+static void BM_Mat4Multiply(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Mat4x4> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = in.matrices[i] * in.matrices[(i + 1) % COUNT];
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+static void BM_Mat4Inverse(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Mat4x4> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = in.matrices[i].inverse();
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+static void BM_QuatMultiply(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Quat> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = in.quats[i] * in.quats[(i + 1) % COUNT];
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+static void BM_QuatNormalize(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Quat> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = (in.quats[i] * 3.0f).normalized();
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+static void BM_QuatSlerp(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Quat> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = Quat::slerp(in.quats[i], in.quats[(i + 1) % COUNT], in.amounts[i]);
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+static void BM_AffineCompose(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Affine3D> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = in.affines[i] * in.affines[(i + 1) % COUNT];
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+static void BM_AffineCreateTransform(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Affine3D> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = Affine3D::create_transform(in.vectors[i], in.quats[i], Vec3F::one(), in.vectors[(i + 1) % COUNT]);
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+// one point at a time through Affine3D::transform(), against the batched version below
+static void BM_TransformPoints(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	const Affine3D& mat = in.affines[0];
+	Vector<Vec3F> out(COUNT);
+
+	for (auto _ : state)
+	{
+		for (u64 i = 0; i < COUNT; i++) {
+			out[i] = Affine3D::transform(in.vectors[i], mat);
+		}
+
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+static void BM_BatchTransformPoints(benchmark::State& state)
+{
+	const Inputs& in = inputs();
+	Vector<Vec3F> out(COUNT);
+
+	for (auto _ : state)
+	{
+		batch::transform_points(out.data(), in.vectors.data(), COUNT, in.affines[0]);
+		benchmark::DoNotOptimize(out.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+BENCHMARK(BM_Mat4Multiply);
+BENCHMARK(BM_Mat4Inverse);
+BENCHMARK(BM_QuatMultiply);
+BENCHMARK(BM_QuatNormalize);
+BENCHMARK(BM_QuatSlerp);
+BENCHMARK(BM_AffineCompose);
+BENCHMARK(BM_AffineCreateTransform);
+BENCHMARK(BM_TransformPoints);
+BENCHMARK(BM_BatchTransformPoints);
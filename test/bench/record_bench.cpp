@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+#include <wvn/container/vector.h>
+#include <wvn/graphics/draw_chunks.h>
+#include <wvn/system/worker_pool.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+// VulkanCommandRecorder::record_pass() without vulkan, to see where splitting a pass over threads starts paying for itself.
+// each vkCmd* call record_draws() makes becomes a packet written into a plain buffer, which is cheaper than
+// a real driver, so this is a lower bound on how much work a chunk needs to cover the cost of handing it out
+namespace
+{
+	constexpr u32 PUSH_CONSTANT_WORDS = 16;
+
+	enum FakeCommand : u32
+	{
+		CMD_SET_VIEWPORT,
+		CMD_SET_SCISSOR,
+		CMD_BIND_VERTEX_BUFFER,
+		CMD_BIND_INDEX_BUFFER,
+		CMD_PUSH_CONSTANTS,
+		CMD_BIND_DESCRIPTOR_SETS,
+		CMD_BIND_PIPELINE,
+		CMD_DRAW_INDEXED,
+		CMD_EXECUTE_COMMANDS
+	};
+
+	struct FakeDraw
+	{
+		u32 pipeline;
+		u32 descriptor_set;
+		u32 vertex_buffer;
+		u32 index_buffer;
+		u32 index_count;
+		u32 push_constants_offset;
+		float viewport[6];
+		u32 scissor[4];
+	};
+
+	// stand-in for a command buffer, cleared rather than freed between frames like a reset command pool
+	struct FakeCommandBuffer
+	{
+		Vector<u32> words;
+
+		void push(FakeCommand cmd, const void* args, u64 size)
+		{
+			u64 offset = words.size();
+			words.resize(offset + 1 + (size / sizeof(u32)));
+			words[offset] = cmd;
+			std::memcpy(words.data() + offset + 1, args, size);
+		}
+	};
+
+	// same sequence of calls as VulkanCommandRecorder::record_draws()
+	void record_draws(FakeCommandBuffer& cmd, const FakeDraw* draws, u64 count, const u32* push_constants)
+	{
+		u32 bound_pipeline = ~0u;
+
+		for (u64 i = 0; i < count; i++)
+		{
+			const FakeDraw& draw = draws[i];
+
+			cmd.push(CMD_SET_VIEWPORT, draw.viewport, sizeof(draw.viewport));
+			cmd.push(CMD_SET_SCISSOR, draw.scissor, sizeof(draw.scissor));
+			cmd.push(CMD_BIND_VERTEX_BUFFER, &draw.vertex_buffer, sizeof(u32));
+			cmd.push(CMD_BIND_INDEX_BUFFER, &draw.index_buffer, sizeof(u32));
+			cmd.push(CMD_PUSH_CONSTANTS, push_constants + draw.push_constants_offset, PUSH_CONSTANT_WORDS * sizeof(u32));
+			cmd.push(CMD_BIND_DESCRIPTOR_SETS, &draw.descriptor_set, sizeof(u32));
+
+			if (draw.pipeline != bound_pipeline)
+			{
+				cmd.push(CMD_BIND_PIPELINE, &draw.pipeline, sizeof(u32));
+				bound_pipeline = draw.pipeline;
+			}
+
+			cmd.push(CMD_DRAW_INDEXED, &draw.index_count, sizeof(u32));
+		}
+	}
+
+	void make_pass(u32 draw_count, Vector<FakeDraw>& draws, Vector<u32>& push_constants)
+	{
+		for (u32 i = 0; i < draw_count; i++)
+		{
+			FakeDraw draw = {};
+			draw.pipeline = i / 32; // draws come sorted by pipeline
+			draw.descriptor_set = i;
+			draw.vertex_buffer = i % 97;
+			draw.index_buffer = i % 97;
+			draw.index_count = 36 + (i % 7) * 3;
+			draw.push_constants_offset = i * PUSH_CONSTANT_WORDS;
+			draws.push_back(draw);
+
+			for (u32 j = 0; j < PUSH_CONSTANT_WORDS; j++) {
+				push_constants.push_back(i + j);
+			}
+		}
+	}
+}
+
+static void BM_RecordPass(benchmark::State& state)
+{
+	u32 draw_count = state.range(0);
+	u32 thread_count = state.range(1);
+	u32 min_draws = state.range(2);
+
+	Vector<FakeDraw> draws;
+	Vector<u32> push_constants;
+	make_pass(draw_count, draws, push_constants);
+
+	sys::WorkerPool pool;
+	pool.set_thread_count(thread_count);
+
+	FakeCommandBuffer primary;
+	FakeCommandBuffer secondaries[sys::WorkerPool::MAX_THREADS];
+	DrawChunk chunks[sys::WorkerPool::MAX_THREADS];
+	u32 chunk_count = 0;
+
+	for (auto _ : state)
+	{
+		primary.words.clear();
+
+		chunk_count = split_draws(chunks, draws.size(), pool.thread_count(), min_draws);
+
+		if (chunk_count <= 1)
+		{
+			record_draws(primary, draws.data(), draws.size(), push_constants.data());
+		}
+		else
+		{
+			pool.run(chunk_count, [&](u32 thread_idx)
+			{
+				FakeCommandBuffer& cmd = secondaries[thread_idx];
+				const DrawChunk& chunk = chunks[thread_idx];
+
+				cmd.words.clear();
+				record_draws(cmd, draws.data() + chunk.begin, chunk.end - chunk.begin, push_constants.data());
+			});
+
+			for (u32 i = 0; i < chunk_count; i++) {
+				primary.push(CMD_EXECUTE_COMMANDS, &i, sizeof(u32));
+			}
+		}
+
+		benchmark::DoNotOptimize(primary.words.data());
+	}
+
+	state.counters["chunks"] = chunk_count;
+	state.SetItemsProcessed(state.iterations() * draw_count);
+}
+
+// the recorder's MIN_DRAWS_PER_CHUNK is 64, either side of it for comparison
+BENCHMARK(BM_RecordPass)
+	->ArgNames({ "draws", "threads", "min_draws" })
+	->ArgsProduct({ { 64, 256, 1024, 4096 }, { 1, 4 }, { 16, 64, 256 } })
+	->Unit(benchmark::kMicrosecond)
+	->UseRealTime();
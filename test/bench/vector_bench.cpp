@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <wvn/container/vector.h>
+#include <wvn/container/small_vector.h>
+#include <wvn/container/string.h>
+#include <wvn/maths/colour.h>
+
+using namespace wvn;
+
+// growth is where the relocation strategy shows up: trivially copyable types go through realloc,
+// opted in types (strings, nested vectors) are memcpy'd into a fresh buffer and the rest are moved one by one
+namespace
+{
+	template <typename T> T make_item(int i);
+
+	template <> int make_item<int>(int i) { return i; }
+	template <> Colour make_item<Colour>(int i) { return Colour(i & 255, (i >> 8) & 255, 0, 255); }
+	template <> String make_item<String>(int i) { return String(i & 1 ? "relocate" : "me"); }
+	template <> Vector<int> make_item<Vector<int>>(int i) { return Vector<int>(4, i); }
+
+	template <typename T> void insert_front(Vector<T>& container, const T& item) { container.insert(0, item); }
+	template <typename T> void insert_front(std::vector<T>& container, const T& item) { container.insert(container.begin(), item); }
+}
+
+template <typename Container, typename T>
+static void BM_PushBack(benchmark::State& state)
+{
+	const int count = state.range(0);
+
+	for (auto _ : state)
+	{
+		Container container;
+
+		for (int i = 0; i < count; i++) {
+			container.push_back(make_item<T>(i));
+		}
+
+		benchmark::DoNotOptimize(container.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename Container, typename T>
+static void BM_InsertFront(benchmark::State& state)
+{
+	const int count = state.range(0);
+
+	for (auto _ : state)
+	{
+		Container container;
+
+		for (int i = 0; i < count; i++) {
+			insert_front(container, make_item<T>(i));
+		}
+
+		benchmark::DoNotOptimize(container.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+// short lists that are built and thrown away, the case SmallVector exists for
+template <typename Container>
+static void BM_ShortList(benchmark::State& state)
+{
+	const int count = state.range(0);
+
+	for (auto _ : state)
+	{
+		Container container;
+
+		for (int i = 0; i < count; i++) {
+			container.push_back(i);
+		}
+
+		benchmark::DoNotOptimize(container.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_TEMPLATE(BM_PushBack, Vector<int>, int)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector<int>, int)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PushBack, Vector<Colour>, Colour)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector<Colour>, Colour)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PushBack, Vector<String>, String)->Range(1 << 6, 1 << 12);
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector<String>, String)->Range(1 << 6, 1 << 12);
+BENCHMARK_TEMPLATE(BM_PushBack, Vector<Vector<int>>, Vector<int>)->Range(1 << 6, 1 << 12);
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector<Vector<int>>, Vector<int>)->Range(1 << 6, 1 << 12);
+
+BENCHMARK_TEMPLATE(BM_InsertFront, Vector<int>, int)->Range(1 << 6, 1 << 10);
+BENCHMARK_TEMPLATE(BM_InsertFront, std::vector<int>, int)->Range(1 << 6, 1 << 10);
+BENCHMARK_TEMPLATE(BM_InsertFront, Vector<String>, String)->Range(1 << 6, 1 << 10);
+BENCHMARK_TEMPLATE(BM_InsertFront, std::vector<String>, String)->Range(1 << 6, 1 << 10);
+
+BENCHMARK_TEMPLATE(BM_ShortList, SmallVector<int, 16>)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortList, Vector<int>)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ShortList, std::vector<int>)->Arg(4)->Arg(16)->Arg(64);
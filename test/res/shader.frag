@@ -9,12 +9,89 @@ layout (binding = 0) uniform UniformBufferObject {
 layout (binding = 1) uniform sampler2D main_texture;
 layout (binding = 2) uniform samplerCube skybox;
 
+// LightClusterGrid's output, storage buffers are bound after the 2 ubos and all 16 texture slots
+// see RenderingMgr::LIGHT_CLUSTER_*_SLOT, the layouts match ClusterLightData, LightClusterParams & LightCluster
+
+const uint GRID_X = 16;
+const uint GRID_Y = 9;
+const uint GRID_Z = 24;
+
+const uint LIGHT_TYPE_POINT = 1;
+const uint LIGHT_TYPE_SPOT = 3;
+
+struct ClusterLight
+{
+	vec3 position;
+	float range;
+	vec3 colour;
+	float intensity;
+	vec3 direction;
+	uint type;
+};
+
+layout (std430, binding = 18) readonly buffer ClusterLights {
+	ClusterLight lights[];
+};
+
+layout (std430, binding = 19) readonly buffer ClusterLightIndices {
+	uint light_indices[];
+};
+
+layout (std430, binding = 20) readonly buffer Clusters {
+	float near;
+	float log_depth_ratio;
+	vec2 screen_size;
+	uvec2 clusters[]; // offset, count
+};
+
 layout (location = 0) in vec3 frag_colour;
 layout (location = 1) in vec2 frag_uv;
 layout (location = 2) in vec3 frag_position;
+layout (location = 3) in vec3 frag_world_position;
+layout (location = 4) in float frag_view_depth;
 
 layout (location = 0) out vec4 o_colour;
 
+// same mapping as LightClusterGrid, tiles count up from the bottom of the screen & slices are exponential in depth
+uint cluster_index()
+{
+	uint x = min(uint(gl_FragCoord.x / screen_size.x * float(GRID_X)), GRID_X - 1);
+	uint y = min(uint((1.0 - (gl_FragCoord.y / screen_size.y)) * float(GRID_Y)), GRID_Y - 1);
+	uint z = uint(clamp(log(max(frag_view_depth, near) / near) / log_depth_ratio * float(GRID_Z), 0.0, float(GRID_Z - 1)));
+
+	return x + (y * GRID_X) + (z * GRID_X * GRID_Y);
+}
+
+// only the lights binned into this fragment's cluster are looked at
+vec3 cluster_lighting()
+{
+	uvec2 cluster = clusters[cluster_index()];
+	vec3 result = vec3(0.0);
+
+	for (uint i = 0; i < cluster.y; i++)
+	{
+		ClusterLight light = lights[light_indices[cluster.x + i]];
+
+		vec3 to_light = light.position - frag_world_position;
+		float distance = length(to_light);
+
+		if (distance >= light.range) {
+			continue;
+		}
+
+		float attenuation = 1.0 - (distance / light.range);
+		attenuation *= attenuation;
+
+		if (light.type == LIGHT_TYPE_SPOT) {
+			attenuation *= smoothstep(0.8, 0.9, dot(-to_light / distance, normalize(light.direction)));
+		}
+
+		result += light.colour * light.intensity * attenuation;
+	}
+
+	return result;
+}
+
 void main()
 {
 	vec3 dir = normalize(frag_position);
@@ -22,5 +99,5 @@ void main()
 	vec4 texture_colour = texture(main_texture, frag_uv) * vec4(frag_colour, 1.0);
 	o_colour = mix(reflected_colour, vec4(0.5), 0.2);
 	o_colour = mix(o_colour, texture_colour, 0.5);
-	o_colour = vec4(frag_uv, 0.0, 1.0);
+	o_colour.rgb += texture_colour.rgb * cluster_lighting();
 }
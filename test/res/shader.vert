@@ -13,11 +13,18 @@ layout (location = 2) in vec3 i_colour;
 layout (location = 0) out vec3 frag_colour;
 layout (location = 1) out vec2 frag_uv;
 layout (location = 2) out vec3 frag_position;
+layout (location = 3) out vec3 frag_world_position;
+layout (location = 4) out float frag_view_depth;
 
 void main()
 {
-	gl_Position = ubo.proj * ubo.view * mat4(ubo.model) * vec4(i_position, 1.0);
+	vec4 world_position = mat4(ubo.model) * vec4(i_position, 1.0);
+	vec4 view_position = ubo.view * world_position;
+
+	gl_Position = ubo.proj * view_position;
 	frag_colour = i_colour;
 	frag_uv = i_uv;
 	frag_position = i_position;
+	frag_world_position = world_position.xyz;
+	frag_view_depth = -view_position.z;
 }
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <wvn/graphics/block_compression.h>
+#include <wvn/maths/calc.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	// texels on a straight line through colour space, which a single pair of endpoints can cover,
+	// the widest channel spans 150 so every format's error is bounded by half a palette step of that
+	void make_gradient_block(Colour* texels)
+	{
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++) {
+			texels[i] = Colour(40 + (i * 10), 200 - (i * 8), 90 + (i * 5), 255 - (i * 6));
+		}
+	}
+
+	u32 max_channel_error(const Colour* a, const Colour* b, u32 channels)
+	{
+		u32 result = 0;
+
+		for (u32 i = 0; i < bc::BLOCK_TEXELS; i++) {
+			for (u32 c = 0; c < channels; c++) {
+				result = CalcU::max(result, (u32)CalcI::abs((int)a[i].data[c] - (int)b[i].data[c]));
+			}
+		}
+
+		return result;
+	}
+
+	u32 round_trip_error(TextureFormat format, const Colour* texels, u32 channels)
+	{
+		byte block[16] = {};
+		Colour decoded[bc::BLOCK_TEXELS];
+
+		bc::encode_block(format, texels, block);
+		bc::decode_block(format, block, decoded);
+
+		return max_channel_error(texels, decoded, channels);
+	}
+}
+
+TEST(BlockCompressionTest, LevelSizeRoundsUpToWholeBlocks)
+{
+	EXPECT_EQ(bc::level_size(TEX_FORMAT_BC1_RGBA_UNORM, 4, 4), 8);
+	EXPECT_EQ(bc::level_size(TEX_FORMAT_BC7_UNORM, 5, 4), 32);
+	EXPECT_EQ(bc::level_size(TEX_FORMAT_BC3_UNORM, 1, 1), 16);
+	EXPECT_EQ(bc::level_size(TEX_FORMAT_BC5_UNORM, 0, 0), 16);
+	EXPECT_EQ(bc::level_size(TEX_FORMAT_R8G8B8A8_UNORM, 16, 16), 0);
+}
+
+TEST(BlockCompressionTest, SolidBlocksOnlyLoseEndpointPrecision)
+{
+	Colour texels[bc::BLOCK_TEXELS];
+
+	for (auto& texel : texels) {
+		texel = Colour(123, 45, 210, 255);
+	}
+
+	// 5:6:5 endpoints for bc1 & bc3 colour, 7 bits plus a shared bit for bc7 mode 6
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC1_RGBA_UNORM, texels, 3), 4);
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC3_UNORM, texels, 4), 4);
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC5_UNORM, texels, 2), 1);
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC7_UNORM, texels, 4), 1);
+}
+
+TEST(BlockCompressionTest, GradientBlocksStayWithinTheFormatsErrorBound)
+{
+	Colour texels[bc::BLOCK_TEXELS];
+	make_gradient_block(texels);
+
+	// 4, 8 & 16 entry palettes, plus the endpoints' own quantisation
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC1_RGBA_UNORM, texels, 3), 25 + 4);
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC3_UNORM, texels, 4), 25 + 4);
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC5_UNORM, texels, 2), 11 + 1);
+	EXPECT_LE(round_trip_error(TEX_FORMAT_BC7_UNORM, texels, 4), 5 + 1);
+}
+
+// eight interpolated values over the full range, so no value is further than half a step from one of them
+TEST(BlockCompressionTest, BC4RampIsWithinHalfAPaletteStep)
+{
+	u8 values[bc::BLOCK_TEXELS];
+	u8 decoded[bc::BLOCK_TEXELS];
+	byte block[8] = {};
+
+	for (u32 i = 0; i < bc::BLOCK_TEXELS; i++) {
+		values[i] = (u8)((i * 255) / (bc::BLOCK_TEXELS - 1));
+	}
+
+	bc::encode_bc4(values, block);
+	bc::decode_bc4(block, decoded);
+
+	for (u32 i = 0; i < bc::BLOCK_TEXELS; i++) {
+		EXPECT_LE(CalcI::abs((int)values[i] - (int)decoded[i]), 19) << "texel " << i;
+	}
+}
+
+TEST(BlockCompressionTest, BC1PunchThroughKeepsTransparentTexelsTransparent)
+{
+	Colour texels[bc::BLOCK_TEXELS];
+	make_gradient_block(texels);
+
+	for (u32 i = 0; i < bc::BLOCK_TEXELS; i += 2) {
+		texels[i].a = 0;
+	}
+
+	byte block[8] = {};
+	Colour decoded[bc::BLOCK_TEXELS];
+
+	bc::encode_bc1(texels, block, true);
+	bc::decode_bc1(block, decoded, false);
+
+	for (u32 i = 0; i < bc::BLOCK_TEXELS; i++) {
+		EXPECT_EQ(decoded[i].a, (i % 2 == 0) ? 0 : 255) << "texel " << i;
+	}
+}
+
+TEST(BlockCompressionTest, BC7OnlyDecodesMode6)
+{
+	Colour texels[bc::BLOCK_TEXELS];
+	make_gradient_block(texels);
+
+	byte block[16] = {};
+	Colour decoded[bc::BLOCK_TEXELS];
+
+	bc::encode_bc7(texels, block);
+	EXPECT_TRUE(bc::decode_bc7(block, decoded));
+
+	// the mode is the position of the lowest set bit, so this is mode 0
+	byte mode_0[16] = { 0x01 };
+	EXPECT_FALSE(bc::decode_bc7(mode_0, decoded));
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <cmath>
+
+#include <wvn/container/vector.h>
+#include <wvn/maths/bulk_random.h>
+
+using namespace wvn;
+
+// the seeds are fixed, so the statistical bounds below either always pass or always fail, they can't flake.
+// chi-squared limits are around the 99.9th percentile for their degrees of freedom
+namespace
+{
+	constexpr u64 SEED = 0x5eed;
+
+	double chi_squared(const Vector<u64>& bins, u64 total)
+	{
+		double expected = (double)total / (double)bins.size();
+		double result = 0.0;
+
+		for (u64 count : bins) {
+			result += ((double)count - expected) * ((double)count - expected) / expected;
+		}
+
+		return result;
+	}
+
+	double correlation(const Vector<float>& a, const Vector<float>& b, u64 offset)
+	{
+		u64 count = a.size() - offset;
+		double mean_a = 0.0, mean_b = 0.0;
+
+		for (u64 i = 0; i < count; i++)
+		{
+			mean_a += a[i];
+			mean_b += b[i + offset];
+		}
+
+		mean_a /= (double)count;
+		mean_b /= (double)count;
+
+		double cov = 0.0, var_a = 0.0, var_b = 0.0;
+
+		for (u64 i = 0; i < count; i++)
+		{
+			double da = a[i] - mean_a;
+			double db = b[i + offset] - mean_b;
+
+			cov += da * db;
+			var_a += da * da;
+			var_b += db * db;
+		}
+
+		return cov / std::sqrt(var_a * var_b);
+	}
+}
+
+TEST(BulkRandomTest, LanesAreJumpedScalarStreams)
+{
+	constexpr u64 BLOCKS = 4;
+	constexpr u64 BLOCK_SIZE = BulkRandom::LANES * 2;
+
+	Vector<u32> bulk(BLOCKS * BLOCK_SIZE);
+	BulkRandom(SEED, 1).fill(bulk.data(), bulk.size());
+
+	Xoshiro256 scalar(SEED, 1);
+
+	for (int lane = 0; lane < BulkRandom::LANES; lane++)
+	{
+		Xoshiro256 lane_rng = scalar;
+
+		for (u64 block = 0; block < BLOCKS; block++)
+		{
+			u64 value = lane_rng();
+
+			ASSERT_EQ(bulk[(block * BLOCK_SIZE) + (lane * 2) + 0], (u32)value) << "lane " << lane << ", block " << block;
+			ASSERT_EQ(bulk[(block * BLOCK_SIZE) + (lane * 2) + 1], (u32)(value >> 32)) << "lane " << lane << ", block " << block;
+		}
+
+		scalar.jump();
+	}
+}
+
+TEST(BulkRandomTest, SameSeedAndStreamRepeat)
+{
+	Vector<u32> a(1000), b(1000), c(1000);
+
+	BulkRandom(SEED, 2).fill(a.data(), a.size());
+	BulkRandom(SEED, 2).fill(b.data(), b.size());
+	BulkRandom(SEED, 3).fill(c.data(), c.size());
+
+	u64 same_as_other_stream = 0;
+
+	for (u64 i = 0; i < a.size(); i++)
+	{
+		ASSERT_EQ(a[i], b[i]);
+		same_as_other_stream += (a[i] == c[i]);
+	}
+
+	EXPECT_LE(same_as_other_stream, 1u);
+}
+
+TEST(BulkRandomTest, BitsAreBalanced)
+{
+	constexpr u64 COUNT = 1 << 18;
+
+	Vector<u32> values(COUNT);
+	BulkRandom(SEED).fill(values.data(), COUNT);
+
+	for (int bit = 0; bit < 32; bit++)
+	{
+		u64 ones = 0;
+
+		for (u32 v : values) {
+			ones += (v >> bit) & 1;
+		}
+
+		// 5 standard deviations either side of half
+		EXPECT_NEAR((double)ones / COUNT, 0.5, 5.0 * 0.5 / std::sqrt((double)COUNT)) << "bit " << bit;
+	}
+}
+
+TEST(BulkRandomTest, UnitFloatsAreUniform)
+{
+	constexpr u64 COUNT = 1 << 20;
+	constexpr u64 BINS = 1000;
+
+	Vector<float> values(COUNT);
+	BulkRandom(SEED).fill(values.data(), COUNT);
+
+	Vector<u64> bins(BINS, 0);
+	double mean = 0.0, variance = 0.0;
+
+	for (float v : values)
+	{
+		ASSERT_GE(v, 0.0f);
+		ASSERT_LT(v, 1.0f);
+
+		bins[(u64)(v * BINS)]++;
+		mean += v;
+	}
+
+	mean /= COUNT;
+
+	for (float v : values) {
+		variance += (v - mean) * (v - mean);
+	}
+
+	variance /= COUNT;
+
+	EXPECT_NEAR(mean, 0.5, 0.002);
+	EXPECT_NEAR(variance, 1.0 / 12.0, 0.001);
+	EXPECT_LT(chi_squared(bins, COUNT), 1143.0); // 999 degrees of freedom
+}
+
+TEST(BulkRandomTest, FloatRangeNeverReachesMax)
+{
+	constexpr u64 COUNT = 1 << 16;
+
+	// floats are 2 apart here, so anything past the halfway point of the last step would round up onto max
+	const float min = 16777216.0f;
+	const float max = 16777220.0f;
+
+	Vector<float> values(COUNT);
+	BulkRandom(SEED).fill(values.data(), COUNT, min, max);
+
+	u64 counts[3] = {};
+
+	for (float v : values)
+	{
+		ASSERT_GE(v, min);
+		ASSERT_LT(v, max);
+
+		counts[(u64)(v - min) / 2]++;
+	}
+
+	// nothing is lost to the top end, both representable values below max still come out
+	EXPECT_GT(counts[0], 0u);
+	EXPECT_GT(counts[1], 0u);
+
+	Vector<float> unit(COUNT);
+	BulkRandom(SEED).fill(unit.data(), COUNT, -3.0f, 5.0f);
+
+	for (float v : unit)
+	{
+		ASSERT_GE(v, -3.0f);
+		ASSERT_LT(v, 5.0f);
+	}
+}
+
+TEST(BulkRandomTest, SmallIntRangeIsUniform)
+{
+	constexpr u64 COUNT = 600000;
+
+	Vector<int> values(COUNT);
+	BulkRandom(SEED).fill(values.data(), COUNT, 1, 6);
+
+	Vector<u64> bins(6, 0);
+
+	for (int v : values)
+	{
+		ASSERT_GE(v, 1);
+		ASSERT_LE(v, 6);
+
+		bins[v - 1]++;
+	}
+
+	EXPECT_LT(chi_squared(bins, COUNT), 20.5); // 5 degrees of freedom
+}
+
+TEST(BulkRandomTest, FullIntRangeMapsEveryBitPattern)
+{
+	constexpr u64 COUNT = 4096;
+
+	Vector<u32> bits(COUNT);
+	Vector<int> values(COUNT);
+
+	BulkRandom(SEED).fill(bits.data(), COUNT);
+	BulkRandom(SEED).fill(values.data(), COUNT, INT_MIN, INT_MAX);
+
+	// a span of 2^32 makes the multiply a no-op, so every value is just the raw bits offset by INT_MIN
+	for (u64 i = 0; i < COUNT; i++) {
+		ASSERT_EQ(values[i], (int)((s64)INT_MIN + (s64)bits[i])) << "index " << i;
+	}
+
+	Vector<int> single(COUNT);
+	BulkRandom(SEED).fill(single.data(), COUNT, INT_MAX, INT_MAX);
+
+	for (int v : single) {
+		ASSERT_EQ(v, INT_MAX);
+	}
+}
+
+TEST(BulkRandomTest, NeighboursAndStreamsAreUncorrelated)
+{
+	constexpr u64 COUNT = 1 << 18;
+
+	Vector<float> a(COUNT), b(COUNT);
+
+	BulkRandom(SEED, 0).fill(a.data(), COUNT);
+	BulkRandom(SEED, 1).fill(b.data(), COUNT);
+
+	// lag 1 pairs up the two halves of one lane's result, 2 is the next lane and 16 is the same lane one block later
+	for (u64 lag : { 1, 2, 16 }) {
+		EXPECT_LT(std::abs(correlation(a, a, lag)), 0.01) << "lag " << lag;
+	}
+
+	EXPECT_LT(std::abs(correlation(a, b, 0)), 0.01);
+}
@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+
+#include <wvn/graphics/cascaded_shadow_map.h>
+#include <wvn/graphics/render_target.h>
+#include <wvn/graphics/render_target_mgr.h>
+#include <wvn/graphics/renderer_backend.h>
+#include <wvn/camera.h>
+#include <wvn/root.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	class FakeTarget : public RenderTarget
+	{
+	public:
+		FakeTarget(u32 width, u32 height) : RenderTarget(width, height) { }
+
+		void clean_up() override { }
+
+		const Texture* get_attachment(int idx) const override { return nullptr; }
+		const Texture* get_depth_attachment() const override { return nullptr; }
+
+		int get_msaa() const override { return 1; }
+
+		void set_clear_colour(const Colour& colour) override { }
+		void set_depth_stencil_clear(float depth, u32 stencil) override { }
+	};
+
+	class FakeTargetMgr : public RenderTargetMgr
+	{
+	protected:
+		RenderTarget* create_target(u32 width, u32 height) override { return new FakeTarget(width, height); }
+		RenderTarget* create_depth_target(u32 width, u32 height) override { return new FakeTarget(width, height); }
+	};
+
+	// Mat4x4::create_orthographic_ext() only asks the backend which way y points
+	class FakeBackend : public RendererBackend
+	{
+	public:
+		RendererBackendProperties properties() override { return { .y_positive_down = false, .bindless_textures = false }; }
+		RendererBackendFrameStats frame_stats() const override { return {}; }
+
+		void begin_render() override { }
+		void render(const RenderOp& op) override { }
+		void end_render() override { }
+		void swap_buffers() override { }
+
+		void resource_barrier(const Texture* texture, RenderResourceState before, RenderResourceState after) override { }
+
+		Backbuffer* create_backbuffer() override { return nullptr; }
+		void set_render_target(RenderTarget* target) override { }
+
+		void toggle_blending(bool enabled) override { }
+		void set_blend_write_mask(bool r, bool g, bool b, bool a) override { }
+		void set_blend_colour(const Blend& blend) override { }
+		void set_blend_alpha(const Blend& blend) override { }
+		void set_blend_constants(float r, float g, float b, float a) override { }
+		void get_blend_constants(float* constants) override { }
+		void set_blend_op(bool enabled, LogicOp op) override { }
+
+		void set_depth_params(bool depth_test, bool depth_write) override { }
+		void set_depth_op(CompareOp op) override { }
+		void set_depth_bounds_test(bool enabled) override { }
+		void set_depth_bounds(float min, float max) override { }
+		void set_depth_stencil_test(bool enabled) override { }
+
+		void set_viewport(const RectF& rect) override { }
+		void set_scissor(const RectI& rect) override { }
+
+		void set_sample_shading(bool enabled, float min_sample_shading) override { }
+		void set_cull_mode(CullMode cull) override { }
+
+		void set_texture(u32 idx, const Texture* texture) override { }
+		void set_sampler(u32 idx, TextureSampler* sampler) override { }
+
+		void set_storage_buffer(u32 idx, const GPUBuffer* buffer) override { }
+
+		u32 get_bindless_texture_index(const Texture* texture) override { return ~0u; }
+		u32 get_bindless_sampler_index(TextureSampler* sampler) override { return ~0u; }
+		u32 create_bindless_material() override { return ~0u; }
+		void update_bindless_material(u32 idx, const BindlessMaterialData& data) override { }
+
+		void bind_shader(const ShaderProgram* shader) override { }
+		void bind_shader_params(ShaderProgramType shader_type, const ShaderParameters& params) override { }
+
+		void set_push_constants(const ShaderParameters& params) override { }
+		void reset_push_constants() override { }
+
+		void on_window_resize(int width, int height) override { }
+	};
+
+	FakeBackend g_backend;
+
+	class CascadedShadowMapTest : public ::testing::Test
+	{
+	protected:
+		CascadedShadowMapTest()
+			: light(1)
+			, camera(Camera::CAM_PERSP, 1280.0f, 720.0f)
+		{
+			// slanted so the light isn't parallel to either up vector the light space basis can pick
+			light.set_orientation(Quat(Vec3F(0.3f, -1.0f, 0.2f).normalized()));
+
+			camera.fov = 75.0f;
+			camera.near = 0.1f;
+			camera.far = 500.0f;
+		}
+
+		FakeTargetMgr target_mgr;
+		Light light;
+		Camera camera;
+		HashMap<RenderableObjectID, RenderableObject*> objects;
+		CascadedShadowMap cascades;
+	};
+}
+
+// root.cpp brings up the whole engine, these two are all the maths needs from it
+Root* Root::get_singleton()
+{
+	return nullptr;
+}
+
+RendererBackend* Root::renderer_backend()
+{
+	return &g_backend;
+}
+
+TEST(CascadedShadowMapSplitsTest, CoversTheWholeRangeInOrder)
+{
+	float splits[Light::MAX_SHADOW_CASCADES + 1] = {};
+
+	CascadedShadowMap::calc_splits(0.5f, 100.0f, 0.75f, Light::MAX_SHADOW_CASCADES, splits);
+
+	EXPECT_FLOAT_EQ(splits[0], 0.5f);
+	EXPECT_FLOAT_EQ(splits[Light::MAX_SHADOW_CASCADES], 100.0f);
+
+	for (u32 i = 0; i < Light::MAX_SHADOW_CASCADES; i++) {
+		EXPECT_LT(splits[i], splits[i + 1]);
+	}
+}
+
+TEST(CascadedShadowMapSplitsTest, LambdaBlendsBetweenUniformAndLogarithmic)
+{
+	float uniform[3] = {};
+	float logarithmic[3] = {};
+	float blended[3] = {};
+
+	CascadedShadowMap::calc_splits(1.0f, 100.0f, 0.0f, 2, uniform);
+	CascadedShadowMap::calc_splits(1.0f, 100.0f, 1.0f, 2, logarithmic);
+	CascadedShadowMap::calc_splits(1.0f, 100.0f, 0.5f, 2, blended);
+
+	EXPECT_FLOAT_EQ(uniform[1], 50.5f);
+	EXPECT_NEAR(logarithmic[1], 10.0f, 0.001f);
+	EXPECT_NEAR(blended[1], (uniform[1] + logarithmic[1]) * 0.5f, 0.001f);
+}
+
+TEST(CascadedShadowMapSplitsTest, ClampsADegenerateRange)
+{
+	float splits[2] = {};
+
+	CascadedShadowMap::calc_splits(0.0f, 0.0f, 0.75f, 1, splits);
+
+	EXPECT_GT(splits[0], 0.0f);
+	EXPECT_GT(splits[1], splits[0]);
+}
+
+TEST_F(CascadedShadowMapTest, OnlyDirectionalLightsGetSplit)
+{
+	cascades.update(light, camera, objects, 0);
+	EXPECT_EQ(cascades.cascade_count(), Light::MAX_SHADOW_CASCADES);
+
+	light.set_type(LIGHT_TYPE_SPOT);
+
+	cascades.update(light, camera, objects, 0);
+	EXPECT_EQ(cascades.cascade_count(), 1);
+}
+
+TEST_F(CascadedShadowMapTest, SelectsTheFirstCascadeThatContainsTheSphere)
+{
+	cascades.update(light, camera, objects, 0);
+
+	Vec3F near_point = camera.position + (camera.direction * (cascades.cascade(0).split_far * 0.5f));
+	EXPECT_EQ(cascades.select_cascade(near_point, 0.01f), 0);
+
+	// cascades are spheres around their slice so they overlap, only the far end of the last slice is its alone
+	u32 last = cascades.cascade_count() - 1;
+	Vec3F far_point = camera.position + (camera.direction * (cascades.cascade(last).split_far * 0.99f));
+	EXPECT_EQ(cascades.select_cascade(far_point, 0.01f), last);
+
+	// anything too big for every cascade falls back to the widest one
+	EXPECT_EQ(cascades.select_cascade(near_point, 1000000.0f), last);
+}
+
+TEST_F(CascadedShadowMapTest, CachedCascadesStayValidUntilSomethingChanges)
+{
+	cascades.update(light, camera, objects, 0);
+
+	for (u32 i = 0; i < cascades.cascade_count(); i++)
+	{
+		EXPECT_TRUE(cascades.needs_render(i));
+		cascades.mark_rendered(i);
+	}
+
+	cascades.update(light, camera, objects, 0);
+
+	for (u32 i = 0; i < cascades.cascade_count(); i++) {
+		EXPECT_FALSE(cascades.needs_render(i));
+	}
+
+	// a static object having moved invalidates every cascade
+	cascades.update(light, camera, objects, 1);
+
+	for (u32 i = 0; i < cascades.cascade_count(); i++) {
+		EXPECT_TRUE(cascades.needs_render(i));
+	}
+}
+
+TEST_F(CascadedShadowMapTest, MovingTheCameraInvalidatesTheCascades)
+{
+	cascades.update(light, camera, objects, 0);
+
+	for (u32 i = 0; i < cascades.cascade_count(); i++) {
+		cascades.mark_rendered(i);
+	}
+
+	// far enough to cross a shadow map texel in every cascade
+	camera.position = Vec3F(50.0f, 0.0f, 50.0f);
+	cascades.update(light, camera, objects, 0);
+
+	for (u32 i = 0; i < cascades.cascade_count(); i++) {
+		EXPECT_TRUE(cascades.needs_render(i));
+	}
+}
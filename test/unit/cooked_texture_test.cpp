@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <unistd.h>
+
+#include <wvn/graphics/cooked_texture.h>
+#include <wvn/graphics/block_compression.h>
+#include <wvn/root.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	// file layout offsets, see CookedTexture
+	constexpr u64 MAGIC_OFFSET = 0;
+	constexpr u64 VERSION_OFFSET = 4;
+	constexpr u64 DATA_SIZE_OFFSET = 24;
+	constexpr u64 HEADER_SIZE = 32;
+	constexpr u64 LEVEL_SIZE_OFFSET = HEADER_SIZE + 8;
+
+	// stream over a block of memory, so neither the tests nor the loader go anywhere near the system backend
+	class MemoryStream : public io::Stream
+	{
+	public:
+		void read(void* buffer, u64 length) const override
+		{
+			u64 count = CalcU::min(length, bytes.size() - cursor);
+			mem::copy(buffer, bytes.data() + cursor, count);
+			cursor += count;
+		}
+
+		void write(void* data, u64 length) const override
+		{
+			bytes.resize(cursor + length);
+			mem::copy(bytes.data() + cursor, data, length);
+			cursor += length;
+		}
+
+		void seek(s64 offset) const override { cursor = offset; }
+		void close() override { }
+
+		s64 position() const override { return cursor; }
+		s64 size() const override { return bytes.size(); }
+
+		template <typename T>
+		void poke(u64 offset, T value)
+		{
+			mem::copy(bytes.data() + offset, &value, sizeof(T));
+		}
+
+		mutable Vector<byte> bytes;
+		mutable u64 cursor = 0;
+	};
+
+	// a 16x8 bc1 texture with its full mip chain
+	MemoryStream make_file()
+	{
+		CookedTexture texture;
+		texture.init(TEX_FORMAT_BC1_RGBA_UNORM, 16, 8);
+
+		for (u32 i = 0; i < 5; i++)
+		{
+			u32 width = CalcU::max(16 >> i, 1);
+			u32 height = CalcU::max(8 >> i, 1);
+
+			Vector<byte> level(bc::level_size(TEX_FORMAT_BC1_RGBA_UNORM, width, height), (byte)(i + 1));
+			texture.add_level(level.data(), level.size());
+		}
+
+		MemoryStream stream;
+		texture.save(stream);
+		stream.seek(0);
+
+		return stream;
+	}
+
+	// wvn_ERROR writes to stdout before it crashes and death tests only see stderr,
+	// unbuffered so the message isn't lost along with the process
+	void load_and_report(const io::Stream& stream)
+	{
+		::fflush(stdout);
+		::dup2(::fileno(stderr), ::fileno(stdout));
+		::setvbuf(stdout, nullptr, _IONBF, 0);
+
+		CookedTexture texture;
+		texture.load(stream);
+	}
+}
+
+// root.cpp brings up the whole engine, the base stream only reaches for it when it wraps a real file
+Root* Root::get_singleton()
+{
+	return nullptr;
+}
+
+sys::SystemBackend* Root::system_backend()
+{
+	return nullptr;
+}
+
+TEST(CookedTextureTest, SavedTexturesLoadBackTheSame)
+{
+	MemoryStream stream = make_file();
+
+	CookedTexture texture;
+	ASSERT_TRUE(texture.load(stream));
+
+	EXPECT_EQ(texture.format(), TEX_FORMAT_BC1_RGBA_UNORM);
+	EXPECT_EQ(texture.width(), 16);
+	EXPECT_EQ(texture.height(), 8);
+	ASSERT_EQ(texture.mip_count(), 5);
+
+	for (u32 i = 0; i < texture.mip_count(); i++)
+	{
+		EXPECT_EQ(texture.level_size(i), bc::level_size(TEX_FORMAT_BC1_RGBA_UNORM, CalcU::max(16 >> i, 1), CalcU::max(8 >> i, 1)));
+		EXPECT_EQ(texture.level_data(i)[0], i + 1);
+		EXPECT_EQ((u64)texture.level_data(i) % CookedTexture::LEVEL_ALIGNMENT, (u64)texture.level_data(0) % CookedTexture::LEVEL_ALIGNMENT);
+	}
+}
+
+TEST(CookedTextureDeathTest, RejectsABadMagic)
+{
+	MemoryStream stream = make_file();
+	stream.poke<u32>(MAGIC_OFFSET, 0x20534444); // "DDS "
+
+	EXPECT_DEATH(load_and_report(stream), "bad magic: 20534444");
+}
+
+TEST(CookedTextureDeathTest, RejectsAnotherVersion)
+{
+	MemoryStream stream = make_file();
+	stream.poke<u32>(VERSION_OFFSET, CookedTexture::VERSION + 1);
+
+	EXPECT_DEATH(load_and_report(stream), "Unsupported cooked texture version");
+}
+
+TEST(CookedTextureDeathTest, RejectsATruncatedHeader)
+{
+	MemoryStream stream = make_file();
+	stream.bytes.resize(HEADER_SIZE - 1);
+
+	EXPECT_DEATH(load_and_report(stream), "too short to hold a cooked texture header");
+}
+
+TEST(CookedTextureDeathTest, RejectsDataThatRunsPastTheEndOfTheFile)
+{
+	MemoryStream stream = make_file();
+	stream.bytes.resize(stream.bytes.size() - 1);
+
+	EXPECT_DEATH(load_and_report(stream), "claims more data than the file holds");
+}
+
+// a huge size has to be caught before anything gets allocated for it
+TEST(CookedTextureDeathTest, RejectsAHugeDataSize)
+{
+	MemoryStream stream = make_file();
+	stream.poke<u64>(DATA_SIZE_OFFSET, ~0ull);
+
+	EXPECT_DEATH(load_and_report(stream), "claims more data than the file holds");
+}
+
+TEST(CookedTextureDeathTest, RejectsALevelOfTheWrongSize)
+{
+	MemoryStream stream = make_file();
+	stream.poke<u64>(LEVEL_SIZE_OFFSET, 32);
+
+	EXPECT_DEATH(load_and_report(stream), "Level 0 doesn't match the size of a 16x8 level");
+}
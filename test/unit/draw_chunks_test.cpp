@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <wvn/graphics/draw_chunks.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	constexpr u32 MAX_CHUNKS = 8;
+
+	// chunks have to cover every draw exactly once, in order, with none left empty
+	void expect_covers(const DrawChunk* chunks, u32 count, u64 draw_count)
+	{
+		u64 expected_begin = 0;
+
+		for (u32 i = 0; i < count; i++)
+		{
+			EXPECT_EQ(chunks[i].begin, expected_begin) << "chunk " << i;
+			EXPECT_LT(chunks[i].begin, chunks[i].end) << "chunk " << i;
+			expected_begin = chunks[i].end;
+		}
+
+		EXPECT_EQ(expected_begin, draw_count);
+	}
+}
+
+TEST(DrawChunksTest, SmallPassesStayInOneChunk)
+{
+	DrawChunk chunks[MAX_CHUNKS];
+
+	EXPECT_EQ(split_draws(chunks, 0, MAX_CHUNKS, 64), 1u);
+	EXPECT_EQ(chunks[0].begin, 0u);
+	EXPECT_EQ(chunks[0].end, 0u);
+
+	EXPECT_EQ(split_draws(chunks, 127, MAX_CHUNKS, 64), 1u);
+	expect_covers(chunks, 1, 127);
+}
+
+TEST(DrawChunksTest, ChunksNeverDropBelowTheMinimum)
+{
+	DrawChunk chunks[MAX_CHUNKS];
+
+	for (u64 draw_count = 1; draw_count < 2000; draw_count++)
+	{
+		u32 count = split_draws(chunks, draw_count, MAX_CHUNKS, 64);
+
+		ASSERT_GE(count, 1u);
+		ASSERT_LE(count, MAX_CHUNKS);
+		expect_covers(chunks, count, draw_count);
+
+		if (count > 1)
+		{
+			for (u32 i = 0; i < count; i++) {
+				EXPECT_GE(chunks[i].end - chunks[i].begin, 64u) << draw_count << " draws, chunk " << i;
+			}
+		}
+	}
+}
+
+TEST(DrawChunksTest, LargePassesUseEveryThread)
+{
+	DrawChunk chunks[MAX_CHUNKS];
+
+	EXPECT_EQ(split_draws(chunks, 4096, 4, 64), 4u);
+	expect_covers(chunks, 4, 4096);
+
+	for (u32 i = 0; i < 4; i++) {
+		EXPECT_EQ(chunks[i].end - chunks[i].begin, 1024u);
+	}
+
+	// uneven counts are spread out instead of leaving the last chunk short or empty
+	EXPECT_EQ(split_draws(chunks, 5, 4, 1), 4u);
+	expect_covers(chunks, 4, 5);
+}
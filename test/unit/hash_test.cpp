@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <unordered_set>
+
+#include <wvn/common.h>
+
+using namespace wvn;
+
+namespace
+{
+	constexpr const char* TEXT = "the quick brown fox jumps over the lazy dog while the renderer rebuilds its cluster grid, twice";
+	constexpr u64 TEXT_LENGTH = 95;
+
+	// every prefix of TEXT hashed at compile time, covering the small, 16 byte and three lane paths
+	constexpr std::array<u64, TEXT_LENGTH + 1> compile_time_prefixes()
+	{
+		std::array<u64, TEXT_LENGTH + 1> result = {};
+
+		for (u64 i = 0; i <= TEXT_LENGTH; i++) {
+			result[i] = hash::bytes(0, TEXT, i);
+		}
+
+		return result;
+	}
+
+	// splitmix64, just to get inputs that have nothing to do with the hash being tested
+	u64 next_random(u64* state)
+	{
+		u64 z = ((*state) += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+}
+
+TEST(HashTest, PortableMultiplyMatchesTheWideOne)
+{
+	u64 state = 1;
+
+	for (int i = 0; i < 10000; i++)
+	{
+		u64 a = next_random(&state);
+		u64 b = next_random(&state);
+
+		u64 lo = 0, hi = 0;
+		hash::detail::mul128_portable(a, b, &lo, &hi);
+
+		u64 expected_lo = 0, expected_hi = 0;
+		hash::detail::mul128(a, b, &expected_lo, &expected_hi);
+
+		ASSERT_EQ(lo, expected_lo);
+		ASSERT_EQ(hi, expected_hi);
+	}
+
+	u64 lo = 0, hi = 0;
+	hash::detail::mul128_portable(~0ull, ~0ull, &lo, &hi);
+
+	EXPECT_EQ(lo, 1ull);
+	EXPECT_EQ(hi, ~0ull - 1);
+}
+
+TEST(HashTest, CompileTimeMatchesRuntime)
+{
+	constexpr std::array<u64, TEXT_LENGTH + 1> expected = compile_time_prefixes();
+
+	ASSERT_EQ(cstr::length(TEXT), TEXT_LENGTH);
+
+	for (u64 i = 0; i <= TEXT_LENGTH; i++) {
+		EXPECT_EQ(hash::bytes(0, (const void*)TEXT, i), expected[i]) << "length " << i;
+	}
+
+	constexpr u64 key = hash::str("light_cluster_grid");
+	EXPECT_EQ(hash::calc("light_cluster_grid"), key);
+}
+
+TEST(HashTest, LengthAndSeedChangeTheResult)
+{
+	std::unordered_set<u64> seen;
+
+	for (u64 i = 0; i <= TEXT_LENGTH; i++) {
+		EXPECT_TRUE(seen.insert(hash::bytes(0, TEXT, i)).second) << "length " << i;
+	}
+
+	// same bytes, different lengths, the zero padding mustn't make them collide (length 0 was already covered above)
+	char zeroes[64] = {};
+
+	for (u64 i = 1; i <= 64; i++) {
+		EXPECT_TRUE(seen.insert(hash::bytes(0, zeroes, i)).second) << "zero length " << i;
+	}
+
+	for (u64 seed = 1; seed < 64; seed++) {
+		EXPECT_TRUE(seen.insert(hash::bytes(seed, TEXT, TEXT_LENGTH)).second) << "seed " << seed;
+	}
+}
+
+TEST(HashTest, SingleBitFlipsAvalanche)
+{
+	constexpr u64 LENGTHS[] = { 3, 8, 16, 32, 64, 100 };
+	constexpr int SAMPLES = 64;
+
+	u64 state = 2;
+
+	for (u64 length : LENGTHS)
+	{
+		u8 input[100] = {};
+		u64 flips_per_bit[64] = {};
+		u64 total_flips = 0;
+		u64 trials = 0;
+
+		for (int s = 0; s < SAMPLES; s++)
+		{
+			for (u64 i = 0; i < length; i++) {
+				input[i] = (u8)next_random(&state);
+			}
+
+			u64 base = hash::bytes(0, input, length);
+
+			for (u64 bit = 0; bit < length * 8; bit++)
+			{
+				input[bit / 8] ^= (u8)(1 << (bit % 8));
+				u64 diff = base ^ hash::bytes(0, input, length);
+				input[bit / 8] ^= (u8)(1 << (bit % 8));
+
+				total_flips += std::popcount(diff);
+				trials++;
+
+				for (int out = 0; out < 64; out++) {
+					flips_per_bit[out] += (diff >> out) & 1;
+				}
+			}
+		}
+
+		// half of the output should change on average, and no output bit should be stuck or always follow the input
+		double average = (double)total_flips / (double)trials;
+		EXPECT_NEAR(average, 32.0, 1.0) << "length " << length;
+
+		for (int out = 0; out < 64; out++)
+		{
+			double probability = (double)flips_per_bit[out] / (double)trials;
+			EXPECT_NEAR(probability, 0.5, 0.1) << "length " << length << ", output bit " << out;
+		}
+	}
+}
+
+TEST(HashTest, SequentialKeysSpreadAcrossBuckets)
+{
+	constexpr u32 KEY_COUNT = 1 << 16;
+	constexpr u32 BUCKET_COUNT = 256;
+
+	std::unordered_set<u64> seen;
+	u32 low_buckets[BUCKET_COUNT] = {};
+	u32 high_buckets[BUCKET_COUNT] = {};
+
+	for (u32 i = 0; i < KEY_COUNT; i++)
+	{
+		u64 h = hash::calc(&i);
+
+		EXPECT_TRUE(seen.insert(h).second) << "key " << i;
+
+		low_buckets[h % BUCKET_COUNT]++;
+		high_buckets[h >> 56]++;
+	}
+
+	// chi-squared against a uniform spread, 255 degrees of freedom puts the 99.9th percentile at about 330
+	double expected = (double)KEY_COUNT / BUCKET_COUNT;
+	double low_chi2 = 0.0;
+	double high_chi2 = 0.0;
+
+	for (u32 b = 0; b < BUCKET_COUNT; b++)
+	{
+		low_chi2 += (low_buckets[b] - expected) * (low_buckets[b] - expected) / expected;
+		high_chi2 += (high_buckets[b] - expected) * (high_buckets[b] - expected) / expected;
+	}
+
+	EXPECT_LT(low_chi2, 330.0);
+	EXPECT_LT(high_chi2, 330.0);
+}
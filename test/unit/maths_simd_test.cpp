@@ -0,0 +1,414 @@
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+#include <wvn/container/vector.h>
+#include <wvn/maths/mat4x4.h>
+#include <wvn/maths/quat.h>
+#include <wvn/maths/affine_3d.h>
+#include <wvn/maths/batch_transform.h>
+#include <wvn/maths/simd.h>
+
+using namespace wvn;
+
+// the simd maths checked against a plain double precision version of the same operation.
+// the tolerances are a few float ulps scaled by the size of the terms involved, which is what
+// reordering or fusing the adds can cost, so they hold for sse, neon, fma and the scalar fallback alike
+namespace
+{
+	constexpr int SAMPLES = 10000;
+
+	struct Mat4D { double m[4][4]; }; // [row][column]
+	struct QuatD { double w, x, y, z; };
+
+	float at(const Mat4x4& mat, int row, int col) { return mat.data[(col * 4) + row]; }
+	float at(const Basis3D& mat, int row, int col) { return mat.data[(col * 3) + row]; }
+
+	Mat4D to_double(const Mat4x4& mat)
+	{
+		Mat4D result;
+
+		for (int r = 0; r < 4; r++) {
+			for (int c = 0; c < 4; c++) {
+				result.m[r][c] = at(mat, r, c);
+			}
+		}
+
+		return result;
+	}
+
+	Mat4D multiply(const Mat4D& a, const Mat4D& b)
+	{
+		Mat4D result = {};
+
+		for (int r = 0; r < 4; r++) {
+			for (int c = 0; c < 4; c++) {
+				for (int k = 0; k < 4; k++) {
+					result.m[r][c] += a.m[r][k] * b.m[k][c];
+				}
+			}
+		}
+
+		return result;
+	}
+
+	// gauss-jordan with partial pivoting
+	Mat4D inverse(Mat4D a)
+	{
+		Mat4D inv = {};
+
+		for (int i = 0; i < 4; i++) {
+			inv.m[i][i] = 1.0;
+		}
+
+		for (int c = 0; c < 4; c++)
+		{
+			int pivot = c;
+
+			for (int r = c + 1; r < 4; r++) {
+				if (std::abs(a.m[r][c]) > std::abs(a.m[pivot][c])) pivot = r;
+			}
+
+			std::swap(a.m[c], a.m[pivot]);
+			std::swap(inv.m[c], inv.m[pivot]);
+
+			double scale = 1.0 / a.m[c][c];
+
+			for (int k = 0; k < 4; k++)
+			{
+				a.m[c][k] *= scale;
+				inv.m[c][k] *= scale;
+			}
+
+			for (int r = 0; r < 4; r++)
+			{
+				if (r == c) {
+					continue;
+				}
+
+				double factor = a.m[r][c];
+
+				for (int k = 0; k < 4; k++)
+				{
+					a.m[r][k] -= factor * a.m[c][k];
+					inv.m[r][k] -= factor * inv.m[c][k];
+				}
+			}
+		}
+
+		return inv;
+	}
+
+	QuatD to_double(const Quat& q)
+	{
+		return { q.w, q.x, q.y, q.z };
+	}
+
+	QuatD multiply(const QuatD& a, const QuatD& b)
+	{
+		return {
+			(a.w * b.w) - (a.x * b.x) - (a.y * b.y) - (a.z * b.z),
+			(a.w * b.x) + (a.x * b.w) + (a.y * b.z) - (a.z * b.y),
+			(a.w * b.y) - (a.x * b.z) + (a.y * b.w) + (a.z * b.x),
+			(a.w * b.z) + (a.x * b.y) - (a.y * b.x) + (a.z * b.w)
+		};
+	}
+
+	QuatD normalized(const QuatD& q)
+	{
+		double length = std::sqrt((q.w * q.w) + (q.x * q.x) + (q.y * q.y) + (q.z * q.z));
+		return { q.w / length, q.x / length, q.y / length, q.z / length };
+	}
+
+	QuatD slerp(const QuatD& from, QuatD to, double amount)
+	{
+		double cos_theta = (from.w * to.w) + (from.x * to.x) + (from.y * to.y) + (from.z * to.z);
+
+		if (cos_theta < 0.0)
+		{
+			cos_theta = -cos_theta;
+			to = { -to.w, -to.x, -to.y, -to.z };
+		}
+
+		double theta = std::acos(std::min(cos_theta, 1.0));
+
+		if (theta < 1e-9) {
+			return normalized({ from.w + (to.w - from.w) * amount, from.x + (to.x - from.x) * amount, from.y + (to.y - from.y) * amount, from.z + (to.z - from.z) * amount });
+		}
+
+		double a = std::sin((1.0 - amount) * theta) / std::sin(theta);
+		double b = std::sin(amount * theta) / std::sin(theta);
+
+		return { (from.w * a) + (to.w * b), (from.x * a) + (to.x * b), (from.y * a) + (to.y * b), (from.z * a) + (to.z * b) };
+	}
+
+	class MathsSimdTest : public ::testing::Test
+	{
+	protected:
+		float value(float min, float max)
+		{
+			return std::uniform_real_distribution<float>(min, max)(m_rng);
+		}
+
+		Vec3F vec(float min, float max)
+		{
+			return Vec3F(value(min, max), value(min, max), value(min, max));
+		}
+
+		Quat rotation()
+		{
+			return Quat(value(-1.0f, 1.0f), value(-1.0f, 1.0f), value(-1.0f, 1.0f), value(-1.0f, 1.0f)).normalized();
+		}
+
+		// translation * rotation * scale with the scale kept away from zero, so the inverse is well conditioned.
+		// the rotation is written out here so the test doesn't depend on how Mat4x4 builds one
+		Mat4x4 trs()
+		{
+			Vec3F t = vec(-100.0f, 100.0f);
+			Vec3F s = vec(0.5f, 2.0f);
+			Quat q = rotation();
+
+			Mat4x4 r = Mat4x4(
+				1.0f - 2.0f * ((q.y * q.y) + (q.z * q.z)), 2.0f * ((q.x * q.y) - (q.z * q.w)), 2.0f * ((q.x * q.z) + (q.y * q.w)), 0.0f,
+				2.0f * ((q.x * q.y) + (q.z * q.w)), 1.0f - 2.0f * ((q.x * q.x) + (q.z * q.z)), 2.0f * ((q.y * q.z) - (q.x * q.w)), 0.0f,
+				2.0f * ((q.x * q.z) - (q.y * q.w)), 2.0f * ((q.y * q.z) + (q.x * q.w)), 1.0f - 2.0f * ((q.x * q.x) + (q.y * q.y)), 0.0f,
+				0.0f, 0.0f, 0.0f, 1.0f
+			);
+
+			return Mat4x4::create_translation(t.x, t.y, t.z) * r * Mat4x4::create_scale(s.x, s.y, s.z);
+		}
+
+		Mat4x4 any_matrix()
+		{
+			Mat4x4 result;
+
+			for (int i = 0; i < 16; i++) {
+				result.data[i] = value(-10.0f, 10.0f);
+			}
+
+			return result;
+		}
+
+		Affine3D affine()
+		{
+			Affine3D result;
+
+			for (int i = 0; i < 9; i++) {
+				result.basis.data[i] = value(-2.0f, 2.0f);
+			}
+
+			result.origin = vec(-100.0f, 100.0f);
+
+			return result;
+		}
+
+		std::mt19937 m_rng = std::mt19937(5489);
+	};
+}
+
+TEST_F(MathsSimdTest, ReportsTheSelectedPath)
+{
+	// not a check, just so the log says which implementation the rest of the results are for
+	const char* path = wvn_SIMD_SSE ? (wvn_SIMD_FMA ? "sse2 + fma" : "sse2") : (wvn_SIMD_NEON ? "neon" : "scalar");
+	std::printf("simd path: %s\n", path);
+
+	SUCCEED();
+}
+
+TEST_F(MathsSimdTest, MatrixMultiplyMatchesReference)
+{
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		Mat4x4 a = any_matrix();
+		Mat4x4 b = any_matrix();
+
+		Mat4x4 result = a * b;
+		Mat4D expected = multiply(to_double(a), to_double(b));
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				double magnitude = 0.0;
+
+				for (int k = 0; k < 4; k++) {
+					magnitude += std::abs((double)at(a, r, k) * at(b, k, c));
+				}
+
+				ASSERT_NEAR(at(result, r, c), expected.m[r][c], 4.0 * FLT_EPSILON * magnitude) << "sample " << i << ", m" << r + 1 << c + 1;
+			}
+		}
+	}
+}
+
+TEST_F(MathsSimdTest, MatrixInverseMatchesReference)
+{
+	double worst_identity_error = 0.0;
+
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		Mat4x4 m = trs();
+		Mat4x4 inv = m.inverse();
+
+		Mat4D expected = inverse(to_double(m));
+		Mat4D identity = multiply(to_double(m), to_double(inv));
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				ASSERT_NEAR(at(inv, r, c), expected.m[r][c], 1e-5 * std::max(1.0, std::abs(expected.m[r][c]))) << "sample " << i << ", m" << r + 1 << c + 1;
+
+				worst_identity_error = std::max(worst_identity_error, std::abs(identity.m[r][c] - (r == c ? 1.0 : 0.0)));
+			}
+		}
+	}
+
+	EXPECT_LT(worst_identity_error, 1e-4);
+}
+
+TEST_F(MathsSimdTest, QuatMultiplyMatchesReference)
+{
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		Quat a = rotation();
+		Quat b = rotation();
+
+		QuatD result = to_double(a * b);
+		QuatD expected = multiply(to_double(a), to_double(b));
+
+		// both are unit length so every term is at most 1
+		ASSERT_NEAR(result.w, expected.w, 4.0 * FLT_EPSILON * 4.0) << "sample " << i;
+		ASSERT_NEAR(result.x, expected.x, 4.0 * FLT_EPSILON * 4.0) << "sample " << i;
+		ASSERT_NEAR(result.y, expected.y, 4.0 * FLT_EPSILON * 4.0) << "sample " << i;
+		ASSERT_NEAR(result.z, expected.z, 4.0 * FLT_EPSILON * 4.0) << "sample " << i;
+	}
+}
+
+TEST_F(MathsSimdTest, QuatNormalizeAndSlerpMatchReference)
+{
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		Quat raw = Quat(value(-10.0f, 10.0f), value(-10.0f, 10.0f), value(-10.0f, 10.0f), value(-10.0f, 10.0f));
+
+		QuatD result = to_double(raw.normalized());
+		QuatD expected = normalized(to_double(raw));
+
+		ASSERT_NEAR(result.w, expected.w, 4.0 * FLT_EPSILON) << "sample " << i;
+		ASSERT_NEAR(result.x, expected.x, 4.0 * FLT_EPSILON) << "sample " << i;
+		ASSERT_NEAR(result.y, expected.y, 4.0 * FLT_EPSILON) << "sample " << i;
+		ASSERT_NEAR(result.z, expected.z, 4.0 * FLT_EPSILON) << "sample " << i;
+
+		Quat from = rotation();
+		Quat to = (i % 4 == 0) ? (from * Quat::from_axis_angle(Vec3F::up(), value(-0.05f, 0.05f))).normalized() : rotation(); // some nearly parallel pairs, for the lerp path
+		float amount = value(0.0f, 1.0f);
+
+		result = to_double(Quat::slerp(from, to, amount));
+		expected = slerp(to_double(from), to_double(to), amount);
+
+		// acos loses precision as the angle closes, so this is looser than the rest
+		ASSERT_NEAR(result.w, expected.w, 1e-5) << "sample " << i;
+		ASSERT_NEAR(result.x, expected.x, 1e-5) << "sample " << i;
+		ASSERT_NEAR(result.y, expected.y, 1e-5) << "sample " << i;
+		ASSERT_NEAR(result.z, expected.z, 1e-5) << "sample " << i;
+	}
+}
+
+TEST_F(MathsSimdTest, AffineComposeAndTransformMatchReference)
+{
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		Affine3D a = affine();
+		Affine3D b = affine();
+
+		Affine3D result = a * b;
+
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				double expected = 0.0;
+				double magnitude = 0.0;
+
+				for (int k = 0; k < 3; k++)
+				{
+					expected += (double)at(a.basis, r, k) * at(b.basis, k, c);
+					magnitude += std::abs((double)at(a.basis, r, k) * at(b.basis, k, c));
+				}
+
+				ASSERT_NEAR(at(result.basis, r, c), expected, 4.0 * FLT_EPSILON * magnitude) << "sample " << i << ", m" << r + 1 << c + 1;
+			}
+		}
+
+		// points are row vectors: p * basis + origin
+		Vec3F point = vec(-100.0f, 100.0f);
+		Vec3F transformed = Affine3D::transform(point, a);
+
+		const float* p = &point.x;
+		const float* t = &transformed.x;
+		const float* o = &a.origin.x;
+
+		for (int c = 0; c < 3; c++)
+		{
+			double expected = o[c];
+			double magnitude = std::abs(o[c]);
+
+			for (int k = 0; k < 3; k++)
+			{
+				expected += (double)p[k] * at(a.basis, k, c);
+				magnitude += std::abs((double)p[k] * at(a.basis, k, c));
+			}
+
+			ASSERT_NEAR(t[c], expected, 4.0 * FLT_EPSILON * magnitude) << "sample " << i << ", axis " << c;
+		}
+	}
+}
+
+TEST_F(MathsSimdTest, CreateTransformMatchesComposedForm)
+{
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		Vec3F position = vec(-100.0f, 100.0f);
+		Quat rot = rotation();
+		Vec3F scale = vec(0.5f, 2.0f);
+		Vec3F origin = vec(-10.0f, 10.0f);
+
+		Affine3D result = Affine3D::create_transform(position, rot, scale, origin);
+		Affine3D expected = Affine3D::create_translation(-origin) * Affine3D::create_scale(scale) * Affine3D::create_rotation(rot) * Affine3D::create_translation(position);
+
+		for (int k = 0; k < 9; k++) {
+			ASSERT_NEAR(result.basis.data[k], expected.basis.data[k], 1e-5f) << "sample " << i;
+		}
+
+		ASSERT_NEAR(result.origin.x, expected.origin.x, 1e-4f * (1.0f + std::abs(expected.origin.x))) << "sample " << i;
+		ASSERT_NEAR(result.origin.y, expected.origin.y, 1e-4f * (1.0f + std::abs(expected.origin.y))) << "sample " << i;
+		ASSERT_NEAR(result.origin.z, expected.origin.z, 1e-4f * (1.0f + std::abs(expected.origin.z))) << "sample " << i;
+	}
+}
+
+TEST_F(MathsSimdTest, BatchTransformMatchesSingleTransforms)
+{
+	constexpr u64 COUNT = 1027; // not a multiple of any vector width, so the tail gets exercised
+
+	Affine3D mat = affine();
+	Vector<Vec3F> points(COUNT);
+	Vector<Vec3F> transformed(COUNT);
+
+	for (u64 i = 0; i < COUNT; i++) {
+		points[i] = vec(-100.0f, 100.0f);
+	}
+
+	batch::transform_points(transformed.data(), points.data(), COUNT, mat);
+
+	for (u64 i = 0; i < COUNT; i++)
+	{
+		Vec3F expected = Affine3D::transform(points[i], mat);
+		float tolerance = 4.0f * FLT_EPSILON * (600.0f + std::abs(mat.origin.x) + std::abs(mat.origin.y) + std::abs(mat.origin.z));
+
+		ASSERT_NEAR(transformed[i].x, expected.x, tolerance) << "point " << i;
+		ASSERT_NEAR(transformed[i].y, expected.y, tolerance) << "point " << i;
+		ASSERT_NEAR(transformed[i].z, expected.z, tolerance) << "point " << i;
+	}
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <wvn/graphics/render_graph.h>
+#include <wvn/graphics/render_target.h>
+#include <wvn/graphics/render_target_mgr.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	class FakeTarget : public RenderTarget
+	{
+	public:
+		FakeTarget(u32 width, u32 height) : RenderTarget(width, height) { }
+
+		void clean_up() override { }
+
+		const Texture* get_attachment(int idx) const override { return nullptr; }
+		const Texture* get_depth_attachment() const override { return nullptr; }
+
+		int get_msaa() const override { return 1; }
+
+		void set_clear_colour(const Colour& colour) override { }
+		void set_depth_stencil_clear(float depth, u32 stencil) override { }
+	};
+
+	class FakeTargetMgr : public RenderTargetMgr
+	{
+	protected:
+		RenderTarget* create_target(u32 width, u32 height) override { return new FakeTarget(width, height); }
+		RenderTarget* create_depth_target(u32 width, u32 height) override { return new FakeTarget(width, height); }
+	};
+
+	void no_execute(const RenderGraph&)
+	{
+	}
+
+	const RenderGraph::Pass* find_pass(const RenderGraph& graph, const char* name)
+	{
+		for (auto& pass : graph.passes()) {
+			if (strcmp(pass->name, name) == 0) {
+				return pass;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool has_barrier(const RenderGraph::Pass* pass, RenderGraphResource resource, RenderResourceState before, RenderResourceState after)
+	{
+		for (auto& barrier : pass->barriers) {
+			if (barrier.resource == resource && barrier.before == before && barrier.after == after) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	class RenderGraphTest : public ::testing::Test
+	{
+	protected:
+		FakeTargetMgr target_mgr;
+		FakeTarget backbuffer = FakeTarget(1280, 720);
+		RenderGraph graph;
+	};
+}
+
+TEST_F(RenderGraphTest, CullsPassesThatNothingReads)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource unused = RENDER_GRAPH_INVALID_RESOURCE;
+
+	graph.add_pass("unused", [&](RenderGraphBuilder& builder) { unused = builder.write(builder.create("unused", { 256, 256, false })); }, no_execute);
+	graph.add_pass("forward", [&](RenderGraphBuilder& builder) { builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	EXPECT_TRUE(find_pass(graph, "unused")->culled);
+	EXPECT_FALSE(find_pass(graph, "forward")->culled);
+
+	ASSERT_EQ(graph.pass_order().size(), 1);
+	EXPECT_EQ(graph.pass_order()[0], 1);
+}
+
+TEST_F(RenderGraphTest, KeepsEverythingThatFeedsAnOutput)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource a = RENDER_GRAPH_INVALID_RESOURCE;
+	RenderGraphResource b = RENDER_GRAPH_INVALID_RESOURCE;
+
+	graph.add_pass("a", [&](RenderGraphBuilder& builder) { a = builder.write(builder.create("a", { 256, 256, true })); }, no_execute);
+	graph.add_pass("b", [&](RenderGraphBuilder& builder) { builder.read(a); b = builder.write(builder.create("b", { 256, 256, false })); }, no_execute);
+	graph.add_pass("forward", [&](RenderGraphBuilder& builder) { builder.read(b); builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	EXPECT_FALSE(find_pass(graph, "a")->culled);
+	EXPECT_FALSE(find_pass(graph, "b")->culled);
+	EXPECT_FALSE(find_pass(graph, "forward")->culled);
+	EXPECT_EQ(graph.pass_order().size(), 3);
+}
+
+TEST_F(RenderGraphTest, KeepsPassesWithSideEffects)
+{
+	graph.add_pass("readback", [&](RenderGraphBuilder& builder) { builder.set_side_effects(); }, no_execute);
+
+	graph.compile();
+
+	EXPECT_FALSE(find_pass(graph, "readback")->culled);
+}
+
+TEST_F(RenderGraphTest, KeepsEarlierWritersOfAResourceThatIsWrittenAgain)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+
+	graph.add_pass("first", [&](RenderGraphBuilder& builder) { builder.write(output); }, no_execute);
+	graph.add_pass("second", [&](RenderGraphBuilder& builder) { builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	EXPECT_FALSE(find_pass(graph, "first")->culled);
+	EXPECT_FALSE(find_pass(graph, "second")->culled);
+}
+
+TEST_F(RenderGraphTest, TransitionsFromWriteToRead)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource shadow = RENDER_GRAPH_INVALID_RESOURCE;
+
+	graph.add_pass("shadow", [&](RenderGraphBuilder& builder) { shadow = builder.write(builder.create("shadow", { 1024, 1024, true })); }, no_execute);
+	graph.add_pass("forward", [&](RenderGraphBuilder& builder) { builder.read(shadow); builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	const RenderGraph::Pass* shadow_pass = find_pass(graph, "shadow");
+	const RenderGraph::Pass* forward_pass = find_pass(graph, "forward");
+
+	ASSERT_EQ(shadow_pass->barriers.size(), 1);
+	EXPECT_TRUE(has_barrier(shadow_pass, shadow, RENDER_RESOURCE_STATE_UNDEFINED, RENDER_RESOURCE_STATE_DEPTH_ATTACHMENT));
+
+	ASSERT_EQ(forward_pass->barriers.size(), 2);
+	EXPECT_TRUE(has_barrier(forward_pass, shadow, RENDER_RESOURCE_STATE_DEPTH_ATTACHMENT, RENDER_RESOURCE_STATE_SHADER_READ));
+	EXPECT_TRUE(has_barrier(forward_pass, output, RENDER_RESOURCE_STATE_UNDEFINED, RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT));
+}
+
+TEST_F(RenderGraphTest, SkipsBarriersBetweenReads)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource shadow = RENDER_GRAPH_INVALID_RESOURCE;
+	RenderGraphResource other = RENDER_GRAPH_INVALID_RESOURCE;
+
+	graph.add_pass("shadow", [&](RenderGraphBuilder& builder) { shadow = builder.write(builder.create("shadow", { 1024, 1024, true })); }, no_execute);
+	graph.add_pass("first read", [&](RenderGraphBuilder& builder) { builder.read(shadow); other = builder.write(builder.create("other", { 256, 256, false })); }, no_execute);
+	graph.add_pass("second read", [&](RenderGraphBuilder& builder) { builder.read(shadow); builder.read(other); builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	const RenderGraph::Pass* second = find_pass(graph, "second read");
+
+	for (auto& barrier : second->barriers) {
+		EXPECT_NE(barrier.resource, shadow);
+	}
+}
+
+TEST_F(RenderGraphTest, StartsImportedTargetsInTheirInitialState)
+{
+	FakeTarget history(1280, 720);
+
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource imported = graph.import_target("history", &history, false, RENDER_RESOURCE_STATE_SHADER_READ);
+
+	graph.add_pass("forward", [&](RenderGraphBuilder& builder) { builder.read(imported); builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	for (auto& barrier : find_pass(graph, "forward")->barriers) {
+		EXPECT_NE(barrier.resource, imported);
+	}
+}
+
+TEST_F(RenderGraphTest, AliasesTransientsWithDisjointLifetimes)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource a = RENDER_GRAPH_INVALID_RESOURCE;
+	RenderGraphResource b = RENDER_GRAPH_INVALID_RESOURCE;
+	RenderGraphResource c = RENDER_GRAPH_INVALID_RESOURCE;
+	RenderGraphResource d = RENDER_GRAPH_INVALID_RESOURCE;
+
+	// a dies once b has read it, so c can take its place, but b is still alive when d is written
+	graph.add_pass("write a", [&](RenderGraphBuilder& builder) { a = builder.write(builder.create("a", { 512, 512, false })); }, no_execute);
+	graph.add_pass("write b", [&](RenderGraphBuilder& builder) { builder.read(a); b = builder.write(builder.create("b", { 512, 512, false })); }, no_execute);
+	graph.add_pass("write c", [&](RenderGraphBuilder& builder) { builder.read(b); c = builder.write(builder.create("c", { 512, 512, false })); }, no_execute);
+	graph.add_pass("write d", [&](RenderGraphBuilder& builder) { builder.read(c); d = builder.write(builder.create("d", { 512, 512, true })); }, no_execute);
+	graph.add_pass("forward", [&](RenderGraphBuilder& builder) { builder.read(b); builder.read(d); builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	const auto& resources = graph.resources();
+
+	EXPECT_EQ(resources[a].physical_idx, resources[c].physical_idx);
+	EXPECT_NE(resources[a].physical_idx, resources[b].physical_idx);
+	EXPECT_NE(resources[b].physical_idx, resources[c].physical_idx);
+
+	// same lifetime as nothing else, but a different description
+	EXPECT_NE(resources[d].physical_idx, resources[a].physical_idx);
+	EXPECT_NE(resources[d].physical_idx, resources[b].physical_idx);
+
+	EXPECT_EQ(graph.physical_target_count(), 3);
+}
+
+TEST_F(RenderGraphTest, OrdersAliasedWritesAfterThePreviousOccupantsReads)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource a = RENDER_GRAPH_INVALID_RESOURCE;
+	RenderGraphResource b = RENDER_GRAPH_INVALID_RESOURCE;
+	RenderGraphResource c = RENDER_GRAPH_INVALID_RESOURCE;
+
+	graph.add_pass("write a", [&](RenderGraphBuilder& builder) { a = builder.write(builder.create("a", { 512, 512, false })); }, no_execute);
+	graph.add_pass("write b", [&](RenderGraphBuilder& builder) { builder.read(a); b = builder.write(builder.create("b", { 512, 512, false })); }, no_execute);
+	graph.add_pass("write c", [&](RenderGraphBuilder& builder) { builder.read(b); c = builder.write(builder.create("c", { 512, 512, false })); }, no_execute);
+	graph.add_pass("forward", [&](RenderGraphBuilder& builder) { builder.read(b); builder.read(c); builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	ASSERT_EQ(graph.resources()[a].physical_idx, graph.resources()[c].physical_idx);
+
+	// a was last read by "write b", so c's first write has to wait on that read rather than start from nothing
+	const RenderGraph::Pass* write_c = find_pass(graph, "write c");
+
+	EXPECT_TRUE(has_barrier(write_c, c, RENDER_RESOURCE_STATE_SHADER_READ, RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT));
+	EXPECT_FALSE(has_barrier(write_c, c, RENDER_RESOURCE_STATE_UNDEFINED, RENDER_RESOURCE_STATE_COLOUR_ATTACHMENT));
+}
+
+TEST_F(RenderGraphTest, ResolvesImportedTargetsToThemselves)
+{
+	RenderGraphResource output = graph.import_output("backbuffer", &backbuffer);
+	RenderGraphResource shadow = RENDER_GRAPH_INVALID_RESOURCE;
+
+	graph.add_pass("shadow", [&](RenderGraphBuilder& builder) { shadow = builder.write(builder.create("shadow", { 1024, 1024, true })); }, no_execute);
+	graph.add_pass("forward", [&](RenderGraphBuilder& builder) { builder.read(shadow); builder.write(output); }, no_execute);
+
+	graph.compile();
+
+	EXPECT_EQ(graph.get_target(output), &backbuffer);
+	EXPECT_EQ(graph.physical_target_count(), 1);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <wvn/graphics/texture_cooker.h>
+#include <wvn/graphics/block_compression.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	// smooth in both directions, the kind of content the cooker's quality numbers are meant to describe
+	Vector<Colour> make_gradient(u32 width, u32 height)
+	{
+		Vector<Colour> texels(width * height);
+
+		for (u32 y = 0; y < height; y++)
+		{
+			for (u32 x = 0; x < width; x++)
+			{
+				u8 u = (u8)((x * 255) / width);
+				u8 v = (u8)((y * 255) / height);
+
+				texels[(y * width) + x] = Colour(u, v, (u8)((u + v) / 2), 255);
+			}
+		}
+
+		return texels;
+	}
+
+	Vector<byte> encode(TextureFormat format, const Vector<Colour>& texels, u32 width, u32 height, u32 thread_count)
+	{
+		Vector<byte> output(bc::level_size(format, width, height));
+		TextureCooker::encode_level(format, texels.data(), width, height, thread_count, output.data());
+		return output;
+	}
+}
+
+TEST(TextureCookerTest, EncodingOnSeveralThreadsMatchesOneThread)
+{
+	Vector<Colour> texels = make_gradient(64, 64);
+
+	Vector<byte> single = encode(TEX_FORMAT_BC7_UNORM, texels, 64, 64, 1);
+	Vector<byte> several = encode(TEX_FORMAT_BC7_UNORM, texels, 64, 64, 4);
+
+	ASSERT_EQ(single.size(), several.size());
+	EXPECT_EQ(mem::compare(single.data(), several.data(), single.size()), 0);
+}
+
+TEST(TextureCookerTest, SmoothGradientsKeepTheirQuality)
+{
+	Vector<Colour> texels = make_gradient(64, 64);
+
+	Vector<byte> bc7 = encode(TEX_FORMAT_BC7_UNORM, texels, 64, 64, 1);
+	Vector<byte> bc1 = encode(TEX_FORMAT_BC1_RGBA_UNORM, texels, 64, 64, 1);
+
+	double bc7_psnr = TextureCooker::calc_psnr(TEX_FORMAT_BC7_UNORM, texels.data(), 64, 64, bc7.data());
+	double bc1_psnr = TextureCooker::calc_psnr(TEX_FORMAT_BC1_RGBA_UNORM, texels.data(), 64, 64, bc1.data());
+
+	EXPECT_GT(bc7_psnr, 40.0);
+	EXPECT_GT(bc1_psnr, 32.0);
+	EXPECT_GT(bc7_psnr, bc1_psnr);
+}
+
+// mode 6 shares a low bit between every channel of an endpoint, so only a colour that agrees on it comes back exactly
+TEST(TextureCookerTest, IdenticalImagesMeasureAsLossless)
+{
+	Vector<Colour> texels(16 * 16);
+
+	for (auto& texel : texels) {
+		texel = Colour(128, 64, 32, 200);
+	}
+
+	Vector<byte> bc7 = encode(TEX_FORMAT_BC7_UNORM, texels, 16, 16, 1);
+	EXPECT_EQ(TextureCooker::calc_psnr(TEX_FORMAT_BC7_UNORM, texels.data(), 16, 16, bc7.data()), 99.0);
+}
+
+// the edge texels get repeated into the padding rather than left as garbage the endpoint fit would have to cover,
+// the gradient is steeper than the 64x64 one so it can't be held to quite the same number
+TEST(TextureCookerTest, SizesThatArentAMultipleOfFourArePadded)
+{
+	Vector<Colour> texels = make_gradient(37, 13);
+
+	Vector<byte> single = encode(TEX_FORMAT_BC7_UNORM, texels, 37, 13, 1);
+	Vector<byte> several = encode(TEX_FORMAT_BC7_UNORM, texels, 37, 13, 3);
+
+	ASSERT_EQ(single.size(), 10 * 4 * 16);
+	EXPECT_EQ(mem::compare(single.data(), several.data(), single.size()), 0);
+
+	EXPECT_GT(TextureCooker::calc_psnr(TEX_FORMAT_BC7_UNORM, texels.data(), 37, 13, single.data()), 32.0);
+}
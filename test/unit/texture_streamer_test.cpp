@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <wvn/graphics/texture_streamer.h>
+
+using namespace wvn;
+using namespace wvn::gfx;
+
+namespace
+{
+	// a 128x128 single channel texture, its pinned mip is 1 and its full resolution mip costs 16 KiB
+	TextureStreamID add_loaded_small_texture(TextureStreamer& streamer)
+	{
+		Vector<TextureStreamingChange> changes;
+
+		TextureStreamID id = streamer.add(128, 128, 1);
+		streamer.request(id, 0);
+		streamer.update(&changes);
+
+		return id;
+	}
+}
+
+TEST(TextureStreamerTest, PinsMipsUpToTheMinimumResidentSize)
+{
+	TextureStreamer streamer;
+
+	TextureStreamID id = streamer.add(1024, 1024, 4);
+
+	EXPECT_EQ(streamer.mip_count(id), 11);
+	EXPECT_EQ(streamer.resident_mip(id), 4);
+}
+
+TEST(TextureStreamerTest, EvictsUnusedMipsToMakeRoomForALoad)
+{
+	TextureStreamer streamer;
+	TextureStreamID small = add_loaded_small_texture(streamer);
+	ASSERT_EQ(streamer.resident_mip(small), 0);
+
+	// the next mip of the large texture costs 64 KiB, evicting the small texture's 16 KiB mip makes it fit exactly
+	TextureStreamID large = streamer.add(1024, 1024, 4);
+	streamer.set_budget(streamer.resident_bytes() + TextureStreamer::calc_mip_size(1024, 1024, 4, 3) - TextureStreamer::calc_mip_size(128, 128, 1, 0));
+
+	Vector<TextureStreamingChange> changes;
+	streamer.request(large, 3);
+	streamer.update(&changes);
+
+	EXPECT_EQ(streamer.resident_mip(small), 1);
+	EXPECT_EQ(streamer.resident_mip(large), 3);
+	EXPECT_EQ(streamer.resident_bytes(), streamer.budget());
+}
+
+TEST(TextureStreamerTest, LeavesResidentMipsAloneWhenALoadCantFit)
+{
+	TextureStreamer streamer;
+	TextureStreamID small = add_loaded_small_texture(streamer);
+	ASSERT_EQ(streamer.resident_mip(small), 0);
+
+	// evicting everything that can go still wouldn't free the 64 KiB the large texture needs
+	TextureStreamID large = streamer.add(1024, 1024, 4);
+	streamer.set_budget(streamer.resident_bytes());
+
+	u64 resident_before = streamer.resident_bytes();
+
+	Vector<TextureStreamingChange> changes;
+	streamer.request(large, 3);
+	streamer.update(&changes);
+
+	EXPECT_EQ(streamer.resident_mip(small), 0);
+	EXPECT_EQ(streamer.resident_mip(large), 4);
+	EXPECT_EQ(streamer.resident_bytes(), resident_before);
+	EXPECT_TRUE(changes.empty());
+}
+
+TEST(TextureStreamerTest, LoweringTheBudgetEvictsAsMuchAsItCan)
+{
+	TextureStreamer streamer;
+	TextureStreamID small = add_loaded_small_texture(streamer);
+	ASSERT_EQ(streamer.resident_mip(small), 0);
+
+	streamer.set_budget(0);
+
+	Vector<TextureStreamingChange> changes;
+	streamer.update(&changes);
+
+	EXPECT_EQ(streamer.resident_mip(small), 1);
+	ASSERT_EQ(changes.size(), 1);
+	EXPECT_EQ(changes[0].id, small);
+	EXPECT_EQ(changes[0].resident_mip, 1);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <wvn/maths/transform_hierarchy.h>
+
+using namespace wvn;
+
+TEST(TransformHierarchyTest, ChildrenFollowTheirParent)
+{
+	TransformHierarchy hierarchy;
+
+	TransformNodeID parent = hierarchy.create();
+	TransformNodeID child = hierarchy.create(parent);
+
+	hierarchy.set_position(parent, Vec3F(1.0f, 2.0f, 3.0f));
+	hierarchy.set_position(child, Vec3F(0.0f, 1.0f, 0.0f));
+	hierarchy.update();
+
+	Vec3F world = Affine3D::transform(Vec3F::zero(), hierarchy.world(child));
+
+	EXPECT_FLOAT_EQ(world.x, 1.0f);
+	EXPECT_FLOAT_EQ(world.y, 3.0f);
+	EXPECT_FLOAT_EQ(world.z, 3.0f);
+	EXPECT_EQ(hierarchy.parent(child), parent);
+}
+
+TEST(TransformHierarchyTest, DestroyTakesChildrenWithIt)
+{
+	TransformHierarchy hierarchy;
+
+	TransformNodeID parent = hierarchy.create();
+	TransformNodeID child = hierarchy.create(parent);
+	TransformNodeID other = hierarchy.create();
+
+	hierarchy.destroy(parent);
+	EXPECT_FALSE(hierarchy.is_valid(parent));
+
+	hierarchy.update();
+
+	EXPECT_FALSE(hierarchy.is_valid(child));
+	EXPECT_TRUE(hierarchy.is_valid(other));
+	EXPECT_EQ(hierarchy.size(), 1u);
+}
+
+TEST(TransformHierarchyTest, StaleIdsDontMatchAReusedSlot)
+{
+	TransformHierarchy hierarchy;
+
+	TransformNodeID old_node = hierarchy.create();
+	hierarchy.destroy(old_node);
+	hierarchy.update();
+
+	// the freed slot is handed straight back out, but under a new generation
+	TransformNodeID new_node = hierarchy.create();
+	hierarchy.update();
+
+	EXPECT_EQ((u32)new_node, (u32)old_node);
+	EXPECT_NE(new_node, old_node);
+	EXPECT_TRUE(hierarchy.is_valid(new_node));
+	EXPECT_FALSE(hierarchy.is_valid(old_node));
+}
+
+TEST(TransformHierarchyTest, NullAndUnknownIdsAreInvalid)
+{
+	TransformHierarchy hierarchy;
+	TransformNodeID node = hierarchy.create();
+
+	EXPECT_FALSE(hierarchy.is_valid(TransformHierarchy::NULL_ID));
+	EXPECT_FALSE(hierarchy.is_valid(node + 1));
+	EXPECT_FALSE(hierarchy.is_valid(node + (1ull << 32)));
+}
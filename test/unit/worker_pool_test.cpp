@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <wvn/system/worker_pool.h>
+
+using namespace wvn;
+using namespace wvn::sys;
+
+TEST(WorkerPoolTest, RunsEachThreadIndexOnce)
+{
+	WorkerPool pool;
+	pool.set_thread_count(4);
+
+	for (u32 run = 0; run < 100; run++)
+	{
+		std::atomic<u32> calls[WorkerPool::MAX_THREADS] = {};
+
+		pool.run(4, [&](u32 thread_idx) { calls[thread_idx]++; });
+
+		for (u32 i = 0; i < WorkerPool::MAX_THREADS; i++) {
+			EXPECT_EQ(calls[i].load(), i < 4 ? 1u : 0u) << "run " << run << ", thread " << i;
+		}
+	}
+}
+
+TEST(WorkerPoolTest, CallerIsThreadZero)
+{
+	WorkerPool pool;
+	pool.set_thread_count(3);
+
+	std::thread::id caller = std::this_thread::get_id();
+	std::thread::id ids[3] = {};
+
+	pool.run(3, [&](u32 thread_idx) { ids[thread_idx] = std::this_thread::get_id(); });
+
+	EXPECT_EQ(ids[0], caller);
+	EXPECT_NE(ids[1], caller);
+	EXPECT_NE(ids[2], caller);
+	EXPECT_NE(ids[1], ids[2]);
+}
+
+TEST(WorkerPoolTest, SmallJobsLeaveTheRestIdle)
+{
+	WorkerPool pool;
+	pool.set_thread_count(4);
+
+	std::atomic<u32> per_thread[4] = {};
+
+	pool.run(2, [&](u32 thread_idx) { per_thread[thread_idx]++; });
+
+	EXPECT_EQ(per_thread[0].load(), 1u);
+	EXPECT_EQ(per_thread[1].load(), 1u);
+	EXPECT_EQ(per_thread[2].load(), 0u);
+	EXPECT_EQ(per_thread[3].load(), 0u);
+
+	// asking for more threads than there are just uses them all
+	std::atomic<u32> calls = 0;
+	pool.run(100, [&](u32) { calls++; });
+	EXPECT_EQ(calls.load(), 4u);
+}
+
+TEST(WorkerPoolTest, ThreadCountIsClamped)
+{
+	WorkerPool pool;
+	EXPECT_EQ(pool.thread_count(), 1u);
+
+	pool.set_thread_count(0);
+	EXPECT_EQ(pool.thread_count(), 1u);
+
+	pool.set_thread_count(100);
+	EXPECT_EQ(pool.thread_count(), WorkerPool::MAX_THREADS);
+
+	std::atomic<u32> calls = 0;
+	pool.run(WorkerPool::MAX_THREADS, [&](u32) { calls++; });
+	EXPECT_EQ(calls.load(), WorkerPool::MAX_THREADS);
+
+	pool.set_thread_count(2);
+
+	calls = 0;
+	pool.run(WorkerPool::MAX_THREADS, [&](u32) { calls++; });
+	EXPECT_EQ(calls.load(), 2u);
+}